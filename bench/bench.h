@@ -0,0 +1,149 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        bench.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Math library benchmarks common header file.
+ * NOTE:        Benchmarks are built as separate console application
+ *              (see 'mth_bench.vcxproj'), not as part of engine.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __bench_h_
+#define __bench_h_
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "mth/mth.h"
+
+/* Benchmarks namespace */
+namespace bench
+{
+  /* Benchmark result record */
+  struct result
+  {
+    std::string
+      Suite,   // Suite name
+      Impl,    // Implementation (type and kernels level)
+      Name,    // Benchmark name
+      Kind;    // Measurement kind ("throughput" or "latency")
+    size_t Batch; // Number of operations per run
+    DBL
+      NsPerOp, // Best time of one operation (throughput) in nanoseconds
+      NsRun;   // Best time of whole run in nanoseconds
+  }; /* End of 'result' structure */
+
+  /* Keep value from optimizer function.
+   * ARGUMENTS:
+   *   - value reference:
+   *       const Type &V;
+   * RETURNS: None.
+   */
+  template<typename Type>
+    inline VOID Keep( const Type &V )
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      static const volatile char * volatile Sink;
+
+      Sink = &reinterpret_cast<const volatile char &>(V);
+      _ReadWriteBarrier();
+#else  // _MSC_VER && !__clang__
+      asm volatile("" : : "r,m"(V) : "memory");
+#endif // _MSC_VER && !__clang__
+    } /* End of 'Keep' function */
+
+  /* Benchmarks context */
+  class context
+  {
+  public:
+    std::vector<result> Results; // Collected results
+    std::string
+      Impl,                      // Current implementation name (stored to results)
+      Kind = "throughput";       // Current measurement kind (stored to results)
+    DBL MinRunTime = 0.01;       // Minimal measured time of one repeat in seconds
+    INT Repeats = 3;             // Number of repeats (best one is taken)
+
+    /* Run benchmark function.
+     * ARGUMENTS:
+     *   - suite and benchmark names:
+     *       const std::string &Suite, &Name;
+     *   - number of operations per run:
+     *       size_t Batch;
+     *   - run function (performs 'Batch' operations):
+     *       Func F;
+     * RETURNS:
+     *   (DBL) best time of one operation in nanoseconds.
+     */
+    template<typename Func>
+      DBL Run( const std::string &Suite, const std::string &Name, size_t Batch, Func F )
+      {
+        using clock = std::chrono::steady_clock;
+        size_t Runs = 1;
+        DBL Best = 1e300;
+
+        // Warm up and calibrate number of runs per repeat
+        for (;;)
+        {
+          auto Start = clock::now();
+
+          for (size_t i = 0; i < Runs; i++)
+            F();
+
+          DBL Time = std::chrono::duration<DBL>(clock::now() - Start).count();
+
+          if (Time >= MinRunTime || Runs >= (size_t(1) << 30))
+            break;
+          Runs *= 2;
+        }
+        for (INT r = 0; r < Repeats; r++)
+        {
+          auto Start = clock::now();
+
+          for (size_t i = 0; i < Runs; i++)
+            F();
+
+          DBL Time = std::chrono::duration<DBL, std::nano>(clock::now() - Start).count() / Runs;
+
+          Best = Time < Best ? Time : Best;
+        }
+        Results.push_back({Suite, Impl, Name, Kind, Batch, Best / Batch, Best});
+        return Best / Batch;
+      } /* End of 'Run' function */
+
+    /* Write results to JSON file function.
+     * ARGUMENTS:
+     *   - file name:
+     *       const std::string &FileName;
+     * RETURNS:
+     *   (BOOL) TRUE if success.
+     */
+    BOOL WriteJson( const std::string &FileName ) const;
+  }; /* End of 'context' class */
+
+  /* Expression templates benchmark suite function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID XprSuite( context &Ctx );
+
+  /* Math library benchmark suite function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID MthSuite( context &Ctx );
+} /* end of 'bench' namespace */
+
+#endif // !__bench_h_
+
+/* END OF 'bench.h' FILE */
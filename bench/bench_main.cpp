@@ -0,0 +1,104 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        bench_main.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Math library benchmarks startup file.
+ * NOTE:        Usage: mth_bench [-o results.json] [mth] [xpr]
+ *              (all suites are run if none is specified).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "bench.h"
+
+/* Write results to JSON file function.
+ * ARGUMENTS:
+ *   - file name:
+ *       const std::string &FileName;
+ * RETURNS:
+ *   (BOOL) TRUE if success.
+ */
+BOOL bench::context::WriteJson( const std::string &FileName ) const
+{
+  std::ofstream F(FileName);
+
+  if (!F.is_open())
+    return FALSE;
+
+  const char *Level = "none";
+#if defined(USE_MTH_MATR_SIMD)
+  const char *LevelNames[] = {"scalar", "sse4.1", "avx2"};
+
+  Level = LevelNames[static_cast<INT>(mth::simd::DetectLevel())];
+#endif // USE_MTH_MATR_SIMD
+
+  F << "{\n  \"cpu_level\": \"" << Level << "\",\n  \"results\": [\n";
+  for (size_t i = 0; i < Results.size(); i++)
+  {
+    const result &R = Results[i];
+    char Buf[64];
+
+    F << "    {\"suite\": \"" << R.Suite << "\", \"impl\": \"" << R.Impl <<
+         "\", \"name\": \"" << R.Name << "\", \"kind\": \"" << R.Kind <<
+         "\", \"batch\": " << R.Batch;
+    std::snprintf(Buf, sizeof(Buf), ", \"ns_per_op\": %.4f, \"ns_run\": %.2f}", R.NsPerOp, R.NsRun);
+    F << Buf << (i + 1 < Results.size() ? ",\n" : "\n");
+  }
+  F << "  ]\n}\n";
+  return F.good();
+} /* End of 'bench::context::WriteJson' function */
+
+/* Benchmarks main program function.
+ * ARGUMENTS:
+ *   - command line arguments:
+ *       INT argc; char *argv[];
+ * RETURNS:
+ *   (INT) program exit code.
+ */
+INT main( INT argc, char *argv[] )
+{
+  bench::context Ctx;
+  std::string JsonName = "mth_bench.json";
+  BOOL
+    IsMth = FALSE,
+    IsXpr = FALSE;
+
+  for (INT i = 1; i < argc; i++)
+    if (std::strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      JsonName = argv[++i];
+    else if (std::strcmp(argv[i], "mth") == 0)
+      IsMth = TRUE;
+    else if (std::strcmp(argv[i], "xpr") == 0)
+      IsXpr = TRUE;
+    else
+    {
+      std::fprintf(stderr, "Usage: %s [-o results.json] [mth] [xpr]\n", argv[0]);
+      return 1;
+    }
+  if (!IsMth && !IsXpr)
+    IsMth = IsXpr = TRUE;
+
+  if (IsMth)
+    bench::MthSuite(Ctx);
+  if (IsXpr)
+    bench::XprSuite(Ctx);
+
+  if (!Ctx.WriteJson(JsonName))
+  {
+    std::fprintf(stderr, "Cannot write '%s'\n", JsonName.c_str());
+    return 1;
+  }
+  std::printf("Results written to '%s'\n", JsonName.c_str());
+  return 0;
+} /* End of 'main' function */
+
+/* END OF 'bench_main.cpp' FILE */
@@ -0,0 +1,360 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        bench_mth.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Math library operations benchmark suite.
+ * NOTE:        'matr<FLT>' is measured with every supported kernels level
+ *              (scalar level runs the same code as generic template),
+ *              'matr<DBL>' measures generic template itself.
+ *              Throughput runs use independent operations over arrays,
+ *              latency runs chain every operation on previous result.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <cstdio>
+
+#include "bench.h"
+
+/* Benchmarks namespace */
+namespace bench
+{
+  /* Benchmark input data */
+  template<typename Type>
+    struct mth_input
+    {
+      std::vector<mth::vec3<Type>> V1, V2, VRes; // Vectors
+      std::vector<mth::matr<Type>> M1, M2, MRes; // Matrices
+      std::vector<Type> SRes;                    // Scalars
+
+      /* Constructor by size.
+       * ARGUMENTS:
+       *   - number of elements:
+       *       size_t N;
+       *   - random numbers generator:
+       *       mth::rng &Rng;
+       */
+      mth_input( size_t N, mth::rng &Rng ) :
+        V1(N), V2(N), VRes(N), M1(N), M2(N), MRes(N), SRes(N)
+      {
+        for (size_t i = 0; i < N; i++)
+        {
+          V1[i] = mth::vec3<Type>(Rng.Rnd1<Type>(), Rng.Rnd1<Type>(), Rng.Rnd1<Type>() + 2);
+          V2[i] = mth::vec3<Type>(Rng.Rnd1<Type>() + 2, Rng.Rnd1<Type>(), Rng.Rnd1<Type>());
+          M1[i] = mth::matr<Type>::Rotate(Rng.Rnd1<Type>() * 180, V1[i]) * mth::matr<Type>::Translate(V2[i]);
+          M2[i] = mth::matr<Type>::Scale(V2[i]) * mth::matr<Type>::RotateY(Rng.Rnd1<Type>() * 180);
+        }
+      } /* End of 'mth_input' function */
+    }; /* End of 'mth_input' structure */
+
+  /* Run operation throughput and latency benchmarks function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   *   - operation name:
+   *       const std::string &Name;
+   *   - number of operations:
+   *       size_t N;
+   *   - throughput run (independent operations) function:
+   *       Throughput T;
+   *   - latency run (dependent operations) function:
+   *       Latency L;
+   * RETURNS: None.
+   */
+  template<typename Throughput, typename Latency>
+    static VOID RunOp( context &Ctx, const std::string &Name, size_t N, Throughput T, Latency L )
+    {
+      Ctx.Kind = "throughput";
+      DBL Tt = Ctx.Run("mth", Name, N, T);
+
+      Ctx.Kind = "latency";
+      DBL Tl = Ctx.Run("mth", Name, N, L);
+
+      std::printf("  %-22s %6zu  %9.2f ns  %9.2f ns\n", Name.c_str(), N, Tt, Tl);
+    } /* End of 'RunOp' function */
+
+  /* Run operations benchmarks for one type and batch size function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   *   - number of operations per run:
+   *       size_t N;
+   * RETURNS: None.
+   */
+  template<typename Type>
+    static VOID RunOps( context &Ctx, size_t N )
+    {
+      using vec3 = mth::vec3<Type>;
+      using matr = mth::matr<Type>;
+      mth::rng Rng(47);
+      mth_input<Type> In(N, Rng);
+
+      RunOp(Ctx, "vec3 dot", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.SRes[i] = In.V1[i] & In.V2[i];
+          Keep(In.SRes[0]);
+        },
+        [&]( VOID )
+        {
+          Type S = 0;
+
+          for (size_t i = 0; i < N; i++)
+            S = (In.V1[i] * S + In.V2[i]) & In.V1[i];
+          Keep(S);
+        });
+      RunOp(Ctx, "vec3 cross", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.VRes[i] = In.V1[i] % In.V2[i];
+          Keep(In.VRes[0]);
+        },
+        [&]( VOID )
+        {
+          vec3 V = In.V1[0];
+
+          for (size_t i = 0; i < N; i++)
+            V = V % In.V2[i];
+          Keep(V);
+        });
+      RunOp(Ctx, "vec3 normalize", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.VRes[i] = In.V1[i].Normalizing();
+          Keep(In.VRes[0]);
+        },
+        [&]( VOID )
+        {
+          vec3 V = In.V1[0];
+
+          for (size_t i = 0; i < N; i++)
+            V = (V + In.V2[i]).Normalizing();
+          Keep(V);
+        });
+      RunOp(Ctx, "matr multiply", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.MRes[i] = In.M1[i] * In.M2[i];
+          Keep(In.MRes[0]);
+        },
+        [&]( VOID )
+        {
+          matr M = In.M1[0];
+
+          for (size_t i = 0; i < N; i++)
+            M = M * In.M2[i];
+          Keep(M);
+        });
+      RunOp(Ctx, "matr inverse", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.MRes[i] = In.M1[i].Inverse();
+          Keep(In.MRes[0]);
+        },
+        [&]( VOID )
+        {
+          matr M = In.M1[0];
+
+          for (size_t i = 0; i < N; i++)
+            M = M.Inverse();
+          Keep(M);
+        });
+      RunOp(Ctx, "matr transpose", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.MRes[i] = In.M1[i].Transpose();
+          Keep(In.MRes[0]);
+        },
+        [&]( VOID )
+        {
+          matr M = In.M1[0];
+
+          for (size_t i = 0; i < N; i++)
+            M = M.Transpose();
+          Keep(M);
+        });
+      RunOp(Ctx, "matr determinant", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.SRes[i] = !In.M1[i];
+          Keep(In.SRes[0]);
+        },
+        [&]( VOID )
+        {
+          Type S = 0;
+
+          for (size_t i = 0; i < N; i++)
+          {
+            matr M = In.M1[i];
+
+            M.M[3][0] += S;
+            S = !M * Type(1e-3);
+          }
+          Keep(S);
+        });
+      RunOp(Ctx, "matr transform point", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.VRes[i] = In.M1[i].TransformPoint(In.V1[i]);
+          Keep(In.VRes[0]);
+        },
+        [&]( VOID )
+        {
+          vec3 V = In.V1[0];
+
+          for (size_t i = 0; i < N; i++)
+            V = In.M1[i].TransformPoint(V);
+          Keep(V);
+        });
+      RunOp(Ctx, "matr View", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.MRes[i] = matr::View(In.V1[i], In.V2[i], vec3(0, 1, 0));
+          Keep(In.MRes[0]);
+        },
+        [&]( VOID )
+        {
+          vec3 Loc = In.V1[0];
+
+          for (size_t i = 0; i < N; i++)
+          {
+            matr M = matr::View(Loc, In.V2[i], vec3(0, 1, 0));
+
+            Loc = vec3(M.M[3][0], M.M[3][1], M.M[3][2] + 3);
+          }
+          Keep(Loc);
+        });
+      RunOp(Ctx, "matr Frustum", N,
+        [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.MRes[i] = matr::Frustum(-In.V1[i].X, In.V1[i].X, -In.V1[i].Y, In.V1[i].Y, 0.1f, 100);
+          Keep(In.MRes[0]);
+        },
+        [&]( VOID )
+        {
+          FLT W = 1;
+
+          for (size_t i = 0; i < N; i++)
+          {
+            matr M = matr::Frustum(-W, W, -In.V1[i].Y, In.V1[i].Y, 0.1f, 100);
+
+            W = FLT(M.M[0][0]) + 0.5f;
+          }
+          Keep(W);
+        });
+    } /* End of 'RunOps' function */
+
+  /* Run camera benchmarks for batch size function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   *   - number of operations per run:
+   *       size_t N;
+   * RETURNS: None.
+   */
+  static VOID RunCamera( context &Ctx, size_t N )
+  {
+    mth::rng Rng(47);
+    mth_input<FLT> In(N, Rng);
+    std::vector<mth::camera<FLT>> Cams(N);
+
+    RunOp(Ctx, "camera SetLocAtUp", N,
+      [&]( VOID )
+      {
+        for (size_t i = 0; i < N; i++)
+          Cams[i].SetLocAtUp(In.V1[i], In.V2[i]);
+        Keep(Cams[0]);
+      },
+      [&]( VOID )
+      {
+        mth::camera<FLT> &Cam = Cams[0];
+
+        for (size_t i = 0; i < N; i++)
+          Cam.SetLocAtUp(Cam.Loc + In.V1[i], In.V2[i]);
+        Keep(Cam);
+      });
+    RunOp(Ctx, "camera Resize", N,
+      [&]( VOID )
+      {
+        for (size_t i = 0; i < N; i++)
+          Cams[i].Resize(INT(100 + i % 1000), INT(100 + i % 700));
+        Keep(Cams[0]);
+      },
+      [&]( VOID )
+      {
+        mth::camera<FLT> &Cam = Cams[0];
+
+        for (size_t i = 0; i < N; i++)
+          Cam.Resize(INT(100 + i % 1000), Cam.FrameW / 2 + INT(i % 700));
+        Keep(Cam);
+      });
+  } /* End of 'RunCamera' function */
+
+  /* Math library benchmark suite function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID MthSuite( context &Ctx )
+  {
+    const size_t Batches[] = {1, 16, 256, 4096};
+
+    // Single precision with every kernels level
+#if defined(USE_MTH_MATR_SIMD)
+    const struct
+    {
+      mth::simd::level Level;
+      const char *Name;
+    } Levels[] =
+    {
+      {mth::simd::level::SCALAR, "matr<FLT> scalar"},
+      {mth::simd::level::SSE41, "matr<FLT> sse4.1"},
+      {mth::simd::level::AVX2, "matr<FLT> avx2"},
+    };
+    mth::simd::level Saved = mth::simd::GetKernels().Level;
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+        continue;
+      Ctx.Impl = L.Name;
+#else  // USE_MTH_MATR_SIMD
+    {
+      Ctx.Impl = "matr<FLT> scalar";
+#endif // USE_MTH_MATR_SIMD
+      std::printf("%s:\n  %-22s %6s  %12s  %12s\n", Ctx.Impl.c_str(), "operation", "batch", "throughput", "latency");
+      for (size_t N : Batches)
+      {
+        RunOps<FLT>(Ctx, N);
+        RunCamera(Ctx, N);
+      }
+    }
+#if defined(USE_MTH_MATR_SIMD)
+    mth::simd::SetLevel(Saved);
+#endif // USE_MTH_MATR_SIMD
+
+    // Generic template
+    Ctx.Impl = "matr<DBL> generic";
+    std::printf("%s:\n  %-22s %6s  %12s  %12s\n", Ctx.Impl.c_str(), "operation", "batch", "throughput", "latency");
+    for (size_t N : Batches)
+      RunOps<DBL>(Ctx, N);
+  } /* End of 'MthSuite' function */
+} /* end of 'bench' namespace */
+
+/* END OF 'bench_mth.cpp' FILE */
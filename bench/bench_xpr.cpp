@@ -0,0 +1,163 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        bench_xpr.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Lazy expressions ('mth_xpr.h') vs eager evaluation
+ *              benchmark suite.
+ * NOTE:        Chains are taken from units code ('u_map.cpp',
+ *              'u_ctrl.cpp', 'u_model.cpp'). Every chain is checked for
+ *              equal results before timing.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <cstdio>
+
+#include "bench.h"
+#include "mth/mth_xpr.h"
+
+/* Benchmarks namespace */
+namespace bench
+{
+  /* Matrix chain benchmark input */
+  struct xpr_input
+  {
+    std::vector<FLT> A, B;              // Angles
+    std::vector<mth::vec3<FLT>> T, S;   // Translations and scales
+    std::vector<mth::matr<FLT>> Res;    // Results
+  }; /* End of 'xpr_input' structure */
+
+  /* Count different matrices elements function.
+   * ARGUMENTS:
+   *   - matrices to compare:
+   *       const mth::matr<FLT> &M1, &M2;
+   * RETURNS:
+   *   (INT) number of different elements.
+   */
+  static INT CountDiff( const mth::matr<FLT> &M1, const mth::matr<FLT> &M2 )
+  {
+    INT Count = 0;
+
+    for (INT i = 0; i < 4; i++)
+      for (INT j = 0; j < 4; j++)
+        Count += M1.M[i][j] != M2.M[i][j];
+    return Count;
+  } /* End of 'CountDiff' function */
+
+  /* Run eager and lazy versions of chain function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   *   - benchmark input:
+   *       xpr_input &In;
+   *   - chain name:
+   *       const std::string &Name;
+   *   - eager and lazy chains (by element index):
+   *       Eager EagerChain; Lazy LazyChain;
+   * RETURNS: None.
+   */
+  template<typename Eager, typename Lazy>
+    static VOID RunChain( context &Ctx, xpr_input &In, const std::string &Name, Eager EagerChain, Lazy LazyChain )
+    {
+      size_t N = In.A.size();
+      INT Diff = 0;
+
+      for (size_t i = 0; i < N; i++)
+        Diff += CountDiff(EagerChain(i), LazyChain(i));
+
+      DBL
+        Te = Ctx.Run("xpr", Name + " eager", N, [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.Res[i] = EagerChain(i);
+          Keep(In.Res[0]);
+        }),
+        Tl = Ctx.Run("xpr", Name + " lazy", N, [&]( VOID )
+        {
+          for (size_t i = 0; i < N; i++)
+            In.Res[i] = LazyChain(i);
+          Keep(In.Res[0]);
+        });
+
+      std::printf("%-28s eager %8.2f ns  lazy %8.2f ns  speedup %5.2fx  diff %d\n", Name.c_str(), Te, Tl, Te / Tl, Diff);
+    } /* End of 'RunChain' function */
+
+  /* Expression templates benchmark suite function.
+   * ARGUMENTS:
+   *   - benchmarks context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID XprSuite( context &Ctx )
+  {
+    using matr = mth::matr<FLT>;
+    using vec3 = mth::vec3<FLT>;
+    namespace xpr = mth::xpr;
+    const size_t N = 1024;
+    mth::rng Rng(30);
+    xpr_input In;
+
+    In.A.resize(N), In.B.resize(N), In.T.resize(N), In.S.resize(N), In.Res.resize(N);
+    Ctx.Impl = "matr<FLT>";
+    Ctx.Kind = "throughput";
+    Rng.Fill(In.A, -180, 180);
+    Rng.Fill(In.B, -180, 180);
+    mth::FillRnd1(std::span<vec3>(In.T));
+    mth::FillRnd0(std::span<vec3>(In.S));
+    for (size_t i = 0; i < N; i++)
+      In.T[i] = In.T[i] * 100, In.S[i] = In.S[i] + vec3(0.5);
+
+    std::printf("Expression templates (%zu chains per run):\n", N);
+    RunChain(Ctx, In, "RotateY * Translate",
+      [&]( size_t i ) { return matr::RotateY(In.A[i]) * matr::Translate(In.T[i]); },
+      [&]( size_t i ) -> matr { return xpr::RotateY(In.A[i]) * xpr::Translate(In.T[i]); });
+    RunChain(Ctx, In, "RotateX * RotateY * Translate",
+      [&]( size_t i ) { return matr::RotateX(In.A[i]) * matr::RotateY(In.B[i]) * matr::Translate(In.T[i]); },
+      [&]( size_t i ) -> matr { return xpr::RotateX(In.A[i]) * xpr::RotateY(In.B[i]) * xpr::Translate(In.T[i]); });
+    RunChain(Ctx, In, "Scale * RotateY * Translate",
+      [&]( size_t i ) { return matr::Scale(In.S[i]) * matr::RotateY(In.A[i]) * matr::Translate(In.T[i]); },
+      [&]( size_t i ) -> matr { return xpr::Scale(In.S[i]) * xpr::RotateY(In.A[i]) * xpr::Translate(In.T[i]); });
+    RunChain(Ctx, In, "Translate * RotateX * Translate",
+      [&]( size_t i ) { return matr::Translate(-In.T[i]) * matr::RotateX(In.A[i]) * matr::Translate(In.T[i]); },
+      [&]( size_t i ) -> matr { return xpr::Translate(-In.T[i]) * xpr::RotateX(In.A[i]) * xpr::Translate(In.T[i]); });
+    RunChain(Ctx, In, "Scale * Translate * Scale",
+      [&]( size_t i ) { return matr::Scale(In.S[i]) * matr::Translate(In.T[i]) * matr::Scale(In.S[i]); },
+      [&]( size_t i ) -> matr { return xpr::Scale(In.S[i]) * xpr::Translate(In.T[i]) * xpr::Scale(In.S[i]); });
+
+    // Vector expression: (A + B) * s - C / d
+    std::vector<vec3> Res(N);
+    INT Diff = 0;
+    auto VecEager = [&]( size_t i ) { return (In.T[i] + In.S[i]) * In.A[i] - In.T[(i + 1) % N] / In.B[i]; };
+    auto VecLazy = [&]( size_t i ) -> vec3 { return (xpr::Lazy(In.T[i]) + xpr::Lazy(In.S[i])) * In.A[i] - xpr::Lazy(In.T[(i + 1) % N]) / In.B[i]; };
+
+    for (size_t i = 0; i < N; i++)
+    {
+      vec3 Ve = VecEager(i), Vl = VecLazy(i);
+
+      Diff += (Ve.X != Vl.X) + (Ve.Y != Vl.Y) + (Ve.Z != Vl.Z);
+    }
+
+    DBL
+      Te = Ctx.Run("xpr", "(A + B) * s - C / d eager", N, [&]( VOID )
+      {
+        for (size_t i = 0; i < N; i++)
+          Res[i] = VecEager(i);
+        Keep(Res[0]);
+      }),
+      Tl = Ctx.Run("xpr", "(A + B) * s - C / d lazy", N, [&]( VOID )
+      {
+        for (size_t i = 0; i < N; i++)
+          Res[i] = VecLazy(i);
+        Keep(Res[0]);
+      });
+
+    std::printf("%-28s eager %8.2f ns  lazy %8.2f ns  speedup %5.2fx  diff %d\n", "(A + B) * s - C / d", Te, Tl, Te / Tl, Diff);
+  } /* End of 'XprSuite' function */
+} /* end of 'bench' namespace */
+
+/* END OF 'bench_xpr.cpp' FILE */
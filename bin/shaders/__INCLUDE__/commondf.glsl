@@ -11,6 +11,8 @@
 #ifndef _COMDF_GLSL_INC_ // Protection against repeated inclusions
 #define _COMDF_GLSL_INC_
 
+#extension GL_EXT_nonuniform_qualifier : require
+
 
 
 //=========================================
@@ -60,6 +62,7 @@ layout(std140, set = 0, binding = 1) uniform SYNC_BUF
 {              
   vec4 TimeDTGlobalTimeDT;    // Time parameters
   vec4 IsWireFrameIsPause[4]; // WireFrame, pause, FPS, ... flags
+  ivec4 TexIds;               // Global textures slots in textures array (sky, -1 if no texture)
 };
                                               
 /* Macroses for fast UBO synchronization data access  */
@@ -70,6 +73,7 @@ layout(std140, set = 0, binding = 1) uniform SYNC_BUF
 #define IsWireFrame     bool(IsWireFrameIsPause[0])
 #define IsPause         bool(IsWireFrameIsPause[1])
 #define FPS             IsWireFrameIsPause.z
+#define SkyTexId        TexIds.x
 
 
 /*
@@ -81,7 +85,7 @@ struct Material
   vec4 Ka4;              // Ambient time parameters
   vec4 KdTrans;          // Diffuse coefficient and transpanency
   vec4 KsPh;             // Specular coefficient and Phong power value
-  bvec4 TextureFlags;    // Material texture flags
+  ivec4 TextureIds[2];   // Material textures slots in textures array (-1 if no texture)
 };
 
 // Material data UBO representation type
@@ -120,10 +124,11 @@ layout(push_constant, std140) uniform DRAW_BUF
 #define MtlKs Materials[MtlId].KsPh.xyz
 //#define Ph KsPh.w 
 #define MtlPh Materials[MtlId].KsPh.w   
-#define IsTexture0 bool(Materials[MtlId].TextureFlags[0])     
-#define IsTexture1 bool(Materials[MtlId].TextureFlags[1])
-#define IsTexture2 bool(Materials[MtlId].TextureFlags[2])
-#define IsTexture3 bool(Materials[MtlId].TextureFlags[3])
+#define MtlTexId(i) Materials[MtlId].TextureIds[(i) / 4][(i) % 4]
+#define IsTexture0 (MtlTexId(0) >= 0)
+#define IsTexture1 (MtlTexId(1) >= 0)
+#define IsTexture2 (MtlTexId(2) >= 0)
+#define IsTexture3 (MtlTexId(3) >= 0)
 
 /*
  * PRIMITIVE
@@ -155,8 +160,13 @@ layout(std140, set = 0, binding = 3) buffer PRIM_BUF
 #define AddonF   PrimBufs[PrimId].AddonFArray
 #define AddonV   PrimBufs[PrimId].AddonVArray
 
-//layout(std140, set = 0, binding = 4) sampl
-layout(set = 1, binding = 0) uniform sampler2D Tex;
+// Textures array (bound once per frame, indexed by material and sync buffers slots)
+layout(set = 1, binding = 0) uniform sampler2D Textures[];
+
+/* Macroses for fast textures access (indices are same for whole draw call, so no 'nonuniformEXT') */
+#define MtlTex(i) Textures[MtlTexId(i)]
+#define Tex       MtlTex(0)
+#define SkyTex    Textures[SkyTexId]
 
 
 /*
@@ -8,8 +8,6 @@
 
 #line 8
 
-layout(binding = 0) uniform sampler2D Tex;
-
 in vec4 DrawColor;     
 in vec2 DrawTexCoord;
 in vec3 DrawNormal;
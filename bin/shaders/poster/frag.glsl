@@ -8,8 +8,6 @@
 
 in vec2 DrawPosition;
 
-layout(binding = 0) uniform sampler2D Tex;
-
 void main( void )
 {                                           
   OutColor = texelFetch(Tex, ivec2(DrawPosition), 0);
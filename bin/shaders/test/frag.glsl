@@ -7,7 +7,7 @@
 //
 #version 460
 
-#include <commondf.h>
+#include <commondf.glsl>
 
 // Entry data to shader
 layout(location = 0) in VS_OUT
@@ -7,7 +7,7 @@
 //
 #version 460
 
-#include <commondf.h>
+#include <commondf.glsl>
 
 // Entry to shader data
 layout(location = 0) in vec3 InPosition; // Position
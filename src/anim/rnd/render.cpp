@@ -5,7 +5,7 @@
 
 /* FILE:        render.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Render functions declaring file.
  * NOTE:        None.
  *
@@ -31,7 +31,7 @@ namespace pivk
     matr w = Pr->Transform * World;
     DRAW_BUF Buf =
     {
-      w, w * Camera.VP, w.Inverse().Transpose(), // Matrixes
+      w, w * Camera.VP, w.NormalMatrix(),        // Matrixes
       {Pr->Mtl->Id, Pr->Id, 0, 0},               // Subdata for primnitives and materials
       {{}, {}, {},},                         // Array with subdata
     };
@@ -53,9 +53,15 @@ namespace pivk
 
     if (1)
     {
-      if (Pr->VBuf != nullptr)
+      // Buffers not created because of out of device memory are skipped
+      if (Pr->VBuf != nullptr && Pr->VBuf->Buffer != nullptr && (Pr->IBuf == nullptr || Pr->IBuf->Buffer != nullptr))
       {
         UINT64 Offset = 0;
+
+        // Buffers rewriting waits for this frame
+        Pr->VBuf->LastUse = VulkanCore.FrameNo;
+        if (Pr->IBuf != nullptr)
+          Pr->IBuf->LastUse = VulkanCore.FrameNo;
         vkCmdBindVertexBuffers(VulkanCore.CommandBuffer, 0, 1, &Pr->VBuf->Buffer, &Offset);
         if (Pr->IBuf != nullptr)
         {
@@ -67,6 +73,48 @@ namespace pivk
       }
     }
   } /* End of 'render::Draw' function */
+
+  /* Evict least recently used resources function.
+   * ARGUMENTS:
+   *   - number of bytes to free:
+   *       UINT64 Bytes;
+   * RETURNS:
+   *   (UINT64) number of freed bytes.
+   */
+  UINT64 render::EvictLRU( UINT64 Bytes )
+  {
+    /* Eviction candidate structure */
+    struct candidate
+    {
+      UINT64 LastUse; // Number of last frame resource was used in
+      texture *Tex;   // Texture (nullptr for model)
+      model *Mdl;     // Model (nullptr for texture)
+    };
+    std::vector<candidate> Candidates;
+    UINT64 Frame = VulkanCore.FrameNo, Freed = 0, Age = VulkanCore.Frames.size();
+
+    // Resources used by frames in flight (texture slots may still be read) are working set and stay resident.
+    // Only textures loaded from file can be reloaded after eviction.
+    for (texture &T : texture_manager::Stock)
+      if (T.IsFromFile && T.Image != VK_NULL_HANDLE && T.LastUse + Age < Frame)
+        Candidates.push_back({T.LastUse, &T, nullptr});
+    for (model &M : model_manager::Stock)
+      if (!M.IsEvicted && !M.Prims.empty() && M.LastUse + Age < Frame)
+        Candidates.push_back({M.LastUse, nullptr, &M});
+
+    std::sort(Candidates.begin(), Candidates.end(),
+      []( const candidate &A, const candidate &B )
+      {
+        return A.LastUse < B.LastUse;
+      });
+    for (auto &C : Candidates)
+    {
+      if (Freed >= Bytes)
+        break;
+      Freed += C.Tex != nullptr ? C.Tex->TexEvict() : C.Mdl->Evict();
+    }
+    return Freed;
+  } /* End of 'render::EvictLRU' function */
 } /* end of 'pivk' namespace */
 
 /* END OF 'render.cpp' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        render.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 28.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Render core header file.
  * NOTE:        None.
  * 
@@ -40,9 +40,7 @@ namespace pivk
   public:
     vlk VulkanCore;          // Vulkan core
     anim &AnimRef;           // Animation reference
-    vlk_buf *CamBuf;         // Camera buffer
     vlk_buf *PrBuf;          // Primitive buffer
-    vlk_buf *SyncBuf;        // Sync buffer
     camera Camera;           // Camera of render
     HDC hDC;                 // Program context
 
@@ -68,8 +66,11 @@ namespace pivk
     {
       vec4 TimeDTGlobalTimeDT;    // Time parameters
       vec4 IsWireFrameIsPause[4]; // WireFrame, pause, FPS, ... flags
+      ivec4 TexIds;               // Global textures slots in textures array (sky, -1 if no texture)
     };
 
+    CAMERA_BUF CamData {};   // Camera buffer data (written to ring buffer every frame)
+
     /* Struct for push constants data */
     struct DRAW_BUF
     {
@@ -112,16 +113,21 @@ namespace pivk
 
       VulkanCore.Init();
 
+      // Keep device memory under budget by evicting least recently used textures and models
+      VulkanCore.OnEvict = [this]( UINT64 Bytes )
+        {
+          return EvictLRU(Bytes);
+        };
+
       /*** Render parametrs setup ***/
       render::Camera.SetLocAtUp(vec3(20.0f), vec3(0.0f));
 
       // Create default buffers
       //PrBuf = VulkanCore.BufCreate(sizeof(PRIM_BUF), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT); //BufCreate<PRIM_BUF>("Primitive buffer", BufferBindPrim);
       //PrBuf->Apply();
-      SyncBuf = VulkanCore.BufCreate(sizeof(SYNC_BUF), 1, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);//BufCreate<SYNC_BUF>("Sync buffer", BufferBindSync);
-      //SyncBuf->Apply();
-      CamBuf = VulkanCore.BufCreate(sizeof(CAMERA_BUF), 1, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);//BufCreate<CAMERA_BUF>("Camera buffer", BufferBindCamera);
-      //CamBuf->Apply();
+      // Camera and sync buffers are in ring buffer (written once, bound by dynamic offsets)
+      VulkanCore.UpdateDescriptor(VulkanCore.RingBuf, BufferBindCamera, 2, sizeof(CAMERA_BUF));
+      VulkanCore.UpdateDescriptor(VulkanCore.RingBuf, BufferBindSync, 2, sizeof(SYNC_BUF));
 
       TextureInit();
       //shader_manager::ShdCreate("Default");
@@ -141,11 +147,10 @@ namespace pivk
       ShdClose();
 
       // Buffers delete
-      material_manager::MaterialSSBO->Free();
+      material_manager::MaterialSSBO.Free();
+      primitive_manager::PrimitiveSSBO.Free();
 
       //PrBuf->Free();
-      SyncBuf->Free();
-      CamBuf->Free();
 
       // Delete vulkan core
       VulkanCore.Close();
@@ -158,7 +163,8 @@ namespace pivk
      */
     VOID UpdateCameraBuf( VOID )
     {
-      CAMERA_BUF Buf {};
+      CAMERA_BUF &Buf = CamData;
+
       Buf.CamAt4 = vec4(Camera.At, 0);
       Buf.CamDir4 = vec4(Camera.Dir, 0);
       Buf.CamLoc4 = vec4(Camera.Loc, 0);
@@ -171,8 +177,6 @@ namespace pivk
       Buf.MatrShadow = matr::Identity();
       Buf.MatrV = Camera.View;
       Buf.MatrVP = Camera.VP;
-      CamBuf->Write(&Buf);
-      VulkanCore.UpdateDescriptor(CamBuf, BufferBindCamera);
     } /* End of 'UpdateCameraBuf' function */
 
     /* Resize function.
@@ -199,21 +203,37 @@ namespace pivk
      */    
     VOID FrameStart( VOID )
     {
-      /* Update buffer with materials */
-      material_manager::MtlUpdateSSBO();
+      // Evicted models drawn by previous frame are loaded before recording
+      model_manager::ModelReload();
 
-      /* Update SYNC buffer */
-      SYNC_BUF Buf {};
-      SyncBuf->Write(&Buf);
-      VulkanCore.UpdateDescriptor(SyncBuf, BufferBindSync);
+      /* Update buffers with materials and primitives */
+      material_manager::MtlUpdateSSBO();
+      primitive_manager::PrimUpdateSSBO();
+      // Descriptor writes of changed buffers are applied by one call before recording
+      VulkanCore.FlushDescriptors();
 
       VulkanCore.RenderStart();
 
-      // Bind buffers
+      /* Write camera and SYNC buffers to ring buffer part of this frame */
+      SYNC_BUF Buf {};
+      texture *Sky = TextureSky();
+
+      Buf.TexIds = ivec4(-1, -1, -1, -1);
+      if (Sky != nullptr)
+      {
+        Sky->TexApply();
+        Buf.TexIds[0] = Sky->TexIndex;
+      }
+      VulkanCore.DynamicOffsets[BufferBindCamera] = VulkanCore.RingWrite(CamData);
+      VulkanCore.DynamicOffsets[BufferBindSync] = VulkanCore.RingWrite(Buf);
+
+      // Materials and primitives changed since this frame resources were used are copied to them
+      VulkanCore.DynamicOffsets[BufferBindMaterial] = material_manager::MaterialSSBO.Sync();
+      VulkanCore.DynamicOffsets[BufferBindPrim] = primitive_manager::PrimitiveSSBO.Sync();
+
+      // Bind buffers (all system buffers are in one descriptor set) and textures array
       VulkanCore.BindDescriptor(BufferBindCamera);
-      VulkanCore.BindDescriptor(BufferBindSync);
-      VulkanCore.BindDescriptor(BufferBindMaterial);
-      VulkanCore.BindDescriptor(BufferBindPrim);
+      VulkanCore.BindTexDescriptor();
       // TODO: shd update
       //ShdUpdate(); NOT USED
     } /* End of 'FrameStart' function */
@@ -225,6 +245,7 @@ namespace pivk
     VOID FrameEnd( VOID )
     {
       VulkanCore.RenderEnd();
+      VulkanCore.MemUpdate();
       //SwapBuffers(hDC);
     } /* End of 'FrameEnd' function */
 
@@ -240,6 +261,15 @@ namespace pivk
      */
     VOID Draw( const prim *Pr, const matr &World = matr::Identity(), const std::array<fvec4, 4> *SubData = nullptr );// const;
 
+    /* Evict least recently used resources function.
+     * ARGUMENTS:
+     *   - number of bytes to free:
+     *       UINT64 Bytes;
+     * RETURNS:
+     *   (UINT64) number of freed bytes.
+     */
+    UINT64 EvictLRU( UINT64 Bytes );
+
   }; /* End of 'render' class */
 
 } /* end of 'pivk' namespace */
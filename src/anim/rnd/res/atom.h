@@ -0,0 +1,166 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        atom.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Interned names (atoms) table header file.
+ * NOTE:        Every distinct name is stored once and gets compact
+ *              identifier, so resources are found by integer key.
+ *              Names are never removed from table.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __atom_h_
+#define __atom_h_
+
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+
+#include "def.h"
+
+/* Base project namespace */
+namespace pivk
+{
+  /* Interned name class */
+  class atom
+  {
+  private:
+    /* Atoms table structure */
+    struct table
+    {
+      std::shared_mutex Mutex;                           // Table access guard
+      std::deque<std::string> Names {std::string()};     // Names storage (stable addresses, 0 - empty name)
+      std::unordered_map<std::string_view, UINT32> Ids;  // Name -> identifier table (views into 'Names')
+    }; /* End of 'table' structure */
+
+    /* Get global atoms table function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (table &) table reference.
+     */
+    static table & Table( VOID )
+    {
+      static table Tbl;
+
+      return Tbl;
+    } /* End of 'Table' function */
+
+  public:
+    UINT32 Id {}; // Atom identifier (0 - empty name)
+
+    /* Class default constructor */
+    constexpr atom( VOID ) = default;
+
+    /* Class constructor by name (interns name).
+     * ARGUMENTS:
+     *   - name:
+     *       std::string_view Name;
+     */
+    explicit atom( std::string_view Name ) : Id(Intern(Name).Id)
+    {
+    } /* End of 'atom' function */
+
+    /* Intern name function.
+     * ARGUMENTS:
+     *   - name:
+     *       std::string_view Name;
+     * RETURNS:
+     *   (atom) name atom.
+     */
+    static atom Intern( std::string_view Name )
+    {
+      if (atom A = Lookup(Name); A || Name.empty())
+        return A;
+
+      table &Tbl = Table();
+      std::unique_lock Lock(Tbl.Mutex);
+
+      // Name could be added while lock was released
+      if (auto Found = Tbl.Ids.find(Name); Found != Tbl.Ids.end())
+        return FromId(Found->second);
+
+      UINT32 NewId = static_cast<UINT32>(Tbl.Names.size());
+
+      Tbl.Names.emplace_back(Name);
+      Tbl.Ids.emplace(Tbl.Names.back(), NewId);
+      return FromId(NewId);
+    } /* End of 'Intern' function */
+
+    /* Find already interned name function (never adds name).
+     * ARGUMENTS:
+     *   - name:
+     *       std::string_view Name;
+     * RETURNS:
+     *   (atom) name atom or empty atom if name was never interned.
+     */
+    static atom Lookup( std::string_view Name )
+    {
+      table &Tbl = Table();
+      std::shared_lock Lock(Tbl.Mutex);
+
+      if (auto Found = Tbl.Ids.find(Name); Found != Tbl.Ids.end())
+        return FromId(Found->second);
+      return atom();
+    } /* End of 'Lookup' function */
+
+    /* Build atom from identifier function.
+     * ARGUMENTS:
+     *   - atom identifier:
+     *       UINT32 NewId;
+     * RETURNS:
+     *   (atom) atom.
+     */
+    static constexpr atom FromId( UINT32 NewId )
+    {
+      atom A;
+
+      A.Id = NewId;
+      return A;
+    } /* End of 'FromId' function */
+
+    /* Get atom name function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (std::string_view) interned name (valid until program end).
+     */
+    std::string_view Str( VOID ) const
+    {
+      table &Tbl = Table();
+      std::shared_lock Lock(Tbl.Mutex);
+
+      return Tbl.Names[Id];
+    } /* End of 'Str' function */
+
+    /* Check non empty atom operator.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if atom refers to non empty name.
+     */
+    constexpr explicit operator bool( VOID ) const
+    {
+      return Id != 0;
+    } /* End of 'operator bool' function */
+
+    /* Compare atoms operator.
+     * ARGUMENTS:
+     *   - atom to compare with:
+     *       const atom &A;
+     * RETURNS:
+     *   (BOOL) TRUE if atoms are equal.
+     */
+    constexpr BOOL operator==( const atom &A ) const
+    {
+      return Id == A.Id;
+    } /* End of 'operator==' function */
+  }; /* End of 'atom' class */
+} /* end of 'pivk' namespace */
+
+#endif // !__atom_h_
+
+/* END OF 'atom.h' FILE */
@@ -152,8 +152,8 @@ namespace pivk
 
     /* Buffer update function.
      * ARGUMENTS:
-     *   - name:
-     *       const std::string &Name;
+     *   - name (string or interned):
+     *       name_type Name;
      *   - buffer data:
      *       const data_type *Data;
      *   - start of elements update:
@@ -162,24 +162,60 @@ namespace pivk
      *       INT Size;
      * RETURNS: None.
      */
-    template<typename data_type>
-      VOID BufUpdate( const std::string &Name, const data_type* Data, INT Start = 0, INT Size = -1 )
+    template<typename data_type, typename name_type>
+      VOID BufUpdate( const name_type &Name, const data_type* Data, INT Start = 0, INT Size = -1 )
       {
-        if (auto *ptr = resource_manager::Find(Name); ptr != nullptr)
+        if (auto *ptr = BufFind(Name); ptr != nullptr)
           ptr->Update(Data, Start, Size);
       } /* End of 'BufUpdate' function */
 
+    /* Apply buffer function.
+     * ARGUMENTS:
+     *   - interned name:
+     *       atom Name;
+     * RETURNS: None.
+     */
+    VOID BufApply( atom Name )
+    {
+      if (auto *ptr = BufFind(Name); ptr != nullptr)
+        ptr->Apply();
+    } /* End of 'BufApply' function */
+
     /* Apply buffer function.
      * ARGUMENTS:
      *   - name:
-     *       const std::string &Name;
+     *       std::string_view Name;
      * RETURNS: None.
      */
-    VOID BufApply( const std::string &Name )
+    VOID BufApply( std::string_view Name )
     {
-      if (auto *ptr = resource_manager::Find(Name); ptr != nullptr)
+      if (auto *ptr = BufFind(Name); ptr != nullptr)
         ptr->Apply();
     } /* End of 'BufApply' function */
+
+    /* Find buffer by interned name function.
+     * ARGUMENTS:
+     *   - interned name:
+     *       atom Name;
+     * RETURNS:
+     *   (buffer *) found buffer or nullptr.
+     */
+    buffer * BufFind( atom Name )
+    {
+      return resource_manager::Find(Name);
+    } /* End of 'BufFind' function */
+
+    /* Find buffer by name function.
+     * ARGUMENTS:
+     *   - name:
+     *       std::string_view Name;
+     * RETURNS:
+     *   (buffer *) found buffer or nullptr.
+     */
+    buffer * BufFind( std::string_view Name )
+    {
+      return resource_manager::Find(Name);
+    } /* End of 'BufFind' function */
   }; /* End of 'buffer_manager' class */
 } /* end of 'pivk' namespace */
 
@@ -8,7 +8,7 @@
  *               Markers class implementation module.
  * PROGRAMMER  : CGSG'Sr'2023.
  *               IP5.
- * LAST UPDATE : 26.11.2024.
+ * LAST UPDATE : 17.10.2026.
  * NOTE        : Module namespace 'pivk'.
  *
  * No part of this file may be changed without agreement of
@@ -76,7 +76,7 @@ VOID pivk::marker_manager::DrawAllMarkers( VOID )
   matr
     w = matr::Identity(),
     wvp = w * RndRef.Camera.VP,
-    invw = w.Inverse();
+    invw = w.InverseAffine(mth::matr_kind::RIGID);
 
   for (INT i = 0; i < 2; i++)
   {
@@ -112,7 +112,7 @@ VOID pivk::marker_manager::DrawAllMarkers( VOID )
     {
       //vkCmdBindDescriptorSets(RndRef.VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, PipelineLayouts[0],
       //                        0, 1, &RndRef.VulkanCore.DescriptorSet, 0, nullptr);
-      vkCmdBindPipeline(RndRef.VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, MarkersPipelines[0]);
+      RndRef.VulkanCore.BindPipeline(MarkersPipelines[0]);
       RndRef.VulkanCore.BindDescriptor(0);
 
       render::DRAW_BUF bp 
@@ -148,7 +148,7 @@ VOID pivk::marker_manager::DrawAllMarkers( VOID )
     {
       //vkCmdBindDescriptorSets(RndRef.VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, PipelineLayouts[1],
       //                        0, 1, &RndRef.VulkanCore.FrameDescriptorSet, 0, nullptr);
-      vkCmdBindPipeline(RndRef.VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, MarkersPipelines[1]);
+      RndRef.VulkanCore.BindPipeline(MarkersPipelines[1]);
       RndRef.VulkanCore.BindDescriptor(0);
 
       render::DRAW_BUF bp 
@@ -5,7 +5,7 @@
 
 /* FILE:        material.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Material functions declaring file.
  * NOTE:        None.
  *
@@ -25,9 +25,9 @@ namespace pivk
   VOID material_manager::MtlInit()
   {
     // Default materials list
-    static struct _MatLibType
+    static constexpr struct _MatLibType
     {
-      std::string Name;
+      const CHAR *Name;
       vec3 amb, dif, spec;
       FLOAT shin;
     } MatLib[] =
@@ -57,7 +57,7 @@ namespace pivk
 
     for (INT i = 0; i < MatLibSize; ++i)
     {
-      material *M = material_manager::Add(material().Create(MatLib[i].Name,
+      material *M = material_manager::Add(material().Create(std::string(MatLib[i].Name),
                                           MatLib[i].amb,
                                           MatLib[i].dif,
                                           MatLib[i].spec,
@@ -66,7 +66,7 @@ namespace pivk
       //M->Shd = RndRef.ShdFind("default");
     }
 
-    MaterialSSBO = RndRef.VulkanCore.BufCreate(10000 * sizeof(material::BUF_MTL), 10000, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    MaterialSSBO.Create(&RndRef.VulkanCore, BufferBindMaterial, sizeof(material::BUF_MTL), 256);
   } /* End of 'MtlInit' function */
 
   /* Material creation function.
@@ -133,58 +133,80 @@ namespace pivk
    */
   INT material::Apply( VOID )
   {
+    if (Shd != nullptr)
+    {
+      // Variant is looked up only when shader pipeline is changed (e.g. reloaded)
+      if (PipelineBase != Shd->Pipeline)
+      {
+        PipelineBase = Pipeline = Shd->Pipeline;
+        if (CullMode.has_value() || IsBlend.has_value())
+        {
+          pipeline_key Key = Shd->PipelineKey;
+
+          if (CullMode.has_value())
+            Key.CullMode = *CullMode;
+          if (IsBlend.has_value())
+          {
+            Key.BlendEnable = *IsBlend ? VK_TRUE : VK_FALSE;
+            Key.SrcColorBlend = *IsBlend ? VK_BLEND_FACTOR_SRC_ALPHA : VK_BLEND_FACTOR_ONE;
+            Key.DstColorBlend = *IsBlend ? VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA : VK_BLEND_FACTOR_ZERO;
+            // Transparent surfaces do not hide each other (opaque keep shader depth write state)
+            if (*IsBlend)
+              Key.DepthWrite = VK_FALSE;
+          }
+          Pipeline = Rnd->VulkanCore.PipelineGet(Key);
+        }
+      }
+      Rnd->VulkanCore.BindPipeline(Pipeline);
+    }
+
     // Apply ubo buffer
     this->Rnd->VulkanCore.BindDescriptor(BufferBindMaterial);
 
-    /* Set textures */
+    /* Mark textures used (they are read from textures array by material buffer indices) */
     for (INT i = 0; i < 8; i++)
     {
       if (this->Tex[i] != nullptr)
-        Tex[i]->TexApply(i);
+        Tex[i]->TexApply();
     }
-    if (auto *ptr = Rnd->TextureFind("Skytex"); ptr != nullptr)
-      ptr->TexApply(8);
 
     return INT();
   } /* End of 'material::Apply' function */
 
-  /* Update buffers and textures function.
+  /* Get material storage buffer record function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (BUF_MTL) material buffer data.
+   */
+  material::BUF_MTL material::GetBufData( VOID ) const
+  {
+    BUF_MTL Buf;
+
+    Buf.Ka = vec4(Ka, 0);
+    Buf.KdTrans = vec4(Kd, Trans);
+    Buf.KsPh = vec4(Ks, Ph);
+    for (INT i = 0; i < 8; ++i)
+      Buf.TextureIds[i] = Tex[i] == nullptr ? -1 : Tex[i]->TexIndex;
+    return Buf;
+  } /* End of 'material::GetBufData' function */
+
+  /* Update material record in storage buffer function.
    * ARGUMENTS: None.
    * RETURNS: None.
    */
   VOID material::Update( VOID )
   {
-    //BufferMtl
-    //BUF_MTL buf;
-    //buf.Ka = vec4(Ka, 0);
-    //buf.KdTrans = vec4(Kd, Trans);
-    //buf.KsPh = vec4(Ks, Ph);
-    //for (INT i = 0; i < 8; i++)
-    //{
-    //  if (this->Tex[i] != nullptr)
-    //    buf.TextureFlags[i] = 1;
-    //  else
-    //    buf.TextureFlags[i] = -1;
-    //}
-    ////BufferMtl->Write(&buf);
-    //
-    ////this->Rnd->VulkanCore.UpdateDescriptor(BufferMtl, BufferBindMaterial);
-    ////this->Rnd->VulkanCore.BindDescriptor(BufferBindMaterial);
-    //
-    ///* Set textures */
-    //for (INT i = 0; i < 8; i++)
-    //{
-    //  if (this->Tex[i] != nullptr)
-    //  {
-    //    this->Rnd->VulkanCore.TexUpdateDescriptor(Tex[i]->ImageView, Tex[i]->Sampler, i + 4);
-    //    //this->Rnd->VulkanCore.BindDescriptor(BufferBindMaterial);
-    //  }
-    //}
-    //if (auto *ptr = Rnd->TextureFind("Skytex"); ptr != nullptr)
-    //{
-    //  this->Rnd->VulkanCore.TexUpdateDescriptor(ptr->ImageView, ptr->Sampler, 12);
-    //  //this->Rnd->VulkanCore.BindDescriptor(BufferBindMaterial);
-    //}
+    // Pipeline variant is looked up again (overrides may be changed)
+    PipelineBase = VK_NULL_HANDLE;
+
+    // Whole buffer is rewritten at frame start anyway
+    if (Id < 0 || Rnd->UpdateMaterialSSBO)
+      return;
+
+    BUF_MTL Buf = GetBufData();
+
+    // Only record of this material is written (frames in flight keep their copies)
+    Rnd->MaterialSSBO.Write(Id, &Buf);
   } /* End of 'material::Update' function */
 
   /* Update material storage buffer function.
@@ -197,36 +219,17 @@ namespace pivk
       return;
 
     UpdateMaterialSSBO = FALSE;
-    MaterialSSBO->Resize(resource_manager::TotalRefCnt * sizeof(material::BUF_MTL), resource_manager::TotalRefCnt);
-
-    BYTE *MapPointer;
-
-    if (vmaMapMemory(RndRef.VulkanCore.Allocator, MaterialSSBO->Allocation, reinterpret_cast<VOID **>(&MapPointer)) != VK_SUCCESS)
-    {
-      throw;
-    }
-
-    material::BUF_MTL Buf;
+    MaterialSSBO.Resize(Stock.Size());
 
     INT count = 0;
 
     for (auto &i : Stock)
     {
-      i.second.Id = count++;
-      Buf.Ka = vec4(i.second.Ka, 0);
-      Buf.KdTrans = vec4(i.second.Kd, i.second.Trans);
-      Buf.KsPh = vec4(i.second.Ks, i.second.Ph);
-      
-      for (INT j = 0; j < 8; ++j)
-        Buf.TextureFlags[j] = i.second.Tex[j] == nullptr ? 0 : 1;
-
-      memcpy(MapPointer, &Buf, sizeof(material::BUF_MTL));
-      MapPointer += sizeof(material::BUF_MTL);
-    }
+      material::BUF_MTL Buf = i.GetBufData();
 
-    vmaUnmapMemory(RndRef.VulkanCore.Allocator, MaterialSSBO->Allocation);
-
-    RndRef.VulkanCore.UpdateDescriptor(MaterialSSBO, BufferBindMaterial, 1);
+      i.Id = count;
+      MaterialSSBO.Write(count++, &Buf);
+    }
   } /* End of 'MtlUpdateSSBO' function */
 } /* end of 'pivk' namespace */
 
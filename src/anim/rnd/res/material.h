@@ -5,7 +5,7 @@
 
 /* FILE:        material.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Resource material class header file.
  * NOTE:        None.
  * 
@@ -33,7 +33,7 @@ namespace pivk
       vec4 Ka;             // Ambient
       vec4 KdTrans;        // Diffuse + Transparency
       vec4 KsPh;           // Specular + Phong
-      INT TextureFlags[8]; // Material texture flags
+      INT TextureIds[8];   // Material textures slots in textures array (-1 if no texture)
     }; /* End of 'BUF_MTL' structure */
  
     // Material name
@@ -49,6 +49,11 @@ namespace pivk
     texture *Tex[8];
     // Id in SSBO buffer
     INT Id = -1;
+    // Pipeline state overrides (shader state is used if not set)
+    std::optional<VkCullModeFlags> CullMode; // Culled faces
+    std::optional<BOOL> IsBlend;             // Alpha blending flag
+    // Shader pipeline variant with overrides and shader pipeline it is made for
+    VkPipeline Pipeline {}, PipelineBase {};
  
     // Material data buffer
     //buffer *BufferMtl {};
@@ -112,7 +117,14 @@ namespace pivk
      */
     INT Apply( VOID );
 
-    /* Update buffers and textures function.
+    /* Get material storage buffer record function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BUF_MTL) material buffer data.
+     */
+    BUF_MTL GetBufData( VOID ) const;
+
+    /* Update material record in storage buffer and pipeline variant function.
      * ARGUMENTS: None.
      * RETURNS: None.
      */
@@ -127,7 +139,7 @@ namespace pivk
     BOOL IsNoAddedDefMtl = TRUE;    // Flag of adding default material
     material *DefMtl = nullptr;     // Pointer to default material
     BOOL UpdateMaterialSSBO = TRUE; // Update material SSBO flag.
-    vlk_buf *MaterialSSBO;          // Material storage buffer
+    vlk_frame_buf MaterialSSBO;     // Material storage buffer (copy per frame in flight)
 
     /* Material manager constructor.
      * ARGUMENTS:
@@ -179,15 +191,12 @@ namespace pivk
      */
     material * MtlAdd( const material &Mat )
     {
-      material *mtl = resource_manager::Find(Mat.Name);
+      if (material *mtl = resource_manager::Find(Mat.Name); mtl != nullptr)
+        return mtl;
 
-      if (mtl == nullptr)
-      {
-        UpdateMaterialSSBO = TRUE;
-        return resource_manager::Add(material().Create(Mat.Name, Mat.Ka, Mat.Kd, Mat.Ks, Mat.Ph, Mat.Trans, Mat.Shd, 
-                                     {Mat.Tex[0], Mat.Tex[1], Mat.Tex[2], Mat.Tex[3], Mat.Tex[4], Mat.Tex[5], Mat.Tex[6], Mat.Tex[7]}, &RndRef));
-      }
-      return resource_manager::Find(Mat.Name);
+      UpdateMaterialSSBO = TRUE;
+      return resource_manager::Add(material().Create(Mat.Name, Mat.Ka, Mat.Kd, Mat.Ks, Mat.Ph, Mat.Trans, Mat.Shd, 
+                                   {Mat.Tex[0], Mat.Tex[1], Mat.Tex[2], Mat.Tex[3], Mat.Tex[4], Mat.Tex[5], Mat.Tex[6], Mat.Tex[7]}, &RndRef));
     } /* End of 'MtlAdd' function */
 
     /* Get shader ProgID
@@ -210,20 +219,30 @@ namespace pivk
      */
     VOID MtlFree( material *Mtl )
     {
-      material *i = resource_manager::Find(Mtl->Name);
-
-      if (i != nullptr)
+      if (material *i = resource_manager::Find(Mtl->Name); i != nullptr)
         resource_manager::Delete(i);
     } /* End of 'MtlFree' function */
 
     /* Get material by name function.
      * ARGUMENTS:
      *   - name of material:
-     *       std::string Name;
+     *       std::string_view Name;
+     * RETURNS:
+     *   (material *) pointer to material.
+     */
+    material * MtlFind( std::string_view Name )
+    {
+      return resource_manager::Find(Name);
+    } /* End of 'MtlFind' function */
+
+    /* Get material by interned name function.
+     * ARGUMENTS:
+     *   - interned name of material:
+     *       atom Name;
      * RETURNS:
      *   (material *) pointer to material.
      */
-    material * MtlFind( std::string Name )
+    material * MtlFind( atom Name )
     {
       return resource_manager::Find(Name);
     } /* End of 'MtlFind' function */
@@ -5,7 +5,7 @@
 
 /* FILE:        model.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Model resource functions declaring file.
  * NOTE:        None.
  *
@@ -18,6 +18,25 @@
 /* Base project namespace */
 namespace pivk
 { 
+  /* Evaluate file content hash function.
+   * ARGUMENTS:
+   *   - file name:
+   *       const std::string &Filename;
+   * RETURNS:
+   *   (UINT64) hash value (0 if file cannot be read).
+   */
+  static UINT64 HashFile( const std::string &Filename )
+  {
+    std::fstream f(Filename, std::fstream::in | std::fstream::binary);
+
+    if (!f.is_open())
+      return 0;
+
+    std::vector<BYTE> mem((std::istreambuf_iterator<CHAR>(f)), std::istreambuf_iterator<CHAR>());
+
+    return HashBytes(mem.data(), mem.size());
+  } /* End of 'HashFile' function */
+
   /* Load g3dm model function
    * ARGUMENTS:
    *   - name of file with model:
@@ -49,6 +68,7 @@ namespace pivk
     BYTE *ptr = mem.data();
 
     f.read((CHAR *)mem.data(), flen);
+    FileHash = HashBytes(mem.data(), mem.size());
 
     rdr rd(ptr);
 
@@ -66,8 +86,13 @@ namespace pivk
     /* Load primitives */
     std::vector<INT> prims_mtl;
     prims_mtl.resize(NoofP);
+
+    // Loading model is used in current frame, so out of memory allocations below do not evict it
+    LastUse = Rnd->VulkanCore.FrameNo;
     Prims.resize(NoofP);
 
+    // All primitives geometry and textures are uploaded by one batch without waiting
+    Rnd->VulkanCore.UploadBegin();
     for (INT i = 0; i < NoofP; i++)
     {
       INT nv = 0, ni = 0;
@@ -87,12 +112,8 @@ namespace pivk
       rd(&V[0], nv);
       rd(&I[0], ni);
 
-      //for (INT j = 0; j < nv; j++)
-      //{
-      //  V[j].P = Transform.TransformPoint(V[j].P);
-      //  V[j].N = Transform.TransformNormal(V[j].N);
-      //}
       Prims[i] = Rnd->PrimCreate(topology::trimesh(V, I));
+      Bvh.AddMesh(std::span<const vertex::std>(V), &vertex::std::P, std::span<const INT>(I), i);
     }
 
 
@@ -167,11 +188,13 @@ namespace pivk
         Ptr = new BYTE[store_texs[i].W * store_texs[i].H * store_texs[i].C];
         rd(Ptr, store_texs[i].W * store_texs[i].H * store_texs[i].C);
 
-        texs[i] = Rnd->TextureCreateFromImg(store_texs[i].Name, store_texs[i].W, store_texs[i].H, store_texs[i].C, Ptr);
+        // Changed file reload replaces images of textures with the same names
+        texs[i] = Rnd->TextureUpdateFromImg(store_texs[i].Name, store_texs[i].W, store_texs[i].H, store_texs[i].C, Ptr);
 
         delete[] Ptr;
       }
     }
+    UploadTicket = Rnd->VulkanCore.UploadEnd();
 
     mtls.resize(NoofM);
 
@@ -190,9 +213,39 @@ namespace pivk
       for (INT t = 0; t < 8; t++)
         mtl.Tex[t] = store_mtls[i].Tex[t] == -1 ? nullptr : texs[store_mtls[i].Tex[t]];
 
-      mtls[i] = Rnd->MtlAdd(mtl);
+      // Loaded file values override material with the same name (file may be reloaded after change)
+      if (material *Found = Rnd->MtlFind(mtl.Name); Found != nullptr)
+      {
+        Found->Ka = mtl.Ka;
+        Found->Kd = mtl.Kd;
+        Found->Ks = mtl.Ks;
+        Found->Ph = mtl.Ph;
+        Found->Trans = mtl.Trans;
+        for (INT t = 0; t < 8; t++)
+          Found->Tex[t] = mtl.Tex[t];
+        mtls[i] = Found;
+      }
+      else
+        mtls[i] = Rnd->MtlAdd(mtl);
       mtls[i]->Shd = Rnd->ShdFind("Default");
+      mtls[i]->Update();
+    }
+
+#if _DEBUG
+    // Reloaded model refers to materials with just loaded values
+    for (INT i = 0; i < NoofM; i++)
+    {
+      const material *M = mtls[i];
+      const STORE_MATERIAL &S = store_mtls[i];
+
+      assert(M->Ka.X == S.Ka.X && M->Ka.Y == S.Ka.Y && M->Ka.Z == S.Ka.Z);
+      assert(M->Kd.X == S.Kd.X && M->Kd.Y == S.Kd.Y && M->Kd.Z == S.Kd.Z);
+      assert(M->Ks.X == S.Ks.X && M->Ks.Y == S.Ks.Y && M->Ks.Z == S.Ks.Z);
+      assert(M->Ph == S.Ph && M->Trans == S.Trans);
+      for (INT t = 0; t < 8; t++)
+        assert(M->Tex[t] == (S.Tex[t] == -1 ? nullptr : texs[S.Tex[t]]));
     }
+#endif // _DEBUG
 
     // Correct primitives material references
     if (NoofM > 0)
@@ -234,29 +287,251 @@ namespace pivk
    */
   VOID model::Draw( const matr &World )
   {
-    matr m = World;
-    //anim &Ani = anim::GetRef();
-    ///render Rnd;
+    LastUse = Rnd->VulkanCore.FrameNo;
+
+    // Evicted model is not loaded while frame is recorded, it is reloaded before next frame
+    if (IsEvicted)
+    {
+      Rnd->ModelQueueReload(this);
+      return;
+    }
+
+    frustum F(Rnd->Camera);
+    auto &[WorldMatrs, WorldBounds, Visible] = Rnd->DrawScratch;
+
+    /* Cull primitives by world bound boxes */
+    WorldMatrs.resize(Prims.size());
+    WorldBounds.resize(Prims.size());
+    Visible.resize(Prims.size());
+    for (size_t i = 0; i < Prims.size(); i++)
+    {
+      WorldMatrs[i] = Prims[i]->Transform * World;
+      WorldBounds[i] = aabb(Prims[i]->Min, Prims[i]->Max).Transform(WorldMatrs[i]);
+    }
+    size_t NumOfVisible = mth::Cull(F, std::span<const aabb>(WorldBounds), std::span<BYTE>(Visible));
+
+    // Primitives without bound box (zero extent) are never culled
+    for (size_t i = 0; i < Prims.size(); i++)
+      if (!Visible[i] &&
+          Prims[i]->Min.X == 0 && Prims[i]->Min.Y == 0 && Prims[i]->Min.Z == 0 &&
+          Prims[i]->Max.X == 0 && Prims[i]->Max.Y == 0 && Prims[i]->Max.Z == 0)
+        Visible[i] = 1, NumOfVisible++;
+    if (NumOfVisible == 0)
+      return;
 
     /* Draw all nontransparent primitives */
-    for (auto &i : Prims)
-      if (i->Mtl->Trans == 1)
-        Rnd->Draw(i, i->Transform * m);
+    for (size_t i = 0; i < Prims.size(); i++)
+      if (Visible[i] && Prims[i]->Mtl->Trans == 1)
+        Rnd->Draw(Prims[i], WorldMatrs[i]);
 
     /* Draw all transparent primitives */
     
     /* Draw all front-face-culling */
-    for (auto &i : Prims)
-      if (i->Mtl->Trans != 1)
-        Rnd->Draw(i, i->Transform * m);
+    for (size_t i = 0; i < Prims.size(); i++)
+      if (Visible[i] && Prims[i]->Mtl->Trans != 1)
+        Rnd->Draw(Prims[i], WorldMatrs[i]);
     
     /* Draw all back-face-culling */
-    for (auto &i : Prims)
-      if (i->Mtl->Trans != 1)
-        Rnd->Draw(i, i->Transform * m);
+    for (size_t i = 0; i < Prims.size(); i++)
+      if (Visible[i] && Prims[i]->Mtl->Trans != 1)
+        Rnd->Draw(Prims[i], WorldMatrs[i]);
     
     /* Pop changes */
   } /* End of 'model::Draw' function */
+
+  /* Free model function (primitives are deleted from render).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID model::Free( VOID )
+  {
+    if (Rnd != nullptr)
+      for (auto &i : Prims)
+        if (i != nullptr)
+          Rnd->PrimFree(i);
+    Prims.clear();
+    Bvh.Clear();
+    FileHash = 0;
+  } /* End of 'model::Free' function */
+
+  /* Evict model primitives from device memory function (model is reloaded on next draw).
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (UINT64) number of freed bytes.
+   */
+  UINT64 model::Evict( VOID )
+  {
+    UINT64 Size = 0;
+
+    for (auto &Pr : Prims)
+    {
+      // Not created yet primitives of loading model
+      if (Pr == nullptr)
+        continue;
+      if (Pr->VBuf != nullptr)
+        Size += Rnd->VulkanCore.MemSize(Pr->VBuf->Allocation);
+      if (Pr->IBuf != nullptr)
+        Size += Rnd->VulkanCore.MemSize(Pr->IBuf->Allocation);
+    }
+    Free();
+    IsEvicted = TRUE;
+    return Size;
+  } /* End of 'model::Evict' function */
+
+  /* Model ray intersection function.
+   * ARGUMENTS:
+   *   - world space ray:
+   *       const ray &R;
+   *   - model world matrix (affine):
+   *       const matr &World;
+   *   - nearest hit (only closer than H.T hits are searched, H.PrimId is primitive index in 'Prims'):
+   *       hit &H;
+   * RETURNS:
+   *   (BOOL) TRUE if hit was updated.
+   */
+  BOOL model::Intersect( const ray &R, const matr &World, hit &H ) const
+  {
+    matr InvW = World.InverseAffine();
+    ray LR;
+
+    // Hierarchy is built only for models which are really queried
+    if (Bvh.Nodes.empty())
+      Bvh.Build();
+
+    // Direction is not normalized to keep hit distance in world units
+    LR.Org = InvW.TransformPoint(R.Org);
+    LR.Dir = InvW.TransformVector(R.Dir);
+    return Bvh.Intersect(LR, H);
+  } /* End of 'model::Intersect' function */
+
+  /* Get model cache key (normalized file path) function.
+   * ARGUMENTS:
+   *   - file name:
+   *       std::string_view Filename;
+   * RETURNS:
+   *   (std::string) normalized path.
+   */
+  std::string model_manager::ModelPath( std::string_view Filename )
+  {
+    std::error_code Err;
+    std::filesystem::path Path = std::filesystem::weakly_canonical(std::filesystem::path(Filename), Err);
+
+    if (Err)
+      Path = std::filesystem::path(Filename).lexically_normal();
+    return Path.generic_string();
+  } /* End of 'model_manager::ModelPath' function */
+
+  /* Load model from g3dm file function.
+   * ARGUMENTS:
+   *   - filename:
+   *       const std::string &Filename;
+   * RETURNS:
+   *   (model *) loaded model.
+   */
+  model * model_manager::ModelLoadG3DM( const std::string &Filename )
+  {
+    std::string Path = ModelPath(Filename);
+    atom Key = atom::Intern(Path);
+    std::error_code Err;
+    UINT64 Size = 0;
+    INT64 Time = 0;
+
+    if (UINT64 S = std::filesystem::file_size(Path, Err); !Err)
+      Size = S;
+    if (auto T = std::filesystem::last_write_time(Path, Err); !Err)
+      Time = T.time_since_epoch().count();
+
+    if (model *M = resource_manager::Find(Key); M != nullptr)
+    {
+      cache_entry &E = Cache[Key.Id];
+
+      if (E.Size != Size || E.Time != Time)
+      {
+        // Only touched file (same content) is still shared as is
+        if (E.Size != Size || HashFile(Path) != E.Hash)
+        {
+          M->Free();
+          M->LoadG3DM(Path, &RndRef);
+          E.Hash = M->FileHash;
+        }
+        E.Size = Size;
+        E.Time = Time;
+      }
+      E.RefCnt++;
+      return M;
+    }
+
+    model *M = resource_manager::Add(model().LoadG3DM(Path, &RndRef));
+
+    Cache[Key.Id] = {Size, Time, M->FileHash, 1};
+    return M;
+  } /* End of 'model_manager::ModelLoadG3DM' function */
+
+  /* Release model function (model is freed when last reference is released).
+   * ARGUMENTS:
+   *   - pointer to model:
+   *       model *Model;
+   * RETURNS: None.
+   */
+  VOID model_manager::ModelFree( model *Model )
+  {
+    if (Model == nullptr)
+      return;
+
+    atom Key = atom::Lookup(Model->Name);
+
+    if (auto E = Cache.find(Key.Id); E != Cache.end() && resource_manager::Find(Key) == Model)
+    {
+      if (--E->second.RefCnt > 0)
+        return;
+      Cache.erase(E);
+    }
+    resource_manager::Delete(Model);
+  } /* End of 'model_manager::ModelFree' function */
+
+  /* Queue evicted model reload function (model is reloaded by 'ModelReload' before next frame).
+   * ARGUMENTS:
+   *   - pointer to model:
+   *       model *Model;
+   * RETURNS: None.
+   */
+  VOID model_manager::ModelQueueReload( model *Model )
+  {
+    if (Model->IsReloadQueued)
+      return;
+    Model->IsReloadQueued = TRUE;
+    ReloadQueue.push_back(atom::Lookup(Model->Name));
+  } /* End of 'model_manager::ModelQueueReload' function */
+
+  /* Reload queued evicted models function (called between frames).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID model_manager::ModelReload( VOID )
+  {
+    // Models released after queueing are not found
+    for (atom Key : ReloadQueue)
+    {
+      model *M = resource_manager::Find(Key);
+
+      if (M == nullptr)
+        continue;
+      M->IsReloadQueued = FALSE;
+      if (!M->IsEvicted)
+        continue;
+      M->LoadG3DM(M->Name);
+      M->IsEvicted = FALSE;
+      for (auto &Pr : M->Prims)
+        if (Pr->VBuf != nullptr && Pr->VBuf->Buffer == nullptr)
+        {
+          // Out of device memory - keep model evicted (queued again by next draw)
+          M->Free();
+          M->IsEvicted = TRUE;
+          break;
+        }
+    }
+    ReloadQueue.clear();
+  } /* End of 'model_manager::ModelReload' function */
 } /* End of 'pivk' namespace */
 
 /* END OF 'model.cpp' FILE */
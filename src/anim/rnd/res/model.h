@@ -5,9 +5,12 @@
 
 /* FILE:        model.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Model resource class header file.
- * NOTE:        None.
+ * NOTE:        Models loaded through manager are shared between all
+ *              users of the same file, so per-instance state (world
+ *              matrices) should be passed to 'Draw', not stored in model
+ *              primitives.
  *
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -65,6 +68,12 @@ namespace pivk
     std::string Name;          // String
     vec3 
       Min, Max;                // Bound box
+    mutable bvh Bvh;               // Primitives triangles hierarchy (model space, built on first ray query)
+    UINT64 FileHash = 0;           // Loaded file content hash (FNV-1a, 0 if not loaded)
+    UINT64 UploadTicket = 0;       // Geometry and textures upload ticket (see 'vlk_upload_manager')
+    UINT64 LastUse = 0;            // Number of last frame model was drawn in
+    BOOL IsEvicted = FALSE;        // Primitives are evicted from device memory flag
+    BOOL IsReloadQueued = FALSE;   // Evicted model is queued for reload flag
     //rdr rd;                    // Reader
 
     /* Default constructor */
@@ -96,22 +105,62 @@ namespace pivk
      */
     VOID Draw( const matr &World = matr::Identity() );
 
-    /* Free model function.
+    /* Model ray intersection function.
+     * ARGUMENTS:
+     *   - world space ray:
+     *       const ray &R;
+     *   - model world matrix (affine):
+     *       const matr &World;
+     *   - nearest hit (only closer than H.T hits are searched, H.PrimId is primitive index in 'Prims'):
+     *       hit &H;
+     * RETURNS:
+     *   (BOOL) TRUE if hit was updated.
+     */
+    BOOL Intersect( const ray &R, const matr &World, hit &H ) const;
+
+    /* Free model function (primitives are deleted from render).
      * ARGUMENTS: None.
      * RETURNS: None.
      */
-    VOID Free( VOID )
-    {
-      for (auto &i : Prims)
-        i->Free();
-    } /* End of 'Free' function */
+    VOID Free( VOID );
+
+    /* Evict model primitives from device memory function (model is reloaded on next draw).
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) number of freed bytes.
+     */
+    UINT64 Evict( VOID );
 
   }; /* End of 'model' class */
 
   /* Model manager class */
   class model_manager : public resource_manager<model, std::string>
   {
+  private:
+    /* Cached model file identity structure */
+    struct cache_entry
+    {
+      UINT64 Size = 0;  // File size
+      INT64 Time = 0;   // File last write time
+      UINT64 Hash = 0;  // File content hash
+      INT RefCnt = 0;   // Number of model users
+    }; /* End of 'cache_entry' structure */
+
+    // Loaded models cache: normalized path atom identifier -> file identity
+    std::unordered_map<UINT32, cache_entry> Cache;
+
+    // Evicted models to reload before next frame (normalized path atoms)
+    std::vector<atom> ReloadQueue;
+
   public:
+    /* Model draw scratch arrays structure (reused by draws of all models) */
+    struct draw_scratch
+    {
+      std::vector<matr> WorldMatrs;  // Primitives world matrices
+      std::vector<aabb> WorldBounds; // Primitives world bound boxes
+      std::vector<BYTE> Visible;     // Primitives visibility flags
+    } DrawScratch;
+
     /* Model manager constructor.
      * ARGUMENTS:
      *   - ref to render:
@@ -122,28 +171,70 @@ namespace pivk
     } /* End of 'model_manager' function */
 
     /* Load model from g3dm file function.
+     * Already loaded unchanged file is shared (reference counter is
+     * increased), changed on disk file is reloaded in place.
      * ARGUMENTS:
      *   - filename:
      *       const std::string &Filename;
      * RETURNS:
-     *   (model *) new model.
+     *   (model *) loaded model.
+     */
+    model * ModelLoadG3DM( const std::string &Filename );
+
+    /* Get model cache key (normalized file path) function.
+     * ARGUMENTS:
+     *   - file name:
+     *       std::string_view Filename;
+     * RETURNS:
+     *   (std::string) normalized path.
      */
-    model * ModelLoadG3DM( const std::string &Filename )
+    static std::string ModelPath( std::string_view Filename );
+
+    /* Find model by file name function.
+     * ARGUMENTS:
+     *   - file name:
+     *       std::string_view Filename;
+     * RETURNS:
+     *   (model *) found model or nullptr.
+     */
+    model * ModelFind( std::string_view Filename )
+    {
+      return resource_manager::Find(ModelPath(Filename));
+    } /* End of 'ModelFind' function */
+
+    /* Find model by interned file name function.
+     * ARGUMENTS:
+     *   - interned file name (normalized by 'ModelPath'):
+     *       atom Filename;
+     * RETURNS:
+     *   (model *) found model or nullptr.
+     */
+    model * ModelFind( atom Filename )
     {
-      return resource_manager::Add(model().LoadG3DM(Filename, &RndRef));
-    } /* End of 'ModelLoadG3DM' function */
+      return resource_manager::Find(Filename);
+    } /* End of 'ModelFind' function */
 
-    /* Delete model function.
+    /* Release model function (model is freed when last reference is released).
      * ARGUMENTS:
      *   - pointer to model:
      *       model *Model;
      * RETURNS: None.
      */
-    VOID ModelFree( model *Model )
-    {
-      Model->Free();
-      resource_manager::Delete(Model);
-    } /* End of 'ModelFree' function */
+    VOID ModelFree( model *Model );
+
+    /* Queue evicted model reload function (model is reloaded by 'ModelReload' before next frame).
+     * ARGUMENTS:
+     *   - pointer to model:
+     *       model *Model;
+     * RETURNS: None.
+     */
+    VOID ModelQueueReload( model *Model );
+
+    /* Reload queued evicted models function (called between frames).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID ModelReload( VOID );
 
   }; /* End of 'model_manager' class */
 } /* end of 'pivk' namespace */
@@ -91,24 +91,49 @@ namespace pivk
   private:
     /* Create pipeline pattern function.
      * ARGUMENTS:
-     *   - name of pipeline pattern:
-     *       std::string &Name;
-     * RETURNS: None.
+     *   - interned name of pipeline pattern:
+     *       atom Name;
+     * RETURNS:
+     *   (pipeline_pattern *) created pipeline pattern.
      */
-    pipeline_pattern * PipelinePatternAdd( const std::string &Name )
+    pipeline_pattern * PipelinePatternAdd( atom Name )
     {
-      return &(Stock[Name] = pipeline_pattern());
+      handle H = Stock.Emplace(pipeline_pattern());
+      entry_ref *Ref = Stock.Get(H);
+
+      Ref->EntryRef = H;
+      Ref->NameAtom = Name;
+      Names.emplace(Name.Id, H);
+      return Ref;
     } /* End of 'pipeline_pattern' function */
 
   public:
-    /* Find pipeline pattern */
-    pipeline_pattern * PipelinePatternFind( const std::string &Name )
+    /* Find pipeline pattern (create if not exists) function.
+     * ARGUMENTS:
+     *   - interned name of pipeline pattern:
+     *       atom Name;
+     * RETURNS:
+     *   (pipeline_pattern *) found pipeline pattern.
+     */
+    pipeline_pattern * PipelinePatternFind( atom Name )
     {
-      auto i = Stock.find(Name);
+      pipeline_pattern *Pattern = Find(Name);
 
-      if (i == Stock.end())
+      if (Pattern == nullptr)
         return PipelinePatternAdd(Name);
-      return &Stock[Name];
+      return Pattern;
+    } /* End of 'PipelinePatternFind' function */
+
+    /* Find pipeline pattern (create if not exists) function.
+     * ARGUMENTS:
+     *   - name of pipeline pattern:
+     *       std::string_view Name;
+     * RETURNS:
+     *   (pipeline_pattern *) found pipeline pattern.
+     */
+    pipeline_pattern * PipelinePatternFind( std::string_view Name )
+    {
+      return PipelinePatternFind(atom::Intern(Name));
     } /* End of 'PipelinePatternFind' function */
   }; /* End of 'pipeline_pattern_manager' class */
 
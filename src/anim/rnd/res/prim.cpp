@@ -10,7 +10,8 @@ namespace pivk
    */
   VOID primitive_manager::PrimInit( VOID )
   {
-    PrimitiveSSBO = RndRef.VulkanCore.BufCreate(0, 0, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    // Buffer is created (and bound to set 0) before first primitive, so set 0 is always complete
+    PrimitiveSSBO.Create(&RndRef.VulkanCore, BufferBindPrim, sizeof(prim::PRIM_BUF), 256);
   } /* End of 'primtiive_manager::PrimInit' function */
 
   /* Primitive update storage buffer function.
@@ -23,29 +24,33 @@ namespace pivk
       return;
 
     UpdatePrimitiveSSBO = FALSE;
-    PrimitiveSSBO->Resize(resource_manager::TotalRefCnt * sizeof(material::BUF_MTL), resource_manager::TotalRefCnt);
+    PrimitiveSSBO.Resize(Stock.Size());
 
-    BYTE *MapPointer;
-
-    if (vmaMapMemory(RndRef.VulkanCore.Allocator, PrimitiveSSBO->Allocation, reinterpret_cast<VOID **>(&MapPointer)) != VK_SUCCESS)
-    {
-      throw;
-    }
-
-    material::BUF_MTL Buf;
     INT count = 0;
 
     for (auto &i : Stock)
     {
-      i.second.Id = count++;
-      memcpy(MapPointer, &i.second.PrimitiveData, sizeof(prim::PRIM_BUF));
-      MapPointer += sizeof(prim::PRIM_BUF);
+      i.Id = count;
+      PrimitiveSSBO.Write(count++, &i.PrimitiveData);
     }
+  } /* End of 'primitive_manager::PrimUpdateSSBO' function */
 
-    vmaUnmapMemory(RndRef.VulkanCore.Allocator, PrimitiveSSBO->Allocation);
+  /* Update primitive buffer function.
+   * ARGUMENTS:
+   *   - pointer to primitive:
+   *       prim *Pr;
+   * RETURNS: None.
+   */
+  VOID primitive_manager::PrimUpdateBuffer( prim *Pr )
+  {
+    Pr->PrimUpdateBuffer();
 
-    RndRef.VulkanCore.UpdateDescriptor(PrimitiveSSBO, BufferBindPrim, 1);
-  } /* End of 'primitive_manager::PrimUpdateSSBO' function */
+    // Primitive has record in buffer - only it is written
+    if (!UpdatePrimitiveSSBO && Pr->Id >= 0 && Pr->Id * sizeof(prim::PRIM_BUF) < PrimitiveSSBO.Data.size())
+      PrimitiveSSBO.Write(Pr->Id, &Pr->PrimitiveData);
+    else
+      UpdatePrimitiveSSBO = TRUE;
+  } /* End of 'primitive_manager::PrimUpdateBuffer' function */
 
   /* Update primitive buffer function.
    * ARGUMENTS: None.
@@ -5,7 +5,7 @@
 
 /* FILE:        prim.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Resource primitive class header file.
  * NOTE:        None.
  * 
@@ -119,9 +119,7 @@ namespace pivk
           // Collect min-max info
           if constexpr (requires{vertex::P;})
           {
-            Min = Max = T.V[0].P;
-            for (auto vrt : T.V)
-              Min = vrt.P.Min(Min), Max = vrt.P.Max(Max);
+            mth::ComputeBounds(std::span<const vertex>(T.V), &vertex::P, Min, Max);
           }
 
           INT count = 0;
@@ -153,7 +151,8 @@ namespace pivk
           //{
           //}
 
-          VBuf = GetVlk(Rnd)->BufCreate(T.V.size() * sizeof(vertex), 1, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+          // Geometry is static - it is placed to device local memory
+          VBuf = GetVlk(Rnd)->BufCreate(T.V.size() * sizeof(vertex), 1, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, TRUE);
           VBuf->Write(T.V.data());
           //VBuf.Create(T.V.size(), VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
           //VBuf.Write(T.V);
@@ -164,7 +163,7 @@ namespace pivk
         {
           if (T.V.size() != 0)
           {
-            IBuf = GetVlk(Rnd)->BufCreate(T.I.size() * sizeof(INT), 1, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
+            IBuf = GetVlk(Rnd)->BufCreate(T.I.size() * sizeof(INT), 1, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, TRUE);
             IBuf->Write(T.I.data());
             //IBuf.Create(T.I.size(), VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
             //IBuf.Write(T.V.size())
@@ -217,7 +216,7 @@ namespace pivk
   {
   public:
     BOOL UpdatePrimitiveSSBO = TRUE;  // Update primitive SSBO flag.
-    vlk_buf *PrimitiveSSBO = nullptr; // Material storage buffer
+    vlk_frame_buf PrimitiveSSBO;      // Primitive storage buffer (copy per frame in flight)
 
     /* Primitive manager constructor.
      * ARGUMENTS:
@@ -273,11 +272,7 @@ namespace pivk
      *       prim *Pr;
      * RETURNS: None.
      */
-    VOID PrimUpdateBuffer( prim *Pr )
-    {
-      Pr->PrimUpdateBuffer();
-      UpdatePrimitiveSSBO = TRUE;
-    } /* End of 'PrimUpdateBuffer' function */
+    VOID PrimUpdateBuffer( prim *Pr );
 
   }; /* End of 'primitive_manager' class */
 
@@ -5,9 +5,11 @@
 
 /* FILE:        res.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Resource storage base class header file.
- * NOTE:        None.
+ * NOTE:        Entries are stored in generational slot map and
+ *              addressed by 32-bit handles, named entries are also
+ *              found by interned name ('atom.h').
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -16,7 +18,10 @@
 #ifndef __res_h_
 #define __res_h_
 
+#include <memory>
+
 #include "../vulkan/vlk_core.h"
+#include "atom.h"
 
 /* Base project namespace */
 namespace pivk
@@ -29,6 +34,289 @@ namespace pivk
     render *Rnd {}; // Pointer to render
   }; /* End of 'resource' class */
 
+  /* Resource handle structure.
+   * Packed slot index (low 20 bits) and slot generation (high 12 bits).
+   * Handle of deleted entry never matches reused slot until generation wraps.
+   */
+  struct handle
+  {
+    static constexpr UINT32
+      IndexBits = 20,                     // Number of slot index bits
+      IndexMask = (1u << IndexBits) - 1,  // Slot index mask
+      GenMask = (1u << (32 - IndexBits)) - 1; // Generation mask
+
+    UINT32 Value {}; // Packed handle value (0 - invalid handle)
+
+    /* Get slot index function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT32) slot index.
+     */
+    constexpr UINT32 Index( VOID ) const noexcept
+    {
+      return Value & IndexMask;
+    } /* End of 'Index' function */
+
+    /* Get slot generation function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT32) slot generation.
+     */
+    constexpr UINT32 Gen( VOID ) const noexcept
+    {
+      return Value >> IndexBits;
+    } /* End of 'Gen' function */
+
+    /* Check handle validity operator.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (bool) true if handle may refer to entry.
+     */
+    constexpr explicit operator bool( VOID ) const noexcept
+    {
+      return Value != 0;
+    } /* End of 'operator bool' function */
+
+    /* Compare handles operator.
+     * ARGUMENTS:
+     *   - handle to compare with:
+     *       const handle &H;
+     * RETURNS:
+     *   (BOOL) TRUE if handles are equal.
+     */
+    constexpr BOOL operator==( const handle &H ) const noexcept
+    {
+      return Value == H.Value;
+    } /* End of 'operator==' function */
+  }; /* End of 'handle' structure */
+
+  /* Generational slot map class.
+   * Entries live in fixed size pages which are never relocated, so entry
+   * pointers stay valid until entry is erased (managers hand them out).
+   * Live entries are enumerated through dense array of slot indices,
+   * erasing swaps last dense index into freed place - O(1) add, find
+   * and erase, iteration touches live entries only.
+   */
+  template<typename Type>
+    class slot_map
+    {
+    private:
+      static constexpr UINT32 PageSize = 256; // Number of slots in page
+
+      /* Slot structure */
+      struct slot
+      {
+        std::optional<Type> Entry; // Stored entry (empty if slot is free)
+        UINT32
+          Gen = 1,                 // Current slot generation
+          DenseIndex = 0;          // Index in dense array (next free slot if free)
+      }; /* End of 'slot' structure */
+
+      std::vector<std::unique_ptr<slot[]>> Pages; // Slot pages
+      std::vector<UINT32> Dense;                  // Live slots indices
+      UINT32
+        SlotsCount = 0,                           // Number of used slots
+        FreeHead = ~0u;                           // First free slot index (~0 - none)
+
+      /* Get slot by index function.
+       * ARGUMENTS:
+       *   - slot index:
+       *       UINT32 Index;
+       * RETURNS:
+       *   (slot &) slot reference.
+       */
+      slot & Slot( UINT32 Index ) const
+      {
+        return Pages[Index / PageSize][Index % PageSize];
+      } /* End of 'Slot' function */
+
+    public:
+      /* Live entries iterator class */
+      class iterator
+      {
+      private:
+        const slot_map *Map;         // Iterated map
+        const UINT32 *Cur;           // Current dense array element
+
+      public:
+        /* Iterator constructor.
+         * ARGUMENTS:
+         *   - iterated map:
+         *       const slot_map *NewMap;
+         *   - dense array element:
+         *       const UINT32 *NewCur;
+         */
+        iterator( const slot_map *NewMap, const UINT32 *NewCur ) : Map(NewMap), Cur(NewCur)
+        {
+        } /* End of 'iterator' function */
+
+        /* Get entry operator.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (Type &) entry reference.
+         */
+        Type & operator*( VOID ) const
+        {
+          return *Map->Slot(*Cur).Entry;
+        } /* End of 'operator*' function */
+
+        /* Get entry pointer operator.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (Type *) entry pointer.
+         */
+        Type * operator->( VOID ) const
+        {
+          return &*Map->Slot(*Cur).Entry;
+        } /* End of 'operator->' function */
+
+        /* Go to next entry operator.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (iterator &) self reference.
+         */
+        iterator & operator++( VOID )
+        {
+          Cur++;
+          return *this;
+        } /* End of 'operator++' function */
+
+        /* Compare iterators operator.
+         * ARGUMENTS:
+         *   - iterator to compare with:
+         *       const iterator &It;
+         * RETURNS:
+         *   (BOOL) TRUE if iterators are different.
+         */
+        BOOL operator!=( const iterator &It ) const
+        {
+          return Cur != It.Cur;
+        } /* End of 'operator!=' function */
+      }; /* End of 'iterator' class */
+
+      /* Get first live entry iterator function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (iterator) iterator.
+       */
+      iterator begin( VOID ) const
+      {
+        return iterator(this, Dense.data());
+      } /* End of 'begin' function */
+
+      /* Get past last live entry iterator function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (iterator) iterator.
+       */
+      iterator end( VOID ) const
+      {
+        return iterator(this, Dense.data() + Dense.size());
+      } /* End of 'end' function */
+
+      /* Get number of live entries function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (size_t) number of entries.
+       */
+      size_t Size( VOID ) const
+      {
+        return Dense.size();
+      } /* End of 'Size' function */
+
+      /* Create entry in free slot function.
+       * ARGUMENTS:
+       *   - entry constructor arguments:
+       *       ArgsType &&...Args;
+       * RETURNS:
+       *   (handle) new entry handle.
+       */
+      template<typename ...ArgsType>
+        handle Emplace( ArgsType &&...Args )
+        {
+          UINT32 Index;
+
+          if (FreeHead != ~0u)
+            Index = FreeHead, FreeHead = Slot(Index).DenseIndex;
+          else
+          {
+            assert(SlotsCount <= handle::IndexMask);
+            if (SlotsCount % PageSize == 0)
+              Pages.push_back(std::make_unique<slot[]>(PageSize));
+            Index = SlotsCount++;
+          }
+
+          slot &S = Slot(Index);
+
+          S.DenseIndex = static_cast<UINT32>(Dense.size());
+          Dense.push_back(Index);
+          S.Entry.emplace(std::forward<ArgsType>(Args)...);
+          return handle {Index | (S.Gen << handle::IndexBits)};
+        } /* End of 'Emplace' function */
+
+      /* Get entry by handle function.
+       * ARGUMENTS:
+       *   - entry handle:
+       *       handle H;
+       * RETURNS:
+       *   (Type *) entry pointer or nullptr if handle is stale.
+       */
+      Type * Get( handle H ) const
+      {
+        if (H.Index() >= SlotsCount)
+          return nullptr;
+
+        slot &S = Slot(H.Index());
+
+        if (S.Gen != H.Gen() || !S.Entry)
+          return nullptr;
+        return &*S.Entry;
+      } /* End of 'Get' function */
+
+      /* Erase entry by handle function.
+       * ARGUMENTS:
+       *   - entry handle:
+       *       handle H;
+       * RETURNS:
+       *   (BOOL) TRUE if entry was erased.
+       */
+      BOOL Erase( handle H )
+      {
+        if (Get(H) == nullptr)
+          return FALSE;
+
+        UINT32 Index = H.Index();
+        slot &S = Slot(Index);
+
+        // Move last dense index to freed place
+        Slot(Dense.back()).DenseIndex = S.DenseIndex;
+        Dense[S.DenseIndex] = Dense.back();
+        Dense.pop_back();
+
+        S.Entry.reset();
+        S.Gen = (S.Gen + 1) & handle::GenMask;
+        if (S.Gen == 0)
+          S.Gen = 1;
+        S.DenseIndex = FreeHead;
+        FreeHead = Index;
+        return TRUE;
+      } /* End of 'Erase' function */
+
+      /* Erase all entries function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Clear( VOID )
+      {
+        while (!Dense.empty())
+        {
+          UINT32 Index = Dense.back();
+
+          Erase(handle {Index | (Slot(Index).Gen << handle::IndexBits)});
+        }
+      } /* End of 'Clear' function */
+    }; /* End of 'slot_map' class */
+
   /* Resource manager class */
   template<typename entry_type, typename index_type = INT>
     class resource_manager
@@ -38,23 +326,18 @@ namespace pivk
       /* Entry reference structure */
       struct entry_ref : public entry_type
       {
-        /* Entry reference index value */
-        index_type EntryRef;
+        /* Entry handle in stock */
+        handle EntryRef;
 
-        /* Class constructor */
-        entry_ref( void ) : EntryRef {}
-        {
-        } /* End of 'entry_ref' function */
+        /* Entry interned name (named entries only) */
+        atom NameAtom;
 
         /* Class constructor.
          * ARGUMENTS:
          *   - entry reference to be attached:
          *       const entry_ref &Entry;
-         *   - entry reference index value:
-         *       const index_type &RefVal;
          */
-        entry_ref( const entry_type &Entry, const index_type &RefVal = {} ) :
-          entry_type(Entry), EntryRef(RefVal)
+        entry_ref( const entry_type &Entry ) : entry_type(Entry)
         {
         } /* End of 'entry_ref' function */
       }; /* End of 'entry_ref' structure */
@@ -63,6 +346,9 @@ namespace pivk
       static_assert(std::is_convertible_v<entry_type, resource>,
                     "resource store class should be derived from 'resource'");
 
+      // Entries are keyed by name unless index type is integer one
+      static constexpr bool IsNamed = !std::is_convertible_v<index_type, INT>;
+
       render &RndRef; // Reference to render
 
       /* resource manager constructor
@@ -75,10 +361,10 @@ namespace pivk
       } /* End of 'resouse_manager' function */
 
       /* Resource entries stock */
-      std::map<index_type, entry_ref> Stock;
+      slot_map<entry_ref> Stock;
 
-      /* Manager reference counter */
-      INT TotalRefCnt = 0;
+      /* Entries names table: atom identifier -> handle (used for named entries only) */
+      std::unordered_map<UINT32, handle> Names;
 
       /* Add to stock function.
        * ARGUMENTS:
@@ -89,17 +375,31 @@ namespace pivk
        */
       entry_type * Add( const entry_type &Entry )
       {
-        if constexpr (std::is_convertible_v<index_type, INT>)
-        {
-          entry_ref ref(Entry, TotalRefCnt);
-          return &(Stock[TotalRefCnt++] = ref);
-        }
-        else
+        atom Name;
+
+        if constexpr (IsNamed)
         {
-          entry_ref ref(Entry, Entry.Name);
-          TotalRefCnt++;
-          return &(Stock[Entry.Name] = ref);
+          Name = atom::Intern(Entry.Name);
+          // Unnamed entries are never replaced and never found by name
+          if (auto Found = Name ? Names.find(Name.Id) : Names.end(); Found != Names.end())
+          {
+            // Replace entry with the same name in place
+            entry_ref *Ref = Stock.Get(Found->second);
+
+            static_cast<entry_type &>(*Ref) = Entry;
+            return Ref;
+          }
         }
+
+        handle H = Stock.Emplace(Entry);
+        entry_ref *Ref = Stock.Get(H);
+
+        Ref->EntryRef = H;
+        Ref->NameAtom = Name;
+        if constexpr (IsNamed)
+          if (Name)
+            Names.emplace(Name.Id, H);
+        return Ref;
       } /* End of 'Add' function */
 
       /* Clear manager stock function.
@@ -110,8 +410,9 @@ namespace pivk
       resource_manager & Clear( VOID )
       {
         for (auto &entry : Stock)
-          entry.second.Free();
-        Stock.clear();
+          entry.Free();
+        Stock.Clear();
+        Names.clear();
         return *this;
       } /* End of 'Clear' function */
 
@@ -119,17 +420,60 @@ namespace pivk
       /* Find resource at stock function.
        * ARGUMENTS:
        *   - resource name to find:
-       *       const std::string &Name;
+       *       std::string_view Name;
        * RETURNS:
        *   (type *) reference to found elememt.
        */
-      entry_type * Find( const index_type &Name )
+      entry_type * Find( std::string_view Name ) requires IsNamed
       {
-        if (Stock.find(Name) == Stock.end())
+        return Find(atom::Lookup(Name));
+      } /* End of 'Find' function */
+
+      /* Find resource by interned name function.
+       * ARGUMENTS:
+       *   - resource name atom:
+       *       atom Name;
+       * RETURNS:
+       *   (type *) found element or nullptr.
+       */
+      entry_type * Find( atom Name ) requires IsNamed
+      {
+        if (!Name)
+          return nullptr;
+
+        auto Found = Names.find(Name.Id);
+
+        if (Found == Names.end())
           return nullptr;
-        return &Stock[Name];
+        return Stock.Get(Found->second);
+      } /* End of 'Find' function */
+
+      /* Find resource by handle function.
+       * ARGUMENTS:
+       *   - resource handle:
+       *       handle H;
+       * RETURNS:
+       *   (type *) found element or nullptr if handle is stale.
+       */
+      entry_type * Find( handle H )
+      {
+        return Stock.Get(H);
       } /* End of 'Find' function */
 
+      /* Get resource handle function.
+       * ARGUMENTS:
+       *   - entry interface pointer:
+       *       const entry_type *Entry;
+       * RETURNS:
+       *   (handle) entry handle.
+       */
+      static handle GetHandle( const entry_type *Entry )
+      {
+        if (Entry == nullptr)
+          return handle {};
+        return static_cast<const entry_ref *>(Entry)->EntryRef;
+      } /* End of 'GetHandle' function */
+
       /* Entry delete function.
        * ARGUMENTS:
        *   - entry interface pointer:
@@ -144,11 +488,13 @@ namespace pivk
 
         Entry->Free();
 
-        auto find_entry =
-          Stock.find(reinterpret_cast<entry_ref *>(Entry)->EntryRef);
+        const entry_ref *Ref = static_cast<const entry_ref *>(Entry);
+        handle H = Ref->EntryRef;
 
-        if (find_entry != Stock.end())
-          Stock.erase(find_entry);
+        if constexpr (IsNamed)
+          if (auto Found = Names.find(Ref->NameAtom.Id); Found != Names.end() && Found->second == H)
+            Names.erase(Found);
+        Stock.Erase(H);
 
         return *this;
       } /* End of 'Delete' function */
@@ -5,7 +5,7 @@
 
 /* FILE:        shader.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 27.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Shader class file.
  * NOTE:        None.
  *
@@ -167,110 +167,43 @@ namespace pivk
         if (s.Module != VK_NULL_HANDLE)
           vkDestroyShaderModule(Rnd->VulkanCore.Device, s.Module, nullptr), s.Module = VK_NULL_HANDLE;
 
-    //std::array<VkPipelineShaderStageCreateInfo, 2> ShaderStageInfoArr;
-    std::vector<VkPipelineShaderStageCreateInfo> ShaderStageInfoArr;
-    ShaderStageInfoArr.reserve(6);
-
-    // Vertex shader
-    if (ShaderModuleVert != VK_NULL_HANDLE)
-    {
-      VkPipelineShaderStageCreateInfo ShaderStageInfo
-      {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_VERTEX_BIT,
-        .module = ShaderModuleVert,
-        .pName = "main",
-      };
-
-      ShaderStageInfoArr.push_back(ShaderStageInfo);
-    }
-    // Fragment shader
-    if (ShaderModuleFrag != VK_NULL_HANDLE)
-    {
-      VkPipelineShaderStageCreateInfo ShaderStageInfo
-      {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-        .module = ShaderModuleFrag,
-        .pName = "main",
-      };
-
-      ShaderStageInfoArr.push_back(ShaderStageInfo);
-    }
-    // Geometry shader
-    if (ShaderModuleGeom != VK_NULL_HANDLE)
-    {
-      VkPipelineShaderStageCreateInfo ShaderStageInfo
-      {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_GEOMETRY_BIT,
-        .module = ShaderModuleGeom,
-        .pName = "main",
-      };
-
-      ShaderStageInfoArr.push_back(ShaderStageInfo);
-    }
-    // Control shader
-    if (ShaderModuleCtrl != VK_NULL_HANDLE)
-    {
-      VkPipelineShaderStageCreateInfo ShaderStageInfo
-      {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
-        .module = ShaderModuleCtrl,
-        .pName = "main",
-      };
-
-      ShaderStageInfoArr.push_back(ShaderStageInfo);
-    }
-    // Evaluation shader
-    if (ShaderModuleEval != VK_NULL_HANDLE)
-    {
-      VkPipelineShaderStageCreateInfo ShaderStageInfo
-      {
-        .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-        .stage = VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT,
-        .module = ShaderModuleEval,
-        .pName = "main",
-      };
-
-      ShaderStageInfoArr.push_back(ShaderStageInfo);
-    }
-
-    //uint32_t                                    vertexBindingDescriptionCount;
-    //const VkVertexInputBindingDescription*      pVertexBindingDescriptions;
-    //uint32_t                                    vertexAttributeDescriptionCount;
-    //const VkVertexInputAttributeDescription*    pVertexAttributeDescriptions;
-
     //===============================
     // Setup render pipeline settings
     //===============================
 
-    // Vertex input
-    UINT32 VertexStride = 0;
-    std::vector<VkVertexInputAttributeDescription> AttributesDescription;
-    AttributesDescription.reserve(6);
+    // Shader modules and vertex format, other state is default
+    PipelineKey = pipeline_key {};
+    PipelineKey.Vert = ShaderModuleVert;
+    PipelineKey.Ctrl = ShaderModuleCtrl;
+    PipelineKey.Eval = ShaderModuleEval;
+    PipelineKey.Geom = ShaderModuleGeom;
+    PipelineKey.Frag = ShaderModuleFrag;
 
     for (auto &i : PipelinePattern->VertexFormat)
     {
-      AttributesDescription.push_back(i.second);
+      if (PipelineKey.NumOfAttributes >= std::size(PipelineKey.Attributes))
+      {
+        std::cout << "Too many attributes in vulkan pattern!\n";
+        break;
+      }
+      PipelineKey.Attributes[PipelineKey.NumOfAttributes++] = i.second;
 
       // Update vertex stride
       switch (i.second.format)
       {
       // Vulkan vec3
       case VK_FORMAT_R32G32B32_SFLOAT:
-        VertexStride += sizeof(fvec3);
+        PipelineKey.VertexStride += sizeof(fvec3);
         break;
 
       // Vulkan vec2
       case VK_FORMAT_R32G32_SFLOAT:
-        VertexStride += sizeof(fvec2);
+        PipelineKey.VertexStride += sizeof(fvec2);
         break;
 
       // Vulkan vec4
       case VK_FORMAT_R32G32B32A32_SFLOAT:
-        VertexStride += sizeof(fvec4);
+        PipelineKey.VertexStride += sizeof(fvec4);
         break;
 
       // Wrong format
@@ -280,208 +213,8 @@ namespace pivk
       }
     }
 
-    // NOT const
-    // Vertex input binding description
-    VkVertexInputBindingDescription BindingDescription = 
-    {
-      .binding = 0,
-      .stride = VertexStride,
-      .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
-    };
-
-    // Attributes
-    // NOT const
-    /// std::array<VkVertexInputAttributeDescription, 3> AttributesDescription = {};
-    /// 
-    /// // Position
-    /// AttributesDescription[0].binding = 0;
-    /// AttributesDescription[0].format = VK_FORMAT_R32G32B32_SFLOAT;
-    /// AttributesDescription[0].location = 0;
-    /// AttributesDescription[0].offset = 0;
-    /// 
-    /// // TC
-    /// AttributesDescription[1].binding = 0;
-    /// AttributesDescription[1].format = VK_FORMAT_R32G32_SFLOAT;
-    /// AttributesDescription[1].location = 1;
-    /// AttributesDescription[1].offset = sizeof(vec3);
-    /// 
-    /// // Normals
-    /// AttributesDescription[2].binding = 0;
-    /// AttributesDescription[2].format = VK_FORMAT_R32G32B32_SFLOAT;
-    /// AttributesDescription[2].location = 2;
-    /// AttributesDescription[2].offset = sizeof(vec3) + sizeof(vec2);
-
-    // Setup vertex input
-    // Const
-    VkPipelineVertexInputStateCreateInfo  VertexInputInfo = 
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
-      .vertexBindingDescriptionCount = 1,
-      .pVertexBindingDescriptions = &BindingDescription,
-      .vertexAttributeDescriptionCount = UINT32(AttributesDescription.size()),
-      .pVertexAttributeDescriptions = AttributesDescription.data(),
-    };
-
-    // Setup vertex assembly
-    // NOT const
-    VkPipelineInputAssemblyStateCreateInfo InputAssembly = 
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      //.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
-      .topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
-      .primitiveRestartEnable = VK_FALSE,
-    };
-
-    // Setup viewport state
-    // CONST
-    VkPipelineViewportStateCreateInfo ViewportState = 
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .viewportCount = 1,
-      .pViewports = &Rnd->VulkanCore.Viewport,
-      .scissorCount = 1,
-      .pScissors = &Rnd->VulkanCore.Scissor,
-    };
-
-    // Setup rasterizer
-    // CONST
-    VkPipelineRasterizationStateCreateInfo Rasterizer = 
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .depthClampEnable = VK_FALSE,
-      .rasterizerDiscardEnable = VK_FALSE,
-      .polygonMode = VK_POLYGON_MODE_FILL,
-      .cullMode = VK_CULL_MODE_NONE,//VK_CULL_MODE_BACK_BIT,
-      .frontFace = VK_FRONT_FACE_CLOCKWISE,
-      .depthBiasEnable = VK_FALSE,
-      .depthBiasConstantFactor = 0.0f,
-      .depthBiasClamp = 0.0f,
-      .depthBiasSlopeFactor = 0.0f,
-      .lineWidth = 1.0f,
-    };
-
-    // Setup multisampling
-    // CONST
-    VkPipelineMultisampleStateCreateInfo  Multisampling = 
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
-      .sampleShadingEnable = VK_FALSE,
-      .minSampleShading = 1.0f,
-      .pSampleMask = nullptr,            // Optional
-      .alphaToCoverageEnable = VK_FALSE, // Optional
-      .alphaToOneEnable = VK_FALSE,      // Optional
-    };
-
-    // Setup color blending
-    // (CONST) | ??? Not const
-    VkPipelineColorBlendAttachmentState  ColorBlendAttachment =
-    {
-      .blendEnable = VK_FALSE,
-      .srcColorBlendFactor = VK_BLEND_FACTOR_ONE,
-      .dstColorBlendFactor = VK_BLEND_FACTOR_ZERO,
-      .colorBlendOp = VK_BLEND_OP_ADD,
-      .srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE,
-      .dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO,
-      .alphaBlendOp = VK_BLEND_OP_ADD,
-      .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
-    };
-
-    // Setup color blend state
-    // CONST
-    VkPipelineColorBlendStateCreateInfo ColorBlending =
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .logicOpEnable = VK_FALSE,
-      .logicOp = VK_LOGIC_OP_COPY,
-      .attachmentCount = 1,
-      .pAttachments = &ColorBlendAttachment,
-      .blendConstants = {0.0f, 0.0f, 0.0f, 0.0f},
-    };
-
-    // Vulkan pipeline depth stencil state create info structure
-    // CONST
-    VkPipelineDepthStencilStateCreateInfo DepthStencil {};
-
-    DepthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-    DepthStencil.depthTestEnable = VK_TRUE;
-    DepthStencil.depthWriteEnable = VK_TRUE;
-    DepthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
-    DepthStencil.depthBoundsTestEnable = VK_FALSE;
-    DepthStencil.minDepthBounds = 0.0f; // Optional
-    DepthStencil.maxDepthBounds = 1.0f; // Optional
-    DepthStencil.stencilTestEnable = VK_FALSE;
-    DepthStencil.front = {}; // Optional
-    DepthStencil.back = {}; // Optional
-
-    // Tessellation parameters
-    // CONST
-    VkPipelineTessellationDomainOriginStateCreateInfo TessellationDomainOriginStateInfo
-    {
-      .sType =  VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_DOMAIN_ORIGIN_STATE_CREATE_INFO, 
-      .domainOrigin = VK_TESSELLATION_DOMAIN_ORIGIN_UPPER_LEFT,
-    };
-    VkPipelineTessellationStateCreateInfo TessellationStateInfo
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
-      .pNext = &TessellationDomainOriginStateInfo,
-      .patchControlPoints = 1,
-    };
-
-    // Dynamic state setup
-    std::array<VkDynamicState, 3> DynamicStates
-    {
-      VK_DYNAMIC_STATE_POLYGON_MODE_EXT,
-      VK_DYNAMIC_STATE_VIEWPORT,
-      VK_DYNAMIC_STATE_SCISSOR
-    };
-    VkPipelineDynamicStateCreateInfo DynamicStateInfo
-    {
-      .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
-      .dynamicStateCount = static_cast<UINT32>(DynamicStates.size()),
-      .pDynamicStates = DynamicStates.data(),
-    };
-
-    // Graphics pipeline creare info
-    // CONST ???
-    VkGraphicsPipelineCreateInfo PipelineInfo =
-    {
-      .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .stageCount = UINT32(ShaderStageInfoArr.size()),
-      .pStages = ShaderStageInfoArr.data(),
-      .pVertexInputState = &VertexInputInfo,
-      .pInputAssemblyState = &InputAssembly,
-      .pTessellationState = &TessellationStateInfo, // Optional
-      .pViewportState = &ViewportState,
-      .pRasterizationState = &Rasterizer,
-      .pMultisampleState = &Multisampling,
-      .pDepthStencilState = &DepthStencil, // Optional
-      .pColorBlendState = &ColorBlending,
-      .pDynamicState = &DynamicStateInfo,
-      .layout = Rnd->VulkanCore.PipelineLayout,
-      .renderPass = Rnd->VulkanCore.RenderPass,
-      .subpass = 0,
-      .basePipelineHandle = nullptr,
-      .basePipelineIndex = 0,
-    };
-
-    // Finally, create graphic pipeline
-    if (vkCreateGraphicsPipelines(Rnd->VulkanCore.Device, VK_NULL_HANDLE, 1, &PipelineInfo, nullptr, &Pipeline) != VK_SUCCESS )
-    {
-      throw;
-    }
+    // Pipeline of same state is created once and shared by shaders and materials
+    Pipeline = Rnd->VulkanCore.PipelineGet(PipelineKey);
 
     return *this;
   } /* End of 'Load' function */
@@ -776,7 +509,7 @@ namespace pivk
    */
   VOID shader::Apply( VOID )
   {
-    vkCmdBindPipeline(Rnd->VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, Pipeline);
+    Rnd->VulkanCore.BindPipeline(Pipeline);
   } /* End of 'shader::Apply' function */
 
 
@@ -807,7 +540,10 @@ namespace pivk
   VOID shader::Free( VOID )
   {
     //vkDestroyPipelineLayout(Rnd->VulkanCore.Device, PipelineLayout, nullptr);
-    vkDestroyPipeline(Rnd->VulkanCore.Device, Pipeline, nullptr);
+    // Pipelines of all variants using these modules are freed by vulkan core
+    for (VkShaderModule Module : {ShaderModuleVert, ShaderModuleCtrl, ShaderModuleEval, ShaderModuleGeom, ShaderModuleFrag})
+      Rnd->VulkanCore.PipelinesFree(Module);
+    Pipeline = VK_NULL_HANDLE;
 
     if (ShaderModuleCtrl != VK_NULL_HANDLE)
       vkDestroyShaderModule(Rnd->VulkanCore.Device, ShaderModuleCtrl, nullptr);
@@ -5,7 +5,7 @@
 
 /* FILE:        shader.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 30.08.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Shader class header file.
  * NOTE:        None.
  * 
@@ -186,8 +186,10 @@ namespace pivk
       ShaderModuleFrag = VK_NULL_HANDLE; // Fragment shader
 
     //std::map<TypeOfShader, VkShaderModule> ShaderModules;
-    // Vulkan shader pipeline
-    VkPipeline Pipeline;
+    // Vulkan shader pipeline (owned by vulkan core pipelines table)
+    VkPipeline Pipeline {};
+    // Pipeline state key (materials create variants of it)
+    pipeline_key PipelineKey {};
     //  Vulkan shader pipeline layout
     //VkPipelineLayout PipelineLayout;
 
@@ -329,22 +331,40 @@ namespace pivk
       return Shd;
     } /* End of 'ShdLoad' function */
 
-    /* Find shader by name.
+    /* Find shader by name (load if not found) function.
      * ARGUMENTS:
      *   - shader name:
-     *       const std::string &Name;
+     *       std::string_view Name;
      *   - pipeline pattern (nullptr if using old):
      *       pipeline_pattern *PipelinePattern;
      * RETURNS:
      *   (shader *) pointer to shader, if shader finded, or nullptr, if no.
      */
-    shader * ShdFind( const std::string &Name, pipeline_pattern *PipelinePattern = nullptr )
+    shader * ShdFind( std::string_view Name, pipeline_pattern *PipelinePattern = nullptr )
     {
       shader *S = resource_manager::Find(Name);
 
       if (S != nullptr)
         return S;
-      return ShdCreate(Name, PipelinePattern);
+      return ShdCreate(std::string(Name), PipelinePattern);
+    } /* End of 'ShdFind' function */
+
+    /* Find shader by interned name (load if not found) function.
+     * ARGUMENTS:
+     *   - interned shader name:
+     *       atom Name;
+     *   - pipeline pattern (nullptr if using old):
+     *       pipeline_pattern *PipelinePattern;
+     * RETURNS:
+     *   (shader *) pointer to shader, if shader finded, or nullptr, if no.
+     */
+    shader * ShdFind( atom Name, pipeline_pattern *PipelinePattern = nullptr )
+    {
+      shader *S = resource_manager::Find(Name);
+
+      if (S != nullptr)
+        return S;
+      return ShdCreate(std::string(Name.Str()), PipelinePattern);
     } /* End of 'ShdFind' function */
  
     /* Class destructor */
@@ -360,7 +380,7 @@ namespace pivk
     VOID ShdClose( VOID )
     {
       for (auto &i : resource_manager::Stock)
-        i.second.Free();
+        i.Free();
     } /* End of 'ShdClose' function */
  
     /* Update all shaders in stock function.
@@ -372,7 +392,7 @@ namespace pivk
       //if (Watcher.IsChanged())
       //{
       //  for (auto &shd : Stock)
-      //    shd.second.Update();
+      //    shd.Update();
       //}
     } /* End of 'Update' function */
   }; /* End of 'shader_manager' class */
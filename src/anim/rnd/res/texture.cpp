@@ -5,7 +5,7 @@
 
 /* FILE:        texture.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 03.09.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Texture functions declare file.
  * NOTE:        None.
  * 
@@ -50,9 +50,9 @@ namespace pivk
     // Set format by 'C'
     switch (C)
     {
-    // One color
+    // One color (normalized, as all textures are read by float samplers)
     case 1:
-      Format = VK_FORMAT_R8_UINT;
+      Format = VK_FORMAT_R8_UNORM;
       break;
 
     // RGB
@@ -76,35 +76,18 @@ namespace pivk
     VkImageUsageFlags UsageFlags = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | // Used as source on shader
                                    VK_IMAGE_USAGE_SAMPLED_BIT;       // Used for image_view for sampler
 
-    Rnd->VulkanCore.ImageCreate(Image, ImageView, Allocation,
-                                W, H, VK_TRUE, VK_FALSE, Format, UsageFlags,
-                                VK_IMAGE_LAYOUT_UNDEFINED, Bits, W * H * C, mips);
+    // Not created image (out of device memory) is not applied
+    if (!Rnd->VulkanCore.ImageCreate(Image, ImageView, Allocation,
+                                     W, H, VK_TRUE, VK_FALSE, Format, UsageFlags,
+                                     VK_IMAGE_LAYOUT_UNDEFINED, Bits, W * H * C, mips, &UploadTicket))
+      return *this;
     Rnd->VulkanCore.SamplerCreate(Sampler, ImageView);
-    
-    VkDescriptorSetLayout DSL = Rnd->VulkanCore.TexDescriptorSetLayout;
-
-    std::array<VkDescriptorSetLayout, 9> DSLA 
-    {
-      DSL, DSL, DSL,
-      DSL, DSL, DSL,
-      DSL, DSL, DSL,
-    };
-
-    VkDescriptorSetAllocateInfo AllocInfo {};
-    AllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    AllocInfo.descriptorPool = Rnd->VulkanCore.DescriptorPool;
-    AllocInfo.descriptorSetCount = 9;
-    AllocInfo.pSetLayouts = DSLA.data();
-
-    if (VkResult res; (res = vkAllocateDescriptorSets(Rnd->VulkanCore.Device, &AllocInfo, TextureDescriptorSets)) != VK_SUCCESS) 
-    {
-      std::cout << res;
-      throw; // std::runtime_error("failed to allocate descriptor sets!");
-    }
-
-    for (INT i = 0; i < 9; i++)
-      Rnd->VulkanCore.TexUpdateDescriptor(TextureDescriptorSets[i], ImageView, Sampler, i);
+    IsEvicted = FALSE;
 
+    // Reloaded texture is written to the same slot (materials keep its index)
+    if (TexIndex < 0)
+      TexIndex = Rnd->VulkanCore.TexAllocIndex();
+    Rnd->VulkanCore.TexUpdateDescriptor(TexIndex, ImageView, Sampler);
     return *this;
   } /* End of 'texture::TexAddImg' function */
 
@@ -166,6 +149,7 @@ namespace pivk
 
     std::string FileName = Rnd->AnimRef.Path + "/bin/textures/" + Name;
 
+    IsFromFile = TRUE;
     if ((hBm = (HBITMAP)LoadImage(nullptr, FileName.c_str(), IMAGE_BITMAP, 0, 0, LR_LOADFROMFILE | LR_CREATEDIBSECTION)) != nullptr)
     {
       BITMAP bm {};
@@ -179,24 +163,59 @@ namespace pivk
     return *this;
   } /* End of 'texture::TexAddFile' function */
 
-  /* Texture free function.
+  /* Texture free function (image and textures array slot are released).
    * ARGUMENTS: None.
    * RETURNS:
    *   - (texture &) this texture.
    */
   texture & texture::TexFree( VOID )
   {
-    Rnd->VulkanCore.ImageFree(Image, ImageView, Allocation);
+    TexImageFree();
+    Rnd->VulkanCore.TexFreeIndex(TexIndex);
+    TexIndex = -1;
     return *this;
   } /* End of 'texture::TexFree' function */
 
-  /* Texture apply function.
+  /* Free texture image function (textures array slot is kept).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID texture::TexImageFree( VOID )
+  {
+    Rnd->VulkanCore.ImageFree(Image, ImageView, Allocation);
+    if (Sampler != VK_NULL_HANDLE)
+      Rnd->VulkanCore.SamplerFree(Sampler);
+  } /* End of 'texture::TexImageFree' function */
+
+  /* Evict texture image from device memory function (reloaded from file on next apply).
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (UINT64) number of freed bytes.
+   */
+  UINT64 texture::TexEvict( VOID )
+  {
+    UINT64 Size = Rnd->VulkanCore.MemSize(Allocation);
+
+    // Evicted texture keeps its slot (materials refer to it), which is
+    // not used by frames in flight (see 'render::EvictLRU')
+    Rnd->VulkanCore.TexResetDescriptor(TexIndex);
+    TexImageFree();
+    IsEvicted = TRUE;
+    return Size;
+  } /* End of 'texture::TexEvict' function */
+
+  /* Texture apply function (texture is read from textures array by index, only usage is marked).
    * ARGUMENTS: None.
    * RETURNS: None.
    */
-  VOID texture::TexApply( INT BindPoint )
+  VOID texture::TexApply( VOID )
   {
-    vkCmdBindDescriptorSets(Rnd->VulkanCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, Rnd->VulkanCore.PipelineLayout, 1, 1, &TextureDescriptorSets[BindPoint], 0, nullptr);
+    UINT64 Frame = Rnd->VulkanCore.FrameNo;
+
+    // Evicted texture reload is tried once per frame
+    if (IsEvicted && LastUse != Frame)
+      TexAddFile();
+    LastUse = Frame;
   } /* End of 'texture::TexApply' function */
 
   /* Update texture array function.
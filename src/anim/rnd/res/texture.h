@@ -5,7 +5,7 @@
 
 /* FILE:        texture.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 13.09.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Texture class header file.
  * NOTE:        None.
  * 
@@ -26,16 +26,21 @@ namespace pivk
   class texture : public resource
   {
   public:
-    std::string Name;                         // Texture name
-    INT TexW, TexH;                           // Texture size
-    //UINT TexId;                             // Texture id
-    //BOOL IsCubeMap = FALSE;                 // Is cube map flag
-    VkImage Image;                            // Vulkan image
-    VkImageView ImageView;                    // Vulkan image view
-    VkSampler Sampler;                        // Vulkan sampler
-    VmaAllocation Allocation;                 // AMD VMA allocate for image
-    VkDescriptorSet TextureDescriptorSets[9]; // Vulkan texture descriptor set
-    BOOL IsUpdated = FALSE;                   // Information about updat
+    std::string Name;                            // Texture name
+    INT TexW, TexH;                              // Texture size
+    //UINT TexId;                                // Texture id
+    //BOOL IsCubeMap = FALSE;                    // Is cube map flag
+    VkImage Image {};                            // Vulkan image
+    VkImageView ImageView {};                    // Vulkan image view
+    VkSampler Sampler {};                        // Vulkan sampler
+    VmaAllocation Allocation {};                 // AMD VMA allocate for image
+    INT TexIndex = -1;                           // Slot in textures array (kept while texture exists, -1 if not allocated)
+    BOOL IsUpdated = FALSE;                      // Information about updat
+    BOOL IsFromFile = FALSE;                     // Loaded from file (may be evicted and reloaded) flag
+    BOOL IsEvicted = FALSE;                      // Image is evicted from device memory flag
+    UINT64 LastUse = 0;                          // Number of last frame texture was applied in
+    UINT64 UploadTicket = 0;                     // Pixels upload ticket (see 'vlk_upload_manager::UploadIsDone')
+    UINT64 ImgHash = 0;                          // Pixels hash of image created from memory (0 - not from memory)
     
     /* Default constructor */
     texture() : Name()
@@ -111,26 +116,66 @@ namespace pivk
      */
     texture & TexAddFile( render *NewRnd = nullptr );
 
-    /* Texture free function.
+    /* Texture free function (image and textures array slot are released).
      * ARGUMENTS: None.
      * RETURNS:
      *   - (texture &) this texture.
      */
     texture & TexFree( VOID );
 
-    /* Texture apply function.
-     * ARGUMENTS:
-     *   - bind point:
-     *       INT BindPoint;
+    /* Free texture image function (textures array slot is kept).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID TexImageFree( VOID );
+
+    /* Free texture function (called by texture manager on delete).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Free( VOID )
+    {
+      TexFree();
+    } /* End of 'Free' function */
+
+    /* Evict texture image from device memory function (reloaded from file on next apply).
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) number of freed bytes.
+     */
+    UINT64 TexEvict( VOID );
+
+    /* Texture apply function (texture is read from textures array by index, only usage is marked).
+     * ARGUMENTS: None.
      * RETURNS: None.
      */
-    VOID TexApply( INT BindPoint );
+    VOID TexApply( VOID );
 
   }; /* End of 'texture' class */
 
   /* Texture manager */
   class texture_manager : public resource_manager<texture, std::string> 
   {
+  private:
+    handle SkyTex {}; // Sky texture handle (resolved when texture with sky name is added)
+
+    /* Add texture to stock function.
+     * ARGUMENTS:
+     *   - texture to add:
+     *       const texture &Tex;
+     * RETURNS:
+     *   (texture *) added texture.
+     */
+    texture * TexAdd( const texture &Tex )
+    {
+      texture *T = resource_manager::Add(Tex);
+
+      if (T->Name == "Skytex")
+        SkyTex = resource_manager::GetHandle(T);
+      UpdateTexturesArray = TRUE;
+      return T;
+    } /* End of 'TexAdd' function */
+
   public:
     BOOL UpdateTexturesArray = TRUE; // Update material SSBO flag.
 
@@ -154,7 +199,7 @@ namespace pivk
       image Img {"bin/textures/skytex.g24", img_type::G24};
 
       //resource_manager::Add(texture("Skytex").TexAddImg(Img.W, Img.H, 4, Img.Pixels, &RndRef));
-      resource_manager::Add(texture("Default").TexAddImg(2, 2, 1, Txt, &RndRef));
+      TexAdd(texture("Default").TexAddImg(2, 2, 1, Txt, &RndRef));
     } /* End of 'material_patern_manager' function */
 
     /* Create material pattern function.
@@ -166,12 +211,9 @@ namespace pivk
      */
     texture * TextureCreateFromFile( const std::string &FileName )
     {
-      if (resource_manager::Find(FileName) == nullptr)
-      {
-        UpdateTexturesArray = TRUE;
-        return resource_manager::Add(texture(FileName).TexAddFile(&RndRef));
-      }
-      return resource_manager::Find(FileName); 
+      if (texture *T = resource_manager::Find(FileName); T != nullptr)
+        return T;
+      return TexAdd(texture(FileName).TexAddFile(&RndRef));
     } /* End of 'TextureCreateFromFile' function */
 
     /* Create material pattern function.
@@ -189,13 +231,48 @@ namespace pivk
      */
     texture * TextureCreateFromImg( const std::string &FileName, INT W, INT H, INT C, VOID *Bits )
     {
-      if (resource_manager::Find(FileName) == nullptr)
+      if (texture *T = resource_manager::Find(FileName); T != nullptr)
+        return T;
+      return TexAdd(texture(FileName).TexAddImg(W, H, C, Bits, &RndRef));
+    } /* End of 'TextureCreateFromImg' function */
+
+    /* Create or update texture from image function.
+     * Found texture with other pixels gets new image in the same
+     * textures array slot (materials keep referring to it).
+     * ARGUMENTS: 
+     *   - file name:
+     *       const std::string &FileName;
+     *   - Texture size in pixels:
+     *       INT W, INT H;
+     *   - Number of components per point:
+     *       INT C;
+     *   - Pointer to an array with components:
+     *       VOID *Bits;
+     * RETURNS:
+     *   - (texture *) pointer to texture.
+     */
+    texture * TextureUpdateFromImg( const std::string &FileName, INT W, INT H, INT C, VOID *Bits )
+    {
+      UINT64 Hash = HashBytes(Bits, static_cast<size_t>(W) * H * C);
+      texture *T = resource_manager::Find(FileName);
+
+      if (T == nullptr)
       {
-        UpdateTexturesArray = TRUE;
-        return resource_manager::Add(texture(FileName).TexAddImg(W, H, C, Bits, &RndRef));
+        T = TexAdd(texture(FileName).TexAddImg(W, H, C, Bits, &RndRef));
+        T->ImgHash = Hash;
+        return T;
       }
-      return resource_manager::Find(FileName); 
-    } /* End of 'TextureCreateFromImg' function */
+      if (T->ImgHash == Hash && T->Image != VK_NULL_HANDLE)
+        return T;
+
+      // Slot refers to default texture until new image is created
+      RndRef.VulkanCore.TexResetDescriptor(T->TexIndex);
+      T->TexImageFree();
+      T->TexAddImg(W, H, C, Bits);
+      T->ImgHash = Hash;
+      UpdateTexturesArray = TRUE;
+      return T;
+    } /* End of 'TextureUpdateFromImg' function */
 
     /* Add texture by OpenGL low-level format to stock function.
      * ARGUMENTS: 
@@ -209,12 +286,9 @@ namespace pivk
      */
     texture * TextureCreateFromFmt( const std::string &FileName, INT W, INT H, INT GLType )
     {
-      if (resource_manager::Find(FileName) == nullptr)
-      {
-        UpdateTexturesArray = TRUE;
-        return resource_manager::Add(texture(FileName).TexAddFmt(W, H, GLType));
-      }
-      return resource_manager::Find(FileName); 
+      if (texture *T = resource_manager::Find(FileName); T != nullptr)
+        return T;
+      return TexAdd(texture(FileName).TexAddFmt(W, H, GLType));
     } /* End of 'TextureCreateFromFmt' function */
 
     /* Create material pattern function.
@@ -226,26 +300,45 @@ namespace pivk
      */
     texture * TextureCreateFromCubeMap( const std::string &FileName )
     {
-      if (resource_manager::Find(FileName) == nullptr)
-      {
-        UpdateTexturesArray = TRUE;
-        return resource_manager::Add(texture(FileName).TexAddCubeMap());
-      }
-      return resource_manager::Find(FileName); 
+      if (texture *T = resource_manager::Find(FileName); T != nullptr)
+        return T;
+      return TexAdd(texture(FileName).TexAddCubeMap());
     } /* End of 'TextureCreateFromCubeMap' function */
 
     /* Find by name texture function.
      * ARGUMENTS: 
      *   - name texture:
-     *       std::string Name;
+     *       std::string_view Name;
+     * RETURNS:
+     *   - (texture *) pointer to texture.
+     */
+    texture * TextureFind( std::string_view Name )
+    {
+      return resource_manager::Find(Name);
+    } /* End of 'TextureFind' function */
+
+    /* Find by interned name texture function.
+     * ARGUMENTS: 
+     *   - interned name texture:
+     *       atom Name;
      * RETURNS:
      *   - (texture *) pointer to texture.
      */
-    texture * TextureFind( std::string Name )
+    texture * TextureFind( atom Name )
     {
       return resource_manager::Find(Name);
     } /* End of 'TextureFind' function */
 
+    /* Get sky texture function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   - (texture *) pointer to sky texture or nullptr if it is not loaded.
+     */
+    texture * TextureSky( VOID )
+    {
+      return resource_manager::Find(SkyTex);
+    } /* End of 'TextureSky' function */
+
     /* Update texture array function.
      * ARGUMENTS: None.
      * RETURNS: None.
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_buffer.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 29.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan buffer file.
  * NOTE:        None.
  * 
@@ -49,36 +49,82 @@ namespace pivk
    *       UINT_PTR NewSize;
    *   - type of using:
    *       VkBufferUsageFlags UsageFlags;
+   *   - device local buffer flag (for static data, otherwise buffer is host visible):
+   *       BOOL NewIsStatic;
    * RETURNS:
    *    (vlk_buf &) reference to this buf.
    */
-  vlk_buf & vlk_buf::Create( UINT_PTR NewSize, UINT_PTR NewCount, VkBufferUsageFlags UsageFlags )
+  vlk_buf & vlk_buf::Create( UINT_PTR NewSize, UINT_PTR NewCount, VkBufferUsageFlags UsageFlags, BOOL NewIsStatic )
   {
     BufferUsageFlags = UsageFlags;
+    IsStatic = NewIsStatic;
     CountOfElements = NewCount;
     Size = NewSize;
+    Class = (UsageFlags & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT)) != 0 ?
+      mem_class::GEOMETRY : mem_class::OTHER;
 
     if (Size > 0)
     {
+      // Static buffers are written by transfer queue and may be rewritten
+      // after drawing, so they are shared instead of ownership transfers
+      UINT32 Families[] {VlkCore->CommandFamily, VlkCore->TransferFamily};
+      BOOL IsShared = IsStatic && VlkCore->IsTransferFamily;
+
       VkBufferCreateInfo Info
       {
-        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, // Structure type.
-        .size = Size,                                  // Size of buffer in bytes.
-        .usage = UsageFlags,                           // Bit mask of using buffer.
-        .sharingMode = VK_SHARING_MODE_EXCLUSIVE,      // Sharing type when accessed 
-                                                       // by several families of queues
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,       // Structure type.
+        .size = Size,                                        // Size of buffer in bytes.
+        .usage = UsageFlags |                                // Bit mask of using buffer.
+                 (IsStatic ? VK_BUFFER_USAGE_TRANSFER_DST_BIT : 0),
+        .sharingMode = IsShared ? VK_SHARING_MODE_CONCURRENT // Sharing type when accessed
+                                : VK_SHARING_MODE_EXCLUSIVE, // by several families of queues
+        .queueFamilyIndexCount = IsShared ? 2U : 0U,         // Number of sharing families.
+        .pQueueFamilyIndices = IsShared ? Families : nullptr // Sharing families.
       };
 
       VmaAllocationCreateInfo AllocationCreateInfo{};
-      AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-      AllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
-      AllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+      if (IsStatic)
+      {
+        // Static data is placed to device local memory and is written through staging buffer
+        AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+        AllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+        AllocationCreateInfo.flags = 0;
+      }
+      else
+      {
+        AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        AllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+        AllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+      }
       AllocationCreateInfo.priority = 1.0f;
 
-      if (vmaCreateBuffer(VlkCore->Allocator, &Info, &AllocationCreateInfo, &Buffer, &Allocation, nullptr) != VK_SUCCESS)
+      VkResult Res;
+      VmaAllocationInfo AllocationInfo {};
+
+      // Out of memory - evict not used resources and retry
+      while ((Res = vmaCreateBuffer(VlkCore->Allocator, &Info, &AllocationCreateInfo, &Buffer, &Allocation, &AllocationInfo)) != VK_SUCCESS &&
+             VlkCore->MemReclaim(Size))
+        ;
+      if (Res != VK_SUCCESS)
       {
-        throw;
+#if _DEBUG
+        MessageLog(std::format("Buffer of {} bytes is not created (error {})\n", Size, static_cast<INT>(Res)), 2);
+#endif // _DEBUG
+        // Buffer stays empty (not drawn/written) instead of terminating application
+        Buffer = nullptr;
+        Allocation = nullptr;
+        Mapped = nullptr;
+        Size = 0;
+        return *this;
       }
+      VlkCore->MemAlloc(Class, Allocation);
+
+      // Memory is mapped once for whole buffer life time (static buffers are not mapped)
+      VkMemoryPropertyFlags MemFlags;
+
+      vmaGetAllocationMemoryProperties(VlkCore->Allocator, Allocation, &MemFlags);
+      Mapped = static_cast<BYTE *>(AllocationInfo.pMappedData);
+      IsCoherent = (MemFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
 
       ////VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
       //
@@ -151,45 +197,52 @@ namespace pivk
    * ARGUMENTS:
    *   - memory data buffer:
    *       const VOID *Data;
+   *   - offset in buffer (in bytes):
+   *       UINT_PTR Offset;
+   *   - size of data (in bytes, 0 - up to buffer end):
+   *       UINT_PTR WriteSize;
    * RETURNS: None.
    */
-  VOID vlk_buf::Write( const VOID *Data )
+  VOID vlk_buf::Write( const VOID *Data, UINT_PTR Offset, UINT_PTR WriteSize )
   {
-    VOID *MapPointer;
+    if (Buffer == nullptr || Offset >= Size)
+      return;
+    if (WriteSize == 0 || WriteSize > Size - Offset)
+      WriteSize = Size - Offset;
 
-    if (vmaMapMemory(VlkCore->Allocator, Allocation, &MapPointer) != VK_SUCCESS)
+    if (IsStatic)
     {
-      throw;
+      // Transfer queue is not ordered with command queue - frames
+      // which still read buffer are waited before rewriting it
+      if (VlkCore->IsTransferFamily && LastUse > VlkCore->CompletedNo)
+        VlkCore->FramesWait(LastUse);
+      VlkCore->UploadBuf(this, Data, Offset, WriteSize);
+      return;
     }
-
-    //if (vkMapMemory(VlkCore->Device,            // Logical device.
-    //                DeviceMemory,               // Memory.
-    //                0,                          // Align from start memory.
-    //                Size,                       // Size of getting memory.
-    //                0,                          // Flags (not used, reserved for future).
-    //                &MapPointer) != VK_SUCCESS) // Getting pointer.
-    //{
-    //  throw;
-    //}
-
-    //VkMappedMemoryRange MemoryRange;
-
-    //vkMappedMemoryRand
+    if (Mapped == nullptr)
+      return;
 
     // Write buffer to memory.
-    std::memcpy(MapPointer, Data, Size);
+    std::memcpy(Mapped + Offset, Data, WriteSize);
+    Flush(Offset, WriteSize);
+  } /* Endof 'vlk_buf::Write' function */
 
-    // Not used, we use VK_MEMORY_PROPERTY_HOST_COHERENT_BIT flag
-    //if (TRUE) // Update data on GPU, if memory don't have corresponding flag. (???)
-    //  vkFlushMappedMemoryRanges(VlkCore->Device, );
+  /* Make written data visible to GPU function (does nothing for host coherent memory).
+   * ARGUMENTS:
+   *   - offset in buffer (in bytes):
+   *       UINT_PTR Offset;
+   *   - size of data (in bytes, 0 - up to buffer end):
+   *       UINT_PTR FlushSize;
+   * RETURNS: None.
+   */
+  VOID vlk_buf::Flush( UINT_PTR Offset, UINT_PTR FlushSize )
+  {
+    if (IsCoherent || Mapped == nullptr || Offset >= Size)
+      return;
 
-    // Finally, free pointer to memory.
-    // Pointer definety bounded to memory, so his not need transmit to function.
-    
-    vmaUnmapMemory(VlkCore->Allocator, Allocation);
-    //vkUnmapMemory(VlkCore->Device, // Logical device.
-    //              DeviceMemory);   // Memory.
-  } /* Endof 'vlk_buf::Write' function */
+    // VMA aligns range to 'nonCoherentAtomSize'
+    vmaFlushAllocation(VlkCore->Allocator, Allocation, Offset, FlushSize == 0 ? VK_WHOLE_SIZE : FlushSize);
+  } /* End of 'vlk_buf::Flush' function */
 
   /* Delete buffer function.
    * ARGUMENTS: None.
@@ -199,8 +252,16 @@ namespace pivk
   {
     if (Buffer != nullptr)
     {
-      vmaDestroyBuffer(VlkCore->Allocator, Buffer, Allocation);
+      VlkCore->MemFree(Class, Allocation);
+
+      // Buffer may be used by not completed frame
+      VlkCore->DeferDestroy([Allocator = VlkCore->Allocator, OldBuffer = Buffer, OldAllocation = Allocation]( VOID )
+        {
+          vmaDestroyBuffer(Allocator, OldBuffer, OldAllocation);
+        });
       Buffer = nullptr;
+      Allocation = nullptr;
+      Mapped = nullptr;
       //vkFreeMemory(VlkCore->Device, DeviceMemory, nullptr);                                                                   
       //vkDestroyBuffer(VlkCore->Device, Buffer, nullptr);
     }
@@ -218,9 +279,127 @@ namespace pivk
       return;
 
     Free();
-    Create(NewSize, NewCount, BufferUsageFlags);
+    Create(NewSize, NewCount, BufferUsageFlags, IsStatic);
   } /* End of 'Resize' function */
 
+  /* Create per frame storage buffer function.
+   * ARGUMENTS:
+   *   - vulkan core:
+   *       vlk *NewVlkCore;
+   *   - descriptor binding:
+   *       INT NewBindPoint;
+   *   - size of one record in bytes:
+   *       UINT_PTR NewRecordSize;
+   *   - initial number of records in each copy:
+   *       UINT_PTR NewCapacity;
+   * RETURNS:
+   *   (vlk_frame_buf &) reference to this buffer.
+   */
+  vlk_frame_buf & vlk_frame_buf::Create( vlk *NewVlkCore, INT NewBindPoint, UINT_PTR NewRecordSize, UINT_PTR NewCapacity )
+  {
+    VlkCore = NewVlkCore;
+    BindPoint = NewBindPoint;
+    RecordSize = NewRecordSize;
+    Capacity = 0;
+    Data.clear();
+    Version = 1;
+    Versions.assign(VlkCore->Frames.size(), 0);
+
+    // Copies are created for initial capacity, there are no records yet
+    Resize(NewCapacity);
+    Data.clear();
+    return *this;
+  } /* End of 'vlk_frame_buf::Create' function */
+
+  /* Set number of records function (copies are grown if needed, descriptor is updated).
+   * ARGUMENTS:
+   *   - number of records:
+   *       UINT_PTR Count;
+   * RETURNS: None.
+   */
+  VOID vlk_frame_buf::Resize( UINT_PTR Count )
+  {
+    Data.resize(Count * RecordSize);
+    Version++;
+    if (Count <= Capacity && Buf != nullptr && Buf->Buffer != nullptr)
+      return;
+
+    UINT_PTR NewCapacity = Count > Capacity * 2 ? Count : Capacity * 2;
+
+    if (NewCapacity == 0)
+      return;
+
+    // Each copy starts at offset suitable for dynamic binding
+    CopySize = (NewCapacity * RecordSize + VlkCore->RingAlign - 1) / VlkCore->RingAlign * VlkCore->RingAlign;
+    if (Buf == nullptr)
+      Buf = VlkCore->BufCreate(CopySize * VlkCore->Frames.size(), NewCapacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+    else
+      Buf->Resize(CopySize * VlkCore->Frames.size(), NewCapacity);
+    if (Buf->Buffer == nullptr)
+      return;
+    Capacity = NewCapacity;
+
+    // New buffer has no valid copies (old one is destroyed after frames using it)
+    std::fill(Versions.begin(), Versions.end(), 0);
+    VlkCore->UpdateDescriptor(Buf, BindPoint, 3, CopySize);
+  } /* End of 'vlk_frame_buf::Resize' function */
+
+  /* Write record function (copies of frames are updated by 'Sync').
+   * ARGUMENTS:
+   *   - record index:
+   *       UINT_PTR Index;
+   *   - record data ('RecordSize' bytes):
+   *       const VOID *Record;
+   * RETURNS: None.
+   */
+  VOID vlk_frame_buf::Write( UINT_PTR Index, const VOID *Record )
+  {
+    if ((Index + 1) * RecordSize > Data.size())
+      return;
+    std::memcpy(Data.data() + Index * RecordSize, Record, RecordSize);
+    Version++;
+  } /* End of 'vlk_frame_buf::Write' function */
+
+  /* Update copy of recorded frame function (called when frame resources are free).
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (UINT32) dynamic offset of recorded frame copy.
+   */
+  UINT32 vlk_frame_buf::Sync( VOID )
+  {
+    if (Buf == nullptr || Buf->Mapped == nullptr || Capacity == 0)
+      return 0;
+
+    UINT Frame = VlkCore->FrameIdx;
+    UINT_PTR
+      Offset = Frame * CopySize,
+      Size = Data.size() < Capacity * RecordSize ? Data.size() : Capacity * RecordSize;
+
+    // Frame copy is rewritten only if records were changed since its last recording
+    if (Versions[Frame] != Version)
+    {
+      Versions[Frame] = Version;
+      if (Size > 0)
+      {
+        std::memcpy(Buf->Mapped + Offset, Data.data(), Size);
+        Buf->Flush(Offset, Size);
+      }
+    }
+    return static_cast<UINT32>(Offset);
+  } /* End of 'vlk_frame_buf::Sync' function */
+
+  /* Delete per frame storage buffer function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_frame_buf::Free( VOID )
+  {
+    if (Buf != nullptr)
+      Buf->Free();
+    Data.clear();
+    Capacity = 0;
+  } /* End of 'vlk_frame_buf::Free' function */
+
 } /* End of 'pivk' namespace */
 
 /* END OF 'vlk_buffer.cpp' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_comandpool.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 29.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan comand pool file.
  * NOTE:        None.
  * 
@@ -26,7 +26,7 @@ namespace pivk
   {
     // Get handles for every queue families.
     vkGetDeviceQueue(Device,         // Logic device.
-                     0,              // Index of queue family.
+                     CommandFamily,  // Index of queue family.
                      0,              // Queue index.
                      &CommandQueue); // Pointer to variable VkQueue.
   } /* End of 'CreateCommandQueue' function */
@@ -82,39 +82,113 @@ namespace pivk
                         &CommandPool); // Pointer to variable VkCommandPool.
   } /* End of 'vlk::CreateCommandPool' function */
 
-  /* Create command buffer function.
+  /* Create frames in flight command buffers and synchronization objects function.
    * ARGUMENTS: None.
    * RETURNS: None.
    */
-  VOID vlk::CreateCommandBuffer( VOID )
+  VOID vlk::CreateFrames( VOID )
   {
-    VkCommandBufferAllocateInfo Info
+    queue_family_indices Indices = GetQueueFamilyIndices();
+
+    VkCommandPoolCreateInfo PoolInfo
     {
-      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // Structure type.
-      .commandPool = CommandPool,                              // Using command pool.
-      .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,                // Command buffer size.
-      .commandBufferCount = 1                                  // Count of command buffers.
+      .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, // Type of structure.
+      .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,       // Pool is reset every frame.
+      .queueFamilyIndex = Indices.GraphicsFamily.value()   // Index of using queue family.
     };
-    
-    if (vkAllocateCommandBuffers(Device,                        // Logic device.
-                                 &Info,                         // Creating information.
-                                 &CommandBuffer) != VK_SUCCESS) // Pointer to array with variables VkCommandBuffer
-                                                                // (now we have one buffer => one variable).
+    VkSemaphoreCreateInfo SemaphoreInfo
     {
-      exit(3);
-    }
-
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    };
     VkFenceCreateInfo FenceCreateInfo
     {
       .sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
-      .flags = 0,
+      .flags = VK_FENCE_CREATE_SIGNALED_BIT, // Not submitted frame is completed
     };
 
-    if (vkCreateFence(Device, &FenceCreateInfo, nullptr, &Fence))
+    // Fence for one time submissions
+    if (vkCreateFence(Device, &FenceCreateInfo, nullptr, &Fence) != VK_SUCCESS)
     {
       exit(3);
     }
-  } /* End of 'vlk::CreateCommandBuffer' function */
+
+    Frames.resize(FramesInFlight < 1 ? 1 : FramesInFlight);
+    FrameIdx = 0;
+    for (frame &F : Frames)
+    {
+      if (vkCreateCommandPool(Device, &PoolInfo, nullptr, &F.CommandPool) != VK_SUCCESS)
+      {
+        exit(3);
+      }
+
+      VkCommandBufferAllocateInfo Info
+      {
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // Structure type.
+        .commandPool = F.CommandPool,                            // Using command pool.
+        .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,                // Command buffer size.
+        .commandBufferCount = 1                                  // Count of command buffers.
+      };
+
+      if (vkAllocateCommandBuffers(Device, &Info, &F.CommandBuffer) != VK_SUCCESS ||
+          vkCreateSemaphore(Device, &SemaphoreInfo, nullptr, &F.ImageAvailable) != VK_SUCCESS ||
+          vkCreateFence(Device, &FenceCreateInfo, nullptr, &F.Fence) != VK_SUCCESS)
+      {
+        exit(3);
+      }
+    }
+    CommandBuffer = Frames[0].CommandBuffer;
+  } /* End of 'vlk::CreateFrames' function */
+
+  /* Destroy frames in flight resources function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk::DestroyFrames( VOID )
+  {
+    for (frame &F : Frames)
+    {
+      vkDestroyFence(Device, F.Fence, nullptr);
+      vkDestroySemaphore(Device, F.ImageAvailable, nullptr);
+      vkDestroyCommandPool(Device, F.CommandPool, nullptr);
+    }
+    Frames.clear();
+    CommandBuffer = VK_NULL_HANDLE;
+    vkDestroyFence(Device, Fence, nullptr);
+  } /* End of 'vlk::DestroyFrames' function */
+
+  /* Wait for all submitted frames completion function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk::FramesWait( VOID )
+  {
+    for (UINT i = 0; i < Frames.size(); i++)
+      // Fence of recorded frame is signaled only after its submission
+      if (!IsFrameRecording || i != FrameIdx)
+        vkWaitForFences(Device, 1, &Frames[i].Fence, VK_TRUE, UINT64_MAX);
+  } /* End of 'vlk::FramesWait' function */
+
+  /* Wait for submitted frames completion up to frame number function.
+   * ARGUMENTS:
+   *   - number of last frame to wait:
+   *       UINT64 No;
+   * RETURNS: None.
+   */
+  VOID vlk::FramesWait( UINT64 No )
+  {
+    // Recorded frame is submitted after all uploads made during its recording
+    if (IsFrameRecording && No >= FrameNo)
+      No = FrameNo - 1;
+    if (No <= CompletedNo)
+      return;
+
+    for (UINT i = 0; i < Frames.size(); i++)
+      if ((!IsFrameRecording || i != FrameIdx) && Frames[i].FrameNo > CompletedNo && Frames[i].FrameNo <= No)
+        vkWaitForFences(Device, 1, &Frames[i].Fence, VK_TRUE, UINT64_MAX);
+
+    // Frames are completed in submission order
+    DeferredCollect(No);
+  } /* End of 'vlk::FramesWait' function */
 
 } /* end of 'pivk' namespace */
 
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_core.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 28.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan core file.
  * NOTE:        None.
  * 
@@ -30,13 +30,16 @@ namespace pivk
     CreateSurface();
     CreateCommandQueue();
     CreateCommandPool();
-    CreateCommandBuffer();
+    CreateFrames();
+    UploadInit();
     CreateSwapchain(47, 47);
     CreateRenderPass();
     CreateFrameBuffers();
     CreateDescriptors();
     CreatePipelineLayout();
+    CreatePipelineCache();
     vlk_descriptor_manager::CreateDescriptors();
+    RingCreate();
   } /* End of 'vlk::Init' function */
 
   /* Vulkan core close function
@@ -45,13 +48,20 @@ namespace pivk
    */
   VOID vlk::Close( VOID )
   {
+    UploadClose();
     vlk_descriptor_manager::FreeDescriptors();
     vlk_buf_manager::BufsFree();
+    vkDeviceWaitIdle(Device);
+    DeferredFlush();
     vkDestroyDescriptorPool(Device, DescriptorPool, nullptr);
+    vkDestroyDescriptorPool(Device, TexDescriptorPool, nullptr);
     vkDestroyDescriptorSetLayout(Device, TexDescriptorSetLayout, nullptr);
+    vkDestroyDescriptorUpdateTemplate(Device, DescriptorUpdateTemplate, nullptr);
     vkDestroyDescriptorSetLayout(Device, DescriptorSetLayout, nullptr);
+    PipelinesFree();
     vkDestroyPipelineLayout(Device, PipelineLayout, nullptr);
-    vkDestroyFence(Device, Fence, nullptr);
+    DestroyPipelineCache();
+    DestroyFrames();
     vkDestroyCommandPool(Device, CommandPool, nullptr);
     for (VkFramebuffer FrameBuffer : FrameBuffers)
       vkDestroyFramebuffer(Device, FrameBuffer, nullptr);
@@ -61,6 +71,9 @@ namespace pivk
     for (INT i = 0; i < SwapchainImageViews.size(); ++i)
       vkDestroyImageView(Device, SwapchainImageViews[i], nullptr);
     vkDestroySwapchainKHR(Device, Swapchain, nullptr);
+    for (VkSemaphore Semaphore : RenderFinished)
+      vkDestroySemaphore(Device, Semaphore, nullptr);
+    RenderFinished.clear();
     vkDestroySurfaceKHR(Instance, Surface, nullptr);
 
     // Destroy VMA allocator
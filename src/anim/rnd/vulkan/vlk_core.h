@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_core.h
  * PROGRAMMER:  IP5
- * LAST UPDATE: 28.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan core header file.
  * NOTE:        None.
  * 
@@ -147,6 +147,15 @@ namespace pivk
   /* Declare vulkan core class */
   class vlk;
 
+  /* Device memory resource class */
+  enum struct mem_class
+  {
+    GEOMETRY, // Vertex and index buffers
+    TEXTURE,  // Texture images
+    OTHER,    // Uniform, storage and other buffers
+    COUNT     // Number of classes
+  }; /* End of 'mem_class' enumeration */
+
   /* Vulkan buffer class */
   class vlk_buf
   {
@@ -157,6 +166,11 @@ namespace pivk
     UINT_PTR CountOfElements;            // Count of elements
     VmaAllocation Allocation {};         // AMD VMA allocation memory variable
     VkBufferUsageFlags BufferUsageFlags; // Variable with usage flags
+    mem_class Class = mem_class::OTHER;  // Memory resource class (by usage flags)
+    BYTE *Mapped = nullptr;              // Persistently mapped memory (valid while buffer exists)
+    BOOL IsCoherent = TRUE;              // Host coherent memory flag (written ranges are not flushed)
+    BOOL IsStatic = FALSE;               // Device local buffer flag (written through staging buffer)
+    UINT64 LastUse = 0;                  // Number of last frame which reads buffer (0 - not used yet)
 
     vlk *VlkCore;                        // Vulkan core
 
@@ -176,18 +190,56 @@ namespace pivk
      *       UINT_PTR Size;
      *   - type of using:
      *       VkBufferUsageFlags UsageFlags;
+     *   - device local buffer flag (for static data, otherwise buffer is host visible):
+     *       BOOL NewIsStatic;
      * RETURNS:
      *    (vlk_buf &) reference to this buf.
      */
-    vlk_buf & Create( UINT_PTR Size, UINT_PTR NewCount, VkBufferUsageFlags UsageFlags );
+    vlk_buf & Create( UINT_PTR Size, UINT_PTR NewCount, VkBufferUsageFlags UsageFlags, BOOL NewIsStatic = FALSE );
 
     /* Write data to vulkan buffer function.
      * ARGUMENTS:
      *   - memory data buffer:
      *       const VOID *Data;
+     *   - offset in buffer (in bytes):
+     *       UINT_PTR Offset;
+     *   - size of data (in bytes, 0 - up to buffer end):
+     *       UINT_PTR WriteSize;
+     * RETURNS: None.
+     */
+    VOID Write( const VOID *Data, UINT_PTR Offset = 0, UINT_PTR WriteSize = 0 );
+
+    /* Make written data visible to GPU function (does nothing for host coherent memory).
+     * ARGUMENTS:
+     *   - offset in buffer (in bytes):
+     *       UINT_PTR Offset;
+     *   - size of data (in bytes, 0 - up to buffer end):
+     *       UINT_PTR FlushSize;
      * RETURNS: None.
      */
-    VOID Write( const VOID *Data );
+    VOID Flush( UINT_PTR Offset = 0, UINT_PTR FlushSize = 0 );
+
+    /* Get buffer memory as array of elements function.
+     * Data written through span should be flushed by 'Flush' call.
+     * ARGUMENTS:
+     *   - first element index:
+     *       UINT_PTR First;
+     *   - count of elements (0 - up to buffer end):
+     *       UINT_PTR Count;
+     * RETURNS:
+     *   (std::span<data_type>) mapped elements (empty if buffer is not created).
+     */
+    template<typename data_type>
+      std::span<data_type> Map( UINT_PTR First = 0, UINT_PTR Count = 0 )
+      {
+        UINT_PTR Total = Mapped == nullptr ? 0 : Size / sizeof(data_type);
+
+        if (First >= Total)
+          return {};
+        if (Count == 0 || Count > Total - First)
+          Count = Total - First;
+        return std::span<data_type>(reinterpret_cast<data_type *>(Mapped) + First, Count);
+      } /* End of 'Map' function */
 
     /* Resize buffer function.
      * ARGUMENTS:
@@ -205,6 +257,74 @@ namespace pivk
 
   }; /* End of 'vlk_buf' class */
 
+  /* Per frame storage buffer class.
+   * Array written by CPU has own copy for each frame in flight (all copies
+   * are in one buffer and are bound by dynamic offset), so changes are never
+   * seen by already submitted frames. Copy of frame is brought up to date
+   * by 'Sync' before frame recording.
+   */
+  class vlk_frame_buf
+  {
+  public:
+    vlk_buf *Buf = nullptr;       // Buffer with copies of all frames
+    INT BindPoint = 0;            // Descriptor binding (dynamic storage buffer)
+    UINT_PTR
+      RecordSize = 0,             // Size of one record in bytes
+      Capacity = 0,               // Number of records in each copy
+      CopySize = 0;               // Size of one copy in bytes (aligned to dynamic offset alignment)
+    std::vector<BYTE> Data;       // Current records (written by CPU)
+    UINT64 Version = 1;           // Current records version (increased on each change)
+    std::vector<UINT64> Versions; // Records versions of frames copies
+
+    vlk *VlkCore = nullptr;       // Vulkan core
+
+    /* Create buffer function.
+     * ARGUMENTS:
+     *   - vulkan core:
+     *       vlk *NewVlkCore;
+     *   - descriptor binding:
+     *       INT NewBindPoint;
+     *   - size of one record in bytes:
+     *       UINT_PTR NewRecordSize;
+     *   - initial number of records in each copy:
+     *       UINT_PTR NewCapacity;
+     * RETURNS:
+     *   (vlk_frame_buf &) reference to this buffer.
+     */
+    vlk_frame_buf & Create( vlk *NewVlkCore, INT NewBindPoint, UINT_PTR NewRecordSize, UINT_PTR NewCapacity );
+
+    /* Set number of records function (copies are grown if needed, descriptor is updated).
+     * ARGUMENTS:
+     *   - number of records:
+     *       UINT_PTR Count;
+     * RETURNS: None.
+     */
+    VOID Resize( UINT_PTR Count );
+
+    /* Write record function (copies of frames are updated by 'Sync').
+     * ARGUMENTS:
+     *   - record index:
+     *       UINT_PTR Index;
+     *   - record data ('RecordSize' bytes):
+     *       const VOID *Record;
+     * RETURNS: None.
+     */
+    VOID Write( UINT_PTR Index, const VOID *Record );
+
+    /* Update copy of recorded frame function (called when frame resources are free).
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT32) dynamic offset of recorded frame copy.
+     */
+    UINT32 Sync( VOID );
+
+    /* Delete buffer function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Free( VOID );
+  }; /* End of 'vlk_frame_buf' class */
+
   /* Vulkan buffers manager class */
   class vlk_buf_manager
   {
@@ -228,9 +348,9 @@ namespace pivk
     } /* End of '~vlk_buf_manager' function */
 
     /* Create buffer function */
-    vlk_buf * BufCreate( UINT_PTR Size, UINT_PTR Count, VkBufferUsageFlags UsageFlags )
+    vlk_buf * BufCreate( UINT_PTR Size, UINT_PTR Count, VkBufferUsageFlags UsageFlags, BOOL IsStatic = FALSE )
     {
-      return &(Stock[StockSize++] = vlk_buf(&VlkCore).Create(Size, Count, UsageFlags));
+      return &(Stock[StockSize++] = vlk_buf(&VlkCore).Create(Size, Count, UsageFlags, IsStatic));
     } /* End of 'BufCreate' function */
 
     /* Write data to vulkan buffer function.
@@ -270,6 +390,9 @@ namespace pivk
   public:
     vlk *VlkCore;
     VkDescriptorSet DescriptorSet;
+    std::array<VkDescriptorBufferInfo, 4> Written {}; // Buffers written to bindings (in binding order, update template data)
+    std::array<VkDescriptorType, 4> WrittenTypes {};  // Descriptor types of written bindings
+    UINT32 DirtyMask = 0;                             // Mask of bindings written after last flush
 
     /* Default constructor */
     vlk_descriptor() : VlkCore(nullptr)
@@ -299,37 +422,41 @@ namespace pivk
      */
     VOID Free( VOID );
 
-    /* Update vulkan descriptor function.
+    /* Update vulkan descriptor function (write is applied by 'Flush').
      * ARGUMENTS:
      *   - buffer:
      *       vlk_buf *Buffer;
+     *   - binding id:
+     *       UINT BindPoint;
      *   - size of buffer (in bytes):
      *       UINT_PTR BufSize;
      *   - offset of buffer:
      *       UINT_PTR BufOffset;
-     *   - type of buffer: (0 - UBO, 1 - SSBO)
+     *   - type of buffer: (0 - UBO, 1 - SSBO, 2 - dynamic UBO)
      *       INT Type;
      * RETURNS: None.
      */
     VOID Update( vlk_buf *Buffer, UINT BindPoint, UINT_PTR BufSize = 0, UINT_PTR BufOffset = 0, INT Type = 0 );
 
-    /* Update vulkan texture descriptor function.
-     * ARGUMENTS:
-     *   - vulkan image view:
-     *       VkImageView ImageView;
-     *   - vulkan image sampler:
-     *       VkSampler Sampler;
-     *   - bind point:
-     *       UINT BindPoint;
+    /* Apply accumulated descriptor writes function.
+     * Set holds dynamic buffers descriptors (they cannot be updated after
+     * bind), so changed set waits for all frames in flight - GPU is stalled.
+     * Bindings are meant to change only when buffers are created or grow,
+     * per frame data should use dynamic offsets instead.
+     * ARGUMENTS: None.
      * RETURNS: None.
      */
-    VOID TexUpdate( VkImageView ImageView, VkSampler Sampler, UINT BindPoint );
+    VOID Flush( VOID );
     
     /* Bind descriptor function.
-     * ARGUMENTS: None.
+     * ARGUMENTS:
+     *   - dynamic offsets count:
+     *       UINT NumOfOffsets;
+     *   - dynamic offsets (in binding order):
+     *       const UINT32 *Offsets;
      * RETURNS: None.
      */
-    VOID Bind( VOID );
+    VOID Bind( UINT NumOfOffsets = 0, const UINT32 *Offsets = nullptr );
 
   }; /* End of 'vlk_descriptor' function */
 
@@ -340,6 +467,12 @@ namespace pivk
     std::map<INT, vlk_descriptor> Stock;
     UINT_PTR StockSize;
     vlk &VlkCore;
+    std::array<UINT32, 4> DynamicOffsets {}; // Dynamic offsets of camera, sync, materials and primitives buffers (in binding order)
+    VkDescriptorSet TexDescriptorSet {};     // Textures array descriptor set (set 1, indexed by 'texture::TexIndex')
+    UINT32
+      TexMaxCount = 4096,                    // Textures array size (clamped by device limit)
+      TexCount = 0;                          // Number of allocated textures array slots
+    std::vector<INT> TexFreeSlots;           // Released textures array slots (reused before new ones)
 
     /* Descriptor manager constructor
      * ARGUMENTS:
@@ -379,19 +512,52 @@ namespace pivk
      */
     VOID UpdateDescriptor( vlk_buf *Buffer, INT BindPoint, INT Type = 0, UINT_PTR BufSize = 0, UINT_PTR BufOffset = 0 );
 
-    /* Update vulkan texture descriptor function.
+    /* Allocate textures array slot function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (INT) slot index (-1 if array is full).
+     */
+    INT TexAllocIndex( VOID );
+
+    /* Release textures array slot function (slot is reused after frames in flight complete).
+     * ARGUMENTS:
+     *   - slot index:
+     *       INT Index;
+     * RETURNS: None.
+     */
+    VOID TexFreeIndex( INT Index );
+
+    /* Update textures array slot function.
      * ARGUMENTS:
-     *   - vulkan descriptor set:
-     *       VkDescriptorSet DescriptorSet;
+     *   - slot index:
+     *       INT Index;
      *   - vulkan image view:
      *       VkImageView ImageView;
      *   - vulkan image sampler:
      *       VkSampler Sampler;
-     *   - bind point:
-     *       UINT BindPoint;
      * RETURNS: None.
      */
-    VOID TexUpdateDescriptor( VkDescriptorSet DescriptorSet, VkImageView ImageView, VkSampler Sampler, UINT BindPoint );
+    VOID TexUpdateDescriptor( INT Index, VkImageView ImageView, VkSampler Sampler );
+
+    /* Reset textures array slot to default texture (slot 0) function.
+     * ARGUMENTS:
+     *   - slot index:
+     *       INT Index;
+     * RETURNS: None.
+     */
+    VOID TexResetDescriptor( INT Index );
+
+    /* Bind textures array descriptor set function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID BindTexDescriptor( VOID );
+
+    /* Apply accumulated descriptor writes function (called before frame recording).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID FlushDescriptors( VOID );
 
     /* Delete vulkan descriptors function.
      * ARGUMENTS: None.
@@ -409,10 +575,549 @@ namespace pivk
 
   }; /* End of 'vlk_descriptor_manager' function */
 
+  /* Vulkan deferred destruction manager class.
+   * Objects freed while recorded or submitted frames may still use them
+   * are destroyed only after GPU completes frame they were freed in.
+   */
+  class vlk_deferred_manager
+  {
+  private:
+    /* Deferred destruction entry structure */
+    struct entry
+    {
+      UINT64 Frame;                        // Frame, after completion of which object is destroyed
+      std::function<VOID( VOID )> Destroy; // Destroy function
+    }; /* End of 'entry' structure */
+
+    // Destruction queue (ordered by frame)
+    std::deque<entry> Queue;
+
+  public:
+    UINT64
+      FrameNo = 1,       // Number of currently recorded frame
+      CompletedNo = 0;   // Number of last frame completed by GPU
+    BOOL IsFrameRecording = FALSE; // Frame 'FrameNo' commands are being recorded flag
+
+    /* Defer object destruction function.
+     * ARGUMENTS:
+     *   - object destroy function:
+     *       std::function<VOID( VOID )> Destroy;
+     * RETURNS: None.
+     */
+    VOID DeferDestroy( std::function<VOID( VOID )> Destroy )
+    {
+      Queue.push_back({FrameNo, std::move(Destroy)});
+    } /* End of 'DeferDestroy' function */
+
+    /* Destroy objects of completed frames function.
+     * ARGUMENTS:
+     *   - number of last frame completed by GPU:
+     *       UINT64 Completed;
+     * RETURNS: None.
+     */
+    VOID DeferredCollect( UINT64 Completed )
+    {
+      if (Completed > CompletedNo)
+        CompletedNo = Completed;
+      while (!Queue.empty() && Queue.front().Frame <= Completed)
+      {
+        entry Entry = std::move(Queue.front());
+
+        Queue.pop_front();
+        Entry.Destroy();
+      }
+    } /* End of 'DeferredCollect' function */
+
+    /* Destroy all deferred objects function (GPU should be idle).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID DeferredFlush( VOID )
+    {
+      DeferredCollect(FrameNo);
+    } /* End of 'DeferredFlush' function */
+  }; /* End of 'vlk_deferred_manager' class */
+
+  /* Vulkan device memory budget manager class.
+   * Tracks memory use per resource class and keeps device local heaps
+   * usage (taken from VMA budget) under budget by evicting resources
+   * through 'OnEvict' callback.
+   */
+  class vlk_memory_manager
+  {
+  private:
+    // Reference to vulkan core
+    vlk &VlkCore;
+
+  public:
+    UINT64 MemClassUsage[static_cast<INT>(mem_class::COUNT)] {}; // Allocated bytes per resource class
+    UINT64 MemBudgetLimit = 0;                                  // Budget limit in bytes (0 - no limit except heaps budget)
+    UINT MemBudgetPercent = 90;                                 // Used part of device local heaps budget (in percents)
+    std::function<UINT64( UINT64 Bytes )> OnEvict;              // Evict resources callback (returns number of freed bytes)
+
+    /* Default constructor */
+    vlk_memory_manager( vlk &NewVlkCore ) : VlkCore(NewVlkCore)
+    {
+    } /* End of 'vlk_memory_manager' function */
+
+    /* Register allocation function.
+     * ARGUMENTS:
+     *   - resource class:
+     *       mem_class Class;
+     *   - allocation:
+     *       VmaAllocation Allocation;
+     * RETURNS: None.
+     */
+    VOID MemAlloc( mem_class Class, VmaAllocation Allocation );
+
+    /* Unregister allocation function.
+     * ARGUMENTS:
+     *   - resource class:
+     *       mem_class Class;
+     *   - allocation:
+     *       VmaAllocation Allocation;
+     * RETURNS: None.
+     */
+    VOID MemFree( mem_class Class, VmaAllocation Allocation );
+
+    /* Get allocation size function.
+     * ARGUMENTS:
+     *   - allocation:
+     *       VmaAllocation Allocation;
+     * RETURNS:
+     *   (UINT64) allocation size in bytes (0 for null allocation).
+     */
+    UINT64 MemSize( VmaAllocation Allocation );
+
+    /* Get device local heaps usage and budget function.
+     * ARGUMENTS:
+     *   - usage and effective budget (with limit and percent applied) in bytes:
+     *       UINT64 &Usage, &Budget;
+     * RETURNS: None.
+     */
+    VOID MemBudget( UINT64 &Usage, UINT64 &Budget );
+
+    /* Evict resources if budget is exceeded function (called once per frame).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID MemUpdate( VOID );
+
+    /* Reclaim memory after failed allocation function.
+     * ARGUMENTS:
+     *   - size of failed allocation in bytes:
+     *       UINT64 Bytes;
+     * RETURNS:
+     *   (BOOL) TRUE if some memory was released and allocation may be retried.
+     */
+    BOOL MemReclaim( UINT64 Bytes );
+  }; /* End of 'vlk_memory_manager' class */
+
+  /* Vulkan per-frame ring allocator class.
+   * One persistently mapped buffer is split into parts for every frame in
+   * flight. Data of recorded frame is linearly allocated in its part, which
+   * is reused only after GPU completes frame, so allocation is pointer bump
+   * and data is bound by dynamic offsets without descriptor writes.
+   */
+  class vlk_ring_manager
+  {
+  private:
+    // Reference to vulkan core
+    vlk &VlkCore;
+
+  public:
+    vlk_buf *RingBuf = nullptr;   // Ring buffer (uniform and storage usage)
+    BYTE *RingData = nullptr;     // Persistently mapped ring memory
+    UINT64
+      RingFrameSize = 1 << 16,    // Size of one frame part in bytes (set before 'Init')
+      RingAlign = 256,            // Allocations alignment (by device limits)
+      RingStart = 0,              // Start of recorded frame part
+      RingOffset = 0,             // First free byte of recorded frame part
+      RingEnd = 0;                // End of recorded frame part
+
+    /* Default constructor */
+    vlk_ring_manager( vlk &NewVlkCore ) : VlkCore(NewVlkCore)
+    {
+    } /* End of 'vlk_ring_manager' function */
+
+    /* Create ring buffer function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID RingCreate( VOID );
+
+    /* Start recorded frame part function (called when frame resources are free).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID RingReset( VOID );
+
+    /* Allocate memory in recorded frame part function.
+     * ARGUMENTS:
+     *   - size in bytes:
+     *       UINT64 Size;
+     *   - dynamic offset of allocation in ring buffer:
+     *       UINT32 &Offset;
+     * RETURNS:
+     *   (VOID *) pointer to mapped memory (nullptr if frame part is full).
+     */
+    VOID * RingAlloc( UINT64 Size, UINT32 &Offset );
+
+    /* Write data to recorded frame part function.
+     * ARGUMENTS:
+     *   - data:
+     *       const VOID *Data;
+     *   - size in bytes:
+     *       UINT64 Size;
+     * RETURNS:
+     *   (UINT32) dynamic offset of data in ring buffer.
+     */
+    UINT32 RingWrite( const VOID *Data, UINT64 Size )
+    {
+      UINT32 Offset;
+
+      if (VOID *Ptr = RingAlloc(Size, Offset); Ptr != nullptr)
+        std::memcpy(Ptr, Data, Size);
+      return Offset;
+    } /* End of 'RingWrite' function */
+
+    /* Write structure to recorded frame part function.
+     * ARGUMENTS:
+     *   - data:
+     *       const data_type &Data;
+     * RETURNS:
+     *   (UINT32) dynamic offset of data in ring buffer.
+     */
+    template<typename data_type>
+      UINT32 RingWrite( const data_type &Data )
+      {
+        return RingWrite(&Data, sizeof(data_type));
+      } /* End of 'RingWrite' function */
+
+    /* Flush written data of recorded frame part function (called before submission).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID RingFlush( VOID );
+  }; /* End of 'vlk_ring_manager' class */
+
+  /* Vulkan asynchronous uploads manager class.
+   * Data of device local buffers and images is copied to staging ring
+   * buffer and transferred by transfer queue (dedicated queue family if
+   * device has one). Copies between 'UploadBegin' and 'UploadEnd' calls
+   * are submitted by one command buffer (outside of batch every upload
+   * is submitted immediately). Every submitted batch has ticket - value
+   * of timeline semaphore, which is signaled when data is ready for
+   * drawing; loaders are not blocked and may wait for ticket if needed.
+   */
+  class vlk_upload_manager
+  {
+  private:
+    // Reference to vulkan core
+    vlk &VlkCore;
+
+    /* Submitted batch structure */
+    struct upload_batch
+    {
+      UINT64 Ticket;              // Batch ticket (timeline semaphores value)
+      VkCommandBuffer Cmd;        // Transfer queue command buffer
+      VkCommandBuffer AcquireCmd; // Command queue ownership acquire command buffer (VK_NULL_HANDLE if not used)
+      UINT64 StagingStart;        // Start of batch data in staging ring
+    }; /* End of 'upload_batch' structure */
+
+    std::deque<upload_batch> UploadBatches;             // Submitted not completed batches (ordered by ticket)
+    VkCommandBuffer UploadCmd {};                       // Recorded batch command buffer (VK_NULL_HANDLE if no copies)
+    std::vector<VkImageMemoryBarrier> AcquireImgs;      // Recorded batch images ownership acquire barriers
+    UINT64 PendingStart = 0;                            // Start of recorded batch data in staging ring
+    INT UploadDepth = 0;                                // Nested batches counter
+
+    /* Allocate staging ring memory function.
+     * ARGUMENTS:
+     *   - size in bytes:
+     *       UINT64 Size;
+     * RETURNS:
+     *   (UINT64) offset in staging buffer (UINT64_MAX if staging buffer is not created).
+     */
+    UINT64 StagingAlloc( UINT64 Size );
+
+    /* Get recorded batch command buffer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (VkCommandBuffer) command buffer in recording state.
+     */
+    VkCommandBuffer UploadRecord( VOID );
+
+  public:
+    VkQueue TransferQueue {};                  // Transfer queue (command queue if no dedicated family)
+    UINT32 TransferFamily = 0;                 // Transfer queue family index
+    BOOL IsTransferFamily = FALSE;             // Dedicated transfer family flag (ownership is transferred)
+    VkCommandPool TransferPool {};             // Transfer queue command pool
+    VkSemaphore UploadSemaphore {};            // Uploaded data is ready for drawing timeline semaphore
+    VkSemaphore TransferSemaphore {};          // Copies completion timeline semaphore (dedicated family only)
+    UINT64
+      UploadTicket = 0,                        // Ticket of last submitted batch
+      UploadCompleted = 0;                     // Ticket of last completed batch (updated by 'UploadCollect')
+    VkBuffer StagingBuffer {};                 // Staging ring buffer
+    VmaAllocation StagingAllocation {};        // Staging buffer allocation
+    BYTE *StagingData = nullptr;               // Persistently mapped staging memory
+    UINT64
+      StagingSize = 0,                         // Staging buffer size in bytes
+      StagingHead = 0,                         // First free byte of staging ring
+      StagingMinSize = 16 << 20;               // Minimal staging buffer size in bytes
+
+    /* Default constructor */
+    vlk_upload_manager( vlk &NewVlkCore ) : VlkCore(NewVlkCore)
+    {
+    } /* End of 'vlk_upload_manager' function */
+
+    /* Create transfer queue objects function (called after device creation).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UploadInit( VOID );
+
+    /* Start uploads batch function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UploadBegin( VOID )
+    {
+      UploadDepth++;
+    } /* End of 'UploadBegin' function */
+
+    /* Finish uploads batch function (submits batch copies).
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) ticket of batch.
+     */
+    UINT64 UploadEnd( VOID )
+    {
+      if (UploadDepth > 0 && --UploadDepth == 0)
+        return UploadSubmit();
+      return UploadCmd != VK_NULL_HANDLE ? UploadTicket + 1 : UploadTicket;
+    } /* End of 'UploadEnd' function */
+
+    /* Upload data to device local buffer function.
+     * ARGUMENTS:
+     *   - destination buffer:
+     *       vlk_buf *Dst;
+     *   - data:
+     *       const VOID *Data;
+     *   - offset in destination buffer (in bytes):
+     *       UINT64 Offset;
+     *   - size of data (in bytes):
+     *       UINT64 Size;
+     * RETURNS:
+     *   (UINT64) ticket of batch with this upload.
+     */
+    UINT64 UploadBuf( vlk_buf *Dst, const VOID *Data, UINT64 Offset, UINT64 Size );
+
+    /* Upload pixels to image function (image is left in shader read only layout).
+     * ARGUMENTS:
+     *   - destination image:
+     *       VkImage Image;
+     *   - image size:
+     *       INT W, H;
+     *   - pixels data:
+     *       const VOID *Data;
+     *   - size of data (in bytes):
+     *       UINT64 Size;
+     * RETURNS:
+     *   (UINT64) ticket of batch with this upload.
+     */
+    UINT64 UploadImage( VkImage Image, INT W, INT H, const VOID *Data, UINT64 Size );
+
+    /* Submit recorded batch function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) ticket of submitted batch.
+     */
+    UINT64 UploadSubmit( VOID );
+
+    /* Release completed batches function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UploadCollect( VOID );
+
+    /* Check upload completion function.
+     * ARGUMENTS:
+     *   - ticket of batch:
+     *       UINT64 Ticket;
+     * RETURNS:
+     *   (BOOL) TRUE if batch data is ready for drawing.
+     */
+    BOOL UploadIsDone( UINT64 Ticket )
+    {
+      if (Ticket > UploadCompleted)
+        UploadCollect();
+      return Ticket <= UploadCompleted;
+    } /* End of 'UploadIsDone' function */
+
+    /* Wait for upload completion function.
+     * ARGUMENTS:
+     *   - ticket of batch:
+     *       UINT64 Ticket;
+     * RETURNS: None.
+     */
+    VOID UploadWait( UINT64 Ticket );
+
+    /* Submit all uploads and wait for completion function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UploadFlush( VOID )
+    {
+      UploadWait(UploadSubmit());
+    } /* End of 'UploadFlush' function */
+
+    /* Free transfer queue objects and staging buffer function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID UploadClose( VOID );
+  }; /* End of 'vlk_upload_manager' class */
+
+  /* Graphics pipeline state key structure.
+   * Key contains all not dynamic pipeline state, fields have no padding
+   * (key is hashed and compared as bytes).
+   */
+  struct pipeline_key
+  {
+    VkShaderModule
+      Vert {},                                        // Vertex shader module
+      Ctrl {},                                        // Tessellation control shader module
+      Eval {},                                        // Tessellation evaluation shader module
+      Geom {},                                        // Geometry shader module
+      Frag {};                                        // Fragment shader module
+    UINT32 VertexStride = 0;                          // Vertex size in bytes
+    UINT32 NumOfAttributes = 0;                       // Number of vertex attributes
+    VkVertexInputAttributeDescription Attributes[8] {}; // Vertex attributes
+    VkPrimitiveTopology Topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST; // Primitive topology
+    UINT32 PatchControlPoints = 1;                    // Number of patch control points
+    VkCullModeFlags CullMode = VK_CULL_MODE_NONE;     // Culled faces
+    VkFrontFace FrontFace = VK_FRONT_FACE_CLOCKWISE;  // Front face orientation
+    VkBool32 BlendEnable = VK_FALSE;                  // Color blending flag
+    VkBlendFactor
+      SrcColorBlend = VK_BLEND_FACTOR_ONE,            // Color source blend factor
+      DstColorBlend = VK_BLEND_FACTOR_ZERO;           // Color destination blend factor
+    VkBlendOp ColorBlendOp = VK_BLEND_OP_ADD;         // Color blend operation
+    VkBlendFactor
+      SrcAlphaBlend = VK_BLEND_FACTOR_ONE,            // Alpha source blend factor
+      DstAlphaBlend = VK_BLEND_FACTOR_ZERO;           // Alpha destination blend factor
+    VkBlendOp AlphaBlendOp = VK_BLEND_OP_ADD;         // Alpha blend operation
+    VkBool32
+      DepthTest = VK_TRUE,                            // Depth test flag
+      DepthWrite = VK_TRUE;                           // Depth write flag
+    VkCompareOp DepthCompareOp = VK_COMPARE_OP_LESS;  // Depth compare operation
+
+    /* Compare keys operator.
+     * ARGUMENTS:
+     *   - key to compare with:
+     *       const pipeline_key &Key;
+     * RETURNS:
+     *   (bool) true if keys are equal.
+     */
+    bool operator==( const pipeline_key &Key ) const
+    {
+      return std::memcmp(this, &Key, sizeof(pipeline_key)) == 0;
+    } /* End of 'operator==' function */
+
+    /* Check shader module usage function.
+     * ARGUMENTS:
+     *   - shader module:
+     *       VkShaderModule Module;
+     * RETURNS:
+     *   (BOOL) TRUE if pipeline uses module.
+     */
+    BOOL IsUsing( VkShaderModule Module ) const
+    {
+      return Module != VK_NULL_HANDLE &&
+        (Vert == Module || Ctrl == Module || Eval == Module || Geom == Module || Frag == Module);
+    } /* End of 'IsUsing' function */
+
+    /* Key hash function object */
+    struct hash
+    {
+      /* Get key hash function (FNV-1a).
+       * ARGUMENTS:
+       *   - key:
+       *       const pipeline_key &Key;
+       * RETURNS:
+       *   (size_t) hash value.
+       */
+      size_t operator()( const pipeline_key &Key ) const
+      {
+        return static_cast<size_t>(HashBytes(&Key, sizeof(pipeline_key)));
+      } /* End of 'operator()' function */
+    }; /* End of 'hash' structure */
+  }; /* End of 'pipeline_key' structure */
+
+  // Key bytes are hashed and compared, so padding (which is not initialized) is not allowed
+  static_assert(std::has_unique_object_representations_v<pipeline_key>, "pipeline key should have no padding");
+
+  /* Vulkan graphics pipelines manager class.
+   * Pipelines are created once for every state key and are shared by
+   * all shaders and materials using same state.
+   */
+  class vlk_pipeline_manager
+  {
+  private:
+    // Reference to vulkan core
+    vlk &VlkCore;
+
+    // Created pipelines table
+    std::unordered_map<pipeline_key, VkPipeline, pipeline_key::hash> Pipelines;
+
+  public:
+    VkPipeline BoundPipeline {}; // Pipeline bound in recorded frame (VK_NULL_HANDLE at frame start)
+
+    /* Default constructor */
+    vlk_pipeline_manager( vlk &NewVlkCore ) : VlkCore(NewVlkCore)
+    {
+    } /* End of 'vlk_pipeline_manager' function */
+
+    /* Get pipeline for state key function (creates pipeline at first request).
+     * ARGUMENTS:
+     *   - pipeline state key:
+     *       const pipeline_key &Key;
+     * RETURNS:
+     *   (VkPipeline) pipeline (VK_NULL_HANDLE if it is not created).
+     */
+    VkPipeline PipelineGet( const pipeline_key &Key );
+
+    /* Free pipelines using shader module function (called before module destruction).
+     * ARGUMENTS:
+     *   - shader module:
+     *       VkShaderModule Module;
+     * RETURNS: None.
+     */
+    VOID PipelinesFree( VkShaderModule Module );
+
+    /* Free all pipelines function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID PipelinesFree( VOID );
+
+    /* Bind pipeline to recorded frame function (same pipeline is not rebound).
+     * ARGUMENTS:
+     *   - pipeline:
+     *       VkPipeline Pipeline;
+     * RETURNS: None.
+     */
+    VOID BindPipeline( VkPipeline Pipeline );
+  }; /* End of 'vlk_pipeline_manager' class */
+
   /* Vulkan core class */
   class vlk : 
     public vlk_buf_manager,
-    public vlk_descriptor_manager
+    public vlk_descriptor_manager,
+    public vlk_deferred_manager,
+    public vlk_memory_manager,
+    public vlk_ring_manager,
+    public vlk_upload_manager,
+    public vlk_pipeline_manager
   {
   public:
     HWND &hWndRef;                                  // Reference to hwnd
@@ -430,6 +1135,8 @@ namespace pivk
       SwapchainImages;                              // Vulkan swapchain images
     std::vector<VkImageView>
       SwapchainImageViews;                          // Vulkan swapchain image views
+    std::vector<VkSemaphore>
+      RenderFinished;                               // Swapchain image rendering finished semaphores (presentation waits)
     VkImage DepthImage{};                           // Vulkan depth image
     VkImageView DepthImageView{};                   // Vulkan depth image view
     VmaAllocation DepthAllocation{};                // AMD VMA depth image allocation
@@ -437,18 +1144,39 @@ namespace pivk
     std::vector<VkFramebuffer>
       FrameBuffers;                                 // Array with vulkan frame buffers.
     VkQueue CommandQueue{};                         // Vulkan command queue
+    UINT32 CommandFamily = 0;                       // Vulkan command queue family index
     VkCommandPool CommandPool{};                    // Vulkan command pool
-    VkCommandBuffer CommandBuffer{};                // Vulkan command buffer
-    VkFence Fence{};                                // Vulkan fence
+    VkCommandBuffer CommandBuffer{};                // Vulkan command buffer of currently recorded frame
+    VkFence Fence{};                                // Vulkan fence (one time submissions)
     UINT32 CurImgIdx{};                             // Vulkan current drawing image
     VkViewport Viewport{};                          // Vulkan viewport
     VkRect2D Scissor{};                             // Vulkan scissor
     VkPipelineLayout PipelineLayout{};              // Vulkan pipeline layout
+    VkPipelineCache PipelineCache{};                // Vulkan pipeline cache (kept between launches)
+    std::string PipelineCacheFileName
+      {"bin/cache/pipeline.bin"};                   // Pipeline cache file name
     VkDescriptorPool DescriptorPool{};              // Vulkan descriptor pool
+    VkDescriptorPool TexDescriptorPool{};           // Vulkan textures array descriptor pool (update after bind)
     VkDescriptorSetLayout DescriptorSetLayout{};    // Vulkan descriptor set layout
-    VkDescriptorSetLayout TexDescriptorSetLayout{}; // Vulkan texture descriptor set layout
+    VkDescriptorUpdateTemplate
+      DescriptorUpdateTemplate{};                   // Vulkan descriptor set update template (whole set by one call)
+    VkDescriptorSetLayout TexDescriptorSetLayout{}; // Vulkan textures array descriptor set layout
     UINT CountOfDescriptorSets = 0;                 // Count of descriptors
 
+    /* Frame in flight resources structure */
+    struct frame
+    {
+      VkCommandPool CommandPool {};     // Frame command pool
+      VkCommandBuffer CommandBuffer {}; // Frame command buffer
+      VkSemaphore ImageAvailable {};    // Swapchain image acquired semaphore
+      VkFence Fence {};                 // Frame execution completed fence
+      UINT64 FrameNo = 0;               // Number of last frame submitted with these resources
+    };
+
+    std::vector<frame> Frames;                      // Frames in flight resources
+    UINT FramesInFlight = 2;                        // Number of frames in flight (set before 'Init')
+    UINT FrameIdx = 0;                              // Index of currently recorded frame resources
+
     /* Queue family indices */
     struct queue_family_indices
     {
@@ -462,7 +1190,8 @@ namespace pivk
      *       HWND hWnd;
      */
     vlk( HWND &hWnd ) :
-      hWndRef(hWnd), vlk_buf_manager(*this), vlk_descriptor_manager(*this)
+      hWndRef(hWnd), vlk_buf_manager(*this), vlk_descriptor_manager(*this), vlk_memory_manager(*this),
+      vlk_ring_manager(*this), vlk_upload_manager(*this), vlk_pipeline_manager(*this)
     {
     } /* End of 'vlk' function */
 
@@ -534,11 +1263,17 @@ namespace pivk
      */
     queue_family_indices GetQueueFamilyIndices( VOID );
 
-    /* Create command buffer function.
+    /* Create frames in flight command buffers and synchronization objects function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID CreateFrames( VOID );
+
+    /* Destroy frames in flight resources function.
      * ARGUMENTS: None.
      * RETURNS: None.
      */
-    VOID CreateCommandBuffer( VOID );
+    VOID DestroyFrames( VOID );
 
     /* Create command queue function.
      * ARGUMENTS: None.
@@ -558,6 +1293,18 @@ namespace pivk
      */
     VOID CreatePipelineLayout( VOID );
 
+    /* Create vulkan pipeline cache function (loads data saved by previous launch).
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID CreatePipelineCache( VOID );
+
+    /* Save and destroy vulkan pipeline cache function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID DestroyPipelineCache( VOID );
+
     /* Begin render pass function.
      * ARGUMENTS: None.
      * RETURNS: None.
@@ -603,6 +1350,20 @@ namespace pivk
      */
     VOID RenderEnd( VOID );
 
+    /* Wait for all submitted frames completion function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID FramesWait( VOID );
+
+    /* Wait for submitted frames completion up to frame number function.
+     * ARGUMENTS:
+     *   - number of last frame to wait:
+     *       UINT64 No;
+     * RETURNS: None.
+     */
+    VOID FramesWait( UINT64 No );
+
     //================================
     //
     //  Images block
@@ -635,13 +1396,15 @@ namespace pivk
      *       UINT PixelsDataSize;
      *   - number of mipmaps to be create:
      *       UINT MipCount;
+     *   - pixels upload ticket output pointer (see 'vlk_upload_manager', may be nullptr):
+     *       UINT64 *Ticket;
      * RETURNS:
      *   (BOOL) success creation result.
      */
     BOOL ImageCreate( VkImage &Image, VkImageView &ImageView, VmaAllocation &Allocation,
                       INT W, INT H, BOOL IsColor, BOOL IsCube,
                       VkFormat Format, VkImageUsageFlags UsageFlags, VkImageLayout Layout,
-                      const VOID *PixelsData, UINT PixelsDataSize, UINT MipCount );
+                      const VOID *PixelsData, UINT PixelsDataSize, UINT MipCount, UINT64 *Ticket = nullptr );
 
     /* Vulkan image free function.
      * ARGUMENTS:
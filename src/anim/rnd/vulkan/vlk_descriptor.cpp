@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_descriptor.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 30.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan descriptor file.
  * NOTE:        None.
  * 
@@ -25,18 +25,18 @@ namespace pivk
   VOID vlk::CreateDescriptors( VOID )
   {
     /* Declare descriptor layouts bindings */
-    // 0 - camera buffer          | UBO
-    // 1 - synchronization buffer | UBO
-    // 2 - primitives buffer      | SSBO (temp one prim, UBO)
-    // 3 - materials buffer       | SSBO (temp one mtl, UBO)
-    // 4 - texture buffer 
+    // 0 - camera buffer          | UBO (dynamic, in ring buffer)
+    // 1 - synchronization buffer | UBO (dynamic, in ring buffer)
+    // 2 - materials buffer       | SSBO (dynamic, copy of recorded frame)
+    // 3 - primitives buffer      | SSBO (dynamic, copy of recorded frame)
+    // Set 1: 0 - textures array  | combined image samplers (indexed by material texture ids)
 
     VkDescriptorSetLayoutBinding DescriptorSetLayoutBindings[]
     {
       /* Camera Buffer */
       {
-        .binding = 0,                                        // Number of binding on shader
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, // Object type.
+        .binding = 0,                                                // Number of binding on shader
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, // Object type (offset is set on bind).
         .descriptorCount = 1,                                // Count in array (may be binding
                                                              // some objects at once).
                                                              // For VK_DESCRIPTOR_TYPE_INLINE_UNIFORM_BLOCK -
@@ -49,23 +49,23 @@ namespace pivk
       /* Synchronization buffer */
       {
         .binding = 1,
-        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
         .descriptorCount = 1,
         .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
         .pImmutableSamplers = nullptr,
       },
-      /* Primitives buffer */
+      /* Materials buffer */
       {
         .binding = 2,
-        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
         .descriptorCount = 1,
         .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
         .pImmutableSamplers = nullptr,
       },
-      /* Materials buffer */
+      /* Primitives buffer */
       {
         .binding = 3,
-        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+        .descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
         .descriptorCount = 1,
         .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
         .pImmutableSamplers = nullptr,
@@ -88,81 +88,89 @@ namespace pivk
       throw;
     }
 
+    /* Create set update template (whole set is written by one call from 'vlk_descriptor::Written' array) */
+    constexpr UINT32 NumOfBindings = sizeof(DescriptorSetLayoutBindings) / sizeof(DescriptorSetLayoutBindings[0]);
+    static_assert(NumOfBindings == std::tuple_size_v<decltype(vlk_descriptor::Written)>, "Written buffers array should cover all bindings");
+    VkDescriptorUpdateTemplateEntry TemplateEntries[NumOfBindings];
+
+    for (UINT32 i = 0; i < NumOfBindings; i++)
+      TemplateEntries[i] =
+      {
+        .dstBinding = DescriptorSetLayoutBindings[i].binding,                              // Descriptor's binding.
+        .dstArrayElement = 0,                                                              // Zero element in array.
+        .descriptorCount = 1,                                                              // Count of descriptors.
+        .descriptorType = DescriptorSetLayoutBindings[i].descriptorType,                   // Descriptor type.
+        .offset = DescriptorSetLayoutBindings[i].binding * sizeof(VkDescriptorBufferInfo), // Offset of buffer info in data.
+        .stride = sizeof(VkDescriptorBufferInfo),                                          // Buffer infos stride.
+      };
+
+    VkDescriptorUpdateTemplateCreateInfo TemplateCreateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO,
+      .descriptorUpdateEntryCount = NumOfBindings,
+      .pDescriptorUpdateEntries = TemplateEntries,
+      .templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_DESCRIPTOR_SET,
+      .descriptorSetLayout = DescriptorSetLayout,
+    };
+
+    if (vkCreateDescriptorUpdateTemplate(Device, &TemplateCreateInfo, nullptr, &DescriptorUpdateTemplate) != VK_SUCCESS)
+    {
+      throw;
+    }
+
+
+    /* Textures array size is limited by device (array is bound once, texture index is stored in material) */
+    VkPhysicalDeviceVulkan12Properties Vulkan12Properties
+    {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES,
+    };
+    VkPhysicalDeviceProperties2 Properties2
+    {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+      .pNext = &Vulkan12Properties,
+    };
+
+    vkGetPhysicalDeviceProperties2(PhysDevice, &Properties2);
+    if (TexMaxCount > Vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages)
+      TexMaxCount = Vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages;
+    if (TexMaxCount > Vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages)
+      TexMaxCount = Vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages;
 
     VkDescriptorSetLayoutBinding TexDescriptorSetLayoutBindings[]
     {
-      /* Base texture binding */
+      /* Textures array binding */
       {
         .binding = 0,
         .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 1,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 2,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 3,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 4,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 5,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 6,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 7,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
-        .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
-        .pImmutableSamplers = nullptr,
-      },
-      {
-        .binding = 8,
-        .descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-        .descriptorCount = 1,
+        .descriptorCount = TexMaxCount,
         .stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS,
         .pImmutableSamplers = nullptr,
       },
     };
 
+    // Not written slots are never read, slots of not used textures are rewritten while frames are in flight
+    VkDescriptorBindingFlags TexBindingFlags[]
+    {
+      VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT |
+      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT |
+      VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT |
+      VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT,
+    };
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfo TexBindingFlagsCreateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+      .bindingCount = (UINT32)std::size(TexBindingFlags),
+      .pBindingFlags = TexBindingFlags,
+    };
+
     VkDescriptorSetLayoutCreateInfo TexDescriptorSetLayoutCreateInfo
     {
-      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,      // Structure type.
-      .flags = 0,                                                        // Flags.
-      .bindingCount = (UINT32)std::size(TexDescriptorSetLayoutBindings), // Count of bindings.
-      .pBindings = TexDescriptorSetLayoutBindings,                       // Pointer to first.
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,        // Structure type.
+      .pNext = &TexBindingFlagsCreateInfo,                                 // Binding flags.
+      .flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT, // Flags.
+      .bindingCount = (UINT32)std::size(TexDescriptorSetLayoutBindings),   // Count of bindings.
+      .pBindings = TexDescriptorSetLayoutBindings,                         // Pointer to first.
     };
 
     if (vkCreateDescriptorSetLayout(Device,
@@ -174,23 +182,21 @@ namespace pivk
     }
 
     /* Create descriptor pool */
-    std::array<VkDescriptorPoolSize, 5> PoolSizes {};
+    std::array<VkDescriptorPoolSize, 4> PoolSizes {};
   
-    PoolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;         // Descriptor type.
+    PoolSizes[0].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; // Descriptor type.
     PoolSizes[0].descriptorCount = 1;                              // Count of descriptor sizes.
-    PoolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;         // Descriptor type.
+    PoolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; // Descriptor type.
     PoolSizes[1].descriptorCount = 1;                              // Count of descriptor sizes.
-    PoolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;         // Descriptor type.
+    PoolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC; // Descriptor type.
     PoolSizes[2].descriptorCount = 1;                              // Count of descriptor sizes.
-    PoolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;         // Descriptor type.
+    PoolSizes[3].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC; // Descriptor type.
     PoolSizes[3].descriptorCount = 1;                              // Count of descriptor sizes.
-    PoolSizes[4].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; // Descriptor type.
-    PoolSizes[4].descriptorCount = 10000;                          // Count of descriptor sizes.
 
     VkDescriptorPoolCreateInfo PoolCreateInfo
     {
       .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
-      .maxSets = 20000,                        // Maximal count descriptor sets, which may be created.
+      .maxSets = 1,                            // Maximal count descriptor sets, which may be created.
       .poolSizeCount = (UINT)PoolSizes.size(), // Count of descriptor sizes.
       .pPoolSizes = PoolSizes.data(),          // Descriptor sizes.
     };
@@ -199,6 +205,27 @@ namespace pivk
     {
       throw;
     }
+
+    /* Create textures array descriptor pool (update after bind sets are allocated only from such pools) */
+    VkDescriptorPoolSize TexPoolSize
+    {
+      .type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+      .descriptorCount = TexMaxCount,
+    };
+
+    VkDescriptorPoolCreateInfo TexPoolCreateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
+      .flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT,
+      .maxSets = 1,
+      .poolSizeCount = 1,
+      .pPoolSizes = &TexPoolSize,
+    };
+
+    if (vkCreateDescriptorPool(Device, &TexPoolCreateInfo, nullptr, &TexDescriptorPool) != VK_SUCCESS)
+    {
+      throw;
+    }
   } /* End of 'vlk::CreateDescriptors' function */
 
   /* Create vulkan descriptor function.
@@ -223,12 +250,16 @@ namespace pivk
   } /* End of 'vlk_descriptor::Free' function */
 
   /* Bind descriptor function.
-   * ARGUMENTS: None.
+   * ARGUMENTS:
+   *   - dynamic offsets count:
+   *       UINT NumOfOffsets;
+   *   - dynamic offsets (in binding order):
+   *       const UINT32 *Offsets;
    * RETURNS: None.
    */
-  VOID vlk_descriptor::Bind( VOID )
+  VOID vlk_descriptor::Bind( UINT NumOfOffsets, const UINT32 *Offsets )
   {
-    vkCmdBindDescriptorSets(VlkCore->CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VlkCore->PipelineLayout, 0, 1, &DescriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(VlkCore->CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VlkCore->PipelineLayout, 0, 1, &DescriptorSet, NumOfOffsets, Offsets);
   } /* End of 'vlk_descriptor::Bind' function */
 
   /* Update vulkan descriptor function.
@@ -241,7 +272,7 @@ namespace pivk
    *       UINT_PTR BufSize;
    *   - offset of buffer:
    *       UINT_PTR BufOffset;
-   *   - type of buffer: (0 - UBO, 1 - SSBO)
+   *   - type of buffer: (0 - UBO, 1 - SSBO, 2 - dynamic UBO, 3 - dynamic SSBO)
    *       INT Type;
    * RETURNS: None.
    */
@@ -269,72 +300,139 @@ namespace pivk
       .range = BufSize == 0 ? Buffer->Size : BufSize, // Buffer size.
     };
 
-    std::array<VkWriteDescriptorSet, 1> DescriptorWrites {};
-    
-    DescriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;     // Structure type
-    DescriptorWrites[0].dstSet = DescriptorSet;                             // Set, which need to update.
-    DescriptorWrites[0].dstBinding = BindPoint;                             // Descriptor's binding.
-    DescriptorWrites[0].dstArrayElement = 0;                                // Zero element in array.
-    DescriptorWrites[0].descriptorType = Type == 0 ?                        // Descriptor type:
-      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :                                   // 0 - UBO
-      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;                                    // 1 - SSBO
-    DescriptorWrites[0].descriptorCount = 1;                                // Count of descriptors for update.
-    DescriptorWrites[0].pBufferInfo = &BufferInfo;                          // Pointer to array buffer info.
-    
-    vkUpdateDescriptorSets(VlkCore->Device,
-                           (UINT)DescriptorWrites.size(), // Count of descriptor write structures.
-                           DescriptorWrites.data(),       // Self descriptor write.
-                           0, nullptr);
+    if (BindPoint >= Written.size())
+      return;
+
+    // Same buffer is already written - set is not changed
+    if (Written[BindPoint].buffer == BufferInfo.buffer &&
+        Written[BindPoint].offset == BufferInfo.offset &&
+        Written[BindPoint].range == BufferInfo.range)
+      return;
+
+    Written[BindPoint] = BufferInfo;
+    WrittenTypes[BindPoint] = Type == 0 ?                     // Descriptor type:
+      VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER :                     // 0 - UBO
+      Type == 1 ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER :         // 1 - SSBO
+      Type == 2 ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC : // 2 - dynamic UBO
+      VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;              // 3 - dynamic SSBO
+    DirtyMask |= 1U << BindPoint;
   } /* End of 'vlk_descriptor::Update' function */
 
-  /* Update vulkan texture descriptor function.
-   * ARGUMENTS:
-   *   - vulkan image view:
-   *       VkImageView ImageView;
-   *   - vulkan image sampler:
-   *       VkSampler Sampler;
-   *   - bind point:
-   *       UINT BindPoint;
+  /* Apply accumulated descriptor writes function.
+   * Set holds dynamic buffers descriptors (they cannot be updated after
+   * bind), so changed set waits for all frames in flight - GPU is stalled.
+   * Bindings are meant to change only when buffers are created or grow,
+   * per frame data should use dynamic offsets instead.
+   * ARGUMENTS: None.
    * RETURNS: None.
    */
-  VOID vlk_descriptor::TexUpdate( VkImageView ImageView, VkSampler Sampler, UINT BindPoint )
+  VOID vlk_descriptor::Flush( VOID )
   {
-    VkDescriptorImageInfo ImageInfo {};
+    if (DirtyMask == 0)
+      return;
 
-    ImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    ImageInfo.imageView = ImageView;
-    ImageInfo.sampler = Sampler;
+    // Set should not be updated while it is used by submitted frames
+    VlkCore->FramesWait();
 
-    std::array<VkWriteDescriptorSet, 1> DescriptorWrites {};
+    BOOL IsComplete = TRUE;
 
-    DescriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    DescriptorWrites[0].dstSet = DescriptorSet;                                     // Set, which need to update.
-    DescriptorWrites[0].dstBinding = BindPoint;                                     // Descriptor's binding.
-    DescriptorWrites[0].dstArrayElement = 0;                                        // Zero element in array.
-    DescriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; // Descriptor type - we have image sampler.
-    DescriptorWrites[0].descriptorCount = 1;                                        // Count of descriptors for update.
-    DescriptorWrites[0].pImageInfo = &ImageInfo;                                    // Pointer to array image info.
+    for (auto &Info : Written)
+      if (Info.buffer == VK_NULL_HANDLE)
+        IsComplete = FALSE;
 
-    vkUpdateDescriptorSets(VlkCore->Device,
-                           (UINT32)DescriptorWrites.size(), // Coutn of descriptor write structures.
-                           DescriptorWrites.data(),       // Self descriptor write.
-                           0, nullptr);
-  } /* End of 'vlk_descriptor::TexUpdate' function */
+    if (IsComplete && VlkCore->DescriptorUpdateTemplate != VK_NULL_HANDLE)
+      // All bindings have buffers - whole set is written from array
+      vkUpdateDescriptorSetWithTemplate(VlkCore->Device, DescriptorSet, VlkCore->DescriptorUpdateTemplate, Written.data());
+    else
+    {
+      // Not written bindings should not be touched - only changed ones are written
+      std::array<VkWriteDescriptorSet, std::tuple_size_v<decltype(Written)>> DescriptorWrites {};
+      UINT32 NumOfWrites = 0;
+
+      for (UINT32 i = 0; i < Written.size(); i++)
+        if (DirtyMask & (1U << i))
+          DescriptorWrites[NumOfWrites++] =
+          {
+            .sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, // Structure type
+            .dstSet = DescriptorSet,                         // Set, which need to update.
+            .dstBinding = i,                                 // Descriptor's binding.
+            .dstArrayElement = 0,                            // Zero element in array.
+            .descriptorCount = 1,                            // Count of descriptors for update.
+            .descriptorType = WrittenTypes[i],               // Descriptor type.
+            .pBufferInfo = &Written[i],                      // Pointer to buffer info.
+          };
+
+      vkUpdateDescriptorSets(VlkCore->Device,
+                             NumOfWrites,             // Count of descriptor write structures.
+                             DescriptorWrites.data(), // Descriptor writes.
+                             0, nullptr);
+    }
+    DirtyMask = 0;
+  } /* End of 'vlk_descriptor::Flush' function */
 
-  /* Update vulkan texture descriptor function.
+  /* Allocate textures array slot function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (INT) slot index (-1 if array is full).
+   */
+  INT vlk_descriptor_manager::TexAllocIndex( VOID )
+  {
+    if (!TexFreeSlots.empty())
+    {
+      INT Index = TexFreeSlots.back();
+
+      TexFreeSlots.pop_back();
+      return Index;
+    }
+    if (TexCount >= TexMaxCount)
+    {
+#if _DEBUG
+      MessageLog(std::format("Textures array of {} slots is full\n", TexMaxCount), 2);
+#endif // _DEBUG
+      return -1;
+    }
+    return static_cast<INT>(TexCount++);
+  } /* End of 'vlk_descriptor_manager::TexAllocIndex' function */
+
+  /* Release textures array slot function (slot is reused after frames in flight complete).
    * ARGUMENTS:
-   *   - vulkan descriptor set:
-   *       VkDescriptorSet DescriptorSet;
+   *   - slot index:
+   *       INT Index;
+   * RETURNS: None.
+   */
+  VOID vlk_descriptor_manager::TexFreeIndex( INT Index )
+  {
+    // Default texture slot is never released
+    if (Index <= 0)
+      return;
+
+    // Frames in flight may still sample slot, so it is reset and reused after them
+    VlkCore.DeferDestroy([this, Index]( VOID )
+      {
+        // Slots allocated before textures array recreation are dropped
+        if (static_cast<UINT32>(Index) < TexCount)
+        {
+          TexResetDescriptor(Index);
+          TexFreeSlots.push_back(Index);
+        }
+      });
+  } /* End of 'vlk_descriptor_manager::TexFreeIndex' function */
+
+  /* Update textures array slot function.
+   * ARGUMENTS:
+   *   - slot index:
+   *       INT Index;
    *   - vulkan image view:
    *       VkImageView ImageView;
    *   - vulkan image sampler:
    *       VkSampler Sampler;
-   *   - bind point:
-   *       UINT BindPoint;
    * RETURNS: None.
    */
-  VOID vlk_descriptor_manager::TexUpdateDescriptor( VkDescriptorSet DescriptorSet, VkImageView ImageView, VkSampler Sampler, UINT BindPoint )
+  VOID vlk_descriptor_manager::TexUpdateDescriptor( INT Index, VkImageView ImageView, VkSampler Sampler )
   {
+    if (Index < 0 || TexDescriptorSet == VK_NULL_HANDLE)
+      return;
+
     VkDescriptorImageInfo ImageInfo {};
 
     ImageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
@@ -344,9 +442,9 @@ namespace pivk
     std::array<VkWriteDescriptorSet, 1> DescriptorWrites {};
 
     DescriptorWrites[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    DescriptorWrites[0].dstSet = DescriptorSet;                                     // Set, which need to update.
-    DescriptorWrites[0].dstBinding = BindPoint;                                     // Descriptor's binding.
-    DescriptorWrites[0].dstArrayElement = 0;                                        // Zero element in array.
+    DescriptorWrites[0].dstSet = TexDescriptorSet;                                  // Set, which need to update.
+    DescriptorWrites[0].dstBinding = 0;                                             // Descriptor's binding.
+    DescriptorWrites[0].dstArrayElement = Index;                                    // Texture slot in array.
     DescriptorWrites[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; // Descriptor type - we have image sampler.
     DescriptorWrites[0].descriptorCount = 1;                                        // Count of descriptors for update.
     DescriptorWrites[0].pImageInfo = &ImageInfo;                                    // Pointer to array image info.
@@ -357,6 +455,34 @@ namespace pivk
                            0, nullptr);
   } /* End of 'vlk_descriptor_manager::TexUpdateDescriptor' function */
 
+  /* Reset textures array slot to default texture (slot 0) function.
+   * ARGUMENTS:
+   *   - slot index:
+   *       INT Index;
+   * RETURNS: None.
+   */
+  VOID vlk_descriptor_manager::TexResetDescriptor( INT Index )
+  {
+    // Materials still refer to slot, so it should stay valid after image is freed
+    if (Index <= 0 || TexDescriptorSet == VK_NULL_HANDLE)
+      return;
+
+    VkCopyDescriptorSet Copy
+    {
+      .sType = VK_STRUCTURE_TYPE_COPY_DESCRIPTOR_SET,
+      .srcSet = TexDescriptorSet,
+      .srcBinding = 0,
+      .srcArrayElement = 0,
+      .dstSet = TexDescriptorSet,
+      .dstBinding = 0,
+      .dstArrayElement = static_cast<UINT32>(Index),
+      .descriptorCount = 1,
+    };
+
+    vkUpdateDescriptorSets(VlkCore.Device, 0, nullptr, 1, &Copy);
+  } /* End of 'vlk_descriptor_manager::TexResetDescriptor' function */
+
+
   /* Init descriptors function.
    * ARGUMENTS: None.
    * RETURNS: None.
@@ -377,12 +503,40 @@ namespace pivk
 
     if (VkResult res; (res = vkAllocateDescriptorSets(VlkCore.Device, &AllocInfo, DescriptorSets.data())) != VK_SUCCESS) 
     {
-      std::cout << res;
-      throw; // std::runtime_error("failed to allocate descriptor sets!");
+#if _DEBUG
+      MessageLog(std::format("Buffers descriptor set is not allocated (error {})\n", static_cast<INT>(res)), 2);
+#endif // _DEBUG
+      throw std::runtime_error("failed to allocate buffers descriptor set!");
     }
 
     for (INT i = 0; i < 1; ++i)
       this->Stock[StockSize++] = vlk_descriptor(&VlkCore).Create(DescriptorSets[i]);
+
+    /* Allocate textures array set (whole array is allocated, slots are written at texture creation) */
+    VkDescriptorSetVariableDescriptorCountAllocateInfo TexCountInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO,
+      .descriptorSetCount = 1,
+      .pDescriptorCounts = &TexMaxCount,
+    };
+    VkDescriptorSetAllocateInfo TexAllocInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+      .pNext = &TexCountInfo,
+      .descriptorPool = VlkCore.TexDescriptorPool,
+      .descriptorSetCount = 1,
+      .pSetLayouts = &VlkCore.TexDescriptorSetLayout,
+    };
+
+    if (VkResult res; (res = vkAllocateDescriptorSets(VlkCore.Device, &TexAllocInfo, &TexDescriptorSet)) != VK_SUCCESS) 
+    {
+#if _DEBUG
+      MessageLog(std::format("Textures array descriptor set of {} slots is not allocated (error {})\n", TexMaxCount, static_cast<INT>(res)), 2);
+#endif // _DEBUG
+      throw std::runtime_error("failed to allocate textures array descriptor set!");
+    }
+    TexCount = 0;
+    TexFreeSlots.clear();
   } /* End of 'vlk_descriptor_manager::CreateDescriptors' function */
 
   /* Update vulkan descriptor function.
@@ -411,6 +565,16 @@ namespace pivk
     this->Stock[0].Update(Buffer, BindPoint, BufSize, BufOffset, Type);
   } /* End of 'vlk_descriptor_manager::UpdateDescriptor' function */
 
+  /* Apply accumulated descriptor writes function (called before frame recording).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_descriptor_manager::FlushDescriptors( VOID )
+  {
+    for (auto &i : Stock)
+      i.second.Flush();
+  } /* End of 'vlk_descriptor_manager::FlushDescriptors' function */
+
   /* Delete vulkan descriptors function.
    * ARGUMENTS: None.
    * RETURNS: None.
@@ -425,6 +589,10 @@ namespace pivk
 
     Stock.clear();
     StockSize = 0;
+    // Textures array set is freed with its pool
+    TexDescriptorSet = VK_NULL_HANDLE;
+    TexCount = 0;
+    TexFreeSlots.clear();
   } /* End of 'vlk_descriptor_manager::FreeDescriptors' function */
 
   /* Bind descriptor function.
@@ -442,10 +610,22 @@ namespace pivk
       return;
     }
 
-    this->Stock[0].Bind();
+    this->Stock[0].Bind(static_cast<UINT>(DynamicOffsets.size()), DynamicOffsets.data());
     //this->Stock[BindPoint].Update(Buffer, BufSize, BufOffset);
   } /* End of 'vlk_descriptor_manager::BindDescriptor' function */
 
+  /* Bind textures array descriptor set function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_descriptor_manager::BindTexDescriptor( VOID )
+  {
+    if (TexDescriptorSet == VK_NULL_HANDLE)
+      return;
+
+    vkCmdBindDescriptorSets(VlkCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, VlkCore.PipelineLayout, 1, 1, &TexDescriptorSet, 0, nullptr);
+  } /* End of 'vlk_descriptor_manager::BindTexDescriptor' function */
+
 } /* End of 'pivk' namespace */
 
 /* END OF 'vlk_descriptor.cpp' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_device.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 28.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan core device file.
  * NOTE:        None.
  * 
@@ -37,16 +37,46 @@ namespace pivk
     for (auto& i : QueuePriorities)
       i = 1.f;
 
-    VkDeviceQueueCreateInfo QueueInfo
+    std::vector<VkQueueFamilyProperties> QueueFamilyProperties(QueueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(PhysDevice, &QueueFamilyCount, QueueFamilyProperties.data());
+
+    // Uploads use transfer only family (or at least not graphics one) if device has it
+    INT TransferScore = 0;
+
+    for (UINT32 i = 0; i < QueueFamilyCount; i++)
     {
-      .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
-      .pNext = nullptr,
-      .flags = 0,
-      .queueFamilyIndex = 0,
-      //.queueCount = 1,
-      .queueCount = QueueFamilyCount,
-      .pQueuePriorities = QueuePriorities.data(),
-    };
+      VkQueueFlags Flags = QueueFamilyProperties[i].queueFlags;
+
+      if (i == CommandFamily || (Flags & VK_QUEUE_TRANSFER_BIT) == 0 || (Flags & VK_QUEUE_GRAPHICS_BIT) != 0)
+        continue;
+      if (INT Score = (Flags & VK_QUEUE_COMPUTE_BIT) != 0 ? 1 : 2; Score > TransferScore)
+      {
+        TransferScore = Score;
+        TransferFamily = i;
+      }
+    }
+    IsTransferFamily = TransferScore > 0;
+
+    std::array<VkDeviceQueueCreateInfo, 2> QueueInfos
+    {{
+      {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .queueFamilyIndex = CommandFamily,
+        //.queueCount = 1,
+        .queueCount = QueueFamilyCount,
+        .pQueuePriorities = QueuePriorities.data(),
+      },
+      {
+        .sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+        .pNext = nullptr,
+        .flags = 0,
+        .queueFamilyIndex = TransferFamily,
+        .queueCount = 1,
+        .pQueuePriorities = QueuePriorities.data(),
+      },
+    }};
 
     // Set extenstions of logical device.
     std::vector<const CHAR *> ExtensionNames
@@ -56,12 +86,43 @@ namespace pivk
       VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME,
     };
 
+    // Enable real heaps budget queries if supported (otherwise VMA estimates budget)
+    UINT32 AvailableCount = 0;
+    BOOL IsMemoryBudget = FALSE;
+
+    vkEnumerateDeviceExtensionProperties(PhysDevice, nullptr, &AvailableCount, nullptr);
+    std::vector<VkExtensionProperties> Available(AvailableCount);
+    vkEnumerateDeviceExtensionProperties(PhysDevice, nullptr, &AvailableCount, Available.data());
+    for (auto &Ext : Available)
+      if (std::strcmp(Ext.extensionName, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) == 0)
+      {
+        ExtensionNames.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        IsMemoryBudget = TRUE;
+        break;
+      }
+
     VkPhysicalDeviceExtendedDynamicState3FeaturesEXT PhysicalDeviceExtendedDynamicState3Features
     {
       .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT,
       .extendedDynamicState3PolygonMode = VK_TRUE,
     };
 
+    // Timeline semaphores are used for uploads completion tickets,
+    // descriptor indexing - for one textures array (see 'vlk::CreateDescriptors')
+    VkPhysicalDeviceVulkan12Features PhysicalDeviceVulkan12Features
+    {
+      .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+      .pNext = &PhysicalDeviceExtendedDynamicState3Features,
+      .descriptorIndexing = VK_TRUE,
+      .shaderSampledImageArrayNonUniformIndexing = VK_TRUE,
+      .descriptorBindingSampledImageUpdateAfterBind = VK_TRUE,
+      .descriptorBindingUpdateUnusedWhilePending = VK_TRUE,
+      .descriptorBindingPartiallyBound = VK_TRUE,
+      .descriptorBindingVariableDescriptorCount = VK_TRUE,
+      .runtimeDescriptorArray = VK_TRUE,
+      .timelineSemaphore = VK_TRUE,
+    };
+
     VkPhysicalDeviceFeatures DeviceFeatures;
     vkGetPhysicalDeviceFeatures(PhysDevice, &DeviceFeatures);
     DeviceFeatures.samplerAnisotropy = VK_TRUE;
@@ -69,10 +130,10 @@ namespace pivk
     VkDeviceCreateInfo DeviceInfo
     {
       .sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-      .pNext = &PhysicalDeviceExtendedDynamicState3Features,
+      .pNext = &PhysicalDeviceVulkan12Features,
       .flags = 0,
-      .queueCreateInfoCount = 1,
-      .pQueueCreateInfos = &QueueInfo,
+      .queueCreateInfoCount = IsTransferFamily ? 2U : 1U,
+      .pQueueCreateInfos = QueueInfos.data(),
       .enabledLayerCount = 0,
       .ppEnabledLayerNames = nullptr,
       .enabledExtensionCount = UINT32(ExtensionNames.size()),
@@ -97,6 +158,8 @@ namespace pivk
     AllocatorCreateInfo.instance = Instance;
     AllocatorCreateInfo.physicalDevice = PhysDevice;
     AllocatorCreateInfo.device = Device;
+    if (IsMemoryBudget)
+      AllocatorCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
 
     if ((vmaCreateAllocator(&AllocatorCreateInfo, &Allocator)) != VK_SUCCESS)
     {
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_image.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 12.11.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan image realization file.
  * NOTE:        None.
  *
@@ -41,13 +41,15 @@
  *       UINT PixelsDataSize;
  *   - number of mipmaps to be create:
  *       UINT MipCount;
+ *   - pixels upload ticket output pointer (see 'vlk_upload_manager', may be nullptr):
+ *       UINT64 *Ticket;
  * RETURNS:
  *   (BOOL) success creation result.
  */
 BOOL pivk::vlk::ImageCreate( VkImage &Image, VkImageView &ImageView, VmaAllocation &Allocation,
                              INT W, INT H, BOOL IsColor, BOOL IsCube,
                              VkFormat Format, VkImageUsageFlags UsageFlags, VkImageLayout Layout,
-                             const VOID *PixelsData, UINT PixelsDataSize, UINT MipCount )
+                             const VOID *PixelsData, UINT PixelsDataSize, UINT MipCount, UINT64 *Ticket )
 {
   if (MipCount < 1)
     MipCount = 1;
@@ -75,9 +77,24 @@ BOOL pivk::vlk::ImageCreate( VkImage &Image, VkImageView &ImageView, VmaAllocati
   AllocationCreateInfo.flags = 0;
   AllocationCreateInfo.priority = 1.0f;
 
-  if (vmaCreateImage(Allocator, &ImageInfo, &AllocationCreateInfo,
-      &Image, &Allocation, nullptr) != VK_SUCCESS)
-    throw;
+  VkResult Res;
+
+  // Out of memory - evict not used resources and retry
+  while ((Res = vmaCreateImage(Allocator, &ImageInfo, &AllocationCreateInfo,
+                               &Image, &Allocation, nullptr)) != VK_SUCCESS &&
+         MemReclaim(PixelsDataSize))
+    ;
+  if (Res != VK_SUCCESS)
+  {
+#if _DEBUG
+    MessageLog(std::format("Image {}x{} is not created (error {})\n", W, H, static_cast<INT>(Res)), 2);
+#endif // _DEBUG
+    Image = VK_NULL_HANDLE;
+    ImageView = VK_NULL_HANDLE;
+    Allocation = VK_NULL_HANDLE;
+    return FALSE;
+  }
+  MemAlloc(mem_class::TEXTURE, Allocation);
 
   VkImageViewCreateInfo viewInfo{};
   viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -95,195 +112,11 @@ BOOL pivk::vlk::ImageCreate( VkImage &Image, VkImageView &ImageView, VmaAllocati
     throw;
   }
 
-  if (PixelsData != nullptr)
-  {
-    VkBuffer StagingBuffer;
-    //VkDeviceMemory StagingBufferMemory;
-    VmaAllocation BufAllocation;
-
-    VkBufferCreateInfo Info
-    {
-      .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, // Structure type.
-      .size = VkDeviceSize(PixelsDataSize),          // Size of buffer in bytes.
-      .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,     // Bit mask of using buffer.
-      .sharingMode = VK_SHARING_MODE_EXCLUSIVE,      // Sharing type when accessed 
-                                                     // by several families of queues
-    };
-
-    VmaAllocationCreateInfo AllocationCreateInfo{};
-    AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
-    AllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
-    AllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
-    AllocationCreateInfo.priority = 1.0f;
-
-    if (vmaCreateBuffer(Allocator, &Info, &AllocationCreateInfo, &StagingBuffer, &BufAllocation, nullptr) != VK_SUCCESS)
-    {
-      throw;
-    }
-
-    VOID *Data;
-
-    vmaMapMemory(Allocator, BufAllocation, &Data);
-    std::memcpy(Data, PixelsData, static_cast<UINT_PTR>(PixelsDataSize));
-    vmaUnmapMemory(Allocator, BufAllocation);
-
-    // Create temporary command buffer
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = CommandPool;
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer TmpCommandBuffer;
-    vkAllocateCommandBuffers(Device, &allocInfo, &TmpCommandBuffer);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    vkBeginCommandBuffer(TmpCommandBuffer, &beginInfo);
-
-    // Work with tmp cmd buf
-
-    // 1. Transition image layout
-    VkPipelineStageFlags SourceStage;
-    VkPipelineStageFlags DestinationStage;
-
-    VkImageLayout OldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    VkImageLayout NewLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    //VkFormat FormatTrans;
-    //VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    VkImageMemoryBarrier barrier{};
-
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = OldLayout;
-    barrier.newLayout = NewLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = Image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = 0; // ?
-    barrier.dstAccessMask = 0; // ?
-
-    if (OldLayout == VK_IMAGE_LAYOUT_UNDEFINED && NewLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-    {
-      barrier.srcAccessMask = 0;
-      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-      SourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-      DestinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    }
-    else if (OldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && NewLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-    {
-      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-      SourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-      DestinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else
-    {
-      throw;
-    }
-
-    vkCmdPipelineBarrier(TmpCommandBuffer,
-                         SourceStage, DestinationStage,
-                         0,
-                         0, nullptr,
-                         0, nullptr,
-                         1, &barrier);
-
-    // 2. Copy buffer to image
-
-    VkBufferImageCopy region{};
-    region.bufferOffset = 0;
-    region.bufferRowLength = 0;
-    region.bufferImageHeight = 0;
-
-    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    region.imageSubresource.mipLevel = 0;
-    region.imageSubresource.baseArrayLayer = 0;
-    region.imageSubresource.layerCount = 1;
-
-    region.imageOffset = {0, 0, 0};
-    region.imageExtent = {UINT(W), UINT(H), 1};
-
-    vkCmdCopyBufferToImage(TmpCommandBuffer,
-                           StagingBuffer,
-                           Image,
-                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                           1,
-                           &region);
-
-    // 3. Set image as VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
-    OldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-    NewLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    //VkFormat FormatTrans;
-    //VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-    //VkImageMemoryBarrier barrier{};
-
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = OldLayout;
-    barrier.newLayout = NewLayout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = Image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-    barrier.srcAccessMask = 0; // ?
-    barrier.dstAccessMask = 0; // ?
-
-    if (OldLayout == VK_IMAGE_LAYOUT_UNDEFINED && NewLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-    {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-        SourceStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        DestinationStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    }
-    else if (OldLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && NewLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
-    {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        SourceStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        DestinationStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    }
-    else
-    {
-        throw;
-    }
-
-    vkCmdPipelineBarrier(TmpCommandBuffer,
-        SourceStage, DestinationStage,
-        0,
-        0, nullptr,
-        0, nullptr,
-        1, &barrier);
-
-    // Delete tmp cmd buf
-    vkEndCommandBuffer(TmpCommandBuffer);
+  // Pixels are copied by upload engine, image is ready for drawing when ticket completes
+  UINT64 ImageTicket = PixelsData != nullptr ? UploadImage(Image, W, H, PixelsData, PixelsDataSize) : 0;
 
-    VkSubmitInfo SubmitInfo{};
-    SubmitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    SubmitInfo.commandBufferCount = 1;
-    SubmitInfo.pCommandBuffers = &TmpCommandBuffer;
-
-    vkQueueSubmit(CommandQueue, 1, &SubmitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(CommandQueue);
-    vkFreeCommandBuffers(Device, CommandPool, 1, &TmpCommandBuffer);
-
-    vmaDestroyBuffer(Allocator, StagingBuffer, Allocation);
-  }
+  if (Ticket != nullptr)
+    *Ticket = ImageTicket;
 
   return TRUE;
 } /* End of 'pivk::vlk::ImageCreate' function */
@@ -300,10 +133,21 @@ BOOL pivk::vlk::ImageCreate( VkImage &Image, VkImageView &ImageView, VmaAllocati
  */
 VOID pivk::vlk::ImageFree( VkImage &Image, VkImageView &ImageView, VmaAllocation &Allocation )
 {
-  if (ImageView != VK_NULL_HANDLE)
-    vkDestroyImageView(Device, ImageView, nullptr);
+  if (Allocation != VK_NULL_HANDLE)
+    MemFree(mem_class::TEXTURE, Allocation);
+
+  // Image may be used by not completed frame (or by recorded copies, which
+  // are submitted now and complete before next frame)
   if (Image != VK_NULL_HANDLE)
-    vmaDestroyImage(Allocator, Image, Allocation);
+    UploadSubmit();
+  if (ImageView != VK_NULL_HANDLE || Image != VK_NULL_HANDLE)
+    DeferDestroy([this, OldImage = Image, OldImageView = ImageView, OldAllocation = Allocation]( VOID )
+      {
+        if (OldImageView != VK_NULL_HANDLE)
+          vkDestroyImageView(Device, OldImageView, nullptr);
+        if (OldImage != VK_NULL_HANDLE)
+          vmaDestroyImage(Allocator, OldImage, OldAllocation);
+      });
     //vkDestroyImage(Device, Image, nullptr);
   //if (Memory != VK_NULL_HANDLE)
   //  vkFreeMemory(Device, Memory, nullptr);
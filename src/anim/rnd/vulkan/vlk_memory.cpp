@@ -0,0 +1,146 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        vlk_memory.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Vulkan device memory budget manager file.
+ * NOTE:        Budget is checked against VMA heap budgets of device
+ *              local heaps ('VK_EXT_memory_budget' values if extension
+ *              is supported, otherwise VMA estimation).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "pivk.h"
+
+/* Base project namespace */
+namespace pivk
+{
+  /* Register allocation function.
+   * ARGUMENTS:
+   *   - resource class:
+   *       mem_class Class;
+   *   - allocation:
+   *       VmaAllocation Allocation;
+   * RETURNS: None.
+   */
+  VOID vlk_memory_manager::MemAlloc( mem_class Class, VmaAllocation Allocation )
+  {
+    MemClassUsage[static_cast<INT>(Class)] += MemSize(Allocation);
+  } /* End of 'vlk_memory_manager::MemAlloc' function */
+
+  /* Unregister allocation function.
+   * ARGUMENTS:
+   *   - resource class:
+   *       mem_class Class;
+   *   - allocation:
+   *       VmaAllocation Allocation;
+   * RETURNS: None.
+   */
+  VOID vlk_memory_manager::MemFree( mem_class Class, VmaAllocation Allocation )
+  {
+    UINT64 &Usage = MemClassUsage[static_cast<INT>(Class)];
+    UINT64 Size = MemSize(Allocation);
+
+    Usage = Usage > Size ? Usage - Size : 0;
+  } /* End of 'vlk_memory_manager::MemFree' function */
+
+  /* Get allocation size function.
+   * ARGUMENTS:
+   *   - allocation:
+   *       VmaAllocation Allocation;
+   * RETURNS:
+   *   (UINT64) allocation size in bytes (0 for null allocation).
+   */
+  UINT64 vlk_memory_manager::MemSize( VmaAllocation Allocation )
+  {
+    if (Allocation == VK_NULL_HANDLE)
+      return 0;
+
+    VmaAllocationInfo Info {};
+
+    vmaGetAllocationInfo(VlkCore.Allocator, Allocation, &Info);
+    return Info.size;
+  } /* End of 'vlk_memory_manager::MemSize' function */
+
+  /* Get device local heaps usage and budget function.
+   * ARGUMENTS:
+   *   - usage and effective budget (with limit and percent applied) in bytes:
+   *       UINT64 &Usage, &Budget;
+   * RETURNS: None.
+   */
+  VOID vlk_memory_manager::MemBudget( UINT64 &Usage, UINT64 &Budget )
+  {
+    const VkPhysicalDeviceMemoryProperties *Props;
+    VmaBudget Budgets[VK_MAX_MEMORY_HEAPS] {};
+
+    vmaGetMemoryProperties(VlkCore.Allocator, &Props);
+    vmaGetHeapBudgets(VlkCore.Allocator, Budgets);
+
+    Usage = Budget = 0;
+    for (UINT32 i = 0; i < Props->memoryHeapCount; i++)
+      if (Props->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+      {
+        // Free space inside VMA blocks is not counted (it is not released by eviction)
+        UINT64 Unused = Budgets[i].statistics.blockBytes - Budgets[i].statistics.allocationBytes;
+
+        Usage += Budgets[i].usage > Unused ? Budgets[i].usage - Unused : 0;
+        Budget += Budgets[i].budget;
+      }
+
+    Budget = Budget / 100 * MemBudgetPercent;
+    if (MemBudgetLimit != 0 && MemBudgetLimit < Budget)
+      Budget = MemBudgetLimit;
+  } /* End of 'vlk_memory_manager::MemBudget' function */
+
+  /* Evict resources if budget is exceeded function (called once per frame).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_memory_manager::MemUpdate( VOID )
+  {
+    UINT64 Usage, Budget;
+
+    MemBudget(Usage, Budget);
+    if (Usage <= Budget || !OnEvict)
+      return;
+
+    UINT64 Freed = OnEvict(Usage - Budget);
+
+#if _DEBUG
+    MessageLog(std::format("Memory budget exceeded: usage {} KB, budget {} KB, evicted {} KB "
+                           "(geometry {} KB, textures {} KB, other {} KB)\n",
+                           Usage >> 10, Budget >> 10, Freed >> 10,
+                           MemClassUsage[static_cast<INT>(mem_class::GEOMETRY)] >> 10,
+                           MemClassUsage[static_cast<INT>(mem_class::TEXTURE)] >> 10,
+                           MemClassUsage[static_cast<INT>(mem_class::OTHER)] >> 10), 3);
+#else  // _DEBUG
+    (VOID)Freed;
+#endif // _DEBUG
+  } /* End of 'vlk_memory_manager::MemUpdate' function */
+
+  /* Reclaim memory after failed allocation function.
+   * ARGUMENTS:
+   *   - size of failed allocation in bytes:
+   *       UINT64 Bytes;
+   * RETURNS:
+   *   (BOOL) TRUE if some memory was released and allocation may be retried.
+   */
+  BOOL vlk_memory_manager::MemReclaim( UINT64 Bytes )
+  {
+    // Resources evicted while frame is recorded are destroyed only after
+    // it completes, so allocation fails and budget is restored at frame end
+    if (VlkCore.IsFrameRecording || !OnEvict || OnEvict(Bytes) == 0)
+      return FALSE;
+
+    vkDeviceWaitIdle(VlkCore.Device);
+    VlkCore.DeferredFlush();
+    return TRUE;
+  } /* End of 'vlk_memory_manager::MemReclaim' function */
+} /* end of 'pivk' namespace */
+
+/* END OF 'vlk_memory.cpp' FILE */
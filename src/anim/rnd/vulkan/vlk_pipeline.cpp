@@ -5,9 +5,13 @@
 
 /* FILE:        vlk_pipeline.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 29.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan pipeline file.
- * NOTE:        None.
+ * NOTE:        Pipeline cache file contains 'pipeline_cache_header'
+ *              and 'vkGetPipelineCacheData' data. Data is used only
+ *              if it is saved on same device and driver version.
+ *              Viewport, scissor and polygon mode are dynamic state,
+ *              so they are not part of 'pipeline_key'.
  * 
  * No part of this file may be changed without agreement of
  * Computer Graphics Support Group of 30 Phys-Math Lyceum.
@@ -18,6 +22,39 @@
 /* Base project namespace */
 namespace pivk
 {
+  /* Pipeline cache file header structure */
+  struct pipeline_cache_header
+  {
+    DWORD Sign;                     // File signature ("PVKC")
+    UINT32 HeaderSize;              // Size of this header in bytes
+    UINT32 VendorID;                // Device vendor identifier
+    UINT32 DeviceID;                // Device identifier
+    UINT32 DriverVersion;           // Device driver version
+    BYTE CacheUUID[VK_UUID_SIZE];   // Device pipeline cache identifier
+    UINT64 DataSize;                // Size of cache data in bytes
+    UINT64 DataHash;                // Cache data hash (FNV-1a)
+  }; /* End of 'pipeline_cache_header' structure */
+
+  /* Fill pipeline cache file header for current device function.
+   * ARGUMENTS:
+   *   - device properties:
+   *       const VkPhysicalDeviceProperties &Props;
+   * RETURNS:
+   *   (pipeline_cache_header) header without data fields.
+   */
+  static pipeline_cache_header PipelineCacheHeader( const VkPhysicalDeviceProperties &Props )
+  {
+    pipeline_cache_header Header {};
+
+    Header.Sign = *(DWORD *)"PVKC";
+    Header.HeaderSize = sizeof(pipeline_cache_header);
+    Header.VendorID = Props.vendorID;
+    Header.DeviceID = Props.deviceID;
+    Header.DriverVersion = Props.driverVersion;
+    std::memcpy(Header.CacheUUID, Props.pipelineCacheUUID, VK_UUID_SIZE);
+    return Header;
+  } /* End of 'PipelineCacheHeader' function */
+
   /* Create vulkan pipeline layout function.
    * ARGUMENTS: None.
    * RETURNS: None.
@@ -54,6 +91,377 @@ namespace pivk
     }
   } /* End of 'vlk::CreatePipelineLayout' function */
 
+  /* Create vulkan pipeline cache function (loads data saved by previous launch).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk::CreatePipelineCache( VOID )
+  {
+    std::vector<BYTE> Data;
+    std::error_code Err;
+    UINT64 FileSize = std::filesystem::file_size(PipelineCacheFileName, Err);
+    std::fstream f(PipelineCacheFileName, std::fstream::in | std::fstream::binary);
+
+    if (f.is_open())
+    {
+      pipeline_cache_header
+        Header {},
+        Expected = PipelineCacheHeader(DeviceProperties);
+
+      // Cache of other device or driver is not used (and is overwritten at close)
+      if (f.read((CHAR *)&Header, sizeof(Header)) &&
+          Header.Sign == Expected.Sign && Header.HeaderSize == Expected.HeaderSize &&
+          Header.VendorID == Expected.VendorID && Header.DeviceID == Expected.DeviceID &&
+          Header.DriverVersion == Expected.DriverVersion &&
+          std::memcmp(Header.CacheUUID, Expected.CacheUUID, VK_UUID_SIZE) == 0 &&
+          !Err && Header.DataSize <= FileSize - sizeof(Header))
+      {
+        Data.resize(Header.DataSize);
+        if (!f.read((CHAR *)Data.data(), Data.size()) ||
+            HashBytes(Data.data(), Data.size()) != Header.DataHash)
+          Data.clear();
+      }
+#if _DEBUG
+      MessageLog(std::format("Pipeline cache '{}' {} ({} bytes)\n",
+                             PipelineCacheFileName, Data.empty() ? "is not valid" : "is loaded", Data.size()), 3);
+#endif // _DEBUG
+    }
+
+    VkPipelineCacheCreateInfo Info
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+      .initialDataSize = Data.size(),
+      .pInitialData = Data.empty() ? nullptr : Data.data(),
+    };
+
+    if (vkCreatePipelineCache(Device, &Info, nullptr, &PipelineCache) != VK_SUCCESS)
+    {
+      // Driver rejected data - start with empty cache
+      Info.initialDataSize = 0;
+      Info.pInitialData = nullptr;
+      if (vkCreatePipelineCache(Device, &Info, nullptr, &PipelineCache) != VK_SUCCESS)
+        PipelineCache = VK_NULL_HANDLE;
+    }
+  } /* End of 'vlk::CreatePipelineCache' function */
+
+  /* Save and destroy vulkan pipeline cache function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk::DestroyPipelineCache( VOID )
+  {
+    if (PipelineCache == VK_NULL_HANDLE)
+      return;
+
+    size_t Size = 0;
+    std::vector<BYTE> Data;
+
+    if (vkGetPipelineCacheData(Device, PipelineCache, &Size, nullptr) == VK_SUCCESS && Size > 0)
+    {
+      Data.resize(Size);
+      if (vkGetPipelineCacheData(Device, PipelineCache, &Size, Data.data()) != VK_SUCCESS)
+        Size = 0;
+      Data.resize(Size);
+    }
+    vkDestroyPipelineCache(Device, PipelineCache, nullptr);
+    PipelineCache = VK_NULL_HANDLE;
+    if (Data.empty())
+      return;
+
+    pipeline_cache_header Header = PipelineCacheHeader(DeviceProperties);
+
+    Header.DataSize = Data.size();
+    Header.DataHash = HashBytes(Data.data(), Data.size());
+
+    // File is written under temporary name and then replaces old one,
+    // so interrupted writing does not damage saved cache
+    std::error_code Err;
+    std::filesystem::path
+      Path(PipelineCacheFileName),
+      TmpPath(PipelineCacheFileName + ".tmp");
+
+    if (Path.has_parent_path())
+      std::filesystem::create_directories(Path.parent_path(), Err);
+    {
+      std::fstream f(TmpPath, std::fstream::out | std::fstream::binary | std::fstream::trunc);
+
+      if (!f.is_open())
+        return;
+      f.write((const CHAR *)&Header, sizeof(Header));
+      f.write((const CHAR *)Data.data(), Data.size());
+      f.flush();
+      if (!f)
+      {
+        f.close();
+        std::filesystem::remove(TmpPath, Err);
+        return;
+      }
+    }
+    std::filesystem::rename(TmpPath, Path, Err);
+#if _DEBUG
+    if (Err)
+      MessageLog(std::format("Pipeline cache '{}' is not saved ({})\n", PipelineCacheFileName, Err.message()), 2);
+#endif // _DEBUG
+  } /* End of 'vlk::DestroyPipelineCache' function */
+
+  /* Get pipeline for state key function (creates pipeline at first request).
+   * ARGUMENTS:
+   *   - pipeline state key:
+   *       const pipeline_key &Key;
+   * RETURNS:
+   *   (VkPipeline) pipeline (VK_NULL_HANDLE if it is not created).
+   */
+  VkPipeline vlk_pipeline_manager::PipelineGet( const pipeline_key &Key )
+  {
+    if (auto It = Pipelines.find(Key); It != Pipelines.end())
+      return It->second;
+
+    // Shader stages
+    std::vector<VkPipelineShaderStageCreateInfo> ShaderStageInfoArr;
+    std::array<std::pair<VkShaderModule, VkShaderStageFlagBits>, 5> Stages
+    {{
+      {Key.Vert, VK_SHADER_STAGE_VERTEX_BIT},
+      {Key.Frag, VK_SHADER_STAGE_FRAGMENT_BIT},
+      {Key.Geom, VK_SHADER_STAGE_GEOMETRY_BIT},
+      {Key.Ctrl, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT},
+      {Key.Eval, VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT},
+    }};
+
+    for (auto &Stage : Stages)
+      if (Stage.first != VK_NULL_HANDLE)
+        ShaderStageInfoArr.push_back(
+          {
+            .sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+            .stage = Stage.second,
+            .module = Stage.first,
+            .pName = "main",
+          });
+
+    // Vertex input binding description
+    VkVertexInputBindingDescription BindingDescription = 
+    {
+      .binding = 0,
+      .stride = Key.VertexStride,
+      .inputRate = VK_VERTEX_INPUT_RATE_VERTEX,
+    };
+
+    // Setup vertex input
+    VkPipelineVertexInputStateCreateInfo VertexInputInfo = 
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
+      .vertexBindingDescriptionCount = 1,
+      .pVertexBindingDescriptions = &BindingDescription,
+      .vertexAttributeDescriptionCount = Key.NumOfAttributes,
+      .pVertexAttributeDescriptions = Key.Attributes,
+    };
+
+    // Setup vertex assembly
+    VkPipelineInputAssemblyStateCreateInfo InputAssembly = 
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .topology = Key.Topology,
+      .primitiveRestartEnable = VK_FALSE,
+    };
+
+    // Setup viewport state
+    VkPipelineViewportStateCreateInfo ViewportState = 
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .viewportCount = 1,
+      .pViewports = &VlkCore.Viewport,
+      .scissorCount = 1,
+      .pScissors = &VlkCore.Scissor,
+    };
+
+    // Setup rasterizer
+    VkPipelineRasterizationStateCreateInfo Rasterizer = 
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .depthClampEnable = VK_FALSE,
+      .rasterizerDiscardEnable = VK_FALSE,
+      .polygonMode = VK_POLYGON_MODE_FILL,
+      .cullMode = Key.CullMode,
+      .frontFace = Key.FrontFace,
+      .depthBiasEnable = VK_FALSE,
+      .depthBiasConstantFactor = 0.0f,
+      .depthBiasClamp = 0.0f,
+      .depthBiasSlopeFactor = 0.0f,
+      .lineWidth = 1.0f,
+    };
+
+    // Setup multisampling
+    VkPipelineMultisampleStateCreateInfo Multisampling = 
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+      .sampleShadingEnable = VK_FALSE,
+      .minSampleShading = 1.0f,
+      .pSampleMask = nullptr,            // Optional
+      .alphaToCoverageEnable = VK_FALSE, // Optional
+      .alphaToOneEnable = VK_FALSE,      // Optional
+    };
+
+    // Setup color blending
+    VkPipelineColorBlendAttachmentState ColorBlendAttachment =
+    {
+      .blendEnable = Key.BlendEnable,
+      .srcColorBlendFactor = Key.SrcColorBlend,
+      .dstColorBlendFactor = Key.DstColorBlend,
+      .colorBlendOp = Key.ColorBlendOp,
+      .srcAlphaBlendFactor = Key.SrcAlphaBlend,
+      .dstAlphaBlendFactor = Key.DstAlphaBlend,
+      .alphaBlendOp = Key.AlphaBlendOp,
+      .colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT,
+    };
+
+    // Setup color blend state
+    VkPipelineColorBlendStateCreateInfo ColorBlending =
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .logicOpEnable = VK_FALSE,
+      .logicOp = VK_LOGIC_OP_COPY,
+      .attachmentCount = 1,
+      .pAttachments = &ColorBlendAttachment,
+      .blendConstants = {0.0f, 0.0f, 0.0f, 0.0f},
+    };
+
+    // Setup depth stencil state
+    VkPipelineDepthStencilStateCreateInfo DepthStencil
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
+      .depthTestEnable = Key.DepthTest,
+      .depthWriteEnable = Key.DepthWrite,
+      .depthCompareOp = Key.DepthCompareOp,
+      .depthBoundsTestEnable = VK_FALSE,
+      .stencilTestEnable = VK_FALSE,
+      .minDepthBounds = 0.0f,
+      .maxDepthBounds = 1.0f,
+    };
+
+    // Tessellation parameters
+    VkPipelineTessellationDomainOriginStateCreateInfo TessellationDomainOriginStateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_DOMAIN_ORIGIN_STATE_CREATE_INFO, 
+      .domainOrigin = VK_TESSELLATION_DOMAIN_ORIGIN_UPPER_LEFT,
+    };
+    VkPipelineTessellationStateCreateInfo TessellationStateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_TESSELLATION_STATE_CREATE_INFO,
+      .pNext = &TessellationDomainOriginStateInfo,
+      .patchControlPoints = Key.PatchControlPoints,
+    };
+
+    // Dynamic state setup
+    std::array<VkDynamicState, 3> DynamicStates
+    {
+      VK_DYNAMIC_STATE_POLYGON_MODE_EXT,
+      VK_DYNAMIC_STATE_VIEWPORT,
+      VK_DYNAMIC_STATE_SCISSOR
+    };
+    VkPipelineDynamicStateCreateInfo DynamicStateInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
+      .dynamicStateCount = static_cast<UINT32>(DynamicStates.size()),
+      .pDynamicStates = DynamicStates.data(),
+    };
+
+    // Graphics pipeline creare info
+    VkGraphicsPipelineCreateInfo PipelineInfo =
+    {
+      .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+      .pNext = nullptr,
+      .flags = 0,
+      .stageCount = UINT32(ShaderStageInfoArr.size()),
+      .pStages = ShaderStageInfoArr.data(),
+      .pVertexInputState = &VertexInputInfo,
+      .pInputAssemblyState = &InputAssembly,
+      .pTessellationState = &TessellationStateInfo, // Optional
+      .pViewportState = &ViewportState,
+      .pRasterizationState = &Rasterizer,
+      .pMultisampleState = &Multisampling,
+      .pDepthStencilState = &DepthStencil, // Optional
+      .pColorBlendState = &ColorBlending,
+      .pDynamicState = &DynamicStateInfo,
+      .layout = VlkCore.PipelineLayout,
+      .renderPass = VlkCore.RenderPass,
+      .subpass = 0,
+      .basePipelineHandle = nullptr,
+      .basePipelineIndex = 0,
+    };
+
+    VkPipeline Pipeline = VK_NULL_HANDLE;
+
+    // Compiled pipelines are kept in pipeline cache file
+    if (vkCreateGraphicsPipelines(VlkCore.Device, VlkCore.PipelineCache, 1, &PipelineInfo, nullptr, &Pipeline) != VK_SUCCESS)
+    {
+      throw;
+    }
+#if _DEBUG
+    MessageLog(std::format("Pipeline {} is created\n", Pipelines.size() + 1), 3);
+#endif // _DEBUG
+    Pipelines.emplace(Key, Pipeline);
+    return Pipeline;
+  } /* End of 'vlk_pipeline_manager::PipelineGet' function */
+
+  /* Free pipelines using shader module function (called before module destruction).
+   * ARGUMENTS:
+   *   - shader module:
+   *       VkShaderModule Module;
+   * RETURNS: None.
+   */
+  VOID vlk_pipeline_manager::PipelinesFree( VkShaderModule Module )
+  {
+    for (auto It = Pipelines.begin(); It != Pipelines.end(); )
+      if (It->first.IsUsing(Module))
+      {
+        // Pipeline may be used by not completed frame
+        VlkCore.DeferDestroy([this, Pipeline = It->second]( VOID )
+          {
+            vkDestroyPipeline(VlkCore.Device, Pipeline, nullptr);
+          });
+        if (BoundPipeline == It->second)
+          BoundPipeline = VK_NULL_HANDLE;
+        It = Pipelines.erase(It);
+      }
+      else
+        ++It;
+  } /* End of 'vlk_pipeline_manager::PipelinesFree' function */
+
+  /* Free all pipelines function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_pipeline_manager::PipelinesFree( VOID )
+  {
+    for (auto &Pipeline : Pipelines)
+      vkDestroyPipeline(VlkCore.Device, Pipeline.second, nullptr);
+    Pipelines.clear();
+    BoundPipeline = VK_NULL_HANDLE;
+  } /* End of 'vlk_pipeline_manager::PipelinesFree' function */
+
+  /* Bind pipeline to recorded frame function (same pipeline is not rebound).
+   * ARGUMENTS:
+   *   - pipeline:
+   *       VkPipeline Pipeline;
+   * RETURNS: None.
+   */
+  VOID vlk_pipeline_manager::BindPipeline( VkPipeline Pipeline )
+  {
+    if (Pipeline == VK_NULL_HANDLE || Pipeline == BoundPipeline)
+      return;
+    vkCmdBindPipeline(VlkCore.CommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, Pipeline);
+    BoundPipeline = Pipeline;
+  } /* End of 'vlk_pipeline_manager::BindPipeline' function */
 }; /* end of 'pivk' namespace */
 
 /* END OF 'vlk_pipeline.cpp' FILE */
@@ -5,7 +5,7 @@
 
 /* FILE:        vlk_renderpass.cpp
  * PROGRAMMER:  IP5
- * LAST UPDATE: 28.10.2024
+ * LAST UPDATE: 17.10.2026
  * PURPOSE:     Vulkan core render pass file.
  * NOTE:        None.
  * 
@@ -100,10 +100,11 @@ namespace pivk
                                                                       // not, so we only starting self passage.
       .dstSubpass = 0,                                                // Index of subpass, in which we moving.
       .srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | // Condition all Pipeline in srcSubpass, in
-                      VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,     // which will be transition has been made in dstSubpass.
+                      VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |    // which will be transition has been made in dstSubpass.
+                      VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,      // (depth buffer is shared by frames in flight)
       .dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | // Condition, from which opportunities will be obtained
                       VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT,     // Access from dstAccessMask.
-      .srcAccessMask = 0,                                             // Access to G-Buffer in srcSubpass.
+      .srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,  // Access to G-Buffer in srcSubpass.
       .dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |         // Access to G-Buffer in dstSubpass.
                        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
       .dependencyFlags = 0,                                           // Flags
@@ -154,22 +155,38 @@ namespace pivk
    */
   VOID vlk::RenderPassBegin( VOID )
   {
-    if (vkResetFences(Device, 1, &Fence) != VK_SUCCESS)
+    frame &F = Frames[FrameIdx];
+
+    // Wait until GPU completes frame previously recorded with these resources
+    if (vkWaitForFences(Device, 1, &F.Fence, VK_TRUE, UINT64_MAX) != VK_SUCCESS)
     {
       throw;
     }
-    if (vkAcquireNextImageKHR(Device, Swapchain, UINT64_MAX, VK_NULL_HANDLE, Fence, &CurImgIdx) != VK_SUCCESS)
+
+    // Frames are completed in submission order - destroy objects freed up to it
+    DeferredCollect(F.FrameNo);
+
+    // Release command buffers and staging memory of completed uploads
+    UploadCollect();
+
+    if (VkResult Res = vkAcquireNextImageKHR(Device, Swapchain, UINT64_MAX, F.ImageAvailable, VK_NULL_HANDLE, &CurImgIdx);
+        Res != VK_SUCCESS && Res != VK_SUBOPTIMAL_KHR)
     {
       throw;
     }
-    if (vkWaitForFences(Device, 1, &Fence, TRUE, UINT64_MAX))
+    if (vkResetFences(Device, 1, &F.Fence) != VK_SUCCESS)
     {
       throw;
     }
-    if (vkResetCommandBuffer(CommandBuffer, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT) != VK_SUCCESS)
+    if (vkResetCommandPool(Device, F.CommandPool, 0) != VK_SUCCESS)
     {
       throw;
     }
+    CommandBuffer = F.CommandBuffer;
+    F.FrameNo = FrameNo;
+
+    // Ring buffer part of this frame is not used by GPU anymore
+    RingReset();
 
     VkCommandBufferBeginInfo CommandBufferBeginInfo
     {
@@ -181,6 +198,8 @@ namespace pivk
     {
       throw;
     }
+    IsFrameRecording = TRUE;
+    BoundPipeline = VK_NULL_HANDLE;
 
     std::array<VkClearValue, 2> ClearValues
     {
@@ -214,41 +233,47 @@ namespace pivk
     vkCmdEndRenderPass(CommandBuffer);
     vkEndCommandBuffer(CommandBuffer);
 
-    if (vkResetFences(Device, 1, &Fence) != VK_SUCCESS)
-    {
-      throw;
-    }
+    // Make frame data written to ring buffer visible to GPU
+    RingFlush();
+
+    frame &F = Frames[FrameIdx];
+    VkPipelineStageFlags WaitStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 
+    // Rendering waits for swapchain image, presentation waits for rendering.
+    // Presentation semaphore is per image: it is reused only after the image is acquired again.
     VkSubmitInfo SubmitInfo
     {
       .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
-      .waitSemaphoreCount = 0,
-      .pWaitSemaphores = nullptr,
-      .pWaitDstStageMask = nullptr,
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores = &F.ImageAvailable,
+      .pWaitDstStageMask = &WaitStage,
       .commandBufferCount = 1,
-      .pCommandBuffers = &CommandBuffer,
-      .signalSemaphoreCount = 0,
-      .pSignalSemaphores = nullptr,
+      .pCommandBuffers = &F.CommandBuffer,
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores = &RenderFinished[CurImgIdx],
     };
 
-    if (vkQueueSubmit(CommandQueue, 1, &SubmitInfo, Fence) != VK_SUCCESS)
+    if (vkQueueSubmit(CommandQueue, 1, &SubmitInfo, F.Fence) != VK_SUCCESS)
     {
       throw;
     }
-
-    vkWaitForFences(Device, 1, &Fence, TRUE, UINT64_MAX);
+    IsFrameRecording = FALSE;
 
     VkPresentInfoKHR PresentInfo
     {
       .sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-      .waitSemaphoreCount = 0,
-      .pWaitSemaphores = nullptr,
+      .waitSemaphoreCount = 1,
+      .pWaitSemaphores = &RenderFinished[CurImgIdx],
       .swapchainCount = 1,
       .pSwapchains = &Swapchain,
       .pImageIndices = &CurImgIdx,
     };
 
     vkQueuePresentKHR(CommandQueue, &PresentInfo);
+
+    // CPU does not wait for GPU here - next frame is recorded with next resources
+    FrameNo++;
+    FrameIdx = (FrameIdx + 1) % static_cast<UINT>(Frames.size());
   } /* End of 'RenderPassEnd' function */
 
 } /* end of 'pivk' namespace */
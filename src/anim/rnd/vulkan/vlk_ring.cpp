@@ -0,0 +1,95 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        vlk_ring.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Vulkan per-frame ring allocator file.
+ * NOTE:        Ring buffer contains 'Frames.size()' parts of
+ *              'RingFrameSize' bytes, part 'FrameIdx' is filled
+ *              by recorded frame.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "pivk.h"
+
+/* Base project namespace */
+namespace pivk
+{
+  /* Create ring buffer function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_ring_manager::RingCreate( VOID )
+  {
+    const VkPhysicalDeviceLimits &Limits = VlkCore.DeviceProperties.limits;
+
+    // Dynamic offsets should be aligned for uniform and storage usage (alignments are powers of 2)
+    RingAlign = Limits.minUniformBufferOffsetAlignment > Limits.minStorageBufferOffsetAlignment ?
+      Limits.minUniformBufferOffsetAlignment : Limits.minStorageBufferOffsetAlignment;
+    if (RingAlign == 0)
+      RingAlign = 1;
+    RingFrameSize = (RingFrameSize + RingAlign - 1) & ~(RingAlign - 1);
+
+    RingBuf = VlkCore.BufCreate(RingFrameSize * VlkCore.Frames.size(), VlkCore.Frames.size(),
+                                VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
+
+    // Buffer memory stays mapped until buffer is freed
+    RingData = RingBuf->Mapped;
+    RingReset();
+  } /* End of 'vlk_ring_manager::RingCreate' function */
+
+  /* Start recorded frame part function (called when frame resources are free).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_ring_manager::RingReset( VOID )
+  {
+    RingStart = RingOffset = RingFrameSize * VlkCore.FrameIdx;
+    RingEnd = RingStart + RingFrameSize;
+  } /* End of 'vlk_ring_manager::RingReset' function */
+
+  /* Allocate memory in recorded frame part function.
+   * ARGUMENTS:
+   *   - size in bytes:
+   *       UINT64 Size;
+   *   - dynamic offset of allocation in ring buffer:
+   *       UINT32 &Offset;
+   * RETURNS:
+   *   (VOID *) pointer to mapped memory (nullptr if frame part is full).
+   */
+  VOID * vlk_ring_manager::RingAlloc( UINT64 Size, UINT32 &Offset )
+  {
+    UINT64 Start = (RingOffset + RingAlign - 1) & ~(RingAlign - 1);
+
+    if (RingData == nullptr || Start + Size > RingEnd)
+    {
+#if _DEBUG
+      MessageLog(std::format("Ring buffer frame part of {} bytes is full ({} bytes requested)\n", RingFrameSize, Size), 2);
+#endif // _DEBUG
+      // Previous data of this frame is bound instead (offset stays valid)
+      Offset = static_cast<UINT32>(RingStart);
+      return nullptr;
+    }
+
+    RingOffset = Start + Size;
+    Offset = static_cast<UINT32>(Start);
+    return RingData + Start;
+  } /* End of 'vlk_ring_manager::RingAlloc' function */
+
+  /* Flush written data of recorded frame part function (called before submission).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_ring_manager::RingFlush( VOID )
+  {
+    if (RingOffset > RingStart)
+      RingBuf->Flush(RingStart, RingOffset - RingStart);
+  } /* End of 'vlk_ring_manager::RingFlush' function */
+} /* end of 'pivk' namespace */
+
+/* END OF 'vlk_ring.cpp' FILE */
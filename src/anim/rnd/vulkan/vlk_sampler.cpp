@@ -68,7 +68,11 @@ namespace pivk
   {
     assert(Sampler != nullptr);
 
-    vkDestroySampler(Device, Sampler, nullptr);
+    // Sampler may be used by not completed frame
+    DeferDestroy([this, OldSampler = Sampler]( VOID )
+      {
+        vkDestroySampler(Device, OldSampler, nullptr);
+      });
     Sampler = VK_NULL_HANDLE;
   } /* END OF 'vlk::DestroySampler' function */
 
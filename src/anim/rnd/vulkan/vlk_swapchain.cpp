@@ -133,6 +133,24 @@ namespace pivk
       }
     }
 
+    // Semaphores of previous swapchain are kept (they may be still waited by its presentation)
+    VkSemaphoreCreateInfo SemaphoreInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+    };
+
+    while (RenderFinished.size() < SwapchainImagesCount)
+    {
+      VkSemaphore Semaphore;
+
+      if (vkCreateSemaphore(Device, &SemaphoreInfo, nullptr, &Semaphore) != VK_SUCCESS)
+      {
+        MessageBox(hWndRef, "Error of creating vulkan swapchain", "T53VLK :: ERROR", MB_OK | MB_ICONERROR);
+        std::exit(3);
+      }
+      RenderFinished.push_back(Semaphore);
+    }
+
     VkFormat DepthFormat = FindSupportedFormat(PhysDevice,
                                                {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT},
                                                VK_IMAGE_TILING_OPTIMAL,
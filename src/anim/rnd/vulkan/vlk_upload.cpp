@@ -0,0 +1,536 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        vlk_upload.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Vulkan asynchronous uploads file.
+ * NOTE:        If device has dedicated transfer queue family, copies
+ *              are executed by it and images ownership is released to
+ *              command queue family; acquire command buffer is submitted
+ *              to command queue right after copies, so frames submitted
+ *              later are ordered after uploaded data (static buffers are
+ *              shared by both families and need no ownership transfer).
+ *              Without dedicated family copies are submitted to command
+ *              queue. Ticket of batch is value of 'UploadSemaphore'.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "pivk.h"
+
+/* Base project namespace */
+namespace pivk
+{
+  /* Create timeline semaphore function.
+   * ARGUMENTS:
+   *   - logical device:
+   *       VkDevice Device;
+   * RETURNS:
+   *   (VkSemaphore) created semaphore.
+   */
+  static VkSemaphore CreateTimelineSemaphore( VkDevice Device )
+  {
+    VkSemaphoreTypeCreateInfo TypeInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+      .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+      .initialValue = 0,
+    };
+    VkSemaphoreCreateInfo Info
+    {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+      .pNext = &TypeInfo,
+    };
+    VkSemaphore Semaphore;
+
+    if (vkCreateSemaphore(Device, &Info, nullptr, &Semaphore) != VK_SUCCESS)
+    {
+      throw;
+    }
+    return Semaphore;
+  } /* End of 'CreateTimelineSemaphore' function */
+
+  /* Allocate and begin one time submitted command buffer function.
+   * ARGUMENTS:
+   *   - logical device:
+   *       VkDevice Device;
+   *   - command pool:
+   *       VkCommandPool Pool;
+   * RETURNS:
+   *   (VkCommandBuffer) command buffer in recording state.
+   */
+  static VkCommandBuffer BeginCommandBuffer( VkDevice Device, VkCommandPool Pool )
+  {
+    VkCommandBufferAllocateInfo AllocInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, // Structure type.
+      .commandPool = Pool,                                     // Using command pool.
+      .level = VK_COMMAND_BUFFER_LEVEL_PRIMARY,                // Command buffer level.
+      .commandBufferCount = 1                                  // Count of command buffers.
+    };
+    VkCommandBuffer Cmd;
+
+    if (vkAllocateCommandBuffers(Device, &AllocInfo, &Cmd) != VK_SUCCESS)
+    {
+      throw;
+    }
+
+    VkCommandBufferBeginInfo BeginInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+    };
+
+    vkBeginCommandBuffer(Cmd, &BeginInfo);
+    return Cmd;
+  } /* End of 'BeginCommandBuffer' function */
+
+  /* Create transfer queue objects function (called after device creation).
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_upload_manager::UploadInit( VOID )
+  {
+    if (IsTransferFamily)
+      vkGetDeviceQueue(VlkCore.Device, TransferFamily, 0, &TransferQueue);
+    else
+    {
+      TransferFamily = VlkCore.CommandFamily;
+      TransferQueue = VlkCore.CommandQueue;
+    }
+
+    VkCommandPoolCreateInfo PoolInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO, // Type of structure.
+      .flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT,       // Command buffers are short living.
+      .queueFamilyIndex = TransferFamily                   // Index of using queue family.
+    };
+
+    if (vkCreateCommandPool(VlkCore.Device, &PoolInfo, nullptr, &TransferPool) != VK_SUCCESS)
+    {
+      throw;
+    }
+    UploadSemaphore = CreateTimelineSemaphore(VlkCore.Device);
+    if (IsTransferFamily)
+      TransferSemaphore = CreateTimelineSemaphore(VlkCore.Device);
+  } /* End of 'vlk_upload_manager::UploadInit' function */
+
+  /* Allocate staging ring memory function.
+   * ARGUMENTS:
+   *   - size in bytes:
+   *       UINT64 Size;
+   * RETURNS:
+   *   (UINT64) offset in staging buffer (UINT64_MAX if staging buffer is not created).
+   */
+  UINT64 vlk_upload_manager::StagingAlloc( UINT64 Size )
+  {
+    while (TRUE)
+    {
+      // Nothing is in flight - whole ring is free
+      if (UploadBatches.empty() && UploadCmd == VK_NULL_HANDLE)
+      {
+        StagingHead = 0;
+        if (Size <= StagingSize)
+        {
+          StagingHead = Size;
+          return 0;
+        }
+
+        // Buffer is grown only when it is not used by GPU
+        if (StagingBuffer != VK_NULL_HANDLE)
+          vmaDestroyBuffer(VlkCore.Allocator, StagingBuffer, StagingAllocation);
+        StagingBuffer = VK_NULL_HANDLE;
+        StagingAllocation = VK_NULL_HANDLE;
+        StagingData = nullptr;
+        StagingSize = 0;
+
+        VkBufferCreateInfo Info
+        {
+          .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,         // Structure type.
+          .size = Size > StagingMinSize ? Size : StagingMinSize, // Size of buffer in bytes.
+          .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,             // Bit mask of using buffer.
+          .sharingMode = VK_SHARING_MODE_EXCLUSIVE,              // Sharing type when accessed
+                                                                 // by several families of queues
+        };
+
+        VmaAllocationCreateInfo AllocationCreateInfo {};
+        AllocationCreateInfo.usage = VMA_MEMORY_USAGE_AUTO;
+        AllocationCreateInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+        AllocationCreateInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT | VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+
+        VmaAllocationInfo AllocationInfo {};
+
+        if (vmaCreateBuffer(VlkCore.Allocator, &Info, &AllocationCreateInfo, &StagingBuffer, &StagingAllocation, &AllocationInfo) != VK_SUCCESS)
+        {
+#if _DEBUG
+          MessageLog(std::format("Staging buffer of {} bytes is not created\n", Info.size), 2);
+#endif // _DEBUG
+          StagingBuffer = VK_NULL_HANDLE;
+          StagingAllocation = VK_NULL_HANDLE;
+          return UINT64_MAX;
+        }
+        StagingData = static_cast<BYTE *>(AllocationInfo.pMappedData);
+        StagingSize = Info.size;
+        continue;
+      }
+
+      // Used part of ring starts from oldest not completed data (strict comparisons
+      // keep head and tail different while ring is not empty)
+      UINT64
+        Tail = UploadBatches.empty() ? PendingStart : UploadBatches.front().StagingStart,
+        Start = (StagingHead + 15) & ~15ULL;
+
+      if (StagingHead >= Tail)
+      {
+        if (Start + Size <= StagingSize)
+        {
+          StagingHead = Start + Size;
+          return Start;
+        }
+        if (Size < Tail)
+        {
+          StagingHead = Size;
+          return 0;
+        }
+      }
+      else if (Start + Size < Tail)
+      {
+        StagingHead = Start + Size;
+        return Start;
+      }
+
+      // Ring is full - wait for oldest batch
+#if _DEBUG
+      MessageLog(std::format("Staging buffer of {} bytes is full ({} bytes requested)\n", StagingSize, Size), 3);
+#endif // _DEBUG
+      UploadWait(UploadBatches.empty() ? UploadSubmit() : UploadBatches.front().Ticket);
+    }
+  } /* End of 'vlk_upload_manager::StagingAlloc' function */
+
+  /* Get recorded batch command buffer function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (VkCommandBuffer) command buffer in recording state.
+   */
+  VkCommandBuffer vlk_upload_manager::UploadRecord( VOID )
+  {
+    if (UploadCmd == VK_NULL_HANDLE)
+    {
+      UploadCmd = BeginCommandBuffer(VlkCore.Device, TransferPool);
+
+      // Data of static buffers may be read by previously submitted frames
+      if (!IsTransferFamily)
+        vkCmdPipelineBarrier(UploadCmd,
+                             VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0,
+                             0, nullptr,
+                             0, nullptr,
+                             0, nullptr);
+    }
+    return UploadCmd;
+  } /* End of 'vlk_upload_manager::UploadRecord' function */
+
+  /* Upload data to device local buffer function.
+   * ARGUMENTS:
+   *   - destination buffer:
+   *       vlk_buf *Dst;
+   *   - data:
+   *       const VOID *Data;
+   *   - offset in destination buffer (in bytes):
+   *       UINT64 Offset;
+   *   - size of data (in bytes):
+   *       UINT64 Size;
+   * RETURNS:
+   *   (UINT64) ticket of batch with this upload.
+   */
+  UINT64 vlk_upload_manager::UploadBuf( vlk_buf *Dst, const VOID *Data, UINT64 Offset, UINT64 Size )
+  {
+    if (Dst->Buffer == nullptr || Size == 0)
+      return UploadTicket;
+
+    UINT64 Src = StagingAlloc(Size);
+
+    if (Src == UINT64_MAX)
+      return UploadTicket;
+    std::memcpy(StagingData + Src, Data, Size);
+
+    BOOL IsFirst = UploadCmd == VK_NULL_HANDLE;
+    VkBufferCopy Region {Src, Offset, Size};
+
+    vkCmdCopyBuffer(UploadRecord(), StagingBuffer, Dst->Buffer, 1, &Region);
+    if (IsFirst)
+      PendingStart = Src;
+
+    if (UploadDepth == 0)
+      return UploadSubmit();
+    return UploadTicket + 1;
+  } /* End of 'vlk_upload_manager::UploadBuf' function */
+
+  /* Upload pixels to image function (image is left in shader read only layout).
+   * ARGUMENTS:
+   *   - destination image:
+   *       VkImage Image;
+   *   - image size:
+   *       INT W, H;
+   *   - pixels data:
+   *       const VOID *Data;
+   *   - size of data (in bytes):
+   *       UINT64 Size;
+   * RETURNS:
+   *   (UINT64) ticket of batch with this upload.
+   */
+  UINT64 vlk_upload_manager::UploadImage( VkImage Image, INT W, INT H, const VOID *Data, UINT64 Size )
+  {
+    if (Image == VK_NULL_HANDLE || Size == 0)
+      return UploadTicket;
+
+    UINT64 Src = StagingAlloc(Size);
+
+    if (Src == UINT64_MAX)
+      return UploadTicket;
+    std::memcpy(StagingData + Src, Data, Size);
+
+    BOOL IsFirst = UploadCmd == VK_NULL_HANDLE;
+    VkCommandBuffer Cmd = UploadRecord();
+
+    if (IsFirst)
+      PendingStart = Src;
+
+    VkImageMemoryBarrier Barrier
+    {
+      .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+      .srcAccessMask = 0,
+      .dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+      .newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+      .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+      .image = Image,
+      .subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1},
+    };
+
+    vkCmdPipelineBarrier(Cmd,
+                         VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         0,
+                         0, nullptr,
+                         0, nullptr,
+                         1, &Barrier);
+
+    VkBufferImageCopy Region
+    {
+      .bufferOffset = Src,
+      .bufferRowLength = 0,
+      .bufferImageHeight = 0,
+      .imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+      .imageOffset = {0, 0, 0},
+      .imageExtent = {static_cast<UINT32>(W), static_cast<UINT32>(H), 1},
+    };
+
+    vkCmdCopyBufferToImage(Cmd, StagingBuffer, Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &Region);
+
+    Barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    Barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    Barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    if (IsTransferFamily)
+    {
+      // Release ownership (layout is changed once by release and acquire pair)
+      Barrier.dstAccessMask = 0;
+      Barrier.srcQueueFamilyIndex = TransferFamily;
+      Barrier.dstQueueFamilyIndex = VlkCore.CommandFamily;
+      vkCmdPipelineBarrier(Cmd,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+                           0,
+                           0, nullptr,
+                           0, nullptr,
+                           1, &Barrier);
+      Barrier.srcAccessMask = 0;
+      Barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      AcquireImgs.push_back(Barrier);
+    }
+    else
+    {
+      Barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+      vkCmdPipelineBarrier(Cmd,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                           0,
+                           0, nullptr,
+                           0, nullptr,
+                           1, &Barrier);
+    }
+
+    if (UploadDepth == 0)
+      return UploadSubmit();
+    return UploadTicket + 1;
+  } /* End of 'vlk_upload_manager::UploadImage' function */
+
+  /* Submit recorded batch function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (UINT64) ticket of submitted batch.
+   */
+  UINT64 vlk_upload_manager::UploadSubmit( VOID )
+  {
+    if (UploadCmd == VK_NULL_HANDLE)
+      return UploadTicket;
+
+    upload_batch Batch {UploadTicket + 1, UploadCmd, VK_NULL_HANDLE, PendingStart};
+
+    // Make copied data visible for drawing commands
+    VkMemoryBarrier Barrier
+    {
+      .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+      .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+      .dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT,
+    };
+
+    if (!IsTransferFamily)
+      vkCmdPipelineBarrier(Batch.Cmd,
+                           VK_PIPELINE_STAGE_TRANSFER_BIT,
+                           VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                           0,
+                           1, &Barrier,
+                           0, nullptr,
+                           0, nullptr);
+    vkEndCommandBuffer(Batch.Cmd);
+
+    VkTimelineSemaphoreSubmitInfo TimelineInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+      .signalSemaphoreValueCount = 1,
+      .pSignalSemaphoreValues = &Batch.Ticket,
+    };
+    VkSubmitInfo SubmitInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
+      .pNext = &TimelineInfo,
+      .commandBufferCount = 1,
+      .pCommandBuffers = &Batch.Cmd,
+      .signalSemaphoreCount = 1,
+      .pSignalSemaphores = IsTransferFamily ? &TransferSemaphore : &UploadSemaphore,
+    };
+
+    if (vkQueueSubmit(TransferQueue, 1, &SubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+    {
+      throw;
+    }
+
+    if (IsTransferFamily)
+    {
+      // Command queue acquires images and makes data visible for later submitted frames
+      Batch.AcquireCmd = BeginCommandBuffer(VlkCore.Device, VlkCore.CommandPool);
+      Barrier.srcAccessMask = 0;
+      vkCmdPipelineBarrier(Batch.AcquireCmd,
+                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+                           VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                           0,
+                           1, &Barrier,
+                           0, nullptr,
+                           static_cast<UINT32>(AcquireImgs.size()), AcquireImgs.data());
+      vkEndCommandBuffer(Batch.AcquireCmd);
+
+      VkPipelineStageFlags WaitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+      TimelineInfo.waitSemaphoreValueCount = 1;
+      TimelineInfo.pWaitSemaphoreValues = &Batch.Ticket;
+      SubmitInfo.waitSemaphoreCount = 1;
+      SubmitInfo.pWaitSemaphores = &TransferSemaphore;
+      SubmitInfo.pWaitDstStageMask = &WaitStage;
+      SubmitInfo.pCommandBuffers = &Batch.AcquireCmd;
+      SubmitInfo.pSignalSemaphores = &UploadSemaphore;
+      if (vkQueueSubmit(VlkCore.CommandQueue, 1, &SubmitInfo, VK_NULL_HANDLE) != VK_SUCCESS)
+      {
+        throw;
+      }
+      AcquireImgs.clear();
+    }
+
+    UploadBatches.push_back(Batch);
+    UploadCmd = VK_NULL_HANDLE;
+    return UploadTicket = Batch.Ticket;
+  } /* End of 'vlk_upload_manager::UploadSubmit' function */
+
+  /* Release completed batches function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_upload_manager::UploadCollect( VOID )
+  {
+    if (UploadBatches.empty())
+      return;
+    if (vkGetSemaphoreCounterValue(VlkCore.Device, UploadSemaphore, &UploadCompleted) != VK_SUCCESS)
+    {
+      throw;
+    }
+
+    // Staging memory of completed batches is reused
+    while (!UploadBatches.empty() && UploadBatches.front().Ticket <= UploadCompleted)
+    {
+      upload_batch &Batch = UploadBatches.front();
+
+      vkFreeCommandBuffers(VlkCore.Device, TransferPool, 1, &Batch.Cmd);
+      if (Batch.AcquireCmd != VK_NULL_HANDLE)
+        vkFreeCommandBuffers(VlkCore.Device, VlkCore.CommandPool, 1, &Batch.AcquireCmd);
+      UploadBatches.pop_front();
+    }
+  } /* End of 'vlk_upload_manager::UploadCollect' function */
+
+  /* Wait for upload completion function.
+   * ARGUMENTS:
+   *   - ticket of batch:
+   *       UINT64 Ticket;
+   * RETURNS: None.
+   */
+  VOID vlk_upload_manager::UploadWait( UINT64 Ticket )
+  {
+    // Ticket of recorded batch
+    if (Ticket > UploadTicket)
+      Ticket = UploadSubmit();
+    if (Ticket <= UploadCompleted)
+      return;
+
+    VkSemaphoreWaitInfo WaitInfo
+    {
+      .sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+      .semaphoreCount = 1,
+      .pSemaphores = &UploadSemaphore,
+      .pValues = &Ticket,
+    };
+
+    if (vkWaitSemaphores(VlkCore.Device, &WaitInfo, UINT64_MAX) != VK_SUCCESS)
+    {
+      throw;
+    }
+    UploadCollect();
+  } /* End of 'vlk_upload_manager::UploadWait' function */
+
+  /* Free transfer queue objects and staging buffer function.
+   * ARGUMENTS: None.
+   * RETURNS: None.
+   */
+  VOID vlk_upload_manager::UploadClose( VOID )
+  {
+    UploadFlush();
+    if (StagingBuffer != VK_NULL_HANDLE)
+      vmaDestroyBuffer(VlkCore.Allocator, StagingBuffer, StagingAllocation);
+    StagingBuffer = VK_NULL_HANDLE;
+    StagingAllocation = VK_NULL_HANDLE;
+    StagingData = nullptr;
+    StagingSize = StagingHead = 0;
+
+    if (TransferPool != VK_NULL_HANDLE)
+      vkDestroyCommandPool(VlkCore.Device, TransferPool, nullptr);
+    if (UploadSemaphore != VK_NULL_HANDLE)
+      vkDestroySemaphore(VlkCore.Device, UploadSemaphore, nullptr);
+    if (TransferSemaphore != VK_NULL_HANDLE)
+      vkDestroySemaphore(VlkCore.Device, TransferSemaphore, nullptr);
+    TransferPool = VK_NULL_HANDLE;
+    UploadSemaphore = TransferSemaphore = VK_NULL_HANDLE;
+  } /* End of 'vlk_upload_manager::UploadClose' function */
+} /* end of 'pivk' namespace */
+
+/* END OF 'vlk_upload.cpp' FILE */
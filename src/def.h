@@ -82,15 +82,18 @@ static struct __Dummy
 #include <filesystem>
 #include <tuple>
 #include <optional>
+#include <functional>
 
 /* Containers header files */
 #include <vector>
 #include <list>
+#include <deque>
 #include <stack>
 #include <queue>
 #include <map>
 #include <unordered_map>
 #include <array>
+#include <span>
 #include <initializer_list>
 
 /* Streams header files */
@@ -144,6 +147,25 @@ namespace pivk
         } /* End of 'Walk' function */
     }; /* End of 'stock' class */
 
+  /* Evaluate data hash (64-bit FNV-1a) function.
+   * ARGUMENTS:
+   *   - data:
+   *       const VOID *Data;
+   *   - data size in bytes:
+   *       size_t Size;
+   * RETURNS:
+   *   (UINT64) hash value.
+   */
+  inline UINT64 HashBytes( const VOID *Data, size_t Size )
+  {
+    const BYTE *Bytes = static_cast<const BYTE *>(Data);
+    UINT64 Hash = 0xCBF29CE484222325ULL;
+
+    for (size_t i = 0; i < Size; i++)
+      Hash = (Hash ^ Bytes[i]) * 0x100000001B3ULL;
+    return Hash;
+  } /* End of 'HashBytes' function */
+
   /* Vec2 declare types */
   typedef mth::vec2<FLT>  vec2;
   typedef mth::vec2<FLT>  fvec2;
@@ -172,7 +194,22 @@ namespace pivk
   typedef mth::matr<INT>  imatr;
   typedef mth::matr<BOOL> bmatr;
 
+  /* Quaternion declare types */
+  typedef mth::quat<FLT>      quat;
+  typedef mth::quat<DBL>      dquat;
+  typedef mth::dual_quat<FLT> dual_quat;
+
   typedef mth::camera<FLT> camera;
+
+  /* Bound volumes declare types */
+  typedef mth::aabb<FLT>    aabb;
+  typedef mth::sphere<FLT>  sphere;
+  typedef mth::frustum<FLT> frustum;
+
+  /* Ray tracing declare types */
+  typedef mth::ray<FLT> ray;
+  typedef mth::hit<FLT> hit;
+  typedef mth::bvh<FLT> bvh;
 } /* end of 'pirt' namespace */
 
 
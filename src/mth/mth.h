@@ -17,12 +17,20 @@
 #define __mth_h_
 
 #include "mth_def.h"
+#include "mth_rng.h"
 #include "mth_vec2.h"
 #include "mth_vec3.h"
 #include "mth_vec4.h"
 #include "mth_matr.h"
+#include "mth_batch.h"
+#include "mth_quat.h"
 #include "mth_camera.h"
 #include "mth_ray.h"
+#include "mth_bound.h"
+#include "mth_frustum.h"
+#include "mth_isect.h"
+#include "mth_bvh.h"
+#include "mth_xpr.h"
 
 #endif // !__mth_h_
 
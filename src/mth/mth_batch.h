@@ -0,0 +1,769 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_batch.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Batched point/vector/normal transformation and bound box
+ *              evaluation over vec3 arrays (AoS, strided AoS and SoA).
+ * NOTE:        AVX2 kernels process 8 vectors per iteration, other CPUs
+ *              use scalar fallback (see 'mth_matr_simd.h' dispatch).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_batch_h_
+#define __mth_batch_h_
+
+#include <span>
+#include <type_traits>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_matr.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Structure of arrays 3D vectors view.
+   * Type is 'FLT' for destination and 'const FLT' for source views.
+   */
+  template<typename Type>
+    struct vec3_soa
+    {
+      std::span<Type>
+        X, Y, Z; // Components arrays (of same size)
+
+      /* Get number of vectors function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (size_t) number of vectors.
+       */
+      size_t size( VOID ) const
+      {
+        return X.size();
+      } /* End of 'size' function */
+    }; /* End of 'vec3_soa' structure */
+
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+    /* Batch transformation mode */
+    enum class batch_mode
+    {
+      POINT,  // (V, 1) * M
+      VECTOR, // (V, 0) * M
+      NORMAL, // (V, 0) * M with normalization
+    }; /* End of 'batch_mode' enum */
+
+    /* 3 components stream description structure.
+     * Components of element i are at (X|Y|Z + i * Stride bytes).
+     */
+    template<typename Type>
+      struct stream3
+      {
+        Type *X, *Y, *Z; // First element components
+        size_t Stride;   // Element stride in bytes
+      }; /* End of 'stream3' structure */
+
+    /* Get stream element component pointer function.
+     * ARGUMENTS:
+     *   - component pointer of first element:
+     *       Type *P;
+     *   - element index:
+     *       size_t Index;
+     *   - element stride in bytes:
+     *       size_t Stride;
+     * RETURNS:
+     *   (Type *) component pointer.
+     */
+    template<typename Type>
+      inline Type * StreamAt( Type *P, size_t Index, size_t Stride )
+      {
+        using byte_type = std::conditional_t<std::is_const_v<Type>, const BYTE, BYTE>;
+
+        return reinterpret_cast<Type *>(reinterpret_cast<byte_type *>(P) + Index * Stride);
+      } /* End of 'StreamAt' function */
+
+    /* Transform stream scalar kernel function.
+     * ARGUMENTS:
+     *   - 3x4 matrix to apply (normal matrix for NORMAL mode):
+     *       const FLT A[4][4];
+     *   - transformation mode:
+     *       batch_mode Mode;
+     *   - source and destination streams:
+     *       const stream3<const FLT> &Src;
+     *       const stream3<FLT> &Dst;
+     *   - elements range:
+     *       size_t Start, Count;
+     * RETURNS: None.
+     */
+    inline VOID TransformStreamScalar( const FLT A[4][4], batch_mode Mode,
+                                       const stream3<const FLT> &Src, const stream3<FLT> &Dst,
+                                       size_t Start, size_t Count )
+    {
+      FLT W = Mode == batch_mode::POINT ? 1.0f : 0.0f;
+
+      for (size_t i = Start; i < Count; i++)
+      {
+        FLT
+          X = *StreamAt(Src.X, i, Src.Stride),
+          Y = *StreamAt(Src.Y, i, Src.Stride),
+          Z = *StreamAt(Src.Z, i, Src.Stride),
+          RX = X * A[0][0] + Y * A[1][0] + Z * A[2][0] + W * A[3][0],
+          RY = X * A[0][1] + Y * A[1][1] + Z * A[2][1] + W * A[3][1],
+          RZ = X * A[0][2] + Y * A[1][2] + Z * A[2][2] + W * A[3][2];
+
+        if (Mode == batch_mode::NORMAL)
+        {
+          FLT Len2 = RX * RX + RY * RY + RZ * RZ;
+
+          if (Len2 != 0 && Len2 != 1)
+          {
+            FLT Len = std::sqrt(Len2);
+
+            RX /= Len, RY /= Len, RZ /= Len;
+          }
+        }
+        *StreamAt(Dst.X, i, Dst.Stride) = RX;
+        *StreamAt(Dst.Y, i, Dst.Stride) = RY;
+        *StreamAt(Dst.Z, i, Dst.Stride) = RZ;
+      }
+    } /* End of 'TransformStreamScalar' function */
+
+    /* Bound box of stream scalar kernel function.
+     * ARGUMENTS:
+     *   - source stream:
+     *       const stream3<const FLT> &Src;
+     *   - elements range:
+     *       size_t Start, Count;
+     *   - bound box to extend:
+     *       FLT Min[3], Max[3];
+     * RETURNS: None.
+     */
+    inline VOID BoundsStreamScalar( const stream3<const FLT> &Src, size_t Start, size_t Count, FLT Min[3], FLT Max[3] )
+    {
+      for (size_t i = Start; i < Count; i++)
+      {
+        FLT
+          X = *StreamAt(Src.X, i, Src.Stride),
+          Y = *StreamAt(Src.Y, i, Src.Stride),
+          Z = *StreamAt(Src.Z, i, Src.Stride);
+
+        Min[0] = X < Min[0] ? X : Min[0], Max[0] = X > Max[0] ? X : Max[0];
+        Min[1] = Y < Min[1] ? Y : Min[1], Max[1] = Y > Max[1] ? Y : Max[1];
+        Min[2] = Z < Min[2] ? Z : Min[2], Max[2] = Z > Max[2] ? Z : Max[2];
+      }
+    } /* End of 'BoundsStreamScalar' function */
+
+#if defined(USE_MTH_MATR_SIMD)
+    /* Load 8 stream elements to SoA registers AVX2 function.
+     * Packed (stride 12) streams are deinterleaved with shuffles,
+     * SoA (stride 4) streams are loaded directly, others are gathered.
+     * ARGUMENTS:
+     *   - source stream:
+     *       const stream3<const FLT> &Src;
+     *   - first element index:
+     *       size_t Index;
+     *   - loaded components:
+     *       __m256 &X, &Y, &Z;
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID Load8AVX2( const stream3<const FLT> &Src, size_t Index, __m256 &X, __m256 &Y, __m256 &Z )
+    {
+      const FLT
+        *PX = StreamAt(Src.X, Index, Src.Stride),
+        *PY = StreamAt(Src.Y, Index, Src.Stride),
+        *PZ = StreamAt(Src.Z, Index, Src.Stride);
+
+      if (Src.Stride == sizeof(FLT))
+      {
+        X = _mm256_loadu_ps(PX);
+        Y = _mm256_loadu_ps(PY);
+        Z = _mm256_loadu_ps(PZ);
+      }
+      else if (Src.Stride == 3 * sizeof(FLT) && PY == PX + 1 && PZ == PX + 2)
+      {
+        __m256
+          M03 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(PX + 0)), _mm_loadu_ps(PX + 12), 1),
+          M14 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(PX + 4)), _mm_loadu_ps(PX + 16), 1),
+          M25 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(PX + 8)), _mm_loadu_ps(PX + 20), 1),
+          XY = _mm256_shuffle_ps(M14, M25, _MM_SHUFFLE(2, 1, 3, 2)),
+          YZ = _mm256_shuffle_ps(M03, M14, _MM_SHUFFLE(1, 0, 2, 1));
+
+        X = _mm256_shuffle_ps(M03, XY, _MM_SHUFFLE(2, 0, 3, 0));
+        Y = _mm256_shuffle_ps(YZ, XY, _MM_SHUFFLE(3, 1, 2, 0));
+        Z = _mm256_shuffle_ps(YZ, M25, _MM_SHUFFLE(3, 0, 3, 1));
+      }
+      else
+      {
+        __m256i Idx = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                         _mm256_set1_epi32(static_cast<INT>(Src.Stride / sizeof(FLT))));
+
+        X = _mm256_i32gather_ps(PX, Idx, sizeof(FLT));
+        Y = _mm256_i32gather_ps(PY, Idx, sizeof(FLT));
+        Z = _mm256_i32gather_ps(PZ, Idx, sizeof(FLT));
+      }
+    } /* End of 'Load8AVX2' function */
+
+    /* Store 8 SoA registers to stream elements AVX2 function.
+     * ARGUMENTS:
+     *   - destination stream:
+     *       const stream3<FLT> &Dst;
+     *   - first element index:
+     *       size_t Index;
+     *   - components to store:
+     *       __m256 X, Y, Z;
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID Store8AVX2( const stream3<FLT> &Dst, size_t Index, __m256 X, __m256 Y, __m256 Z )
+    {
+      FLT
+        *PX = StreamAt(Dst.X, Index, Dst.Stride),
+        *PY = StreamAt(Dst.Y, Index, Dst.Stride),
+        *PZ = StreamAt(Dst.Z, Index, Dst.Stride);
+
+      if (Dst.Stride == sizeof(FLT))
+      {
+        _mm256_storeu_ps(PX, X);
+        _mm256_storeu_ps(PY, Y);
+        _mm256_storeu_ps(PZ, Z);
+      }
+      else if (Dst.Stride == 3 * sizeof(FLT) && PY == PX + 1 && PZ == PX + 2)
+      {
+        __m256
+          RXY = _mm256_shuffle_ps(X, Y, _MM_SHUFFLE(2, 0, 2, 0)),
+          RYZ = _mm256_shuffle_ps(Y, Z, _MM_SHUFFLE(3, 1, 3, 1)),
+          RZX = _mm256_shuffle_ps(Z, X, _MM_SHUFFLE(3, 1, 2, 0)),
+          R03 = _mm256_shuffle_ps(RXY, RZX, _MM_SHUFFLE(2, 0, 2, 0)),
+          R14 = _mm256_shuffle_ps(RYZ, RXY, _MM_SHUFFLE(3, 1, 2, 0)),
+          R25 = _mm256_shuffle_ps(RZX, RYZ, _MM_SHUFFLE(3, 1, 3, 1));
+
+        _mm_storeu_ps(PX + 0, _mm256_castps256_ps128(R03));
+        _mm_storeu_ps(PX + 4, _mm256_castps256_ps128(R14));
+        _mm_storeu_ps(PX + 8, _mm256_castps256_ps128(R25));
+        _mm_storeu_ps(PX + 12, _mm256_extractf128_ps(R03, 1));
+        _mm_storeu_ps(PX + 16, _mm256_extractf128_ps(R14, 1));
+        _mm_storeu_ps(PX + 20, _mm256_extractf128_ps(R25, 1));
+      }
+      else
+      {
+        alignas(32) FLT TX[8], TY[8], TZ[8];
+
+        _mm256_store_ps(TX, X);
+        _mm256_store_ps(TY, Y);
+        _mm256_store_ps(TZ, Z);
+        for (INT i = 0; i < 8; i++)
+        {
+          *StreamAt(PX, i, Dst.Stride) = TX[i];
+          *StreamAt(PY, i, Dst.Stride) = TY[i];
+          *StreamAt(PZ, i, Dst.Stride) = TZ[i];
+        }
+      }
+    } /* End of 'Store8AVX2' function */
+
+    /* Load 8 packed 4-component elements to SoA registers AVX2 function.
+     * ARGUMENTS:
+     *   - first element components (X, Y, Z, W packed):
+     *       const FLT *P;
+     *   - components:
+     *       __m256 &X, &Y, &Z, &W;
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID Load8x4AVX2( const FLT *P, __m256 &X, __m256 &Y, __m256 &Z, __m256 &W )
+    {
+      __m256
+        R0 = _mm256_loadu_ps(P + 0),
+        R1 = _mm256_loadu_ps(P + 8),
+        R2 = _mm256_loadu_ps(P + 16),
+        R3 = _mm256_loadu_ps(P + 24),
+        T0 = _mm256_permute2f128_ps(R0, R2, 0x20),
+        T1 = _mm256_permute2f128_ps(R0, R2, 0x31),
+        T2 = _mm256_permute2f128_ps(R1, R3, 0x20),
+        T3 = _mm256_permute2f128_ps(R1, R3, 0x31),
+        A = _mm256_unpacklo_ps(T0, T1),
+        B = _mm256_unpackhi_ps(T0, T1),
+        C = _mm256_unpacklo_ps(T2, T3),
+        D = _mm256_unpackhi_ps(T2, T3);
+
+      X = _mm256_shuffle_ps(A, C, 0x44);
+      Y = _mm256_shuffle_ps(A, C, 0xEE);
+      Z = _mm256_shuffle_ps(B, D, 0x44);
+      W = _mm256_shuffle_ps(B, D, 0xEE);
+    } /* End of 'Load8x4AVX2' function */
+
+    /* Store SoA registers to 8 packed 4-component elements AVX2 function.
+     * ARGUMENTS:
+     *   - first element components (X, Y, Z, W packed):
+     *       FLT *P;
+     *   - components:
+     *       __m256 X, Y, Z, W;
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID Store8x4AVX2( FLT *P, __m256 X, __m256 Y, __m256 Z, __m256 W )
+    {
+      __m256
+        A = _mm256_unpacklo_ps(X, Y),
+        B = _mm256_unpackhi_ps(X, Y),
+        C = _mm256_unpacklo_ps(Z, W),
+        D = _mm256_unpackhi_ps(Z, W),
+        T0 = _mm256_shuffle_ps(A, C, 0x44),
+        T1 = _mm256_shuffle_ps(A, C, 0xEE),
+        T2 = _mm256_shuffle_ps(B, D, 0x44),
+        T3 = _mm256_shuffle_ps(B, D, 0xEE);
+
+      _mm256_storeu_ps(P + 0, _mm256_permute2f128_ps(T0, T1, 0x20));
+      _mm256_storeu_ps(P + 8, _mm256_permute2f128_ps(T2, T3, 0x20));
+      _mm256_storeu_ps(P + 16, _mm256_permute2f128_ps(T0, T1, 0x31));
+      _mm256_storeu_ps(P + 24, _mm256_permute2f128_ps(T2, T3, 0x31));
+    } /* End of 'Store8x4AVX2' function */
+
+    /* Transform stream AVX2 kernel function.
+     * ARGUMENTS:
+     *   - 3x4 matrix to apply (normal matrix for NORMAL mode):
+     *       const FLT A[4][4];
+     *   - transformation mode:
+     *       batch_mode Mode;
+     *   - source and destination streams:
+     *       const stream3<const FLT> &Src;
+     *       const stream3<FLT> &Dst;
+     *   - number of elements:
+     *       size_t Count;
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID TransformStreamAVX2( const FLT A[4][4], batch_mode Mode,
+                                                     const stream3<const FLT> &Src, const stream3<FLT> &Dst,
+                                                     size_t Count )
+    {
+      __m256 M[4][3];
+      size_t i = 0;
+
+      for (INT r = 0; r < 4; r++)
+        for (INT c = 0; c < 3; c++)
+          M[r][c] = _mm256_set1_ps(Mode == batch_mode::POINT || r < 3 ? A[r][c] : 0.0f);
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256 X, Y, Z;
+
+        Load8AVX2(Src, i, X, Y, Z);
+
+        __m256
+          RX = _mm256_fmadd_ps(Z, M[2][0], _mm256_fmadd_ps(Y, M[1][0], _mm256_fmadd_ps(X, M[0][0], M[3][0]))),
+          RY = _mm256_fmadd_ps(Z, M[2][1], _mm256_fmadd_ps(Y, M[1][1], _mm256_fmadd_ps(X, M[0][1], M[3][1]))),
+          RZ = _mm256_fmadd_ps(Z, M[2][2], _mm256_fmadd_ps(Y, M[1][2], _mm256_fmadd_ps(X, M[0][2], M[3][2])));
+
+        if (Mode == batch_mode::NORMAL)
+        {
+          __m256
+            Len2 = _mm256_fmadd_ps(RZ, RZ, _mm256_fmadd_ps(RY, RY, _mm256_mul_ps(RX, RX))),
+            Zero = _mm256_cmp_ps(Len2, _mm256_setzero_ps(), _CMP_EQ_OQ),
+            InvLen = _mm256_div_ps(_mm256_set1_ps(1), _mm256_sqrt_ps(Len2));
+
+          InvLen = _mm256_blendv_ps(InvLen, _mm256_set1_ps(1), Zero);
+          RX = _mm256_mul_ps(RX, InvLen);
+          RY = _mm256_mul_ps(RY, InvLen);
+          RZ = _mm256_mul_ps(RZ, InvLen);
+        }
+        Store8AVX2(Dst, i, RX, RY, RZ);
+      }
+      TransformStreamScalar(A, Mode, Src, Dst, i, Count);
+    } /* End of 'TransformStreamAVX2' function */
+
+    /* Bound box of stream AVX2 kernel function.
+     * ARGUMENTS:
+     *   - source stream:
+     *       const stream3<const FLT> &Src;
+     *   - number of elements:
+     *       size_t Count;
+     *   - bound box to extend:
+     *       FLT Min[3], Max[3];
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID BoundsStreamAVX2( const stream3<const FLT> &Src, size_t Count, FLT Min[3], FLT Max[3] )
+    {
+      size_t i = 0;
+
+      if (Count >= 8)
+      {
+        __m256 MinX, MinY, MinZ, MaxX, MaxY, MaxZ;
+
+        Load8AVX2(Src, 0, MinX, MinY, MinZ);
+        MaxX = MinX, MaxY = MinY, MaxZ = MinZ;
+        for (i = 8; i + 8 <= Count; i += 8)
+        {
+          __m256 X, Y, Z;
+
+          Load8AVX2(Src, i, X, Y, Z);
+          MinX = _mm256_min_ps(MinX, X), MaxX = _mm256_max_ps(MaxX, X);
+          MinY = _mm256_min_ps(MinY, Y), MaxY = _mm256_max_ps(MaxY, Y);
+          MinZ = _mm256_min_ps(MinZ, Z), MaxZ = _mm256_max_ps(MaxZ, Z);
+        }
+
+        alignas(32) FLT T[6][8];
+
+        _mm256_store_ps(T[0], MinX);
+        _mm256_store_ps(T[1], MinY);
+        _mm256_store_ps(T[2], MinZ);
+        _mm256_store_ps(T[3], MaxX);
+        _mm256_store_ps(T[4], MaxY);
+        _mm256_store_ps(T[5], MaxZ);
+        for (INT c = 0; c < 3; c++)
+          for (INT k = 0; k < 8; k++)
+          {
+            Min[c] = T[c][k] < Min[c] ? T[c][k] : Min[c];
+            Max[c] = T[c + 3][k] > Max[c] ? T[c + 3][k] : Max[c];
+          }
+      }
+      BoundsStreamScalar(Src, i, Count, Min, Max);
+    } /* End of 'BoundsStreamAVX2' function */
+#endif // USE_MTH_MATR_SIMD
+
+    /* Check AVX2 batch kernels usage function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (BOOL) TRUE if AVX2 kernels are selected.
+     */
+    inline BOOL IsBatchAVX2( VOID )
+    {
+#if defined(USE_MTH_MATR_SIMD)
+      return GetKernels().Level == level::AVX2;
+#else  // USE_MTH_MATR_SIMD
+      return FALSE;
+#endif // USE_MTH_MATR_SIMD
+    } /* End of 'IsBatchAVX2' function */
+
+    /* Transform stream with dispatch function.
+     * ARGUMENTS:
+     *   - matrix:
+     *       const matr<FLT> &M;
+     *   - transformation mode:
+     *       batch_mode Mode;
+     *   - source and destination streams:
+     *       const stream3<const FLT> &Src;
+     *       const stream3<FLT> &Dst;
+     *   - number of elements:
+     *       size_t Count;
+     * RETURNS: None.
+     */
+    inline VOID TransformStream( const matr<FLT> &M, batch_mode Mode,
+                                 const stream3<const FLT> &Src, const stream3<FLT> &Dst, size_t Count )
+    {
+      // Normals are transformed by inverse transposed matrix (evaluated once per batch)
+      matr<FLT> A = Mode == batch_mode::NORMAL ? M.Transpose().Inverse() : M;
+
+      assert(Src.Stride % sizeof(FLT) == 0 && Dst.Stride % sizeof(FLT) == 0);
+#if defined(USE_MTH_MATR_SIMD)
+      if (IsBatchAVX2())
+      {
+        TransformStreamAVX2(A.M, Mode, Src, Dst, Count);
+        return;
+      }
+#endif // USE_MTH_MATR_SIMD
+      TransformStreamScalar(A.M, Mode, Src, Dst, 0, Count);
+    } /* End of 'TransformStream' function */
+
+    /* Bound box of stream with dispatch function.
+     * ARGUMENTS:
+     *   - source stream:
+     *       const stream3<const FLT> &Src;
+     *   - number of elements:
+     *       size_t Count;
+     *   - result bound box (zero for empty stream):
+     *       vec3<FLT> &Min, &Max;
+     * RETURNS: None.
+     */
+    inline VOID BoundsStream( const stream3<const FLT> &Src, size_t Count, vec3<FLT> &Min, vec3<FLT> &Max )
+    {
+      if (Count == 0)
+      {
+        Min = Max = vec3<FLT>(0);
+        return;
+      }
+
+      FLT
+        Mn[3] = {*Src.X, *Src.Y, *Src.Z},
+        Mx[3] = {*Src.X, *Src.Y, *Src.Z};
+
+      assert(Src.Stride % sizeof(FLT) == 0);
+#if defined(USE_MTH_MATR_SIMD)
+      if (IsBatchAVX2())
+        BoundsStreamAVX2(Src, Count, Mn, Mx);
+      else
+#endif // USE_MTH_MATR_SIMD
+        BoundsStreamScalar(Src, 0, Count, Mn, Mx);
+      Min = vec3<FLT>(Mn[0], Mn[1], Mn[2]);
+      Max = vec3<FLT>(Mx[0], Mx[1], Mx[2]);
+    } /* End of 'BoundsStream' function */
+
+    /* Make stream from packed vectors array function.
+     * ARGUMENTS:
+     *   - first vector:
+     *       Type *V;
+     * RETURNS:
+     *   (stream3) stream.
+     */
+    template<typename vec_type>
+      inline auto PackedStream( vec_type *V )
+      {
+        using flt_type = std::conditional_t<std::is_const_v<vec_type>, const FLT, FLT>;
+
+        return stream3<flt_type> {&V->X, &V->Y, &V->Z, sizeof(vec3<FLT>)};
+      } /* End of 'PackedStream' function */
+
+    /* Make stream from SoA view function.
+     * ARGUMENTS:
+     *   - SoA view:
+     *       const vec3_soa<Type> &V;
+     * RETURNS:
+     *   (stream3) stream.
+     */
+    template<typename Type>
+      inline stream3<Type> SoAStream( const vec3_soa<Type> &V )
+      {
+        assert(V.Y.size() == V.X.size() && V.Z.size() == V.X.size());
+        return stream3<Type> {V.X.data(), V.Y.data(), V.Z.data(), sizeof(FLT)};
+      } /* End of 'SoAStream' function */
+
+    /* Make stream from vertex array field function.
+     * ARGUMENTS:
+     *   - first vertex:
+     *       vertex_type *V;
+     *   - vertex vector field:
+     *       field_type vertex_type::*Field;
+     * RETURNS:
+     *   (stream3) stream.
+     */
+    template<typename vertex_type, typename field_type>
+      inline auto FieldStream( vertex_type *V, field_type std::remove_const_t<vertex_type>::*Field )
+      {
+        using flt_type = std::conditional_t<std::is_const_v<vertex_type>, const FLT, FLT>;
+        auto &F = V->*Field;
+
+        return stream3<flt_type> {&F.X, &F.Y, &F.Z, sizeof(vertex_type)};
+      } /* End of 'FieldStream' function */
+  } /* end of 'simd' namespace */
+
+  /***
+   * Packed arrays (std::span<vec3>)
+   ***/
+
+  /* Transform points array function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source points:
+   *       std::span<const vec3<FLT>> Src;
+   *   - destination points (may be same as source, size >= source size):
+   *       std::span<vec3<FLT>> Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformPoints( const matr<FLT> &M, std::span<const vec3<FLT>> Src, std::span<vec3<FLT>> Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (!Src.empty())
+      simd::TransformStream(M, simd::batch_mode::POINT, simd::PackedStream(Src.data()), simd::PackedStream(Dst.data()), Src.size());
+  } /* End of 'TransformPoints' function */
+
+  /* Transform vectors array function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source vectors:
+   *       std::span<const vec3<FLT>> Src;
+   *   - destination vectors (may be same as source, size >= source size):
+   *       std::span<vec3<FLT>> Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformVectors( const matr<FLT> &M, std::span<const vec3<FLT>> Src, std::span<vec3<FLT>> Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (!Src.empty())
+      simd::TransformStream(M, simd::batch_mode::VECTOR, simd::PackedStream(Src.data()), simd::PackedStream(Dst.data()), Src.size());
+  } /* End of 'TransformVectors' function */
+
+  /* Transform normals array (by inverse transposed matrix, with normalization) function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source normals:
+   *       std::span<const vec3<FLT>> Src;
+   *   - destination normals (may be same as source, size >= source size):
+   *       std::span<vec3<FLT>> Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformNormals( const matr<FLT> &M, std::span<const vec3<FLT>> Src, std::span<vec3<FLT>> Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (!Src.empty())
+      simd::TransformStream(M, simd::batch_mode::NORMAL, simd::PackedStream(Src.data()), simd::PackedStream(Dst.data()), Src.size());
+  } /* End of 'TransformNormals' function */
+
+  /* Compute points array bound box function.
+   * ARGUMENTS:
+   *   - points:
+   *       std::span<const vec3<FLT>> Src;
+   *   - result bound box (zero for empty array):
+   *       vec3<FLT> &Min, &Max;
+   * RETURNS: None.
+   */
+  inline VOID ComputeBounds( std::span<const vec3<FLT>> Src, vec3<FLT> &Min, vec3<FLT> &Max )
+  {
+    if (Src.empty())
+      Min = Max = vec3<FLT>(0);
+    else
+      simd::BoundsStream(simd::PackedStream(Src.data()), Src.size(), Min, Max);
+  } /* End of 'ComputeBounds' function */
+
+  /***
+   * Structure of arrays (vec3_soa)
+   ***/
+
+  /* Transform SoA points function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source and destination points (may be same):
+   *       const vec3_soa<const FLT> &Src;
+   *       const vec3_soa<FLT> &Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformPoints( const matr<FLT> &M, const vec3_soa<const FLT> &Src, const vec3_soa<FLT> &Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (Src.size() != 0)
+      simd::TransformStream(M, simd::batch_mode::POINT, simd::SoAStream(Src), simd::SoAStream(Dst), Src.size());
+  } /* End of 'TransformPoints' function */
+
+  /* Transform SoA vectors function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source and destination vectors (may be same):
+   *       const vec3_soa<const FLT> &Src;
+   *       const vec3_soa<FLT> &Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformVectors( const matr<FLT> &M, const vec3_soa<const FLT> &Src, const vec3_soa<FLT> &Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (Src.size() != 0)
+      simd::TransformStream(M, simd::batch_mode::VECTOR, simd::SoAStream(Src), simd::SoAStream(Dst), Src.size());
+  } /* End of 'TransformVectors' function */
+
+  /* Transform SoA normals (by inverse transposed matrix, with normalization) function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - source and destination normals (may be same):
+   *       const vec3_soa<const FLT> &Src;
+   *       const vec3_soa<FLT> &Dst;
+   * RETURNS: None.
+   */
+  inline VOID TransformNormals( const matr<FLT> &M, const vec3_soa<const FLT> &Src, const vec3_soa<FLT> &Dst )
+  {
+    assert(Dst.size() >= Src.size());
+    if (Src.size() != 0)
+      simd::TransformStream(M, simd::batch_mode::NORMAL, simd::SoAStream(Src), simd::SoAStream(Dst), Src.size());
+  } /* End of 'TransformNormals' function */
+
+  /* Compute SoA points bound box function.
+   * ARGUMENTS:
+   *   - points:
+   *       const vec3_soa<const FLT> &Src;
+   *   - result bound box (zero for empty array):
+   *       vec3<FLT> &Min, &Max;
+   * RETURNS: None.
+   */
+  inline VOID ComputeBounds( const vec3_soa<const FLT> &Src, vec3<FLT> &Min, vec3<FLT> &Max )
+  {
+    if (Src.size() == 0)
+      Min = Max = vec3<FLT>(0);
+    else
+      simd::BoundsStream(simd::SoAStream(Src), Src.size(), Min, Max);
+  } /* End of 'ComputeBounds' function */
+
+  /***
+   * Vertex arrays (vec3 field of vertex structure, in place)
+   ***/
+
+  /* Transform vertex points field in place function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - vertices:
+   *       std::span<vertex_type> V;
+   *   - vertex point field (for example '&vertex::std::P'):
+   *       vec3<FLT> vertex_type::*Field;
+   * RETURNS: None.
+   */
+  template<typename vertex_type>
+    inline VOID TransformPoints( const matr<FLT> &M, std::span<vertex_type> V, vec3<FLT> vertex_type::*Field )
+    {
+      if (!V.empty())
+        simd::TransformStream(M, simd::batch_mode::POINT,
+                              simd::FieldStream<const vertex_type>(V.data(), Field), simd::FieldStream(V.data(), Field), V.size());
+    } /* End of 'TransformPoints' function */
+
+  /* Transform vertex vectors field in place function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - vertices:
+   *       std::span<vertex_type> V;
+   *   - vertex vector field:
+   *       vec3<FLT> vertex_type::*Field;
+   * RETURNS: None.
+   */
+  template<typename vertex_type>
+    inline VOID TransformVectors( const matr<FLT> &M, std::span<vertex_type> V, vec3<FLT> vertex_type::*Field )
+    {
+      if (!V.empty())
+        simd::TransformStream(M, simd::batch_mode::VECTOR,
+                              simd::FieldStream<const vertex_type>(V.data(), Field), simd::FieldStream(V.data(), Field), V.size());
+    } /* End of 'TransformVectors' function */
+
+  /* Transform vertex normals field in place function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const matr<FLT> &M;
+   *   - vertices:
+   *       std::span<vertex_type> V;
+   *   - vertex normal field (for example '&vertex::std::N'):
+   *       vec3<FLT> vertex_type::*Field;
+   * RETURNS: None.
+   */
+  template<typename vertex_type>
+    inline VOID TransformNormals( const matr<FLT> &M, std::span<vertex_type> V, vec3<FLT> vertex_type::*Field )
+    {
+      if (!V.empty())
+        simd::TransformStream(M, simd::batch_mode::NORMAL,
+                              simd::FieldStream<const vertex_type>(V.data(), Field), simd::FieldStream(V.data(), Field), V.size());
+    } /* End of 'TransformNormals' function */
+
+  /* Compute vertex points field bound box function.
+   * ARGUMENTS:
+   *   - vertices:
+   *       std::span<const vertex_type> V;
+   *   - vertex point field:
+   *       vec3<FLT> vertex_type::*Field;
+   *   - result bound box (zero for empty array):
+   *       vec3<FLT> &Min, &Max;
+   * RETURNS: None.
+   */
+  template<typename vertex_type>
+    inline VOID ComputeBounds( std::span<const vertex_type> V, vec3<FLT> vertex_type::*Field, vec3<FLT> &Min, vec3<FLT> &Max )
+    {
+      if (V.empty())
+        Min = Max = vec3<FLT>(0);
+      else
+        simd::BoundsStream(simd::FieldStream(V.data(), Field), V.size(), Min, Max);
+    } /* End of 'ComputeBounds' function */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_batch_h_
+
+/* END OF 'mth_batch.h' FILE */
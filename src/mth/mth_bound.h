@@ -0,0 +1,243 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_bound.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Bound volumes (box and sphere) header file.
+ * NOTE:        None.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_bound_h_
+#define __mth_bound_h_
+
+#include <limits>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_matr.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Axis aligned bound box type */
+  template<typename Type>
+    class aabb
+    {
+    public:
+      vec3<Type>
+        Min, Max; // Box corners
+
+      /* Default constructor (empty box) */
+      aabb() :
+        Min(std::numeric_limits<Type>::max()),
+        Max(std::numeric_limits<Type>::lowest())
+      {
+      } /* End of 'aabb' function */
+
+      /* Constructor by corners.
+       * ARGUMENTS:
+       *   - box corners:
+       *       const vec3<Type> &NewMin, &NewMax;
+       */
+      aabb( const vec3<Type> &NewMin, const vec3<Type> &NewMax ) : Min(NewMin), Max(NewMax)
+      {
+      } /* End of 'aabb' function */
+
+      /* Check box emptiness function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if box contains no points.
+       */
+      BOOL IsEmpty() const
+      {
+        return Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z;
+      } /* End of 'IsEmpty' function */
+
+      /* Get box center function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (vec3<Type>) box center.
+       */
+      vec3<Type> Center() const
+      {
+        return (Min + Max) * Type(0.5);
+      } /* End of 'Center' function */
+
+      /* Get box half size function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (vec3<Type>) box half size.
+       */
+      vec3<Type> Extent() const
+      {
+        return (Max - Min) * Type(0.5);
+      } /* End of 'Extent' function */
+
+      /* Check point inside box function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3<Type> &P;
+       * RETURNS:
+       *   (BOOL) TRUE if point is inside.
+       */
+      BOOL IsInside( const vec3<Type> &P ) const
+      {
+        return P.X >= Min.X && P.Y >= Min.Y && P.Z >= Min.Z &&
+               P.X <= Max.X && P.Y <= Max.Y && P.Z <= Max.Z;
+      } /* End of 'IsInside' function */
+
+      /* Boxes intersection check function.
+       * ARGUMENTS:
+       *   - other box:
+       *       const aabb &B;
+       * RETURNS:
+       *   (BOOL) TRUE if boxes overlap.
+       */
+      BOOL IsOverlap( const aabb &B ) const
+      {
+        return Min.X <= B.Max.X && Min.Y <= B.Max.Y && Min.Z <= B.Max.Z &&
+               B.Min.X <= Max.X && B.Min.Y <= Max.Y && B.Min.Z <= Max.Z;
+      } /* End of 'IsOverlap' function */
+
+      /* Extend box by point function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3<Type> &P;
+       * RETURNS:
+       *   (aabb &) self reference.
+       */
+      aabb & operator|=( const vec3<Type> &P )
+      {
+        Min = vec3<Type>(P.X < Min.X ? P.X : Min.X, P.Y < Min.Y ? P.Y : Min.Y, P.Z < Min.Z ? P.Z : Min.Z);
+        Max = vec3<Type>(P.X > Max.X ? P.X : Max.X, P.Y > Max.Y ? P.Y : Max.Y, P.Z > Max.Z ? P.Z : Max.Z);
+        return *this;
+      } /* End of 'operator|=' function */
+
+      /* Extend box by other box function.
+       * ARGUMENTS:
+       *   - other box:
+       *       const aabb &B;
+       * RETURNS:
+       *   (aabb &) self reference.
+       */
+      aabb & operator|=( const aabb &B )
+      {
+        if (!B.IsEmpty())
+          *this |= B.Min, *this |= B.Max;
+        return *this;
+      } /* End of 'operator|=' function */
+
+      /* Boxes union function.
+       * ARGUMENTS:
+       *   - other box:
+       *       const aabb &B;
+       * RETURNS:
+       *   (aabb) union box.
+       */
+      aabb operator|( const aabb &B ) const
+      {
+        return aabb(*this) |= B;
+      } /* End of 'operator|' function */
+
+      /* Transform box function (box of transformed box).
+       * ARGUMENTS:
+       *   - affine transformation matrix:
+       *       const matr<Type> &M;
+       * RETURNS:
+       *   (aabb) transformed box.
+       */
+      aabb Transform( const matr<Type> &M ) const
+      {
+        if (IsEmpty())
+          return *this;
+
+        vec3<Type>
+          C = Center(),
+          Ext = Extent(),
+          NC(C.X * M.M[0][0] + C.Y * M.M[1][0] + C.Z * M.M[2][0] + M.M[3][0],
+             C.X * M.M[0][1] + C.Y * M.M[1][1] + C.Z * M.M[2][1] + M.M[3][1],
+             C.X * M.M[0][2] + C.Y * M.M[1][2] + C.Z * M.M[2][2] + M.M[3][2]),
+          NE(Ext.X * fabs(M.M[0][0]) + Ext.Y * fabs(M.M[1][0]) + Ext.Z * fabs(M.M[2][0]),
+             Ext.X * fabs(M.M[0][1]) + Ext.Y * fabs(M.M[1][1]) + Ext.Z * fabs(M.M[2][1]),
+             Ext.X * fabs(M.M[0][2]) + Ext.Y * fabs(M.M[1][2]) + Ext.Z * fabs(M.M[2][2]));
+
+        return aabb(NC - NE, NC + NE);
+      } /* End of 'Transform' function */
+    }; /* End of 'aabb' class */
+
+  /* Bound sphere type */
+  template<typename Type>
+    class sphere
+    {
+    public:
+      vec3<Type> C; // Sphere center
+      Type R;       // Sphere radius
+
+      /* Default constructor */
+      sphere() : R(0)
+      {
+      } /* End of 'sphere' function */
+
+      /* Constructor by center and radius.
+       * ARGUMENTS:
+       *   - sphere center:
+       *       const vec3<Type> &NewC;
+       *   - sphere radius:
+       *       Type NewR;
+       */
+      sphere( const vec3<Type> &NewC, Type NewR ) : C(NewC), R(NewR)
+      {
+      } /* End of 'sphere' function */
+
+      /* Sphere around box constructor.
+       * ARGUMENTS:
+       *   - box:
+       *       const aabb<Type> &B;
+       */
+      explicit sphere( const aabb<Type> &B ) : C(B.Center()), R(!B.Extent())
+      {
+      } /* End of 'sphere' function */
+
+      /* Check point inside sphere function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3<Type> &P;
+       * RETURNS:
+       *   (BOOL) TRUE if point is inside.
+       */
+      BOOL IsInside( const vec3<Type> &P ) const
+      {
+        vec3<Type> D = P - C;
+
+        return (D & D) <= R * R;
+      } /* End of 'IsInside' function */
+
+      /* Transform sphere function (sphere of transformed sphere).
+       * ARGUMENTS:
+       *   - affine transformation matrix:
+       *       const matr<Type> &M;
+       * RETURNS:
+       *   (sphere) transformed sphere.
+       */
+      sphere Transform( const matr<Type> &M ) const
+      {
+        Type
+          S0 = M.M[0][0] * M.M[0][0] + M.M[0][1] * M.M[0][1] + M.M[0][2] * M.M[0][2],
+          S1 = M.M[1][0] * M.M[1][0] + M.M[1][1] * M.M[1][1] + M.M[1][2] * M.M[1][2],
+          S2 = M.M[2][0] * M.M[2][0] + M.M[2][1] * M.M[2][1] + M.M[2][2] * M.M[2][2],
+          S = S0 > S1 ? (S0 > S2 ? S0 : S2) : (S1 > S2 ? S1 : S2);
+
+        return sphere(M.TransformPoint(C), R * sqrt(S));
+      } /* End of 'Transform' function */
+    }; /* End of 'sphere' class */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_bound_h_
+
+/* END OF 'mth_bound.h' FILE */
@@ -0,0 +1,543 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_bvh.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Triangles bound volume hierarchy header file.
+ * NOTE:        Binned SAH build (big subtrees are built in
+ *              parallel), nodes are flattened in depth-first
+ *              order: left child follows its parent, right child
+ *              index is stored in the node.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_bvh_h_
+#define __mth_bvh_h_
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_ray.h"
+#include "mth_camera.h"
+#include "mth_bound.h"
+#include "mth_isect.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Triangles bound volume hierarchy type */
+  template<typename Type>
+    class bvh
+    {
+    public:
+      /* Hierarchy node structure */
+      struct node
+      {
+        aabb<Type> Box; // Node bound box
+        INT
+          Start,        // First triangle for leaf, right child index for inner node
+          Count;        // Number of triangles (0 for inner node)
+      }; /* End of 'node' structure */
+
+      /* Stored triangle structure */
+      struct triangle
+      {
+        vec3<Type> P0, P1, P2; // Triangle vertices
+        INT PrimId, TriId;     // Source primitive and triangle ids
+      }; /* End of 'triangle' structure */
+
+      std::vector<node> Nodes;    // Flattened nodes (root is first)
+      std::vector<triangle> Tris; // Triangles in leaves order
+
+    private:
+      /* Build parameters */
+      static const INT
+        BinsCount = 16,                // Number of SAH bins
+        MaxLeafSize = 8,               // Maximal triangles in leaf (except leaves at maximal depth)
+        ParallelThreshold = 1 << 13,   // Minimal triangles in subtree to build it in parallel
+        MaxParallelDepth = 4,          // Maximal depth of parallel subtrees spawning
+        StackSize = 64,                // Traversal stack size
+        MaxDepth = StackSize;          // Maximal inner nodes depth (deeper ranges are leaves, so stack never overflows)
+
+      std::vector<INT> Slot; // Triangle number in addition order -> index in 'Tris'
+
+      /* Temporary build node structure */
+      struct build_node
+      {
+        aabb<Type> Box;                         // Node bound box
+        INT First = 0, Count = 0;               // Triangles range (for leaf)
+        std::unique_ptr<build_node> Left, Right; // Children (for inner node)
+      }; /* End of 'build_node' structure */
+
+      /* Build context structure */
+      struct build_context
+      {
+        std::vector<aabb<Type>> Boxes;   // Triangles bound boxes
+        std::vector<vec3<Type>> Centers; // Triangles bound boxes centers
+        std::vector<INT> Ids;            // Triangles order
+      }; /* End of 'build_context' structure */
+
+      /* Get box surface half area function.
+       * ARGUMENTS:
+       *   - box:
+       *       const aabb<Type> &B;
+       * RETURNS:
+       *   (Type) half area (0 for empty box).
+       */
+      static Type HalfArea( const aabb<Type> &B )
+      {
+        if (B.IsEmpty())
+          return 0;
+
+        vec3<Type> S = B.Max - B.Min;
+
+        return S.X * S.Y + S.Y * S.Z + S.Z * S.X;
+      } /* End of 'HalfArea' function */
+
+      /* Build subtree function.
+       * ARGUMENTS:
+       *   - build context:
+       *       build_context &Ctx;
+       *   - triangles range in 'Ctx.Ids':
+       *       INT First, Count;
+       *   - node depth:
+       *       INT Depth;
+       * RETURNS:
+       *   (std::unique_ptr<build_node>) subtree root.
+       */
+      static std::unique_ptr<build_node> BuildRec( build_context &Ctx, INT First, INT Count, INT Depth )
+      {
+        auto N = std::make_unique<build_node>();
+        aabb<Type> CBox;
+
+        for (INT i = First; i < First + Count; i++)
+        {
+          N->Box |= Ctx.Boxes[Ctx.Ids[i]];
+          CBox |= Ctx.Centers[Ctx.Ids[i]];
+        }
+        N->First = First;
+        N->Count = Count;
+        if (Count <= 2 || Depth >= MaxDepth)
+          return N;
+
+        // Split axis is the longest axis of centers box
+        vec3<Type> CSize = CBox.Max - CBox.Min;
+        INT Axis = CSize.X > CSize.Y ? (CSize.X > CSize.Z ? 0 : 2) : (CSize.Y > CSize.Z ? 1 : 2);
+        Type
+          CMin = CBox.Min[Axis],
+          CExt = CSize[Axis];
+
+        if (CExt <= 0)
+          return Count <= MaxLeafSize ? std::move(N) : SplitRec(Ctx, std::move(N), First + Count / 2, Depth);
+
+        // Fill bins
+        aabb<Type> BinBoxes[BinsCount];
+        INT BinCounts[BinsCount] {};
+        Type Scale = BinsCount / CExt * Type(0.9999);
+        auto BinOf =
+          [&]( INT Id )
+          {
+            INT b = static_cast<INT>((Ctx.Centers[Id][Axis] - CMin) * Scale);
+
+            return b < BinsCount - 1 ? b : BinsCount - 1;
+          };
+
+        for (INT i = First; i < First + Count; i++)
+        {
+          INT b = BinOf(Ctx.Ids[i]);
+
+          BinCounts[b]++;
+          BinBoxes[b] |= Ctx.Boxes[Ctx.Ids[i]];
+        }
+
+        // Evaluate split costs (right-to-left sweep, then left-to-right)
+        Type RightArea[BinsCount];
+        INT RightCount[BinsCount];
+        aabb<Type> Acc;
+        INT AccCount = 0;
+
+        for (INT b = BinsCount - 1; b > 0; b--)
+        {
+          Acc |= BinBoxes[b];
+          AccCount += BinCounts[b];
+          RightArea[b] = HalfArea(Acc);
+          RightCount[b] = AccCount;
+        }
+
+        Type BestCost = std::numeric_limits<Type>::max();
+        INT BestBin = -1;
+
+        Acc = aabb<Type>();
+        AccCount = 0;
+        for (INT b = 0; b < BinsCount - 1; b++)
+        {
+          Acc |= BinBoxes[b];
+          AccCount += BinCounts[b];
+          if (AccCount == 0 || RightCount[b + 1] == 0)
+            continue;
+
+          Type Cost = HalfArea(Acc) * AccCount + RightArea[b + 1] * RightCount[b + 1];
+
+          if (Cost < BestCost)
+            BestCost = Cost, BestBin = b;
+        }
+
+        // Leaf is cheaper than split (traversal cost is one triangle test)
+        Type LeafCost = HalfArea(N->Box) * (Count - 1);
+
+        if (BestBin == -1 || (Count <= MaxLeafSize && BestCost >= LeafCost))
+          return Count <= MaxLeafSize ? std::move(N) : SplitRec(Ctx, std::move(N), First + Count / 2, Depth);
+
+        INT *Mid = std::partition(Ctx.Ids.data() + First, Ctx.Ids.data() + First + Count,
+                                  [&]( INT Id ){ return BinOf(Id) <= BestBin; });
+
+        return SplitRec(Ctx, std::move(N), static_cast<INT>(Mid - Ctx.Ids.data()), Depth);
+      } /* End of 'BuildRec' function */
+
+      /* Build node children function.
+       * ARGUMENTS:
+       *   - build context:
+       *       build_context &Ctx;
+       *   - node to split:
+       *       std::unique_ptr<build_node> N;
+       *   - first triangle of right child:
+       *       INT Mid;
+       *   - node depth:
+       *       INT Depth;
+       * RETURNS:
+       *   (std::unique_ptr<build_node>) node.
+       */
+      static std::unique_ptr<build_node> SplitRec( build_context &Ctx, std::unique_ptr<build_node> N, INT Mid, INT Depth )
+      {
+        INT
+          First = N->First,
+          LeftCount = Mid - First,
+          RightCount = N->Count - LeftCount;
+
+        // Median split for unsplittable by centers ranges is done by order
+        if (LeftCount == 0 || RightCount == 0)
+          LeftCount = N->Count / 2, RightCount = N->Count - LeftCount, Mid = First + LeftCount;
+
+        if (N->Count >= ParallelThreshold && Depth < MaxParallelDepth)
+        {
+          auto Left = std::async(std::launch::async, BuildRec, std::ref(Ctx), First, LeftCount, Depth + 1);
+
+          N->Right = BuildRec(Ctx, Mid, RightCount, Depth + 1);
+          N->Left = Left.get();
+        }
+        else
+        {
+          N->Left = BuildRec(Ctx, First, LeftCount, Depth + 1);
+          N->Right = BuildRec(Ctx, Mid, RightCount, Depth + 1);
+        }
+        return N;
+      } /* End of 'SplitRec' function */
+
+      /* Flatten subtree function.
+       * ARGUMENTS:
+       *   - subtree root:
+       *       const build_node *N;
+       * RETURNS: None.
+       */
+      VOID Flatten( const build_node *N )
+      {
+        INT Index = static_cast<INT>(Nodes.size());
+
+        Nodes.push_back({N->Box, N->First, N->Left == nullptr ? N->Count : 0});
+        if (N->Left != nullptr)
+        {
+          Flatten(N->Left.get());
+          Nodes[Index].Start = static_cast<INT>(Nodes.size());
+          Flatten(N->Right.get());
+        }
+      } /* End of 'Flatten' function */
+
+      /* Traverse hierarchy function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray<Type> &R;
+       *   - nearest hit (H.T is maximal distance):
+       *       hit<Type> &H;
+       *   - stop on first hit flag:
+       *       BOOL IsAnyHit;
+       * RETURNS:
+       *   (BOOL) TRUE if hit was updated.
+       */
+      BOOL Traverse( const ray<Type> &R, hit<Type> &H, BOOL IsAnyHit ) const
+      {
+        if (Nodes.empty())
+          return FALSE;
+
+        ray_inv<Type> RI(R);
+        struct
+        {
+          INT Node;
+          Type T;
+        } Stack[StackSize];
+        INT Sp = 0, Cur = 0;
+        Type T;
+        BOOL IsHit = FALSE;
+
+        if (!mth::Intersect(RI, Nodes[0].Box, H.T, T))
+          return FALSE;
+        for (;;)
+        {
+          const node &N = Nodes[Cur];
+
+          if (N.Count > 0)
+          {
+            for (INT i = N.Start; i < N.Start + N.Count; i++)
+            {
+              const triangle &Tr = Tris[i];
+
+              if (mth::Intersect(R, Tr.P0, Tr.P1, Tr.P2, Tr.PrimId, Tr.TriId, H))
+              {
+                IsHit = TRUE;
+                if (IsAnyHit)
+                  return TRUE;
+              }
+            }
+          }
+          else
+          {
+            INT
+              L = Cur + 1,
+              Rt = N.Start;
+            Type TL, TR;
+            BOOL
+              IsL = mth::Intersect(RI, Nodes[L].Box, H.T, TL),
+              IsR = mth::Intersect(RI, Nodes[Rt].Box, H.T, TR);
+
+            if (IsL && IsR)
+            {
+              // Visit nearer child first
+              if (TR < TL)
+                std::swap(L, Rt), std::swap(TL, TR);
+              // One entry per inner node on current path at most
+              assert(Sp < StackSize);
+              Stack[Sp++] = {Rt, TR};
+              Cur = L;
+              continue;
+            }
+            if (IsL || IsR)
+            {
+              Cur = IsL ? L : Rt;
+              continue;
+            }
+          }
+
+          // Pop next node which is still closer than nearest hit
+          for (Cur = -1; Sp > 0; )
+            if (Stack[--Sp].T <= H.T)
+            {
+              Cur = Stack[Sp].Node;
+              break;
+            }
+          if (Cur == -1)
+            return IsHit;
+        }
+      } /* End of 'Traverse' function */
+
+    public:
+      /* Add triangle list mesh function.
+       * ARGUMENTS:
+       *   - mesh vertices:
+       *       std::span<const vertex_type> V;
+       *   - vertex position field:
+       *       vec3<Type> vertex_type::*Field;
+       *   - triangle list indices:
+       *       std::span<const INT> Ind;
+       *   - primitive id of mesh:
+       *       INT PrimId;
+       * RETURNS:
+       *   (INT) number of first mesh triangle in addition order (for 'UpdateMesh').
+       */
+      template<typename vertex_type>
+        INT AddMesh( std::span<const vertex_type> V, vec3<Type> vertex_type::*Field, std::span<const INT> Ind, INT PrimId )
+        {
+          INT First = static_cast<INT>(Slot.size());
+
+          for (size_t i = 0; i + 2 < Ind.size(); i += 3)
+          {
+            Slot.push_back(static_cast<INT>(Tris.size()));
+            Tris.push_back({V[Ind[i]].*Field, V[Ind[i + 1]].*Field, V[Ind[i + 2]].*Field, PrimId, static_cast<INT>(i / 3)});
+          }
+          return First;
+        } /* End of 'AddMesh' function */
+
+      /* Update mesh vertices function (call 'Refit' after all updates).
+       * ARGUMENTS:
+       *   - number of first mesh triangle (returned by 'AddMesh'):
+       *       INT First;
+       *   - new mesh vertices:
+       *       std::span<const vertex_type> V;
+       *   - vertex position field:
+       *       vec3<Type> vertex_type::*Field;
+       *   - triangle list indices (same as in 'AddMesh'):
+       *       std::span<const INT> Ind;
+       * RETURNS: None.
+       */
+      template<typename vertex_type>
+        VOID UpdateMesh( INT First, std::span<const vertex_type> V, vec3<Type> vertex_type::*Field, std::span<const INT> Ind )
+        {
+          for (size_t i = 0; i + 2 < Ind.size(); i += 3)
+          {
+            triangle &Tr = Tris[Slot[First + i / 3]];
+
+            Tr.P0 = V[Ind[i]].*Field;
+            Tr.P1 = V[Ind[i + 1]].*Field;
+            Tr.P2 = V[Ind[i + 2]].*Field;
+          }
+        } /* End of 'UpdateMesh' function */
+
+      /* Build hierarchy over all added triangles function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Build( VOID )
+      {
+        INT Count = static_cast<INT>(Tris.size());
+        build_context Ctx;
+
+        Nodes.clear();
+        if (Count == 0)
+          return;
+
+        Ctx.Boxes.resize(Count);
+        Ctx.Centers.resize(Count);
+        Ctx.Ids.resize(Count);
+        std::iota(Ctx.Ids.begin(), Ctx.Ids.end(), 0);
+        for (INT i = 0; i < Count; i++)
+        {
+          const triangle &Tr = Tris[i];
+
+          Ctx.Boxes[i] = aabb<Type>(Tr.P0, Tr.P0);
+          Ctx.Boxes[i] |= Tr.P1;
+          Ctx.Boxes[i] |= Tr.P2;
+          Ctx.Centers[i] = Ctx.Boxes[i].Center();
+        }
+
+        std::unique_ptr<build_node> Root = BuildRec(Ctx, 0, Count, 0);
+
+        Nodes.reserve(static_cast<size_t>(Count) * 2);
+        Flatten(Root.get());
+        Root.reset();
+
+        // Reorder triangles to leaves order
+        std::vector<triangle> NewTris(Count);
+        std::vector<INT> NewPos(Count);
+
+        for (INT i = 0; i < Count; i++)
+        {
+          NewTris[i] = Tris[Ctx.Ids[i]];
+          NewPos[Ctx.Ids[i]] = i;
+        }
+        Tris = std::move(NewTris);
+        for (auto &S : Slot)
+          S = NewPos[S];
+      } /* End of 'Build' function */
+
+      /* Refit node boxes to moved triangles function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Refit( VOID )
+      {
+        // Children always follow parent, so reverse order is bottom-up
+        for (INT i = static_cast<INT>(Nodes.size()) - 1; i >= 0; i--)
+        {
+          node &N = Nodes[i];
+
+          N.Box = aabb<Type>();
+          if (N.Count > 0)
+            for (INT t = N.Start; t < N.Start + N.Count; t++)
+              N.Box |= Tris[t].P0, N.Box |= Tris[t].P1, N.Box |= Tris[t].P2;
+          else
+            N.Box = Nodes[i + 1].Box | Nodes[N.Start].Box;
+        }
+      } /* End of 'Refit' function */
+
+      /* Clear hierarchy function.
+       * ARGUMENTS: None.
+       * RETURNS: None.
+       */
+      VOID Clear( VOID )
+      {
+        Nodes.clear();
+        Tris.clear();
+        Slot.clear();
+      } /* End of 'Clear' function */
+
+      /* Get hierarchy bound box function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (aabb<Type>) bound box (empty if no triangles).
+       */
+      aabb<Type> Bound( VOID ) const
+      {
+        return Nodes.empty() ? aabb<Type>() : Nodes[0].Box;
+      } /* End of 'Bound' function */
+
+      /* Closest hit query function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray<Type> &R;
+       *   - nearest hit (only closer than H.T hits are searched):
+       *       hit<Type> &H;
+       * RETURNS:
+       *   (BOOL) TRUE if hit was updated.
+       */
+      BOOL Intersect( const ray<Type> &R, hit<Type> &H ) const
+      {
+        return Traverse(R, H, FALSE);
+      } /* End of 'Intersect' function */
+
+      /* Closest hit query by frame pixel function.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera<Type> &Cam;
+       *   - frame pixel coordinates:
+       *       Type Xs, Ys;
+       *   - nearest hit (only closer than H.T hits are searched):
+       *       hit<Type> &H;
+       * RETURNS:
+       *   (BOOL) TRUE if hit was updated.
+       */
+      BOOL Intersect( const camera<Type> &Cam, Type Xs, Type Ys, hit<Type> &H ) const
+      {
+        return Traverse(Cam.FrameRay(Xs, Ys), H, FALSE);
+      } /* End of 'Intersect' function */
+
+      /* Any hit query function.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray<Type> &R;
+       *   - maximal distance:
+       *       Type TMax;
+       * RETURNS:
+       *   (BOOL) TRUE if ray hits any triangle closer than TMax.
+       */
+      BOOL IsOccluded( const ray<Type> &R, Type TMax = std::numeric_limits<Type>::max() ) const
+      {
+        hit<Type> H;
+
+        H.T = TMax;
+        return Traverse(R, H, TRUE);
+      } /* End of 'IsOccluded' function */
+    }; /* End of 'bvh' class */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_bvh_h_
+
+/* END OF 'mth_bvh.h' FILE */
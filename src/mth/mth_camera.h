@@ -150,7 +150,9 @@ namespace mth
           rx *= ((Type)FrameW / FrameH);
         else
           ry *= ((Type)FrameH / FrameW);
-        
+        Wp = rx;
+        Hp = ry;
+
         Proj =
           matr<FLT>::Frustum(-rx / 2, rx / 2, -ry / 2, ry / 2, ProjDist, FarClip);
 
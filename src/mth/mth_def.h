@@ -22,15 +22,37 @@
 #include <cassert>
 
 /* Intel instrinsics functions library */
-#include <intrin.h>
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#else  // _MSC_VER
+#  include <immintrin.h>
+#endif // _MSC_VER
 
-#ifndef WIN32
-#define WIN32
-#include <commondf.h>
-#undef WIN32
-#else  // !WIN32
-#include <commondf.h>
-#endif // !WIN32
+#if defined(_WIN32)
+#  ifndef WIN32
+#    define WIN32
+#    include <commondf.h>
+#    undef WIN32
+#  else  // !WIN32
+#    include <commondf.h>
+#  endif // !WIN32
+#else  // _WIN32
+/* Base types for non-Windows platforms (normally from <commondf.h>) */
+#  define VOID void
+typedef int INT;
+typedef unsigned int UINT;
+typedef int BOOL;
+typedef unsigned char BYTE;
+typedef float FLOAT;
+typedef unsigned long long UINT_PTR;
+typedef unsigned long long UINT64;
+#  ifndef TRUE
+#    define TRUE 1
+#  endif // !TRUE
+#  ifndef FALSE
+#    define FALSE 0
+#  endif // !FALSE
+#endif // _WIN32
 
 /* Short version of float types */
 typedef float FLT;
@@ -53,13 +75,33 @@ typedef double DBL;
 #define PI_180    0.017453292519943295769
 #define D180_PI   57.29577951308232087679
 
-/* Convert angle from Degree to Radians */
-#define D2R(A) ((A) * (PI_180))
+/* Convert angle from Degree to Radians function.
+ * ARGUMENTS:
+ *   - angle in degree:
+ *       Type A;
+ * RETURNS:
+ *   (auto) angle in radians.
+ */
+template<typename Type>
+  constexpr auto D2R( Type A ) noexcept
+  {
+    return A * PI_180;
+  } /* End of 'D2R' function */
 #define Degree2Radian(a) D2R(a)
 
-/* Convert angle from Radians to Degree */
-#define R2D(A) ((A) * (D180_PI))
-#define Radian2Degree(a) D2R(a)
+/* Convert angle from Radians to Degree function.
+ * ARGUMENTS:
+ *   - angle in radians:
+ *       Type A;
+ * RETURNS:
+ *   (auto) angle in degree.
+ */
+template<typename Type>
+  constexpr auto R2D( Type A ) noexcept
+  {
+    return A * D180_PI;
+  } /* End of 'R2D' function */
+#define Radian2Degree(a) R2D(a)
 
 /* Special flag for set status of using mth float intrin library */
 #define USE_MTH_FLOAT_INTRIN_LIB_FLAG 0
@@ -68,6 +110,16 @@ typedef double DBL;
 #  define USE_MTH_FLOAT_INTRIN_LIB
 #endif // _MSC_VER && USE_MTH_FLOAT_INTRIN_LIB_FLAG == 1
 
+/* Special flag for set status of using runtime dispatched SIMD matr<FLT> kernels.
+ * Independent from vector specializations: vec3<FLT> must stay 12 bytes for vertex layouts.
+ */
+#define USE_MTH_MATR_SIMD_FLAG 1
+
+#if (defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)) && \
+    defined(USE_MTH_MATR_SIMD_FLAG) && (USE_MTH_MATR_SIMD_FLAG == 1)
+#  define USE_MTH_MATR_SIMD
+#endif // x86 && USE_MTH_MATR_SIMD_FLAG == 1
+
 /* Space math namespace */
 namespace mth
 {
@@ -0,0 +1,312 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_frustum.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     View frustum and visibility culling header file.
+ * NOTE:        Batch culling tests 8 volumes against 6 planes
+ *              per iteration on AVX2 capable processors.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_frustum_h_
+#define __mth_frustum_h_
+
+#include <span>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_vec4.h"
+#include "mth_matr.h"
+#include "mth_matr_simd.h"
+#include "mth_batch.h"
+#include "mth_camera.h"
+#include "mth_bound.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* View frustum type */
+  template<typename Type>
+    class frustum
+    {
+    public:
+      /* Frustum planes enumeration */
+      enum
+      {
+        LEFT, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, PLANES_COUNT
+      };
+
+      /* Planes (N.X, N.Y, N.Z, D), inner half-space is (N & P) + D >= 0, N is normalized */
+      vec4<Type> Planes[PLANES_COUNT];
+
+      /* Default constructor */
+      frustum()
+      {
+      } /* End of 'frustum' function */
+
+      /* Constructor by view-projection matrix.
+       * ARGUMENTS:
+       *   - view-projection matrix (row vector convention):
+       *       const matr<Type> &VP;
+       */
+      explicit frustum( const matr<Type> &VP )
+      {
+        for (INT i = 0; i < 3; i++)
+        {
+          Planes[i * 2] = vec4<Type>(VP.M[0][3] + VP.M[0][i], VP.M[1][3] + VP.M[1][i],
+                                     VP.M[2][3] + VP.M[2][i], VP.M[3][3] + VP.M[3][i]);
+          Planes[i * 2 + 1] = vec4<Type>(VP.M[0][3] - VP.M[0][i], VP.M[1][3] - VP.M[1][i],
+                                         VP.M[2][3] - VP.M[2][i], VP.M[3][3] - VP.M[3][i]);
+        }
+        for (auto &P : Planes)
+        {
+          Type len = sqrt(P.X * P.X + P.Y * P.Y + P.Z * P.Z);
+
+          if (len != 0)
+            P = vec4<Type>(P.X / len, P.Y / len, P.Z / len, P.W / len);
+        }
+      } /* End of 'frustum' function */
+
+      /* Constructor by camera.
+       * ARGUMENTS:
+       *   - camera:
+       *       const camera<Type> &Cam;
+       */
+      explicit frustum( const camera<Type> &Cam ) : frustum(Cam.VP)
+      {
+      } /* End of 'frustum' function */
+
+      /* Point visibility check function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3<Type> &P;
+       * RETURNS:
+       *   (BOOL) TRUE if point is inside frustum.
+       */
+      BOOL IsVisible( const vec3<Type> &P ) const
+      {
+        for (auto &Pl : Planes)
+          if (Pl.X * P.X + Pl.Y * P.Y + Pl.Z * P.Z + Pl.W < 0)
+            return FALSE;
+        return TRUE;
+      } /* End of 'IsVisible' function */
+
+      /* Box visibility check function (conservative).
+       * ARGUMENTS:
+       *   - box:
+       *       const aabb<Type> &B;
+       * RETURNS:
+       *   (BOOL) TRUE if box may be visible.
+       */
+      BOOL IsVisible( const aabb<Type> &B ) const
+      {
+        vec3<Type>
+          C = B.Center(),
+          Ext = B.Extent();
+
+        for (auto &Pl : Planes)
+          if (Pl.X * C.X + Pl.Y * C.Y + Pl.Z * C.Z + Pl.W +
+              fabs(Pl.X) * Ext.X + fabs(Pl.Y) * Ext.Y + fabs(Pl.Z) * Ext.Z < 0)
+            return FALSE;
+        return TRUE;
+      } /* End of 'IsVisible' function */
+
+      /* Sphere visibility check function (conservative).
+       * ARGUMENTS:
+       *   - sphere:
+       *       const sphere<Type> &S;
+       * RETURNS:
+       *   (BOOL) TRUE if sphere may be visible.
+       */
+      BOOL IsVisible( const sphere<Type> &S ) const
+      {
+        for (auto &Pl : Planes)
+          if (Pl.X * S.C.X + Pl.Y * S.C.Y + Pl.Z * S.C.Z + Pl.W + S.R < 0)
+            return FALSE;
+        return TRUE;
+      } /* End of 'IsVisible' function */
+    }; /* End of 'frustum' class */
+
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    /* Write 8 visibility flags from mask function.
+     * ARGUMENTS:
+     *   - visibility flags:
+     *       BYTE *Visible;
+     *   - visible lanes mask:
+     *       INT Mask;
+     * RETURNS:
+     *   (size_t) number of visible lanes.
+     */
+    inline size_t StoreVisible8( BYTE *Visible, INT Mask )
+    {
+      size_t n = 0;
+
+      for (INT i = 0; i < 8; i++)
+        n += Visible[i] = static_cast<BYTE>((Mask >> i) & 1);
+      return n;
+    } /* End of 'StoreVisible8' function */
+
+    /* Boxes frustum culling AVX2 kernel function.
+     * ARGUMENTS:
+     *   - frustum:
+     *       const frustum<FLT> &F;
+     *   - boxes:
+     *       const aabb<FLT> *Boxes;
+     *   - number of boxes (multiple of 8 processed):
+     *       size_t Count;
+     *   - visibility flags:
+     *       BYTE *Visible;
+     *   - number of visible boxes (increased):
+     *       size_t &NoofVisible;
+     * RETURNS:
+     *   (size_t) number of processed boxes.
+     */
+    MTH_TARGET_AVX2 inline size_t CullBoxesAVX2( const frustum<FLT> &F, const aabb<FLT> *Boxes, size_t Count,
+                                                 BYTE *Visible, size_t &NoofVisible )
+    {
+      const stream3<const FLT>
+        SMin {&Boxes->Min.X, &Boxes->Min.Y, &Boxes->Min.Z, sizeof(aabb<FLT>)},
+        SMax {&Boxes->Max.X, &Boxes->Max.Y, &Boxes->Max.Z, sizeof(aabb<FLT>)};
+      const __m256
+        Half = _mm256_set1_ps(0.5f),
+        Zero = _mm256_setzero_ps();
+      size_t i = 0;
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256 MinX, MinY, MinZ, MaxX, MaxY, MaxZ, Out = Zero;
+
+        Load8AVX2(SMin, i, MinX, MinY, MinZ);
+        Load8AVX2(SMax, i, MaxX, MaxY, MaxZ);
+
+        __m256
+          CX = _mm256_mul_ps(_mm256_add_ps(MinX, MaxX), Half),
+          CY = _mm256_mul_ps(_mm256_add_ps(MinY, MaxY), Half),
+          CZ = _mm256_mul_ps(_mm256_add_ps(MinZ, MaxZ), Half),
+          EX = _mm256_mul_ps(_mm256_sub_ps(MaxX, MinX), Half),
+          EY = _mm256_mul_ps(_mm256_sub_ps(MaxY, MinY), Half),
+          EZ = _mm256_mul_ps(_mm256_sub_ps(MaxZ, MinZ), Half);
+
+        for (auto &Pl : F.Planes)
+        {
+          __m256
+            D = _mm256_fmadd_ps(_mm256_set1_ps(Pl.X), CX,
+                _mm256_fmadd_ps(_mm256_set1_ps(Pl.Y), CY,
+                _mm256_fmadd_ps(_mm256_set1_ps(Pl.Z), CZ, _mm256_set1_ps(Pl.W)))),
+            R = _mm256_fmadd_ps(_mm256_set1_ps(fabsf(Pl.X)), EX,
+                _mm256_fmadd_ps(_mm256_set1_ps(fabsf(Pl.Y)), EY,
+                _mm256_mul_ps(_mm256_set1_ps(fabsf(Pl.Z)), EZ)));
+
+          Out = _mm256_or_ps(Out, _mm256_cmp_ps(_mm256_add_ps(D, R), Zero, _CMP_LT_OQ));
+        }
+        NoofVisible += StoreVisible8(Visible + i, ~_mm256_movemask_ps(Out) & 0xFF);
+      }
+      return i;
+    } /* End of 'CullBoxesAVX2' function */
+
+    /* Spheres frustum culling AVX2 kernel function.
+     * ARGUMENTS:
+     *   - frustum:
+     *       const frustum<FLT> &F;
+     *   - spheres:
+     *       const sphere<FLT> *Spheres;
+     *   - number of spheres (multiple of 8 processed):
+     *       size_t Count;
+     *   - visibility flags:
+     *       BYTE *Visible;
+     *   - number of visible spheres (increased):
+     *       size_t &NoofVisible;
+     * RETURNS:
+     *   (size_t) number of processed spheres.
+     */
+    MTH_TARGET_AVX2 inline size_t CullSpheresAVX2( const frustum<FLT> &F, const sphere<FLT> *Spheres, size_t Count,
+                                                   BYTE *Visible, size_t &NoofVisible )
+    {
+      static_assert(sizeof(sphere<FLT>) == 4 * sizeof(FLT), "Sphere must be packed to 4 floats");
+      const __m256 Zero = _mm256_setzero_ps();
+      size_t i = 0;
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256 CX, CY, CZ, R, Out = Zero;
+
+        Load8x4AVX2(&Spheres[i].C.X, CX, CY, CZ, R);
+        for (auto &Pl : F.Planes)
+        {
+          __m256 D =
+            _mm256_fmadd_ps(_mm256_set1_ps(Pl.X), CX,
+            _mm256_fmadd_ps(_mm256_set1_ps(Pl.Y), CY,
+            _mm256_fmadd_ps(_mm256_set1_ps(Pl.Z), CZ, _mm256_add_ps(R, _mm256_set1_ps(Pl.W)))));
+
+          Out = _mm256_or_ps(Out, _mm256_cmp_ps(D, Zero, _CMP_LT_OQ));
+        }
+        NoofVisible += StoreVisible8(Visible + i, ~_mm256_movemask_ps(Out) & 0xFF);
+      }
+      return i;
+    } /* End of 'CullSpheresAVX2' function */
+#endif // USE_MTH_MATR_SIMD
+  } /* end of 'simd' namespace */
+
+  /* Boxes array frustum culling function.
+   * ARGUMENTS:
+   *   - frustum:
+   *       const frustum<FLT> &F;
+   *   - boxes:
+   *       std::span<const aabb<FLT>> Boxes;
+   *   - visibility flags (1 - may be visible, 0 - culled; size >= boxes count):
+   *       std::span<BYTE> Visible;
+   * RETURNS:
+   *   (size_t) number of visible boxes.
+   */
+  inline size_t Cull( const frustum<FLT> &F, std::span<const aabb<FLT>> Boxes, std::span<BYTE> Visible )
+  {
+    size_t i = 0, n = 0;
+
+    assert(Visible.size() >= Boxes.size());
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::IsBatchAVX2())
+      i = simd::CullBoxesAVX2(F, Boxes.data(), Boxes.size(), Visible.data(), n);
+#endif // USE_MTH_MATR_SIMD
+    for (; i < Boxes.size(); i++)
+      n += Visible[i] = static_cast<BYTE>(F.IsVisible(Boxes[i]));
+    return n;
+  } /* End of 'Cull' function */
+
+  /* Spheres array frustum culling function.
+   * ARGUMENTS:
+   *   - frustum:
+   *       const frustum<FLT> &F;
+   *   - spheres:
+   *       std::span<const sphere<FLT>> Spheres;
+   *   - visibility flags (1 - may be visible, 0 - culled; size >= spheres count):
+   *       std::span<BYTE> Visible;
+   * RETURNS:
+   *   (size_t) number of visible spheres.
+   */
+  inline size_t Cull( const frustum<FLT> &F, std::span<const sphere<FLT>> Spheres, std::span<BYTE> Visible )
+  {
+    size_t i = 0, n = 0;
+
+    assert(Visible.size() >= Spheres.size());
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::IsBatchAVX2())
+      i = simd::CullSpheresAVX2(F, Spheres.data(), Spheres.size(), Visible.data(), n);
+#endif // USE_MTH_MATR_SIMD
+    for (; i < Spheres.size(); i++)
+      n += Visible[i] = static_cast<BYTE>(F.IsVisible(Spheres[i]));
+    return n;
+  } /* End of 'Cull' function */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_frustum_h_
+
+/* END OF 'mth_frustum.h' FILE */
@@ -0,0 +1,511 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_isect.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Ray intersection (box, triangle) header file.
+ * NOTE:        Box test is slab method, triangle test is
+ *              Moller-Trumbore (two-sided). Packet functions
+ *              trace 8 rays at once on AVX2 capable processors.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_isect_h_
+#define __mth_isect_h_
+
+#include <limits>
+#include <span>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_matr_simd.h"
+#include "mth_batch.h"
+#include "mth_ray.h"
+#include "mth_camera.h"
+#include "mth_bound.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Ray intersection result type */
+  template<typename Type>
+    struct hit
+    {
+      Type
+        T = std::numeric_limits<Type>::max(), // Ray parameter of nearest hit (max - no hit)
+        U = 0, V = 0;                          // Barycentrics of hit point (P = P0 * (1 - U - V) + P1 * U + P2 * V)
+      INT
+        PrimId = -1,                           // Hit primitive id
+        TriId = -1;                            // Hit triangle id
+
+      /* Check hit presence function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (BOOL) TRUE if something was hit.
+       */
+      BOOL IsHit() const
+      {
+        return TriId != -1;
+      } /* End of 'IsHit' function */
+    }; /* End of 'hit' structure */
+
+  /* Precomputed ray for box tests type */
+  template<typename Type>
+    struct ray_inv
+    {
+      vec3<Type>
+        Org, Dir, // Ray origin and direction
+        InvDir;   // Direction reciprocal
+
+      /* Constructor by ray.
+       * ARGUMENTS:
+       *   - ray:
+       *       const ray<Type> &R;
+       */
+      ray_inv( const ray<Type> &R ) : Org(R.Org), Dir(R.Dir), InvDir(1 / R.Dir.X, 1 / R.Dir.Y, 1 / R.Dir.Z)
+      {
+      } /* End of 'ray_inv' function */
+    }; /* End of 'ray_inv' structure */
+
+  /* Ray-box intersection (slab method) function.
+   * ARGUMENTS:
+   *   - precomputed ray:
+   *       const ray_inv<Type> &R;
+   *   - box:
+   *       const aabb<Type> &B;
+   *   - maximal ray parameter:
+   *       Type TMax;
+   *   - entry ray parameter (0 if origin is inside box):
+   *       Type &T;
+   * RETURNS:
+   *   (BOOL) TRUE if ray hits box in [0, TMax].
+   */
+  template<typename Type>
+    inline BOOL Intersect( const ray_inv<Type> &R, const aabb<Type> &B, Type TMax, Type &T )
+    {
+      Type
+        t0x = (B.Min.X - R.Org.X) * R.InvDir.X, t1x = (B.Max.X - R.Org.X) * R.InvDir.X,
+        t0y = (B.Min.Y - R.Org.Y) * R.InvDir.Y, t1y = (B.Max.Y - R.Org.Y) * R.InvDir.Y,
+        t0z = (B.Min.Z - R.Org.Z) * R.InvDir.Z, t1z = (B.Max.Z - R.Org.Z) * R.InvDir.Z,
+        tn = 0, tf = TMax;
+
+      tn = t0x < t1x ? (t0x > tn ? t0x : tn) : (t1x > tn ? t1x : tn);
+      tf = t0x < t1x ? (t1x < tf ? t1x : tf) : (t0x < tf ? t0x : tf);
+      tn = t0y < t1y ? (t0y > tn ? t0y : tn) : (t1y > tn ? t1y : tn);
+      tf = t0y < t1y ? (t1y < tf ? t1y : tf) : (t0y < tf ? t0y : tf);
+      tn = t0z < t1z ? (t0z > tn ? t0z : tn) : (t1z > tn ? t1z : tn);
+      tf = t0z < t1z ? (t1z < tf ? t1z : tf) : (t0z < tf ? t0z : tf);
+      T = tn;
+      return tn <= tf;
+    } /* End of 'Intersect' function */
+
+  /* Ray-box intersection function.
+   * ARGUMENTS:
+   *   - ray:
+   *       const ray<Type> &R;
+   *   - box:
+   *       const aabb<Type> &B;
+   *   - entry ray parameter (0 if origin is inside box):
+   *       Type &T;
+   * RETURNS:
+   *   (BOOL) TRUE if ray hits box.
+   */
+  template<typename Type>
+    inline BOOL Intersect( const ray<Type> &R, const aabb<Type> &B, Type &T )
+    {
+      return Intersect(ray_inv<Type>(R), B, std::numeric_limits<Type>::max(), T);
+    } /* End of 'Intersect' function */
+
+  /* Ray-triangle intersection (Moller-Trumbore) function.
+   * ARGUMENTS:
+   *   - ray:
+   *       const ray<Type> &R;
+   *   - triangle vertices:
+   *       const vec3<Type> &P0, &P1, &P2;
+   *   - primitive and triangle ids:
+   *       INT PrimId, TriId;
+   *   - nearest hit (updated only if triangle is closer):
+   *       hit<Type> &H;
+   * RETURNS:
+   *   (BOOL) TRUE if nearest hit was updated.
+   */
+  template<typename Type>
+    inline BOOL Intersect( const ray<Type> &R, const vec3<Type> &P0, const vec3<Type> &P1, const vec3<Type> &P2,
+                           INT PrimId, INT TriId, hit<Type> &H )
+    {
+      const Type Threshold = std::numeric_limits<Type>::epsilon();
+      vec3<Type>
+        E1 = P1 - P0,
+        E2 = P2 - P0,
+        P = R.Dir % E2;
+      Type det = E1 & P;
+
+      if (det > -Threshold && det < Threshold)
+        return FALSE;
+
+      Type inv = 1 / det;
+      vec3<Type> S = R.Org - P0;
+      Type u = (S & P) * inv;
+
+      if (u < 0 || u > 1)
+        return FALSE;
+
+      vec3<Type> Q = S % E1;
+      Type v = (R.Dir & Q) * inv;
+
+      if (v < 0 || u + v > 1)
+        return FALSE;
+
+      Type t = (E2 & Q) * inv;
+
+      if (t <= Threshold || t >= H.T)
+        return FALSE;
+      H.T = t;
+      H.U = u;
+      H.V = v;
+      H.PrimId = PrimId;
+      H.TriId = TriId;
+      return TRUE;
+    } /* End of 'Intersect' function */
+
+  /* Ray-indexed triangle mesh intersection function.
+   * ARGUMENTS:
+   *   - ray:
+   *       const ray<FLT> &R;
+   *   - mesh vertices:
+   *       std::span<const vertex_type> V;
+   *   - vertex position field:
+   *       vec3<FLT> vertex_type::*Field;
+   *   - triangle list indices:
+   *       std::span<const INT> Ind;
+   *   - primitive id:
+   *       INT PrimId;
+   *   - nearest hit (updated only for closer triangles):
+   *       hit<FLT> &H;
+   * RETURNS:
+   *   (BOOL) TRUE if nearest hit was updated.
+   */
+  template<typename vertex_type>
+    inline BOOL Intersect( const ray<FLT> &R, std::span<const vertex_type> V, vec3<FLT> vertex_type::*Field,
+                           std::span<const INT> Ind, INT PrimId, hit<FLT> &H )
+    {
+      BOOL IsUpdated = FALSE;
+
+      for (size_t i = 0; i + 2 < Ind.size(); i += 3)
+        IsUpdated |= Intersect(R, V[Ind[i]].*Field, V[Ind[i + 1]].*Field, V[Ind[i + 2]].*Field,
+                               PrimId, static_cast<INT>(i / 3), H);
+      return IsUpdated;
+    } /* End of 'Intersect' function */
+
+  /* Packet of 8 rays (SoA) type */
+  struct alignas(32) ray_packet
+  {
+    FLT
+      OrgX[8], OrgY[8], OrgZ[8], // Ray origins
+      DirX[8], DirY[8], DirZ[8], // Ray directions
+      InvX[8], InvY[8], InvZ[8]; // Direction reciprocals
+
+    /* Default constructor */
+    ray_packet()
+    {
+    } /* End of 'ray_packet' function */
+
+    /* Constructor by 8 rays.
+     * ARGUMENTS:
+     *   - rays:
+     *       std::span<const ray<FLT>, 8> Rays;
+     */
+    explicit ray_packet( std::span<const ray<FLT>, 8> Rays )
+    {
+      for (INT i = 0; i < 8; i++)
+        Set(i, Rays[i]);
+    } /* End of 'ray_packet' function */
+
+    /* Set packet lane ray function.
+     * ARGUMENTS:
+     *   - lane index:
+     *       INT i;
+     *   - ray:
+     *       const ray<FLT> &R;
+     * RETURNS: None.
+     */
+    VOID Set( INT i, const ray<FLT> &R )
+    {
+      OrgX[i] = R.Org.X, OrgY[i] = R.Org.Y, OrgZ[i] = R.Org.Z;
+      DirX[i] = R.Dir.X, DirY[i] = R.Dir.Y, DirZ[i] = R.Dir.Z;
+      InvX[i] = 1 / R.Dir.X, InvY[i] = 1 / R.Dir.Y, InvZ[i] = 1 / R.Dir.Z;
+    } /* End of 'Set' function */
+
+    /* Get packet lane ray function.
+     * ARGUMENTS:
+     *   - lane index:
+     *       INT i;
+     * RETURNS:
+     *   (ray<FLT>) lane ray.
+     */
+    ray<FLT> Get( INT i ) const
+    {
+      ray<FLT> R;
+
+      R.Org = vec3<FLT>(OrgX[i], OrgY[i], OrgZ[i]);
+      R.Dir = vec3<FLT>(DirX[i], DirY[i], DirZ[i]);
+      return R;
+    } /* End of 'Get' function */
+
+    /* Build packet of 8 consecutive frame pixels rays function.
+     * ARGUMENTS:
+     *   - camera:
+     *       const camera<FLT> &Cam;
+     *   - first pixel coordinates (next pixels are at Xs + 1 .. Xs + 7):
+     *       FLT Xs, Ys;
+     * RETURNS:
+     *   (ray_packet) packet.
+     */
+    static ray_packet FrameRays( const camera<FLT> &Cam, FLT Xs, FLT Ys )
+    {
+      ray_packet P;
+
+      for (INT i = 0; i < 8; i++)
+        P.Set(i, Cam.FrameRay(Xs + i, Ys));
+      return P;
+    } /* End of 'FrameRays' function */
+  }; /* End of 'ray_packet' structure */
+
+  /* Packet of 8 ray intersection results (SoA) type */
+  struct alignas(32) hit_packet
+  {
+    FLT
+      T[8],        // Ray parameters of nearest hits
+      U[8], V[8];  // Barycentrics of hit points
+    INT
+      PrimId[8],   // Hit primitive ids
+      TriId[8];    // Hit triangle ids
+
+    /* Default constructor (no hits) */
+    hit_packet()
+    {
+      for (INT i = 0; i < 8; i++)
+        T[i] = std::numeric_limits<FLT>::max(), U[i] = V[i] = 0, PrimId[i] = TriId[i] = -1;
+    } /* End of 'hit_packet' function */
+
+    /* Get packet lane hit function.
+     * ARGUMENTS:
+     *   - lane index:
+     *       INT i;
+     * RETURNS:
+     *   (hit<FLT>) lane hit.
+     */
+    hit<FLT> Get( INT i ) const
+    {
+      return hit<FLT> {T[i], U[i], V[i], PrimId[i], TriId[i]};
+    } /* End of 'Get' function */
+  }; /* End of 'hit_packet' structure */
+
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    /* Ray packet-box intersection AVX2 kernel function.
+     * ARGUMENTS:
+     *   - ray packet:
+     *       const ray_packet &R;
+     *   - box:
+     *       const aabb<FLT> &B;
+     *   - maximal ray parameters:
+     *       const FLT *TMax;
+     *   - entry ray parameters:
+     *       FLT *T;
+     * RETURNS:
+     *   (INT) hit lanes mask.
+     */
+    MTH_TARGET_AVX2 inline INT IntersectPacketBoxAVX2( const ray_packet &R, const aabb<FLT> &B, const FLT *TMax, FLT *T )
+    {
+      __m256
+        OX = _mm256_load_ps(R.OrgX), OY = _mm256_load_ps(R.OrgY), OZ = _mm256_load_ps(R.OrgZ),
+        IX = _mm256_load_ps(R.InvX), IY = _mm256_load_ps(R.InvY), IZ = _mm256_load_ps(R.InvZ),
+        T0X = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.X), OX), IX),
+        T1X = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.X), OX), IX),
+        T0Y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.Y), OY), IY),
+        T1Y = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.Y), OY), IY),
+        T0Z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Min.Z), OZ), IZ),
+        T1Z = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(B.Max.Z), OZ), IZ),
+        TN = _mm256_max_ps(_mm256_max_ps(_mm256_min_ps(T0X, T1X), _mm256_min_ps(T0Y, T1Y)),
+                           _mm256_max_ps(_mm256_min_ps(T0Z, T1Z), _mm256_setzero_ps())),
+        TF = _mm256_min_ps(_mm256_min_ps(_mm256_max_ps(T0X, T1X), _mm256_max_ps(T0Y, T1Y)),
+                           _mm256_min_ps(_mm256_max_ps(T0Z, T1Z), _mm256_loadu_ps(TMax)));
+
+      _mm256_storeu_ps(T, TN);
+      return _mm256_movemask_ps(_mm256_cmp_ps(TN, TF, _CMP_LE_OQ));
+    } /* End of 'IntersectPacketBoxAVX2' function */
+
+    /* Ray packet-triangle intersection AVX2 kernel function.
+     * ARGUMENTS:
+     *   - ray packet:
+     *       const ray_packet &R;
+     *   - triangle vertices:
+     *       const vec3<FLT> &P0, &P1, &P2;
+     *   - primitive and triangle ids:
+     *       INT PrimId, TriId;
+     *   - nearest hits (updated only for closer triangle):
+     *       hit_packet &H;
+     * RETURNS:
+     *   (INT) updated lanes mask.
+     */
+    MTH_TARGET_AVX2 inline INT IntersectPacketTriangleAVX2( const ray_packet &R, const vec3<FLT> &P0, const vec3<FLT> &P1,
+                                                            const vec3<FLT> &P2, INT PrimId, INT TriId, hit_packet &H )
+    {
+      const __m256
+        Threshold = _mm256_set1_ps(std::numeric_limits<FLT>::epsilon()),
+        Zero = _mm256_setzero_ps(),
+        One = _mm256_set1_ps(1);
+      __m256
+        E1X = _mm256_set1_ps(P1.X - P0.X), E1Y = _mm256_set1_ps(P1.Y - P0.Y), E1Z = _mm256_set1_ps(P1.Z - P0.Z),
+        E2X = _mm256_set1_ps(P2.X - P0.X), E2Y = _mm256_set1_ps(P2.Y - P0.Y), E2Z = _mm256_set1_ps(P2.Z - P0.Z),
+        DX = _mm256_load_ps(R.DirX), DY = _mm256_load_ps(R.DirY), DZ = _mm256_load_ps(R.DirZ),
+        // P = D % E2
+        PX = _mm256_fmsub_ps(DY, E2Z, _mm256_mul_ps(DZ, E2Y)),
+        PY = _mm256_fmsub_ps(DZ, E2X, _mm256_mul_ps(DX, E2Z)),
+        PZ = _mm256_fmsub_ps(DX, E2Y, _mm256_mul_ps(DY, E2X)),
+        Det = _mm256_fmadd_ps(E1X, PX, _mm256_fmadd_ps(E1Y, PY, _mm256_mul_ps(E1Z, PZ))),
+        Inv = _mm256_div_ps(One, Det),
+        // S = O - P0
+        SX = _mm256_sub_ps(_mm256_load_ps(R.OrgX), _mm256_set1_ps(P0.X)),
+        SY = _mm256_sub_ps(_mm256_load_ps(R.OrgY), _mm256_set1_ps(P0.Y)),
+        SZ = _mm256_sub_ps(_mm256_load_ps(R.OrgZ), _mm256_set1_ps(P0.Z)),
+        U = _mm256_mul_ps(_mm256_fmadd_ps(SX, PX, _mm256_fmadd_ps(SY, PY, _mm256_mul_ps(SZ, PZ))), Inv),
+        // Q = S % E1
+        QX = _mm256_fmsub_ps(SY, E1Z, _mm256_mul_ps(SZ, E1Y)),
+        QY = _mm256_fmsub_ps(SZ, E1X, _mm256_mul_ps(SX, E1Z)),
+        QZ = _mm256_fmsub_ps(SX, E1Y, _mm256_mul_ps(SY, E1X)),
+        V = _mm256_mul_ps(_mm256_fmadd_ps(DX, QX, _mm256_fmadd_ps(DY, QY, _mm256_mul_ps(DZ, QZ))), Inv),
+        T = _mm256_mul_ps(_mm256_fmadd_ps(E2X, QX, _mm256_fmadd_ps(E2Y, QY, _mm256_mul_ps(E2Z, QZ))), Inv),
+        HT = _mm256_load_ps(H.T),
+        AbsDet = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), Det),
+        Mask = _mm256_and_ps(
+                 _mm256_and_ps(_mm256_cmp_ps(AbsDet, Threshold, _CMP_GE_OQ),
+                               _mm256_and_ps(_mm256_cmp_ps(U, Zero, _CMP_GE_OQ), _mm256_cmp_ps(V, Zero, _CMP_GE_OQ))),
+                 _mm256_and_ps(_mm256_cmp_ps(_mm256_add_ps(U, V), One, _CMP_LE_OQ),
+                               _mm256_and_ps(_mm256_cmp_ps(T, Threshold, _CMP_GT_OQ), _mm256_cmp_ps(T, HT, _CMP_LT_OQ))));
+      INT Bits = _mm256_movemask_ps(Mask);
+
+      if (Bits == 0)
+        return 0;
+      __m256i IMask = _mm256_castps_si256(Mask);
+
+      _mm256_store_ps(H.T, _mm256_blendv_ps(HT, T, Mask));
+      _mm256_store_ps(H.U, _mm256_blendv_ps(_mm256_load_ps(H.U), U, Mask));
+      _mm256_store_ps(H.V, _mm256_blendv_ps(_mm256_load_ps(H.V), V, Mask));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(H.PrimId),
+        _mm256_blendv_epi8(_mm256_load_si256(reinterpret_cast<const __m256i *>(H.PrimId)), _mm256_set1_epi32(PrimId), IMask));
+      _mm256_store_si256(reinterpret_cast<__m256i *>(H.TriId),
+        _mm256_blendv_epi8(_mm256_load_si256(reinterpret_cast<const __m256i *>(H.TriId)), _mm256_set1_epi32(TriId), IMask));
+      return Bits;
+    } /* End of 'IntersectPacketTriangleAVX2' function */
+#endif // USE_MTH_MATR_SIMD
+  } /* end of 'simd' namespace */
+
+  /* Ray packet-box intersection function.
+   * ARGUMENTS:
+   *   - ray packet:
+   *       const ray_packet &R;
+   *   - box:
+   *       const aabb<FLT> &B;
+   *   - maximal ray parameters per lane (e.g. current nearest hits 'hit_packet::T'):
+   *       const FLT *TMax;
+   *   - entry ray parameters per lane:
+   *       FLT *T;
+   * RETURNS:
+   *   (INT) hit lanes mask (bit i set - lane i hits box).
+   */
+  inline INT Intersect( const ray_packet &R, const aabb<FLT> &B, const FLT *TMax, FLT *T )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::IsBatchAVX2())
+      return simd::IntersectPacketBoxAVX2(R, B, TMax, T);
+#endif // USE_MTH_MATR_SIMD
+    INT Bits = 0;
+
+    for (INT i = 0; i < 8; i++)
+    {
+      ray_inv<FLT> RI(R.Get(i));
+
+      RI.InvDir = vec3<FLT>(R.InvX[i], R.InvY[i], R.InvZ[i]);
+      if (Intersect(RI, B, TMax[i], T[i]))
+        Bits |= 1 << i;
+    }
+    return Bits;
+  } /* End of 'Intersect' function */
+
+  /* Ray packet-triangle intersection function.
+   * ARGUMENTS:
+   *   - ray packet:
+   *       const ray_packet &R;
+   *   - triangle vertices:
+   *       const vec3<FLT> &P0, &P1, &P2;
+   *   - primitive and triangle ids:
+   *       INT PrimId, TriId;
+   *   - nearest hits (updated only for closer triangle):
+   *       hit_packet &H;
+   * RETURNS:
+   *   (INT) updated lanes mask.
+   */
+  inline INT Intersect( const ray_packet &R, const vec3<FLT> &P0, const vec3<FLT> &P1, const vec3<FLT> &P2,
+                        INT PrimId, INT TriId, hit_packet &H )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::IsBatchAVX2())
+      return simd::IntersectPacketTriangleAVX2(R, P0, P1, P2, PrimId, TriId, H);
+#endif // USE_MTH_MATR_SIMD
+    INT Bits = 0;
+
+    for (INT i = 0; i < 8; i++)
+    {
+      hit<FLT> Hi = H.Get(i);
+
+      if (Intersect(R.Get(i), P0, P1, P2, PrimId, TriId, Hi))
+      {
+        H.T[i] = Hi.T, H.U[i] = Hi.U, H.V[i] = Hi.V, H.PrimId[i] = Hi.PrimId, H.TriId[i] = Hi.TriId;
+        Bits |= 1 << i;
+      }
+    }
+    return Bits;
+  } /* End of 'Intersect' function */
+
+  /* Ray packet-indexed triangle mesh intersection function.
+   * ARGUMENTS:
+   *   - ray packet:
+   *       const ray_packet &R;
+   *   - mesh vertices:
+   *       std::span<const vertex_type> V;
+   *   - vertex position field:
+   *       vec3<FLT> vertex_type::*Field;
+   *   - triangle list indices:
+   *       std::span<const INT> Ind;
+   *   - primitive id:
+   *       INT PrimId;
+   *   - nearest hits (updated only for closer triangles):
+   *       hit_packet &H;
+   * RETURNS:
+   *   (INT) updated lanes mask.
+   */
+  template<typename vertex_type>
+    inline INT Intersect( const ray_packet &R, std::span<const vertex_type> V, vec3<FLT> vertex_type::*Field,
+                          std::span<const INT> Ind, INT PrimId, hit_packet &H )
+    {
+      INT Bits = 0;
+
+      for (size_t i = 0; i + 2 < Ind.size(); i += 3)
+        Bits |= Intersect(R, V[Ind[i]].*Field, V[Ind[i + 1]].*Field, V[Ind[i + 2]].*Field,
+                          PrimId, static_cast<INT>(i / 3), H);
+      return Bits;
+    } /* End of 'Intersect' function */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_isect_h_
+
+/* END OF 'mth_isect.h' FILE */
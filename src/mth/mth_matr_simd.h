@@ -0,0 +1,676 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_matr_simd.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Runtime dispatched SIMD kernels for float matrix 4x4
+ *              (scalar, SSE4.1 and AVX2 variants).
+ * NOTE:        Kernels work with raw row-major 'FLT [4][4]' arrays with
+ *              row-vector convention (same as generic 'matr' template).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_matr_simd_h_
+#define __mth_matr_simd_h_
+
+#include "mth_def.h"
+
+#if defined(USE_MTH_MATR_SIMD)
+
+/* Per function instruction set target attributes.
+ * MSVC allows any intrinsics without special attributes.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#  define MTH_TARGET_SSE41
+#  define MTH_TARGET_AVX2
+#else  // _MSC_VER && !__clang__
+#  define MTH_TARGET_SSE41 __attribute__((target("sse4.1")))
+#  define MTH_TARGET_AVX2  __attribute__((target("avx2,fma")))
+#endif // _MSC_VER && !__clang__
+
+/* Space math namespace */
+namespace mth
+{
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+    /* Instruction set level type */
+    enum class level
+    {
+      SCALAR, // Plain C++ code
+      SSE41,  // SSE 4.1 instructions
+      AVX2,   // AVX2 + FMA instructions
+    }; /* End of 'level' enum */
+
+    /* Matrix kernels table structure */
+    struct matr_kernels
+    {
+      level Level; // Instruction set level of table
+
+      // Matrix multiplication (R = A * B)
+      VOID (*Mul)( FLT R[4][4], const FLT A[4][4], const FLT B[4][4] );
+      // Matrix transposition (R = A^T)
+      VOID (*Transpose)( FLT R[4][4], const FLT A[4][4] );
+      // Matrix determinant
+      FLT (*Determ)( const FLT A[4][4] );
+      // Matrix inversion (R = A^-1), returns FALSE for singular matrix
+      BOOL (*Inverse)( FLT R[4][4], const FLT A[4][4] );
+      // Point transformation (R = (V, 1) * A)
+      VOID (*TransformPoint)( FLT R[3], const FLT A[4][4], const FLT V[3] );
+      // Vector transformation (R = (V, 0) * A)
+      VOID (*TransformVector)( FLT R[3], const FLT A[4][4], const FLT V[3] );
+    }; /* End of 'matr_kernels' structure */
+
+    /***
+     * Scalar kernels
+     ***/
+
+    /* Matrix 3x3 determinant function.
+     * ARGUMENTS:
+     *   - matrix components:
+     *       FLT A11 - A33;
+     * RETURNS:
+     *   (FLT) determinant.
+     */
+    constexpr FLT Determ3x3Scalar( FLT A11, FLT A12, FLT A13,
+                                FLT A21, FLT A22, FLT A23,
+                                FLT A31, FLT A32, FLT A33 )
+    {
+      return A11 * A22 * A33 + A12 * A23 * A31 + A13 * A21 * A32 -
+             A11 * A23 * A32 - A12 * A21 * A33 - A13 * A22 * A31;
+    } /* End of 'Determ3x3Scalar' function */
+
+    /* Matrix multiplication scalar kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrices:
+     *       const FLT A[4][4], B[4][4];
+     * RETURNS: None.
+     */
+    constexpr VOID MulScalar( FLT R[4][4], const FLT A[4][4], const FLT B[4][4] )
+    {
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+          R[i][j] = A[i][0] * B[0][j] + A[i][1] * B[1][j] + A[i][2] * B[2][j] + A[i][3] * B[3][j];
+    } /* End of 'MulScalar' function */
+
+    /* Matrix transposition scalar kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS: None.
+     */
+    constexpr VOID TransposeScalar( FLT R[4][4], const FLT A[4][4] )
+    {
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+          R[i][j] = A[j][i];
+    } /* End of 'TransposeScalar' function */
+
+    /* Matrix determinant scalar kernel function.
+     * ARGUMENTS:
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS:
+     *   (FLT) determinant.
+     */
+    constexpr FLT DetermScalar( const FLT A[4][4] )
+    {
+      return
+        +A[0][0] * Determ3x3Scalar(A[1][1], A[1][2], A[1][3],
+                                   A[2][1], A[2][2], A[2][3],
+                                   A[3][1], A[3][2], A[3][3]) +
+        -A[0][1] * Determ3x3Scalar(A[1][0], A[1][2], A[1][3],
+                                   A[2][0], A[2][2], A[2][3],
+                                   A[3][0], A[3][2], A[3][3]) +
+        +A[0][2] * Determ3x3Scalar(A[1][0], A[1][1], A[1][3],
+                                   A[2][0], A[2][1], A[2][3],
+                                   A[3][0], A[3][1], A[3][3]) +
+        -A[0][3] * Determ3x3Scalar(A[1][0], A[1][1], A[1][2],
+                                   A[2][0], A[2][1], A[2][2],
+                                   A[3][0], A[3][1], A[3][2]);
+    } /* End of 'DetermScalar' function */
+
+    /* Matrix inversion scalar kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS:
+     *   (BOOL) FALSE if matrix is singular, TRUE otherwise.
+     */
+    constexpr BOOL InverseScalar( FLT R[4][4], const FLT A[4][4] )
+    {
+      FLT det = DetermScalar(A);
+      constexpr INT
+        s[] = {1, -1},
+        P[][3] = {{1, 2, 3}, {0, 2, 3}, {0, 1, 3}, {0, 1, 2}};
+
+      if (det == 0)
+        return FALSE;
+
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+          R[j][i] =
+            s[(i + j) % 2] *
+            Determ3x3Scalar(A[P[i][0]][P[j][0]], A[P[i][0]][P[j][1]], A[P[i][0]][P[j][2]],
+                            A[P[i][1]][P[j][0]], A[P[i][1]][P[j][1]], A[P[i][1]][P[j][2]],
+                            A[P[i][2]][P[j][0]], A[P[i][2]][P[j][1]], A[P[i][2]][P[j][2]]) / det;
+      return TRUE;
+    } /* End of 'InverseScalar' function */
+
+    /* Point transformation scalar kernel function.
+     * ARGUMENTS:
+     *   - result point:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source point:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    constexpr VOID TransformPointScalar( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      FLT X = V[0], Y = V[1], Z = V[2];
+
+      R[0] = X * A[0][0] + Y * A[1][0] + Z * A[2][0] + A[3][0];
+      R[1] = X * A[0][1] + Y * A[1][1] + Z * A[2][1] + A[3][1];
+      R[2] = X * A[0][2] + Y * A[1][2] + Z * A[2][2] + A[3][2];
+    } /* End of 'TransformPointScalar' function */
+
+    /* Vector transformation scalar kernel function.
+     * ARGUMENTS:
+     *   - result vector:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source vector:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    constexpr VOID TransformVectorScalar( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      FLT X = V[0], Y = V[1], Z = V[2];
+
+      R[0] = X * A[0][0] + Y * A[1][0] + Z * A[2][0];
+      R[1] = X * A[0][1] + Y * A[1][1] + Z * A[2][1];
+      R[2] = X * A[0][2] + Y * A[1][2] + Z * A[2][2];
+    } /* End of 'TransformVectorScalar' function */
+
+    /***
+     * SSE 4.1 kernels
+     ***/
+
+/* Shuffle helpers (2x2 sub-matrix inverse by blocks) */
+#define MTH_SHUFFLE_MASK(x, y, z, w)      ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+#define MTH_SWIZZLE(V, x, y, z, w)        _mm_shuffle_ps(V, V, MTH_SHUFFLE_MASK(x, y, z, w))
+#define MTH_SWIZZLE1(V, x)                _mm_shuffle_ps(V, V, MTH_SHUFFLE_MASK(x, x, x, x))
+#define MTH_SHUFFLE(V1, V2, x, y, z, w)   _mm_shuffle_ps(V1, V2, MTH_SHUFFLE_MASK(x, y, z, w))
+
+    /* 2x2 row-major matrices multiplication (A * B) function.
+     * ARGUMENTS:
+     *   - 2x2 matrices (as 4 component vectors):
+     *       __m128 A, B;
+     * RETURNS:
+     *   (__m128) result 2x2 matrix.
+     */
+    MTH_TARGET_SSE41 inline __m128 Mat2MulSSE41( __m128 A, __m128 B )
+    {
+      return _mm_add_ps(_mm_mul_ps(A, MTH_SWIZZLE(B, 0, 3, 0, 3)),
+                        _mm_mul_ps(MTH_SWIZZLE(A, 1, 0, 3, 2), MTH_SWIZZLE(B, 2, 1, 2, 1)));
+    } /* End of 'Mat2MulSSE41' function */
+
+    /* 2x2 row-major matrices adjugate multiplication (adj(A) * B) function.
+     * ARGUMENTS:
+     *   - 2x2 matrices (as 4 component vectors):
+     *       __m128 A, B;
+     * RETURNS:
+     *   (__m128) result 2x2 matrix.
+     */
+    MTH_TARGET_SSE41 inline __m128 Mat2AdjMulSSE41( __m128 A, __m128 B )
+    {
+      return _mm_sub_ps(_mm_mul_ps(MTH_SWIZZLE(A, 3, 3, 0, 0), B),
+                        _mm_mul_ps(MTH_SWIZZLE(A, 1, 1, 2, 2), MTH_SWIZZLE(B, 2, 3, 0, 1)));
+    } /* End of 'Mat2AdjMulSSE41' function */
+
+    /* 2x2 row-major matrices multiplication by adjugate (A * adj(B)) function.
+     * ARGUMENTS:
+     *   - 2x2 matrices (as 4 component vectors):
+     *       __m128 A, B;
+     * RETURNS:
+     *   (__m128) result 2x2 matrix.
+     */
+    MTH_TARGET_SSE41 inline __m128 Mat2MulAdjSSE41( __m128 A, __m128 B )
+    {
+      return _mm_sub_ps(_mm_mul_ps(A, MTH_SWIZZLE(B, 3, 0, 3, 0)),
+                        _mm_mul_ps(MTH_SWIZZLE(A, 1, 0, 3, 2), MTH_SWIZZLE(B, 2, 1, 2, 1)));
+    } /* End of 'Mat2MulAdjSSE41' function */
+
+    /* Matrix multiplication SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrices:
+     *       const FLT A[4][4], B[4][4];
+     * RETURNS: None.
+     */
+    MTH_TARGET_SSE41 inline VOID MulSSE41( FLT R[4][4], const FLT A[4][4], const FLT B[4][4] )
+    {
+      __m128
+        B0 = _mm_loadu_ps(B[0]),
+        B1 = _mm_loadu_ps(B[1]),
+        B2 = _mm_loadu_ps(B[2]),
+        B3 = _mm_loadu_ps(B[3]);
+
+      for (INT i = 0; i < 4; i++)
+      {
+        __m128 Row = _mm_mul_ps(_mm_set1_ps(A[i][0]), B0);
+
+        Row = _mm_add_ps(Row, _mm_mul_ps(_mm_set1_ps(A[i][1]), B1));
+        Row = _mm_add_ps(Row, _mm_mul_ps(_mm_set1_ps(A[i][2]), B2));
+        Row = _mm_add_ps(Row, _mm_mul_ps(_mm_set1_ps(A[i][3]), B3));
+        _mm_storeu_ps(R[i], Row);
+      }
+    } /* End of 'MulSSE41' function */
+
+    /* Matrix transposition SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS: None.
+     */
+    MTH_TARGET_SSE41 inline VOID TransposeSSE41( FLT R[4][4], const FLT A[4][4] )
+    {
+      __m128
+        R0 = _mm_loadu_ps(A[0]),
+        R1 = _mm_loadu_ps(A[1]),
+        R2 = _mm_loadu_ps(A[2]),
+        R3 = _mm_loadu_ps(A[3]);
+
+      _MM_TRANSPOSE4_PS(R0, R1, R2, R3);
+      _mm_storeu_ps(R[0], R0);
+      _mm_storeu_ps(R[1], R1);
+      _mm_storeu_ps(R[2], R2);
+      _mm_storeu_ps(R[3], R3);
+    } /* End of 'TransposeSSE41' function */
+
+    /* Matrix determinant and inverse parts by 2x2 blocks SSE 4.1 function.
+     * ARGUMENTS:
+     *   - source matrix:
+     *       const FLT A[4][4];
+     *   - inverse matrix (may be nullptr for determinant only):
+     *       FLT R[4][4];
+     * RETURNS:
+     *   (FLT) determinant.
+     */
+    MTH_TARGET_SSE41 inline FLT InverseBlocksSSE41( const FLT A[4][4], FLT (*R)[4] )
+    {
+      __m128
+        R0 = _mm_loadu_ps(A[0]),
+        R1 = _mm_loadu_ps(A[1]),
+        R2 = _mm_loadu_ps(A[2]),
+        R3 = _mm_loadu_ps(A[3]),
+        // 2x2 sub-matrices: |BA BB|
+        //                   |BC BD|
+        BA = _mm_movelh_ps(R0, R1),
+        BB = _mm_movehl_ps(R1, R0),
+        BC = _mm_movelh_ps(R2, R3),
+        BD = _mm_movehl_ps(R3, R2),
+        // Sub-matrices determinants (|BA| |BB| |BC| |BD|)
+        DetSub = _mm_sub_ps(_mm_mul_ps(MTH_SHUFFLE(R0, R2, 0, 2, 0, 2), MTH_SHUFFLE(R1, R3, 1, 3, 1, 3)),
+                            _mm_mul_ps(MTH_SHUFFLE(R0, R2, 1, 3, 1, 3), MTH_SHUFFLE(R1, R3, 0, 2, 0, 2))),
+        DetA = MTH_SWIZZLE1(DetSub, 0),
+        DetB = MTH_SWIZZLE1(DetSub, 1),
+        DetC = MTH_SWIZZLE1(DetSub, 2),
+        DetD = MTH_SWIZZLE1(DetSub, 3),
+        D_C = Mat2AdjMulSSE41(BD, BC),
+        A_B = Mat2AdjMulSSE41(BA, BB),
+        DetM = _mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC)),
+        Tr = _mm_mul_ps(A_B, MTH_SWIZZLE(D_C, 0, 2, 1, 3));
+
+      Tr = _mm_hadd_ps(Tr, Tr);
+      Tr = _mm_hadd_ps(Tr, Tr);
+      DetM = _mm_sub_ps(DetM, Tr);
+
+      FLT Det = _mm_cvtss_f32(DetM);
+
+      if (R == nullptr || Det == 0)
+        return Det;
+
+      __m128
+        X = _mm_sub_ps(_mm_mul_ps(DetD, BA), Mat2MulSSE41(BB, D_C)),
+        W = _mm_sub_ps(_mm_mul_ps(DetA, BD), Mat2MulSSE41(BC, A_B)),
+        Y = _mm_sub_ps(_mm_mul_ps(DetB, BC), Mat2MulAdjSSE41(BD, A_B)),
+        Z = _mm_sub_ps(_mm_mul_ps(DetC, BB), Mat2MulAdjSSE41(BA, D_C)),
+        RDetM = _mm_div_ps(_mm_setr_ps(1, -1, -1, 1), DetM);
+
+      X = _mm_mul_ps(X, RDetM);
+      Y = _mm_mul_ps(Y, RDetM);
+      Z = _mm_mul_ps(Z, RDetM);
+      W = _mm_mul_ps(W, RDetM);
+
+      _mm_storeu_ps(R[0], MTH_SHUFFLE(X, Y, 3, 1, 3, 1));
+      _mm_storeu_ps(R[1], MTH_SHUFFLE(X, Y, 2, 0, 2, 0));
+      _mm_storeu_ps(R[2], MTH_SHUFFLE(Z, W, 3, 1, 3, 1));
+      _mm_storeu_ps(R[3], MTH_SHUFFLE(Z, W, 2, 0, 2, 0));
+      return Det;
+    } /* End of 'InverseBlocksSSE41' function */
+
+    /* Matrix determinant SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS:
+     *   (FLT) determinant.
+     */
+    MTH_TARGET_SSE41 inline FLT DetermSSE41( const FLT A[4][4] )
+    {
+      return InverseBlocksSSE41(A, nullptr);
+    } /* End of 'DetermSSE41' function */
+
+    /* Matrix inversion SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrix:
+     *       const FLT A[4][4];
+     * RETURNS:
+     *   (BOOL) FALSE if matrix is singular, TRUE otherwise.
+     */
+    MTH_TARGET_SSE41 inline BOOL InverseSSE41( FLT R[4][4], const FLT A[4][4] )
+    {
+      return InverseBlocksSSE41(A, R) != 0;
+    } /* End of 'InverseSSE41' function */
+
+    /* Store 3 first components of vector function.
+     * ARGUMENTS:
+     *   - destination:
+     *       FLT R[3];
+     *   - vector:
+     *       __m128 V;
+     * RETURNS: None.
+     */
+    MTH_TARGET_SSE41 inline VOID Store3SSE41( FLT R[3], __m128 V )
+    {
+      _mm_storel_pi(reinterpret_cast<__m64 *>(R), V);
+      _mm_store_ss(R + 2, _mm_movehl_ps(V, V));
+    } /* End of 'Store3SSE41' function */
+
+    /* Point transformation SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - result point:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source point:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    MTH_TARGET_SSE41 inline VOID TransformPointSSE41( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      __m128 Res = _mm_mul_ps(_mm_set1_ps(V[0]), _mm_loadu_ps(A[0]));
+
+      Res = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(V[1]), _mm_loadu_ps(A[1])));
+      Res = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(V[2]), _mm_loadu_ps(A[2])));
+      Res = _mm_add_ps(Res, _mm_loadu_ps(A[3]));
+      Store3SSE41(R, Res);
+    } /* End of 'TransformPointSSE41' function */
+
+    /* Vector transformation SSE 4.1 kernel function.
+     * ARGUMENTS:
+     *   - result vector:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source vector:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    MTH_TARGET_SSE41 inline VOID TransformVectorSSE41( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      __m128 Res = _mm_mul_ps(_mm_set1_ps(V[0]), _mm_loadu_ps(A[0]));
+
+      Res = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(V[1]), _mm_loadu_ps(A[1])));
+      Res = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(V[2]), _mm_loadu_ps(A[2])));
+      Store3SSE41(R, Res);
+    } /* End of 'TransformVectorSSE41' function */
+
+    /***
+     * AVX2 kernels
+     ***/
+
+    /* Duplicate matrix row to both 128-bit lanes function.
+     * ARGUMENTS:
+     *   - matrix row:
+     *       const FLT *Row;
+     * RETURNS:
+     *   (__m256) (Row, Row) vector.
+     */
+    MTH_TARGET_AVX2 inline __m256 BroadcastRowAVX2( const FLT *Row )
+    {
+      __m128 V = _mm_loadu_ps(Row);
+
+      return _mm256_insertf128_ps(_mm256_castps128_ps256(V), V, 1);
+    } /* End of 'BroadcastRowAVX2' function */
+
+    /* Matrix multiplication AVX2 kernel function (two rows per iteration).
+     * ARGUMENTS:
+     *   - result matrix:
+     *       FLT R[4][4];
+     *   - source matrices:
+     *       const FLT A[4][4], B[4][4];
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID MulAVX2( FLT R[4][4], const FLT A[4][4], const FLT B[4][4] )
+    {
+      __m256
+        B0 = BroadcastRowAVX2(B[0]),
+        B1 = BroadcastRowAVX2(B[1]),
+        B2 = BroadcastRowAVX2(B[2]),
+        B3 = BroadcastRowAVX2(B[3]);
+
+      for (INT i = 0; i < 4; i += 2)
+      {
+        __m256
+          Rows = _mm256_loadu_ps(A[i]),
+          Res = _mm256_mul_ps(_mm256_shuffle_ps(Rows, Rows, 0x00), B0);
+
+        Res = _mm256_fmadd_ps(_mm256_shuffle_ps(Rows, Rows, 0x55), B1, Res);
+        Res = _mm256_fmadd_ps(_mm256_shuffle_ps(Rows, Rows, 0xAA), B2, Res);
+        Res = _mm256_fmadd_ps(_mm256_shuffle_ps(Rows, Rows, 0xFF), B3, Res);
+        _mm256_storeu_ps(R[i], Res);
+      }
+    } /* End of 'MulAVX2' function */
+
+    /* Point transformation AVX2 (FMA) kernel function.
+     * ARGUMENTS:
+     *   - result point:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source point:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID TransformPointAVX2( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      __m128 Res = _mm_fmadd_ps(_mm_set1_ps(V[0]), _mm_loadu_ps(A[0]), _mm_loadu_ps(A[3]));
+
+      Res = _mm_fmadd_ps(_mm_set1_ps(V[1]), _mm_loadu_ps(A[1]), Res);
+      Res = _mm_fmadd_ps(_mm_set1_ps(V[2]), _mm_loadu_ps(A[2]), Res);
+      Store3SSE41(R, Res);
+    } /* End of 'TransformPointAVX2' function */
+
+    /* Vector transformation AVX2 (FMA) kernel function.
+     * ARGUMENTS:
+     *   - result vector:
+     *       FLT R[3];
+     *   - transformation matrix:
+     *       const FLT A[4][4];
+     *   - source vector:
+     *       const FLT V[3];
+     * RETURNS: None.
+     */
+    MTH_TARGET_AVX2 inline VOID TransformVectorAVX2( FLT R[3], const FLT A[4][4], const FLT V[3] )
+    {
+      __m128 Res = _mm_mul_ps(_mm_set1_ps(V[0]), _mm_loadu_ps(A[0]));
+
+      Res = _mm_fmadd_ps(_mm_set1_ps(V[1]), _mm_loadu_ps(A[1]), Res);
+      Res = _mm_fmadd_ps(_mm_set1_ps(V[2]), _mm_loadu_ps(A[2]), Res);
+      Store3SSE41(R, Res);
+    } /* End of 'TransformVectorAVX2' function */
+
+#undef MTH_SHUFFLE_MASK
+#undef MTH_SWIZZLE
+#undef MTH_SWIZZLE1
+#undef MTH_SHUFFLE
+
+    /***
+     * Kernels dispatch
+     ***/
+
+    // Scalar kernels table
+    inline const matr_kernels KernelsScalar
+    {
+      level::SCALAR,
+      MulScalar, TransposeScalar, DetermScalar, InverseScalar,
+      TransformPointScalar, TransformVectorScalar,
+    };
+
+    // SSE 4.1 kernels table
+    inline const matr_kernels KernelsSSE41
+    {
+      level::SSE41,
+      MulSSE41, TransposeSSE41, DetermSSE41, InverseSSE41,
+      TransformPointSSE41, TransformVectorSSE41,
+    };
+
+    // AVX2 kernels table (inverse/transpose have no profit from 256-bit registers)
+    inline const matr_kernels KernelsAVX2
+    {
+      level::AVX2,
+      MulAVX2, TransposeSSE41, DetermSSE41, InverseSSE41,
+      TransformPointAVX2, TransformVectorAVX2,
+    };
+
+    /* Detect best supported by CPU and OS instruction set level function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (level) instruction set level.
+     */
+    inline level DetectLevel( VOID )
+    {
+      BOOL IsSSE41 = FALSE, IsAVX2 = FALSE;
+
+#if defined(_MSC_VER)
+      INT Info[4];
+
+      __cpuid(Info, 0);
+      INT MaxId = Info[0];
+
+      if (MaxId >= 1)
+      {
+        __cpuid(Info, 1);
+        BOOL
+          IsOSXSave = (Info[2] >> 27) & 1,
+          IsAVX = (Info[2] >> 28) & 1,
+          IsFMA = (Info[2] >> 12) & 1;
+
+        IsSSE41 = (Info[2] >> 19) & 1;
+        if (MaxId >= 7 && IsOSXSave && IsAVX && IsFMA && (_xgetbv(0) & 6) == 6)
+        {
+          __cpuidex(Info, 7, 0);
+          IsAVX2 = (Info[1] >> 5) & 1;
+        }
+      }
+#else  // _MSC_VER
+      __builtin_cpu_init();
+      IsSSE41 = __builtin_cpu_supports("sse4.1");
+      IsAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif // _MSC_VER
+
+      if (IsAVX2)
+        return level::AVX2;
+      if (IsSSE41)
+        return level::SSE41;
+      return level::SCALAR;
+    } /* End of 'DetectLevel' function */
+
+    /* Get kernels table by instruction set level function.
+     * ARGUMENTS:
+     *   - instruction set level:
+     *       level Level;
+     * RETURNS:
+     *   (const matr_kernels &) kernels table.
+     */
+    inline const matr_kernels & SelectKernels( level Level )
+    {
+      switch (Level)
+      {
+      case level::AVX2:
+        return KernelsAVX2;
+      case level::SSE41:
+        return KernelsSSE41;
+      default:
+        return KernelsScalar;
+      }
+    } /* End of 'SelectKernels' function */
+
+    /* Get reference to current kernels table pointer function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const matr_kernels *&) current kernels table pointer.
+     */
+    inline const matr_kernels *& CurrentKernels( VOID )
+    {
+      static const matr_kernels *Kernels = &SelectKernels(DetectLevel());
+
+      return Kernels;
+    } /* End of 'CurrentKernels' function */
+
+    /* Get current kernels table function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (const matr_kernels &) kernels table.
+     */
+    inline const matr_kernels & GetKernels( VOID )
+    {
+      return *CurrentKernels();
+    } /* End of 'GetKernels' function */
+
+    /* Force instruction set level function (for comparison and benchmarks).
+     * Level is clamped to supported by CPU. Not thread safe, call before using matrices.
+     * ARGUMENTS:
+     *   - instruction set level:
+     *       level Level;
+     * RETURNS:
+     *   (level) really set level.
+     */
+    inline level SetLevel( level Level )
+    {
+      level Best = DetectLevel();
+
+      if (static_cast<INT>(Level) > static_cast<INT>(Best))
+        Level = Best;
+      CurrentKernels() = &SelectKernels(Level);
+      return Level;
+    } /* End of 'SetLevel' function */
+  } /* end of 'simd' namespace */
+} /* end of 'mth' namespace */
+
+#endif // USE_MTH_MATR_SIMD
+
+#endif // !__mth_matr_simd_h_
+
+/* END OF 'mth_matr_simd.h' FILE */
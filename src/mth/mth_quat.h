@@ -0,0 +1,722 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_quat.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Quaternion and dual quaternion header file.
+ * NOTE:        Composition follows 'matr' row-vector convention:
+ *              'A * B' means apply A, then B (as 'matr(A) * matr(B)').
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_quat_h_
+#define __mth_quat_h_
+
+#include <span>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_matr.h"
+#include "mth_matr_simd.h"
+#include "mth_batch.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Quaternion type (rotation representation) */
+  template<typename Type>
+    class quat
+    {
+    public:
+      Type
+        X, Y, Z, // Vector (imaginary) part
+        W;       // Scalar (real) part
+
+      /* Default constructor (identity rotation) */
+      quat() : X(0), Y(0), Z(0), W(1)
+      {
+      } /* End of 'quat' function */
+
+      /* Constructor by 4 components.
+       * ARGUMENTS:
+       *   - components:
+       *       const Type NewX, NewY, NewZ, NewW;
+       */
+      quat( const Type NewX, const Type NewY, const Type NewZ, const Type NewW ) : X(NewX), Y(NewY), Z(NewZ), W(NewW)
+      {
+      } /* End of 'quat' function */
+
+      /* Constructor by vector and scalar parts.
+       * ARGUMENTS:
+       *   - vector part:
+       *       const vec3<Type> &V;
+       *   - scalar part:
+       *       const Type NewW;
+       */
+      quat( const vec3<Type> &V, const Type NewW ) : X(V.X), Y(V.Y), Z(V.Z), W(NewW)
+      {
+      } /* End of 'quat' function */
+
+      /* Get identity quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat) identity quaternion.
+       */
+      static quat Identity()
+      {
+        return quat(0, 0, 0, 1);
+      } /* End of 'Identity' function */
+
+      /* Rotation around normalized axis quaternion function.
+       * ARGUMENTS:
+       *   - angle in degree:
+       *       const Type AngleInDegree;
+       *   - normalized rotation axis (not normalized here):
+       *       const vec3<Type> &Axis;
+       * RETURNS:
+       *   (quat) rotation quaternion.
+       */
+      static quat RotateUnit( const Type AngleInDegree, const vec3<Type> &Axis )
+      {
+        Type
+          a = D2R(AngleInDegree) / 2,
+          s = sin(a);
+
+        return quat(Axis.X * s, Axis.Y * s, Axis.Z * s, cos(a));
+      } /* End of 'RotateUnit' function */
+
+      /* Rotation around axis quaternion function.
+       * ARGUMENTS:
+       *   - angle in degree:
+       *       const Type AngleInDegree;
+       *   - rotation axis:
+       *       const vec3<Type> &Axis;
+       * RETURNS:
+       *   (quat) rotation quaternion.
+       */
+      static quat Rotate( const Type AngleInDegree, const vec3<Type> &Axis )
+      {
+        return RotateUnit(AngleInDegree, Axis.Normalizing());
+      } /* End of 'Rotate' function */
+
+      /* Rotation around X axis quaternion function.
+       * ARGUMENTS:
+       *   - angle in degree:
+       *       const Type AngleInDegree;
+       * RETURNS:
+       *   (quat) rotation quaternion.
+       */
+      static quat RotateX( const Type AngleInDegree )
+      {
+        Type a = D2R(AngleInDegree) / 2;
+
+        return quat(sin(a), 0, 0, cos(a));
+      } /* End of 'RotateX' function */
+
+      /* Rotation around Y axis quaternion function.
+       * ARGUMENTS:
+       *   - angle in degree:
+       *       const Type AngleInDegree;
+       * RETURNS:
+       *   (quat) rotation quaternion.
+       */
+      static quat RotateY( const Type AngleInDegree )
+      {
+        Type a = D2R(AngleInDegree) / 2;
+
+        return quat(0, sin(a), 0, cos(a));
+      } /* End of 'RotateY' function */
+
+      /* Rotation around Z axis quaternion function.
+       * ARGUMENTS:
+       *   - angle in degree:
+       *       const Type AngleInDegree;
+       * RETURNS:
+       *   (quat) rotation quaternion.
+       */
+      static quat RotateZ( const Type AngleInDegree )
+      {
+        Type a = D2R(AngleInDegree) / 2;
+
+        return quat(0, 0, sin(a), cos(a));
+      } /* End of 'RotateZ' function */
+
+      /* Hamilton product function.
+       * ARGUMENTS:
+       *   - quaternions:
+       *       const quat &A, &B;
+       * RETURNS:
+       *   (quat) A (x) B.
+       */
+      static quat Hamilton( const quat &A, const quat &B )
+      {
+        return quat(A.W * B.X + A.X * B.W + A.Y * B.Z - A.Z * B.Y,
+                    A.W * B.Y - A.X * B.Z + A.Y * B.W + A.Z * B.X,
+                    A.W * B.Z + A.X * B.Y - A.Y * B.X + A.Z * B.W,
+                    A.W * B.W - A.X * B.X - A.Y * B.Y - A.Z * B.Z);
+      } /* End of 'Hamilton' function */
+
+      /* Compose rotations function (apply this, then Q).
+       * ARGUMENTS:
+       *   - second rotation:
+       *       const quat &Q;
+       * RETURNS:
+       *   (quat) composed rotation.
+       */
+      quat operator*( const quat &Q ) const
+      {
+        return Hamilton(Q, *this);
+      } /* End of 'operator*' function */
+
+      /* Compose with rotation function (apply this, then Q).
+       * ARGUMENTS:
+       *   - second rotation:
+       *       const quat &Q;
+       * RETURNS:
+       *   (quat &) self reference.
+       */
+      quat & operator*=( const quat &Q )
+      {
+        return *this = Hamilton(Q, *this);
+      } /* End of 'operator*=' function */
+
+      /* Quaternion add function.
+       * ARGUMENTS:
+       *   - other quaternion:
+       *       const quat &Q;
+       * RETURNS:
+       *   (quat) sum.
+       */
+      quat operator+( const quat &Q ) const
+      {
+        return quat(X + Q.X, Y + Q.Y, Z + Q.Z, W + Q.W);
+      } /* End of 'operator+' function */
+
+      /* Quaternion sub function.
+       * ARGUMENTS:
+       *   - other quaternion:
+       *       const quat &Q;
+       * RETURNS:
+       *   (quat) difference.
+       */
+      quat operator-( const quat &Q ) const
+      {
+        return quat(X - Q.X, Y - Q.Y, Z - Q.Z, W - Q.W);
+      } /* End of 'operator-' function */
+
+      /* Quaternion mul number function.
+       * ARGUMENTS:
+       *   - number:
+       *       const Type N;
+       * RETURNS:
+       *   (quat) scaled quaternion.
+       */
+      quat operator*( const Type N ) const
+      {
+        return quat(X * N, Y * N, Z * N, W * N);
+      } /* End of 'operator*' function */
+
+      /* Quaternion negation function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat) negated quaternion (same rotation).
+       */
+      quat operator-() const
+      {
+        return quat(-X, -Y, -Z, -W);
+      } /* End of 'operator-' function */
+
+      /* Quaternions dot product function.
+       * ARGUMENTS:
+       *   - other quaternion:
+       *       const quat &Q;
+       * RETURNS:
+       *   (Type) dot product.
+       */
+      Type operator&( const quat &Q ) const
+      {
+        return X * Q.X + Y * Q.Y + Z * Q.Z + W * Q.W;
+      } /* End of 'operator&' function */
+
+      /* Quaternion length function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (Type) length.
+       */
+      Type operator!() const
+      {
+        return sqrt(X * X + Y * Y + Z * Z + W * W);
+      } /* End of 'operator!' function */
+
+      /* Conjugate quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat) conjugate (inverse rotation for unit quaternion).
+       */
+      quat Conjugate() const
+      {
+        return quat(-X, -Y, -Z, W);
+      } /* End of 'Conjugate' function */
+
+      /* Inverse quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat) inverse quaternion (identity for zero quaternion).
+       */
+      quat Inverse() const
+      {
+        Type len2 = *this & *this;
+
+        if (len2 == 0)
+          return Identity();
+        return Conjugate() * (1 / len2);
+      } /* End of 'Inverse' function */
+
+      /* Normalize quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat &) self reference.
+       */
+      quat & Normalize()
+      {
+        Type len2 = *this & *this;
+
+        if (len2 == 0 || len2 == 1)
+          return *this;
+        return *this = *this * (1 / sqrt(len2));
+      } /* End of 'Normalize' function */
+
+      /* Get normalized quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (quat) normalized quaternion.
+       */
+      quat Normalizing() const
+      {
+        return quat(*this).Normalize();
+      } /* End of 'Normalizing' function */
+
+      /* Rotate vector by unit quaternion function.
+       * ARGUMENTS:
+       *   - vector:
+       *       const vec3<Type> &V;
+       * RETURNS:
+       *   (vec3<Type>) rotated vector.
+       */
+      vec3<Type> Rotate( const vec3<Type> &V ) const
+      {
+        vec3<Type>
+          U(X, Y, Z),
+          T = (U % V) * 2;
+
+        return V + T * W + U % T;
+      } /* End of 'Rotate' function */
+
+      /* Convert unit quaternion to rotation matrix function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (matr<Type>) rotation matrix.
+       */
+      matr<Type> ToMatr() const
+      {
+        Type
+          xx = X * X, yy = Y * Y, zz = Z * Z,
+          xy = X * Y, xz = X * Z, yz = Y * Z,
+          wx = W * X, wy = W * Y, wz = W * Z;
+
+        return matr<Type>(1 - 2 * (yy + zz), 2 * (xy + wz), 2 * (xz - wy), 0,
+                          2 * (xy - wz), 1 - 2 * (xx + zz), 2 * (yz + wx), 0,
+                          2 * (xz + wy), 2 * (yz - wx), 1 - 2 * (xx + yy), 0,
+                          0, 0, 0, 1);
+      } /* End of 'ToMatr' function */
+
+      /* Convert rotation matrix (3x3 part without scale) to quaternion function.
+       * ARGUMENTS:
+       *   - rotation matrix:
+       *       const matr<Type> &M;
+       * RETURNS:
+       *   (quat) unit quaternion.
+       */
+      static quat FromMatr( const matr<Type> &M )
+      {
+        Type tr = M.M[0][0] + M.M[1][1] + M.M[2][2], s;
+
+        if (tr > 0)
+        {
+          s = sqrt(tr + 1) * 2;
+          return quat((M.M[1][2] - M.M[2][1]) / s, (M.M[2][0] - M.M[0][2]) / s, (M.M[0][1] - M.M[1][0]) / s, s / 4);
+        }
+        if (M.M[0][0] > M.M[1][1] && M.M[0][0] > M.M[2][2])
+        {
+          s = sqrt(1 + M.M[0][0] - M.M[1][1] - M.M[2][2]) * 2;
+          return quat(s / 4, (M.M[1][0] + M.M[0][1]) / s, (M.M[2][0] + M.M[0][2]) / s, (M.M[1][2] - M.M[2][1]) / s);
+        }
+        if (M.M[1][1] > M.M[2][2])
+        {
+          s = sqrt(1 + M.M[1][1] - M.M[0][0] - M.M[2][2]) * 2;
+          return quat((M.M[1][0] + M.M[0][1]) / s, s / 4, (M.M[2][1] + M.M[1][2]) / s, (M.M[2][0] - M.M[0][2]) / s);
+        }
+        s = sqrt(1 + M.M[2][2] - M.M[0][0] - M.M[1][1]) * 2;
+        return quat((M.M[2][0] + M.M[0][2]) / s, (M.M[2][1] + M.M[1][2]) / s, s / 4, (M.M[0][1] - M.M[1][0]) / s);
+      } /* End of 'FromMatr' function */
+
+      /* Normalized linear interpolation function.
+       * ARGUMENTS:
+       *   - quaternions:
+       *       const quat &A, &B;
+       *   - interpolation parameter [0..1]:
+       *       const Type T;
+       * RETURNS:
+       *   (quat) interpolated unit quaternion.
+       */
+      static quat Nlerp( const quat &A, const quat &B, const Type T )
+      {
+        quat B1 = (A & B) < 0 ? -B : B;
+
+        return (A * (1 - T) + B1 * T).Normalize();
+      } /* End of 'Nlerp' function */
+
+      /* Spherical linear interpolation (by shortest arc) function.
+       * ARGUMENTS:
+       *   - unit quaternions:
+       *       const quat &A, &B;
+       *   - interpolation parameter [0..1]:
+       *       const Type T;
+       * RETURNS:
+       *   (quat) interpolated unit quaternion.
+       */
+      static quat Slerp( const quat &A, const quat &B, const Type T )
+      {
+        Type d = A & B;
+        quat B1 = d < 0 ? (d = -d, -B) : B;
+
+        // Nearly same rotations: avoid division by small sine
+        if (d > Type(0.9995))
+          return (A * (1 - T) + B1 * T).Normalize();
+
+        Type
+          th = acos(d),
+          sn = sin(th);
+
+        return A * (sin((1 - T) * th) / sn) + B1 * (sin(T * th) / sn);
+      } /* End of 'Slerp' function */
+    }; /* End of 'quat' class */
+
+  /* Dual quaternion type (rigid transformation representation) */
+  template<typename Type>
+    class dual_quat
+    {
+    public:
+      quat<Type>
+        Real, // Rotation part
+        Dual; // Translation part (0.5 * T (x) Real)
+
+      /* Default constructor (identity transformation) */
+      dual_quat() : Real(0, 0, 0, 1), Dual(0, 0, 0, 0)
+      {
+      } /* End of 'dual_quat' function */
+
+      /* Constructor by parts.
+       * ARGUMENTS:
+       *   - real and dual parts:
+       *       const quat<Type> &R, &D;
+       */
+      dual_quat( const quat<Type> &R, const quat<Type> &D ) : Real(R), Dual(D)
+      {
+      } /* End of 'dual_quat' function */
+
+      /* Constructor by rotation and translation (rotate, then translate).
+       * ARGUMENTS:
+       *   - unit rotation quaternion:
+       *       const quat<Type> &R;
+       *   - translation:
+       *       const vec3<Type> &T;
+       */
+      dual_quat( const quat<Type> &R, const vec3<Type> &T ) :
+        Real(R), Dual(quat<Type>::Hamilton(quat<Type>(T, 0), R) * Type(0.5))
+      {
+      } /* End of 'dual_quat' function */
+
+      /* Get identity dual quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (dual_quat) identity.
+       */
+      static dual_quat Identity()
+      {
+        return dual_quat();
+      } /* End of 'Identity' function */
+
+      /* Compose transformations function (apply this, then Q).
+       * ARGUMENTS:
+       *   - second transformation:
+       *       const dual_quat &Q;
+       * RETURNS:
+       *   (dual_quat) composed transformation.
+       */
+      dual_quat operator*( const dual_quat &Q ) const
+      {
+        return dual_quat(quat<Type>::Hamilton(Q.Real, Real),
+                         quat<Type>::Hamilton(Q.Real, Dual) + quat<Type>::Hamilton(Q.Dual, Real));
+      } /* End of 'operator*' function */
+
+      /* Inverse of unit dual quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (dual_quat) inverse transformation.
+       */
+      dual_quat Inverse() const
+      {
+        return dual_quat(Real.Conjugate(), Dual.Conjugate());
+      } /* End of 'Inverse' function */
+
+      /* Normalize dual quaternion function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (dual_quat &) self reference.
+       */
+      dual_quat & Normalize()
+      {
+        Type len = !Real;
+
+        if (len == 0)
+          return *this;
+        Real = Real * (1 / len);
+        Dual = Dual * (1 / len);
+        // Keep dual part orthogonal to real part
+        Dual = Dual - Real * (Real & Dual);
+        return *this;
+      } /* End of 'Normalize' function */
+
+      /* Get translation function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (vec3<Type>) translation.
+       */
+      vec3<Type> Translation() const
+      {
+        quat<Type> t = quat<Type>::Hamilton(Dual, Real.Conjugate());
+
+        return vec3<Type>(t.X * 2, t.Y * 2, t.Z * 2);
+      } /* End of 'Translation' function */
+
+      /* Transform point function.
+       * ARGUMENTS:
+       *   - point:
+       *       const vec3<Type> &P;
+       * RETURNS:
+       *   (vec3<Type>) transformed point.
+       */
+      vec3<Type> TransformPoint( const vec3<Type> &P ) const
+      {
+        return Real.Rotate(P) + Translation();
+      } /* End of 'TransformPoint' function */
+
+      /* Transform vector function.
+       * ARGUMENTS:
+       *   - vector:
+       *       const vec3<Type> &V;
+       * RETURNS:
+       *   (vec3<Type>) transformed vector.
+       */
+      vec3<Type> TransformVector( const vec3<Type> &V ) const
+      {
+        return Real.Rotate(V);
+      } /* End of 'TransformVector' function */
+
+      /* Convert to matrix function.
+       * ARGUMENTS: None.
+       * RETURNS:
+       *   (matr<Type>) rigid transformation matrix.
+       */
+      matr<Type> ToMatr() const
+      {
+        matr<Type> m = Real.ToMatr();
+        vec3<Type> t = Translation();
+
+        m.M[3][0] = t.X;
+        m.M[3][1] = t.Y;
+        m.M[3][2] = t.Z;
+        return m;
+      } /* End of 'ToMatr' function */
+
+      /* Convert rigid matrix to dual quaternion function.
+       * ARGUMENTS:
+       *   - rigid matrix:
+       *       const matr<Type> &M;
+       * RETURNS:
+       *   (dual_quat) dual quaternion.
+       */
+      static dual_quat FromMatr( const matr<Type> &M )
+      {
+        return dual_quat(quat<Type>::FromMatr(M), vec3<Type>(M.M[3][0], M.M[3][1], M.M[3][2]));
+      } /* End of 'FromMatr' function */
+
+      /* Dual quaternion linear blending (normalized) function.
+       * ARGUMENTS:
+       *   - dual quaternions:
+       *       const dual_quat &A, &B;
+       *   - interpolation parameter [0..1]:
+       *       const Type T;
+       * RETURNS:
+       *   (dual_quat) blended transformation.
+       */
+      static dual_quat Blend( const dual_quat &A, const dual_quat &B, const Type T )
+      {
+        Type t = (A.Real & B.Real) < 0 ? -T : T;
+
+        return dual_quat(A.Real * (1 - T) + B.Real * t, A.Dual * (1 - T) + B.Dual * t).Normalize();
+      } /* End of 'Blend' function */
+    }; /* End of 'dual_quat' class */
+
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    /* Normalize quaternions AVX2 kernel function.
+     * ARGUMENTS:
+     *   - quaternions:
+     *       quat<FLT> *Q;
+     *   - number of quaternions (multiple of 8 processed):
+     *       size_t Count;
+     * RETURNS:
+     *   (size_t) number of processed quaternions.
+     */
+    MTH_TARGET_AVX2 inline size_t QuatNormalizeAVX2( quat<FLT> *Q, size_t Count )
+    {
+      size_t i = 0;
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256 X, Y, Z, W;
+
+        Load8x4AVX2(&Q[i].X, X, Y, Z, W);
+        __m256
+          Len2 = _mm256_fmadd_ps(W, W, _mm256_fmadd_ps(Z, Z, _mm256_fmadd_ps(Y, Y, _mm256_mul_ps(X, X)))),
+          Zero = _mm256_cmp_ps(Len2, _mm256_setzero_ps(), _CMP_EQ_OQ),
+          InvLen = _mm256_blendv_ps(_mm256_div_ps(_mm256_set1_ps(1), _mm256_sqrt_ps(Len2)), _mm256_set1_ps(1), Zero);
+
+        Store8x4AVX2(&Q[i].X, _mm256_mul_ps(X, InvLen), _mm256_mul_ps(Y, InvLen), _mm256_mul_ps(Z, InvLen), _mm256_mul_ps(W, InvLen));
+      }
+      return i;
+    } /* End of 'QuatNormalizeAVX2' function */
+
+    /* Compose quaternions (Out[i] = A[i] * B[i]) AVX2 kernel function.
+     * ARGUMENTS:
+     *   - source quaternions:
+     *       const quat<FLT> *A, *B;
+     *   - result quaternions:
+     *       quat<FLT> *Out;
+     *   - number of quaternions (multiple of 8 processed):
+     *       size_t Count;
+     * RETURNS:
+     *   (size_t) number of processed quaternions.
+     */
+    MTH_TARGET_AVX2 inline size_t QuatComposeAVX2( const quat<FLT> *A, const quat<FLT> *B, quat<FLT> *Out, size_t Count )
+    {
+      size_t i = 0;
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256 AX, AY, AZ, AW, BX, BY, BZ, BW;
+
+        // A * B == Hamilton(B, A)
+        Load8x4AVX2(&B[i].X, AX, AY, AZ, AW);
+        Load8x4AVX2(&A[i].X, BX, BY, BZ, BW);
+        __m256
+          RX = _mm256_fmsub_ps(AY, BZ, _mm256_mul_ps(AZ, BY)),
+          RY = _mm256_fmsub_ps(AZ, BX, _mm256_mul_ps(AX, BZ)),
+          RZ = _mm256_fmsub_ps(AX, BY, _mm256_mul_ps(AY, BX)),
+          RW = _mm256_mul_ps(AW, BW);
+
+        RX = _mm256_fmadd_ps(AW, BX, _mm256_fmadd_ps(AX, BW, RX));
+        RY = _mm256_fmadd_ps(AW, BY, _mm256_fmadd_ps(AY, BW, RY));
+        RZ = _mm256_fmadd_ps(AW, BZ, _mm256_fmadd_ps(AZ, BW, RZ));
+        RW = _mm256_fnmadd_ps(AX, BX, _mm256_fnmadd_ps(AY, BY, _mm256_fnmadd_ps(AZ, BZ, RW)));
+        Store8x4AVX2(&Out[i].X, RX, RY, RZ, RW);
+      }
+      return i;
+    } /* End of 'QuatComposeAVX2' function */
+#endif // USE_MTH_MATR_SIMD
+  } /* end of 'simd' namespace */
+
+  /* Normalize quaternions array function.
+   * ARGUMENTS:
+   *   - quaternions:
+   *       std::span<quat<FLT>> Q;
+   * RETURNS: None.
+   */
+  inline VOID Normalize( std::span<quat<FLT>> Q )
+  {
+    size_t i = 0;
+
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::GetKernels().Level == simd::level::AVX2)
+      i = simd::QuatNormalizeAVX2(Q.data(), Q.size());
+#endif // USE_MTH_MATR_SIMD
+    for (; i < Q.size(); i++)
+      Q[i].Normalize();
+  } /* End of 'Normalize' function */
+
+  /* Compose quaternions arrays (Out[i] = A[i] * B[i]) function.
+   * ARGUMENTS:
+   *   - source quaternions (same size):
+   *       std::span<const quat<FLT>> A, B;
+   *   - result quaternions (may be same as source, size >= source size):
+   *       std::span<quat<FLT>> Out;
+   * RETURNS: None.
+   */
+  inline VOID Compose( std::span<const quat<FLT>> A, std::span<const quat<FLT>> B, std::span<quat<FLT>> Out )
+  {
+    size_t i = 0;
+
+    assert(B.size() == A.size() && Out.size() >= A.size());
+#if defined(USE_MTH_MATR_SIMD)
+    if (simd::GetKernels().Level == simd::level::AVX2)
+      i = simd::QuatComposeAVX2(A.data(), B.data(), Out.data(), A.size());
+#endif // USE_MTH_MATR_SIMD
+    for (; i < A.size(); i++)
+      Out[i] = A[i] * B[i];
+  } /* End of 'Compose' function */
+
+  /* Spherical interpolation of quaternions arrays function.
+   * ARGUMENTS:
+   *   - source unit quaternions (same size):
+   *       std::span<const quat<FLT>> A, B;
+   *   - interpolation parameter [0..1]:
+   *       FLT T;
+   *   - result quaternions (may be same as source, size >= source size):
+   *       std::span<quat<FLT>> Out;
+   * RETURNS: None.
+   */
+  inline VOID Slerp( std::span<const quat<FLT>> A, std::span<const quat<FLT>> B, FLT T, std::span<quat<FLT>> Out )
+  {
+    assert(B.size() == A.size() && Out.size() >= A.size());
+    for (size_t i = 0; i < A.size(); i++)
+      Out[i] = quat<FLT>::Slerp(A[i], B[i], T);
+  } /* End of 'Slerp' function */
+
+  /* Compose dual quaternions arrays (Out[i] = A[i] * B[i]) function.
+   * ARGUMENTS:
+   *   - source dual quaternions (same size):
+   *       std::span<const dual_quat<FLT>> A, B;
+   *   - result dual quaternions (may be same as source, size >= source size):
+   *       std::span<dual_quat<FLT>> Out;
+   * RETURNS: None.
+   */
+  inline VOID Compose( std::span<const dual_quat<FLT>> A, std::span<const dual_quat<FLT>> B, std::span<dual_quat<FLT>> Out )
+  {
+    assert(B.size() == A.size() && Out.size() >= A.size());
+    for (size_t i = 0; i < A.size(); i++)
+      Out[i] = A[i] * B[i];
+  } /* End of 'Compose' function */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_quat_h_
+
+/* END OF 'mth_quat.h' FILE */
@@ -0,0 +1,302 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_rng.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Pseudo random numbers generator (xoshiro256++) header file.
+ * NOTE:        Every thread owns its generator ('rng::Get'), so random
+ *              vectors are generated without locks. AVX2 span filling
+ *              runs 4 independent (jumped) streams at once.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_rng_h_
+#define __mth_rng_h_
+
+#include <atomic>
+#include <span>
+#include <type_traits>
+
+#include "mth_def.h"
+#include "mth_matr_simd.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* SIMD kernels namespace */
+  namespace simd
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    /* 64-bit lanes rotate left function.
+     * ARGUMENTS:
+     *   - source lanes:
+     *       __m256i V;
+     *   - rotation count:
+     *       INT N;
+     * RETURNS:
+     *   (__m256i) rotated lanes.
+     */
+    MTH_TARGET_AVX2 inline __m256i RotL64AVX2( __m256i V, const INT N )
+    {
+      return _mm256_or_si256(_mm256_slli_epi64(V, N), _mm256_srli_epi64(V, 64 - N));
+    } /* End of 'RotL64AVX2' function */
+
+    /* Fill floats array by 4 xoshiro256++ streams AVX2 kernel function.
+     * ARGUMENTS:
+     *   - streams state (state word, lane):
+     *       UINT64 L[4][4];
+     *   - destination array:
+     *       FLT *Dst;
+     *   - number of elements:
+     *       size_t Count;
+     *   - values range:
+     *       FLT Min, Max;
+     * RETURNS:
+     *   (size_t) number of filled elements (multiple of 8).
+     */
+    MTH_TARGET_AVX2 inline size_t RngFillAVX2( UINT64 L[4][4], FLT *Dst, size_t Count, FLT Min, FLT Max )
+    {
+      __m256i
+        S0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(L[0])),
+        S1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(L[1])),
+        S2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(L[2])),
+        S3 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(L[3]));
+      __m256
+        Scale = _mm256_set1_ps((Max - Min) / 16777216.0f),
+        Bias = _mm256_set1_ps(Min);
+      size_t i = 0;
+
+      for (; i + 8 <= Count; i += 8)
+      {
+        __m256i
+          R = _mm256_add_epi64(RotL64AVX2(_mm256_add_epi64(S0, S3), 23), S0),
+          T = _mm256_slli_epi64(S1, 17);
+
+        S2 = _mm256_xor_si256(S2, S0);
+        S3 = _mm256_xor_si256(S3, S1);
+        S1 = _mm256_xor_si256(S1, S2);
+        S0 = _mm256_xor_si256(S0, S3);
+        S2 = _mm256_xor_si256(S2, T);
+        S3 = RotL64AVX2(S3, 45);
+
+        // Upper 24 bits of every 32-bit half give two floats per lane
+        __m256 F = _mm256_cvtepi32_ps(_mm256_srli_epi32(R, 8));
+
+        _mm256_storeu_ps(Dst + i, _mm256_fmadd_ps(F, Scale, Bias));
+      }
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(L[0]), S0);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(L[1]), S1);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(L[2]), S2);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(L[3]), S3);
+      return i;
+    } /* End of 'RngFillAVX2' function */
+#endif // USE_MTH_MATR_SIMD
+  } /* end of 'simd' namespace */
+
+  /* Pseudo random numbers generator (xoshiro256++) type */
+  class rng
+  {
+  private:
+    UINT64
+      S[4],     // Scalar stream state
+      L[4][4];  // SIMD streams state (state word, lane)
+
+    /* Rotate left function.
+     * ARGUMENTS:
+     *   - source value:
+     *       UINT64 V;
+     *   - rotation count:
+     *       INT N;
+     * RETURNS:
+     *   (UINT64) rotated value.
+     */
+    static constexpr UINT64 RotL( const UINT64 V, const INT N ) noexcept
+    {
+      return (V << N) | (V >> (64 - N));
+    } /* End of 'RotL' function */
+
+    /* Next value of splitmix64 sequence (seed expansion) function.
+     * ARGUMENTS:
+     *   - sequence state:
+     *       UINT64 &X;
+     * RETURNS:
+     *   (UINT64) next value.
+     */
+    static constexpr UINT64 SplitMix( UINT64 &X ) noexcept
+    {
+      UINT64 Z = (X += 0x9E3779B97F4A7C15ULL);
+
+      Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+      Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBULL;
+      return Z ^ (Z >> 31);
+    } /* End of 'SplitMix' function */
+
+  public:
+    /* Constructor by seed.
+     * ARGUMENTS:
+     *   - generator seed:
+     *       UINT64 Seed;
+     */
+    explicit rng( const UINT64 Seed = 0x853C49E6748FEA9BULL ) noexcept
+    {
+      SetSeed(Seed);
+    } /* End of 'rng' function */
+
+    /* Reset generator by seed function.
+     * ARGUMENTS:
+     *   - generator seed:
+     *       UINT64 Seed;
+     * RETURNS: None.
+     */
+    VOID SetSeed( UINT64 Seed ) noexcept
+    {
+      for (INT i = 0; i < 4; i++)
+        S[i] = SplitMix(Seed);
+
+      // SIMD lanes continue after non-overlapping 2^128 jumps
+      for (INT k = 0; k < 4; k++)
+      {
+        Jump();
+        for (INT i = 0; i < 4; i++)
+          L[i][k] = S[i];
+      }
+      Jump();
+    } /* End of 'SetSeed' function */
+
+    /* Get next 64-bit value function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) random value.
+     */
+    UINT64 Next( VOID ) noexcept
+    {
+      UINT64
+        R = RotL(S[0] + S[3], 23) + S[0],
+        T = S[1] << 17;
+
+      S[2] ^= S[0];
+      S[3] ^= S[1];
+      S[1] ^= S[2];
+      S[0] ^= S[3];
+      S[2] ^= T;
+      S[3] = RotL(S[3], 45);
+      return R;
+    } /* End of 'Next' function */
+
+    /* Advance scalar stream by 2^128 values function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Jump( VOID ) noexcept
+    {
+      constexpr UINT64 J[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+      UINT64 T[4] = {0, 0, 0, 0};
+
+      for (INT i = 0; i < 4; i++)
+        for (INT b = 0; b < 64; b++)
+        {
+          if (J[i] & (1ULL << b))
+            for (INT k = 0; k < 4; k++)
+              T[k] ^= S[k];
+          Next();
+        }
+      for (INT k = 0; k < 4; k++)
+        S[k] = T[k];
+    } /* End of 'Jump' function */
+
+    /* Random number in [0, 1) range function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (Type) random number (24 bits for float, 53 bits for double).
+     */
+    template<typename Type = FLT>
+      Type Rnd0( VOID ) noexcept
+      {
+        if constexpr (sizeof(Type) > sizeof(FLT))
+          return Type(Next() >> 11) * Type(1.0 / 9007199254740992.0);
+        else
+          return Type(Next() >> 40) * Type(1.0 / 16777216.0);
+      } /* End of 'Rnd0' function */
+
+    /* Random number in [-1, 1) range function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (Type) random number.
+     */
+    template<typename Type = FLT>
+      Type Rnd1( VOID ) noexcept
+      {
+        return 2 * Rnd0<Type>() - 1;
+      } /* End of 'Rnd1' function */
+
+    /* Fill array by random numbers function.
+     * ARGUMENTS:
+     *   - destination array:
+     *       std::span<FLT> Dst;
+     *   - values range:
+     *       FLT Min, Max;
+     * RETURNS: None.
+     */
+    VOID Fill( std::span<FLT> Dst, const FLT Min = 0, const FLT Max = 1 ) noexcept
+    {
+      size_t i = 0;
+
+#if defined(USE_MTH_MATR_SIMD)
+      if (simd::GetKernels().Level == simd::level::AVX2)
+        i = simd::RngFillAVX2(L, Dst.data(), Dst.size(), Min, Max);
+#endif // USE_MTH_MATR_SIMD
+      for (; i < Dst.size(); i++)
+        Dst[i] = Min + (Max - Min) * Rnd0();
+    } /* End of 'Fill' function */
+
+    /* Get current thread generator function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (rng &) thread generator reference.
+     */
+    static rng & Get( VOID ) noexcept
+    {
+      static std::atomic<UINT64> ThreadCounter {0};
+      thread_local rng Generator(0x853C49E6748FEA9BULL + 0x9E3779B97F4A7C15ULL * ThreadCounter++);
+
+      return Generator;
+    } /* End of 'Get' function */
+  }; /* End of 'rng' class */
+
+  /* Fill vectors array by random (components 0 - 1) vectors function.
+   * ARGUMENTS:
+   *   - destination array (of vec2/vec3/vec4 with FLT components):
+   *       std::span<Vec> Dst;
+   * RETURNS: None.
+   */
+  template<typename Vec>
+    inline VOID FillRnd0( std::span<Vec> Dst ) noexcept
+    {
+      static_assert(std::is_trivially_copyable_v<Vec> && sizeof(Vec) % sizeof(FLT) == 0);
+      static_assert(std::is_same_v<std::remove_cvref_t<decltype(std::declval<Vec &>()[0])>, FLT>, "vector components must be FLT");
+      rng::Get().Fill(std::span<FLT>(reinterpret_cast<FLT *>(Dst.data()), Dst.size_bytes() / sizeof(FLT)), 0, 1);
+    } /* End of 'FillRnd0' function */
+
+  /* Fill vectors array by random (components -1 - 1) vectors function.
+   * ARGUMENTS:
+   *   - destination array (of vec2/vec3/vec4 with FLT components):
+   *       std::span<Vec> Dst;
+   * RETURNS: None.
+   */
+  template<typename Vec>
+    inline VOID FillRnd1( std::span<Vec> Dst ) noexcept
+    {
+      static_assert(std::is_trivially_copyable_v<Vec> && sizeof(Vec) % sizeof(FLT) == 0);
+      static_assert(std::is_same_v<std::remove_cvref_t<decltype(std::declval<Vec &>()[0])>, FLT>, "vector components must be FLT");
+      rng::Get().Fill(std::span<FLT>(reinterpret_cast<FLT *>(Dst.data()), Dst.size_bytes() / sizeof(FLT)), -1, 1);
+    } /* End of 'FillRnd1' function */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_rng_h_
+
+/* END OF 'mth_rng.h' FILE */
@@ -17,6 +17,7 @@
 #define __mth_vec2_h_
 
 #include "mth_def.h"
+#include "mth_rng.h"
 
 #include <mmintrin.h>
 
@@ -32,7 +33,7 @@ namespace mth
         X, Y; // Vector components
 
       /* Default constructor */
-      vec2() : X(0), Y(0)
+      constexpr vec2() noexcept : X(0), Y(0)
       {
       } /* End of 'vec2' function */
 
@@ -41,7 +42,7 @@ namespace mth
        *   - component:
        *       Type N;
        */
-      explicit vec2( const Type N ) : X(N), Y(N)
+      explicit constexpr vec2( const Type N ) noexcept : X(N), Y(N)
       {
       } /* End of 'vec2' function */
 
@@ -50,7 +51,7 @@ namespace mth
        *   - components:
        *       Type A, B;
        */
-      vec2( const Type A, const Type B ) : X(A), Y(B)
+      constexpr vec2( const Type A, const Type B ) noexcept : X(A), Y(B)
       {
       } /* End of 'vec2' function */
 
@@ -59,10 +60,14 @@ namespace mth
        * RETURNS:
        *   (vec2) vector random.
        */
-      static vec2 Rnd0()
+      static vec2 Rnd0() noexcept
       {
-        return vec3(Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd0<Type>(),
+          Y = G.Rnd0<Type>();
+
+        return vec2(X, Y);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -70,11 +75,15 @@ namespace mth
        * RETURNS:
        *   (vec2) vector random.
        */
-      static vec2 Rnd1()
+      static vec2 Rnd1() noexcept
       {
-        return vec2(2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd1<Type>(),
+          Y = G.Rnd1<Type>();
+
+        return vec2(X, Y);
+      } /* End of 'Rnd1' function */
 
 
       /* Vec add vec function.
@@ -84,7 +93,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new vector.
        */
-      vec2 operator+( const vec2 &V ) const
+      constexpr vec2 operator+( const vec2 &V ) const noexcept
       {
         return vec2(X + V.X, Y + V.Y);
       } /* End of 'operator+' function */
@@ -96,7 +105,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new vector.
        */
-      vec2 operator-( const vec2 &V ) const
+      constexpr vec2 operator-( const vec2 &V ) const noexcept
       {
         return vec2(X - V.X, Y - V.Y);
       } /* End of 'operator-' function */
@@ -108,7 +117,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new vector.
        */
-      vec2 operator*( const Type N ) const
+      constexpr vec2 operator*( const Type N ) const noexcept
       {
         return vec2(X * N, Y * N);
       } /* End of 'operator+' function */
@@ -120,7 +129,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new vector.
        */
-      vec2 operator/( const Type N ) const
+      constexpr vec2 operator/( const Type N ) const noexcept
       {
         return vec2(X / N, Y / N);
       } /* End of 'operator/' function */
@@ -130,7 +139,7 @@ namespace mth
        * RETURNS:
        *   (Type) length^2.
        */
-      Type Len2() const
+      constexpr Type Len2() const noexcept
       {
         return X * X + Y * Y;
       } /* End of 'Len2' function */
@@ -140,7 +149,7 @@ namespace mth
        * RETURNS:
        *   (Type) length.
        */
-      Type operator!() const
+      Type operator!() const noexcept
       {
         return std::sqrt(X * X + Y * Y);
       } /* End of 'operator!' function */
@@ -152,7 +161,7 @@ namespace mth
        * RETURNS:
        *   (Type) vec dot vec.
        */
-      Type operator&( const vec2 &V ) const
+      constexpr Type operator&( const vec2 &V ) const noexcept
       {
         return X * V.X + Y * V.Y;
       } /* End of 'operator&' function */
@@ -164,7 +173,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new vector.
        */
-      vec2 operator*( const vec2 &V ) const
+      constexpr vec2 operator*( const vec2 &V ) const noexcept
       {
         return vec2(X * V.X, Y * V.Y);
       } /* End of 'operator*' function */
@@ -174,7 +183,7 @@ namespace mth
        * RETURNS:
        *   (vec2) vector.
        */
-      vec2 operator+() const
+      constexpr vec2 operator+() const noexcept
       {
         return *this;
       } /* End of 'operator+' function */
@@ -184,7 +193,7 @@ namespace mth
        * RETURNS:
        *   (vec2) -vector.
        */
-      vec2 operator-() const
+      constexpr vec2 operator-() const noexcept
       {
         return vec2(-X, -Y);
       } /* End of 'operator-' function */
@@ -196,7 +205,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & operator+=( const vec2 &V )
+      constexpr vec2 & operator+=( const vec2 &V ) noexcept
       {
         X += V.X;
         Y += V.Y;
@@ -211,7 +220,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & operator-=( const vec2 &V )
+      constexpr vec2 & operator-=( const vec2 &V ) noexcept
       {
         X -= V.X;
         Y -= V.Y;
@@ -226,7 +235,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & operator*=( const vec2 &V )
+      constexpr vec2 & operator*=( const vec2 &V ) noexcept
       {
         X *= V.X;
         Y *= V.Y;
@@ -241,7 +250,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & operator*=( const Type N )
+      constexpr vec2 & operator*=( const Type N ) noexcept
       {
         X *= N;
         Y *= N;
@@ -256,7 +265,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & operator/=( const Type N )
+      constexpr vec2 & operator/=( const Type N ) noexcept
       {
         X /= N;
         Y /= N;
@@ -269,7 +278,7 @@ namespace mth
        * RETURNS:
        *   (vec2 &) this vector.
        */
-      vec2 & Normalize()
+      vec2 & Normalize() noexcept
       {
         Type len2 = this->Len2();
 
@@ -286,7 +295,7 @@ namespace mth
        * RETURNS:
        *   (vec2) new normalize vector.
        */
-      vec2 Normalizing() const
+      vec2 Normalizing() const noexcept
       {
         Type len2 = this->Len2();
 
@@ -303,7 +312,7 @@ namespace mth
        * RETURNS:
        *   (Type *) pointer to first element
        */
-      operator Type *() const
+      constexpr operator Type *() const noexcept
       {
         return &this->X;
       } /* End of 'operator Type *' function*/
@@ -315,7 +324,7 @@ namespace mth
        * RETURNS:
        *   (Type &) V[i] component.
        */
-      Type operator[]( INT i )
+      constexpr Type operator[]( INT i ) noexcept
       {
         switch (i)
         {
@@ -336,7 +345,7 @@ namespace mth
        * RETURNS:
        *   (Type &) V[i] component.
        */
-      Type operator[]( INT i ) const
+      constexpr Type operator[]( INT i ) const noexcept
       {
         switch (i)
         {
@@ -412,10 +421,14 @@ namespace mth
        * RETURNS:
        *   (vec2) vector random.
        */
-      static vec2 Rnd0()
+      static vec2 Rnd0() noexcept
       {
-        return vec2(FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd0<FLT>(),
+          Y = G.Rnd0<FLT>();
+
+        return vec2(X, Y);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -423,11 +436,15 @@ namespace mth
        * RETURNS:
        *   (vec3) vector random.
        */
-      static vec2 Rnd1()
+      static vec2 Rnd1() noexcept
       {
-        return vec2(2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd1<FLT>(),
+          Y = G.Rnd1<FLT>();
+
+        return vec2(X, Y);
+      } /* End of 'Rnd1' function */
 
       /* Vec add vec function.
        * ARGUMENTS:
@@ -17,6 +17,7 @@
 #define __mth_vec3_h_
 
 #include "mth_def.h"
+#include "mth_rng.h"
 
 /* Space math namespace */
 namespace mth
@@ -30,7 +31,7 @@ namespace mth
         X, Y, Z; // Vector components
 
       /* Default constructor */
-      vec3() : X(0), Y(0), Z(0)
+      constexpr vec3() noexcept : X(0), Y(0), Z(0)
       {
       } /* End of 'vec3' function */
 
@@ -39,7 +40,7 @@ namespace mth
        *   - component:
        *       const Type N;
        */
-      explicit vec3( const Type N ) : X(N), Y(N), Z(N)
+      explicit constexpr vec3( const Type N ) noexcept : X(N), Y(N), Z(N)
       {
       } /* End of 'vec3' function */
 
@@ -48,7 +49,7 @@ namespace mth
        *   - components:
        *       const Type A, B, C;
        */
-      vec3( const Type A, const Type B, const Type C ) : X(A), Y(B), Z(C)
+      constexpr vec3( const Type A, const Type B, const Type C ) noexcept : X(A), Y(B), Z(C)
       {
       } /* End of 'vec3' function */
 
@@ -57,11 +58,15 @@ namespace mth
        * RETURNS:
        *   (vec3) vector random.
        */
-      static vec3 Rnd0()
+      static vec3 Rnd0() noexcept
       {
-        return vec3(Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd0<Type>(),
+          Y = G.Rnd0<Type>(),
+          Z = G.Rnd0<Type>();
+
+        return vec3(X, Y, Z);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -69,12 +74,16 @@ namespace mth
        * RETURNS:
        *   (vec3) vector random.
        */
-      static vec3 Rnd1()
+      static vec3 Rnd1() noexcept
       {
-        return vec3(2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd1<Type>(),
+          Y = G.Rnd1<Type>(),
+          Z = G.Rnd1<Type>();
+
+        return vec3(X, Y, Z);
+      } /* End of 'Rnd1' function */
 
       /* Vec add vec function.
        * ARGUMENTS:
@@ -83,7 +92,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator+( const vec3 &V ) const
+      constexpr vec3 operator+( const vec3 &V ) const noexcept
       {
         return vec3(X + V.X, Y + V.Y, Z + V.Z);
       } /* End of 'operator+' function */
@@ -95,7 +104,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator-( const vec3 &V ) const
+      constexpr vec3 operator-( const vec3 &V ) const noexcept
       {
         return vec3(X - V.X, Y - V.Y, Z - V.Z);
       } /* End of 'operator-' function */
@@ -107,7 +116,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator*( const Type N ) const
+      constexpr vec3 operator*( const Type N ) const noexcept
       {
         return vec3(X * N, Y * N, Z * N);
       } /* End of 'operator+' function */
@@ -119,7 +128,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator/( const Type N ) const
+      constexpr vec3 operator/( const Type N ) const noexcept
       {
         return vec3(X / N, Y / N, Z / N);
       } /* End of 'operator/' function */
@@ -129,7 +138,7 @@ namespace mth
        * RETURNS:
        *   (Type) length^2.
        */
-      Type Len2() const
+      constexpr Type Len2() const noexcept
       {
         return X * X + Y * Y + Z * Z;
       } /* End of 'Len2' function */
@@ -139,7 +148,7 @@ namespace mth
        * RETURNS:
        *   (Type) length.
        */
-      Type operator!() const
+      Type operator!() const noexcept
       {
         return std::sqrt(X * X + Y * Y + Z * Z);
       } /* End of 'operator!' function */
@@ -151,7 +160,7 @@ namespace mth
        * RETURNS:
        *   (Type) vec dot vec.
        */
-      Type operator&( const vec3 &V ) const
+      constexpr Type operator&( const vec3 &V ) const noexcept
       {
         return X * V.X + Y * V.Y + Z * V.Z;
       } /* End of 'operator&' function */
@@ -163,7 +172,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator%( const vec3 &V ) const
+      constexpr vec3 operator%( const vec3 &V ) const noexcept
       {
         return vec3(Y * V.Z - Z * V.Y,
                     Z * V.X - X * V.Z,
@@ -177,7 +186,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 operator*( const vec3 &V ) const
+      constexpr vec3 operator*( const vec3 &V ) const noexcept
       {
         return vec3(X * V.X, Y * V.Y, Z * V.Z);
       } /* End of 'operator*' function */
@@ -187,7 +196,7 @@ namespace mth
        * RETURNS:
        *   (vec3) vector.
        */
-      vec3 operator+() const
+      constexpr vec3 operator+() const noexcept
       {
         return *this;
       } /* End of 'operator+' function */
@@ -197,7 +206,7 @@ namespace mth
        * RETURNS:
        *   (vec3) -vector.
        */
-      vec3 operator-() const
+      constexpr vec3 operator-() const noexcept
       {
         return vec3(-X, -Y, -Z);
       } /* End of 'operator-' function */
@@ -209,7 +218,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & operator+=( const vec3 &V )
+      constexpr vec3 & operator+=( const vec3 &V ) noexcept
       {
         X += V.X;
         Y += V.Y;
@@ -225,7 +234,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & operator-=( const vec3 &V )
+      constexpr vec3 & operator-=( const vec3 &V ) noexcept
       {
         X -= V.X;
         Y -= V.Y;
@@ -241,7 +250,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & operator*=( const vec3 &V )
+      constexpr vec3 & operator*=( const vec3 &V ) noexcept
       {
         X *= V.X;
         Y *= V.Y;
@@ -257,7 +266,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & operator*=( const Type N )
+      constexpr vec3 & operator*=( const Type N ) noexcept
       {
         X *= N;
         Y *= N;
@@ -273,7 +282,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & operator/=( const Type N )
+      constexpr vec3 & operator/=( const Type N ) noexcept
       {
         X /= N;
         Y /= N;
@@ -287,7 +296,7 @@ namespace mth
        * RETURNS:
        *   (vec3 &) this vector.
        */
-      vec3 & Normalize()
+      vec3 & Normalize() noexcept
       {
         Type len2 = this->Len2();
 
@@ -304,7 +313,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new normalize vector.
        */
-      vec3 Normalizing() const
+      vec3 Normalizing() const noexcept
       {
         Type len2 = this->Len2();
 
@@ -321,7 +330,7 @@ namespace mth
        * RETURNS:
        *   (Type *) pointer to first element
        */
-      operator Type *()
+      constexpr operator Type *() noexcept
       {
         return &this->X;
       } /* End of 'operator Type *' function*/
@@ -333,7 +342,7 @@ namespace mth
        * RETURNS:
        *   (Type &) V[i] component.
        */
-      Type & operator[]( INT i )
+      constexpr Type & operator[]( INT i ) noexcept
       {
         switch (i)
         {
@@ -356,7 +365,7 @@ namespace mth
        * RETURNS:
        *   (Type &) V[i] component.
        */
-      Type operator[]( INT i ) const
+      constexpr Type operator[]( INT i ) const noexcept
       {
         switch (i)
         {
@@ -379,7 +388,7 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 Reflect( const vec3 &n ) const
+      constexpr vec3 Reflect( const vec3 &n ) const noexcept
       {
         return *this - (n * (*this & n) * 2);
       } /* End of 'Reflect' function */
@@ -389,7 +398,7 @@ namespace mth
        * RETURNS:
        *   (Type) max component.
        */
-      Type MaxComponent( VOID ) const
+      constexpr Type MaxComponent( VOID ) const noexcept
       {
         Type MaxC = X;
         if (MaxC < Y)
@@ -407,9 +416,9 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 Min( const vec3 &V )
+      constexpr vec3 Min( const vec3 &V ) const noexcept
       {
-        return vec3(min(X, V.X), min(Y, V.Y), min(Z, V.Z));
+        return vec3(X < V.X ? X : V.X, Y < V.Y ? Y : V.Y, Z < V.Z ? Z : V.Z);
       } /* End of 'Min' function */ 
 
       /* Get vector from maximal components function.
@@ -419,9 +428,9 @@ namespace mth
        * RETURNS:
        *   (vec3) new vector.
        */
-      vec3 Max( const vec3 &V )
+      constexpr vec3 Max( const vec3 &V ) const noexcept
       {
-        return vec3(max(X, V.X), max(Y, V.Y), max(Z, V.Z));
+        return vec3(X > V.X ? X : V.X, Y > V.Y ? Y : V.Y, Z > V.Z ? Z : V.Z);
       } /* End of 'Max' function */ 
 
     }; /* End of 'vec3' class */
@@ -509,11 +518,15 @@ namespace mth
        * RETURNS:
        *   (vec3) vector random.
        */
-      static vec3 Rnd0()
+      static vec3 Rnd0() noexcept
       {
-        return vec3(FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd0<FLT>(),
+          Y = G.Rnd0<FLT>(),
+          Z = G.Rnd0<FLT>();
+
+        return vec3(X, Y, Z);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -521,12 +534,16 @@ namespace mth
        * RETURNS:
        *   (vec3) vector random.
        */
-      static vec3 Rnd1()
+      static vec3 Rnd1() noexcept
       {
-        return vec3(2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd1<FLT>(),
+          Y = G.Rnd1<FLT>(),
+          Z = G.Rnd1<FLT>();
+
+        return vec3(X, Y, Z);
+      } /* End of 'Rnd1' function */
 
       /* Vec add vec function.
        * ARGUMENTS:
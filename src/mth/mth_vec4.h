@@ -17,6 +17,7 @@
 #define __mth_vec4_h_
 
 #include "mth_def.h"
+#include "mth_rng.h"
 
 /* Space math namespace */
 namespace mth
@@ -30,7 +31,7 @@ namespace mth
         X, Y, Z, W; // Vector components
 
       /* Default constructor */
-      vec4() : X(0), Y(0), Z(0), W(0)
+      constexpr vec4() noexcept : X(0), Y(0), Z(0), W(0)
       {
       } /* End of 'vec4' function */
 
@@ -39,7 +40,7 @@ namespace mth
        *   - component:
        *       const Type N;
        */
-      explicit vec4( const Type N ) : X(N), Y(N), Z(N), W(N)
+      explicit constexpr vec4( const Type N ) noexcept : X(N), Y(N), Z(N), W(N)
       {
       } /* End of 'vec4' function */
 
@@ -50,7 +51,7 @@ namespace mth
        *   - 4-th component:
        *       const Type NewW;
        */
-      vec4( const vec3<Type> &V, const Type NewW = 0 ) : X(V.X), Y(V.Y), Z(V.Z), W(NewW)
+      constexpr vec4( const vec3<Type> &V, const Type NewW = 0 ) noexcept : X(V.X), Y(V.Y), Z(V.Z), W(NewW)
       {
       } /* End of 'vec4' function */
 
@@ -59,7 +60,7 @@ namespace mth
        *   - components:
        *       const Type A, B, C, D;
        */
-      vec4( const Type A, const Type B, const Type C, const Type D ) : X(A), Y(B), Z(C), W(D)
+      constexpr vec4( const Type A, const Type B, const Type C, const Type D ) noexcept : X(A), Y(B), Z(C), W(D)
       {
       } /* End of 'vec4' function */
 
@@ -68,12 +69,16 @@ namespace mth
        * RETURNS:
        *   (vec4) vector random.
        */
-      static vec4 Rnd0()
+      static vec4 Rnd0() noexcept
       {
-        return vec4(Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX,
-                    Type(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd0<Type>(),
+          Y = G.Rnd0<Type>(),
+          Z = G.Rnd0<Type>(),
+          W = G.Rnd0<Type>();
+
+        return vec4(X, Y, Z, W);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -81,13 +86,17 @@ namespace mth
        * RETURNS:
        *   (vec4) vector random.
        */
-      static vec4 Rnd1()
+      static vec4 Rnd1() noexcept
       {
-        return vec4(2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1,
-                    2 * Type(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        Type
+          X = G.Rnd1<Type>(),
+          Y = G.Rnd1<Type>(),
+          Z = G.Rnd1<Type>(),
+          W = G.Rnd1<Type>();
+
+        return vec4(X, Y, Z, W);
+      } /* End of 'Rnd1' function */
 
       /* Vec add vec function.
        * ARGUMENTS:
@@ -96,7 +105,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new vector.
        */
-      vec4 operator+( const vec4 &V ) const
+      constexpr vec4 operator+( const vec4 &V ) const noexcept
       {
         return vec4(X + V.X, Y + V.Y, Z + V.Z, W + V.W);
       } /* End of 'operator+' function */
@@ -108,7 +117,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new vector.
        */
-      vec4 operator-( const vec4 &V ) const
+      constexpr vec4 operator-( const vec4 &V ) const noexcept
       {
         return vec4(X - V.X, Y - V.Y, Z - V.Z, W - V.W);
       } /* End of 'operator-' function */
@@ -120,7 +129,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new vector.
        */
-      vec4 operator*( const Type N ) const
+      constexpr vec4 operator*( const Type N ) const noexcept
       {
         return vec4(X * N, Y * N, Z * N, W * N);
       } /* End of 'operator+' function */
@@ -132,7 +141,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new vector.
        */
-      vec4 operator/( const Type N ) const
+      constexpr vec4 operator/( const Type N ) const noexcept
       {
         return vec4(X / N, Y / N, Z / N, W / N);
       } /* End of 'operator/' function */
@@ -142,7 +151,7 @@ namespace mth
        * RETURNS:
        *   (Type) length^2.
        */
-      Type Len2() const
+      constexpr Type Len2() const noexcept
       {
         return X * X + Y * Y + Z * Z + W * W;
       } /* End of 'Len2' function */
@@ -152,7 +161,7 @@ namespace mth
        * RETURNS:
        *   (Type) length.
        */
-      Type operator!() const
+      Type operator!() const noexcept
       {
         return std::sqrt(X * X + Y * Y + Z * Z + W * W);
       } /* End of 'operator!' function */
@@ -164,7 +173,7 @@ namespace mth
        * RETURNS:
        *   (Type) vec dot vec.
        */
-      Type operator&( const vec4 &V ) const
+      constexpr Type operator&( const vec4 &V ) const noexcept
       {
         return X * V.X + Y * V.Y + Z * V.Z + W * V.W;
       } /* End of 'operator&' function */
@@ -176,7 +185,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new vector.
        */
-      vec4 operator*( const vec4 &V ) const
+      constexpr vec4 operator*( const vec4 &V ) const noexcept
       {
         return vec4(X * V.X, Y * V.Y, Z * V.Z, W * V.W);
       } /* End of 'operator*' function */
@@ -186,7 +195,7 @@ namespace mth
        * RETURNS:
        *   (vec4) vector.
        */
-      vec4 operator+() const
+      constexpr vec4 operator+() const noexcept
       {
         return *this;
       } /* End of 'operator+' function */
@@ -196,7 +205,7 @@ namespace mth
        * RETURNS:
        *   (vec4) -vector.
        */
-      vec4 operator-() const
+      constexpr vec4 operator-() const noexcept
       {
         return vec4(-X, -Y, -Z, -W);
       } /* End of 'operator-' function */
@@ -208,7 +217,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & operator+=( const vec4 &V )
+      constexpr vec4 & operator+=( const vec4 &V ) noexcept
       {
         X += V.X;
         Y += V.Y;
@@ -225,7 +234,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & operator-=( const vec4 &V )
+      constexpr vec4 & operator-=( const vec4 &V ) noexcept
       {
         X -= V.X;
         Y -= V.Y;
@@ -242,7 +251,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & operator*=( const vec4 &V )
+      constexpr vec4 & operator*=( const vec4 &V ) noexcept
       {
         X *= V.X;
         Y *= V.Y;
@@ -260,7 +269,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & operator*=( const Type N )
+      constexpr vec4 & operator*=( const Type N ) noexcept
       {
         X *= N;
         Y *= N;
@@ -277,7 +286,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & operator/=( const Type N )
+      constexpr vec4 & operator/=( const Type N ) noexcept
       {
         X /= N;
         Y /= N;
@@ -292,7 +301,7 @@ namespace mth
        * RETURNS:
        *   (vec4 &) this vector.
        */
-      vec4 & Normalize()
+      vec4 & Normalize() noexcept
       {
         Type len2 = this->Len2();
 
@@ -309,7 +318,7 @@ namespace mth
        * RETURNS:
        *   (vec4) new normalize vector.
        */
-      vec4 Normalizing() const
+      vec4 Normalizing() const noexcept
       {
         Type len2 = this->Len2();
 
@@ -326,7 +335,7 @@ namespace mth
        * RETURNS:
        *   (Type *) pointer to first element
        */
-      operator Type *()
+      constexpr operator Type *() noexcept
       {
         return &this->X;
       } /* End of 'operator Type *' function*/
@@ -338,7 +347,7 @@ namespace mth
        * RETURNS:
        *   (Type &) V[i] component.
        */
-      Type & operator[]( INT i )
+      constexpr Type & operator[]( INT i ) noexcept
       {
         switch (i)
         {
@@ -363,7 +372,7 @@ namespace mth
        * RETURNS:
        *   (Type) V[i] component.
        */
-      Type operator[]( INT i ) const
+      constexpr Type operator[]( INT i ) const noexcept
       {
         switch (i)
         {
@@ -470,12 +479,16 @@ namespace mth
        * RETURNS:
        *   (vec4) vector random.
        */
-      static vec4 Rnd0()
+      static vec4 Rnd0() noexcept
       {
-        return vec4(FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX,
-                    FLT(rand()) / RAND_MAX);
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd0<FLT>(),
+          Y = G.Rnd0<FLT>(),
+          Z = G.Rnd0<FLT>(),
+          W = G.Rnd0<FLT>();
+
+        return vec4(X, Y, Z, W);
       } /* End of 'Rnd0' function */
 
       /* Random (components -1 - 1) vector function.
@@ -483,13 +496,17 @@ namespace mth
        * RETURNS:
        *   (vec4) vector random.
        */
-      static vec4 Rnd1()
+      static vec4 Rnd1() noexcept
       {
-        return vec4(2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1,
-                    2 * FLT(rand()) / RAND_MAX - 1);
-      } /* End of 'Rnd0' function */
+        rng &G = rng::Get();
+        FLT
+          X = G.Rnd1<FLT>(),
+          Y = G.Rnd1<FLT>(),
+          Z = G.Rnd1<FLT>(),
+          W = G.Rnd1<FLT>();
+
+        return vec4(X, Y, Z, W);
+      } /* End of 'Rnd1' function */
 
       /* Vec add vec function.
        * ARGUMENTS:
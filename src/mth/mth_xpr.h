@@ -0,0 +1,639 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        mth_xpr.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Lazy (expression template) matrix and vector evaluation
+ *              header file.
+ * NOTE:        Opt-in layer: 'xpr::RotateY(a) * xpr::Translate(t)' builds
+ *              an expression which is evaluated once on conversion to
+ *              'matr'. Products with translation/scale matrices use sparse
+ *              formulas only where every result element is rounded once
+ *              (as in eager product), all other products use eager
+ *              'matr::operator*'. So results are equal to eager ones
+ *              (up to sign of exact zero elements).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __mth_xpr_h_
+#define __mth_xpr_h_
+
+#include <type_traits>
+
+#include "mth_def.h"
+#include "mth_vec3.h"
+#include "mth_matr.h"
+
+/* Space math namespace */
+namespace mth
+{
+  /* Lazy expressions namespace */
+  namespace xpr
+  {
+    /***
+     * Matrix expression nodes
+     ***/
+
+    /* Translation matrix node */
+    template<typename Type>
+      struct translate
+      {
+        using value_type = Type;
+        vec3<Type> T; // Translation vector
+      }; /* End of 'translate' structure */
+
+    /* Scale matrix node */
+    template<typename Type>
+      struct scale
+      {
+        using value_type = Type;
+        vec3<Type> S; // Scale vector
+      }; /* End of 'scale' structure */
+
+    /* Affine (last column is (0, 0, 0, 1)) matrix node */
+    template<typename Type>
+      struct affine
+      {
+        using value_type = Type;
+        matr<Type> M; // Matrix
+      }; /* End of 'affine' structure */
+
+    /* Arbitrary matrix node */
+    template<typename Type>
+      struct general
+      {
+        using value_type = Type;
+        matr<Type> M; // Matrix
+      }; /* End of 'general' structure */
+
+    /* Delayed matrices product node */
+    template<typename L, typename R>
+      struct product
+      {
+        using value_type = typename L::value_type;
+        L Left;  // Left operand
+        R Right; // Right operand
+
+        /* Evaluate expression function.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (matr<value_type>) result matrix.
+         */
+        matr<value_type> Eval( VOID ) const;
+
+        /* Evaluate expression (conversion) function.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (matr<value_type>) result matrix.
+         */
+        operator matr<value_type>( VOID ) const
+        {
+          return Eval();
+        } /* End of 'operator matr' function */
+      }; /* End of 'product' structure */
+
+    /* Matrix expression node check */
+    template<typename Node>
+      struct is_matr_node : std::false_type
+      {
+      }; /* End of 'is_matr_node' structure */
+    template<typename Type>
+      struct is_matr_node<translate<Type>> : std::true_type
+      {
+      }; /* End of 'is_matr_node' structure */
+    template<typename Type>
+      struct is_matr_node<scale<Type>> : std::true_type
+      {
+      }; /* End of 'is_matr_node' structure */
+    template<typename Type>
+      struct is_matr_node<affine<Type>> : std::true_type
+      {
+      }; /* End of 'is_matr_node' structure */
+    template<typename Type>
+      struct is_matr_node<general<Type>> : std::true_type
+      {
+      }; /* End of 'is_matr_node' structure */
+    template<typename L, typename R>
+      struct is_matr_node<product<L, R>> : std::true_type
+      {
+      }; /* End of 'is_matr_node' structure */
+
+    /* Matrix expression node concept */
+    template<typename Node>
+      concept matr_node = is_matr_node<Node>::value;
+
+    /* Translation matrix node function.
+     * ARGUMENTS:
+     *   - translation vector:
+     *       const vec3<Type> &T;
+     * RETURNS:
+     *   (translate<Type>) node.
+     */
+    template<typename Type>
+      constexpr translate<Type> Translate( const vec3<Type> &T ) noexcept
+      {
+        return {T};
+      } /* End of 'Translate' function */
+
+    /* Scale matrix node function.
+     * ARGUMENTS:
+     *   - scale vector:
+     *       const vec3<Type> &S;
+     * RETURNS:
+     *   (scale<Type>) node.
+     */
+    template<typename Type>
+      constexpr scale<Type> Scale( const vec3<Type> &S ) noexcept
+      {
+        return {S};
+      } /* End of 'Scale' function */
+
+    /* Rotation around X axis matrix node function.
+     * ARGUMENTS:
+     *   - angle in degree:
+     *       Type AngleInDegree;
+     * RETURNS:
+     *   (affine<Type>) node.
+     */
+    template<typename Type = FLT>
+      inline affine<Type> RotateX( const std::type_identity_t<Type> AngleInDegree ) noexcept
+      {
+        return {matr<Type>::RotateX(AngleInDegree)};
+      } /* End of 'RotateX' function */
+
+    /* Rotation around Y axis matrix node function.
+     * ARGUMENTS:
+     *   - angle in degree:
+     *       Type AngleInDegree;
+     * RETURNS:
+     *   (affine<Type>) node.
+     */
+    template<typename Type = FLT>
+      inline affine<Type> RotateY( const std::type_identity_t<Type> AngleInDegree ) noexcept
+      {
+        return {matr<Type>::RotateY(AngleInDegree)};
+      } /* End of 'RotateY' function */
+
+    /* Rotation around Z axis matrix node function.
+     * ARGUMENTS:
+     *   - angle in degree:
+     *       Type AngleInDegree;
+     * RETURNS:
+     *   (affine<Type>) node.
+     */
+    template<typename Type = FLT>
+      inline affine<Type> RotateZ( const std::type_identity_t<Type> AngleInDegree ) noexcept
+      {
+        return {matr<Type>::RotateZ(AngleInDegree)};
+      } /* End of 'RotateZ' function */
+
+    /* Rotation around arbitrary axis matrix node function.
+     * ARGUMENTS:
+     *   - angle in degree:
+     *       Type AngleInDegree;
+     *   - rotation axis:
+     *       const vec3<Type> &R;
+     * RETURNS:
+     *   (affine<Type>) node.
+     */
+    template<typename Type>
+      inline affine<Type> Rotate( const std::type_identity_t<Type> AngleInDegree, const vec3<Type> &R ) noexcept
+      {
+        return {matr<Type>::Rotate(AngleInDegree, R)};
+      } /* End of 'Rotate' function */
+
+    /* Wrap matrix to node function.
+     * ARGUMENTS:
+     *   - matrix:
+     *       const matr<Type> &M;
+     * RETURNS:
+     *   (general<Type>) node.
+     */
+    template<typename Type>
+      constexpr general<Type> Lazy( const matr<Type> &M ) noexcept
+      {
+        return {M};
+      } /* End of 'Lazy' function */
+
+    /* Build delayed product function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const L &Left;
+     *       const R &Right;
+     * RETURNS:
+     *   (product<L, R>) node.
+     */
+    template<matr_node L, matr_node R>
+      constexpr product<L, R> operator*( const L &Left, const R &Right ) noexcept
+      {
+        return {Left, Right};
+      } /* End of 'operator*' function */
+
+    /* Build delayed product with plain matrix function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const L &Left;
+     *       const matr<typename L::value_type> &Right;
+     * RETURNS:
+     *   (product<L, general<...>>) node.
+     */
+    template<matr_node L>
+      constexpr product<L, general<typename L::value_type>> operator*( const L &Left, const matr<typename L::value_type> &Right ) noexcept
+      {
+        return {Left, {Right}};
+      } /* End of 'operator*' function */
+
+    /* Build delayed product with plain matrix function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const matr<typename R::value_type> &Left;
+     *       const R &Right;
+     * RETURNS:
+     *   (product<general<...>, R>) node.
+     */
+    template<matr_node R>
+      constexpr product<general<typename R::value_type>, R> operator*( const matr<typename R::value_type> &Left, const R &Right ) noexcept
+      {
+        return {{Left}, Right};
+      } /* End of 'operator*' function */
+
+    /***
+     * Matrix expression evaluation
+     ***/
+
+    /* Node to matrix functions.
+     * ARGUMENTS:
+     *   - node:
+     *       const translate<Type> &N | const scale<Type> &N |
+     *       const affine<Type> &N | const general<Type> &N;
+     * RETURNS:
+     *   (matr<Type>) matrix.
+     */
+    template<typename Type>
+      constexpr matr<Type> ToMatr( const translate<Type> &N ) noexcept
+      {
+        return matr<Type>::Translate(N.T);
+      } /* End of 'ToMatr' function */
+    template<typename Type>
+      constexpr matr<Type> ToMatr( const scale<Type> &N ) noexcept
+      {
+        return matr<Type>::Scale(N.S);
+      } /* End of 'ToMatr' function */
+    template<typename Type>
+      constexpr matr<Type> ToMatr( const affine<Type> &N ) noexcept
+      {
+        return N.M;
+      } /* End of 'ToMatr' function */
+    template<typename Type>
+      constexpr matr<Type> ToMatr( const general<Type> &N ) noexcept
+      {
+        return N.M;
+      } /* End of 'ToMatr' function */
+
+    /* Multiply nodes (eager product fallback) function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const A &Left;
+     *       const B &Right;
+     * RETURNS:
+     *   (general<...>) product.
+     */
+    template<typename A, typename B>
+      inline general<typename A::value_type> Mul( const A &Left, const B &Right ) noexcept
+      {
+        return {ToMatr(Left) * ToMatr(Right)};
+      } /* End of 'Mul' function */
+
+    /* Multiply affine nodes (eager product, result is affine) function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const affine<Type> | translate<Type> &Left;
+     *       const affine<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      inline affine<Type> Mul( const affine<Type> &Left, const affine<Type> &Right ) noexcept
+      {
+        return {Left.M * Right.M};
+      } /* End of 'Mul' function */
+    template<typename Type>
+      inline affine<Type> Mul( const translate<Type> &Left, const affine<Type> &Right ) noexcept
+      {
+        return {ToMatr(Left) * Right.M};
+      } /* End of 'Mul' function */
+
+    /* Multiply translations function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const translate<Type> &Left, &Right;
+     * RETURNS:
+     *   (translate<Type>) product.
+     */
+    template<typename Type>
+      constexpr translate<Type> Mul( const translate<Type> &Left, const translate<Type> &Right ) noexcept
+      {
+        return {Left.T + Right.T};
+      } /* End of 'Mul' function */
+
+    /* Multiply scales function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const scale<Type> &Left, &Right;
+     * RETURNS:
+     *   (scale<Type>) product.
+     */
+    template<typename Type>
+      constexpr scale<Type> Mul( const scale<Type> &Left, const scale<Type> &Right ) noexcept
+      {
+        return {Left.S * Right.S};
+      } /* End of 'Mul' function */
+
+    /* Multiply translation by scale function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const translate<Type> &Left;
+     *       const scale<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      constexpr affine<Type> Mul( const translate<Type> &Left, const scale<Type> &Right ) noexcept
+      {
+        return {matr<Type>(Right.S.X, 0, 0, 0,
+                           0, Right.S.Y, 0, 0,
+                           0, 0, Right.S.Z, 0,
+                           Left.T.X * Right.S.X, Left.T.Y * Right.S.Y, Left.T.Z * Right.S.Z, 1)};
+      } /* End of 'Mul' function */
+
+    /* Multiply scale by translation function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const scale<Type> &Left;
+     *       const translate<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      constexpr affine<Type> Mul( const scale<Type> &Left, const translate<Type> &Right ) noexcept
+      {
+        return {matr<Type>(Left.S.X, 0, 0, 0,
+                           0, Left.S.Y, 0, 0,
+                           0, 0, Left.S.Z, 0,
+                           Right.T.X, Right.T.Y, Right.T.Z, 1)};
+      } /* End of 'Mul' function */
+
+    /* Multiply affine matrix by translation function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const affine<Type> &Left;
+     *       const translate<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      constexpr affine<Type> Mul( const affine<Type> &Left, const translate<Type> &Right ) noexcept
+      {
+        const Type (&A)[4][4] = Left.M.M;
+
+        return {matr<Type>(A[0][0], A[0][1], A[0][2], A[0][3],
+                           A[1][0], A[1][1], A[1][2], A[1][3],
+                           A[2][0], A[2][1], A[2][2], A[2][3],
+                           A[3][0] + Right.T.X, A[3][1] + Right.T.Y, A[3][2] + Right.T.Z, A[3][3])};
+      } /* End of 'Mul' function */
+
+    /* Multiply scale by affine matrix function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const scale<Type> &Left;
+     *       const affine<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      constexpr affine<Type> Mul( const scale<Type> &Left, const affine<Type> &Right ) noexcept
+      {
+        const Type (&A)[4][4] = Right.M.M;
+        const vec3<Type> &S = Left.S;
+
+        return {matr<Type>(S.X * A[0][0], S.X * A[0][1], S.X * A[0][2], S.X * A[0][3],
+                           S.Y * A[1][0], S.Y * A[1][1], S.Y * A[1][2], S.Y * A[1][3],
+                           S.Z * A[2][0], S.Z * A[2][1], S.Z * A[2][2], S.Z * A[2][3],
+                           A[3][0], A[3][1], A[3][2], A[3][3])};
+      } /* End of 'Mul' function */
+
+    /* Multiply affine matrix by scale function.
+     * ARGUMENTS:
+     *   - operands:
+     *       const affine<Type> &Left;
+     *       const scale<Type> &Right;
+     * RETURNS:
+     *   (affine<Type>) product.
+     */
+    template<typename Type>
+      constexpr affine<Type> Mul( const affine<Type> &Left, const scale<Type> &Right ) noexcept
+      {
+        const Type (&A)[4][4] = Left.M.M;
+        const vec3<Type> &S = Right.S;
+
+        return {matr<Type>(A[0][0] * S.X, A[0][1] * S.Y, A[0][2] * S.Z, A[0][3],
+                           A[1][0] * S.X, A[1][1] * S.Y, A[1][2] * S.Z, A[1][3],
+                           A[2][0] * S.X, A[2][1] * S.Y, A[2][2] * S.Z, A[2][3],
+                           A[3][0] * S.X, A[3][1] * S.Y, A[3][2] * S.Z, A[3][3])};
+      } /* End of 'Mul' function */
+
+    /* Reduce node to leaf node function.
+     * ARGUMENTS:
+     *   - node:
+     *       const Node &N;
+     * RETURNS:
+     *   (auto) leaf node (translate, scale, affine or general), leaf
+     *   nodes are returned by reference.
+     */
+    template<typename Node>
+      constexpr const Node & Reduce( const Node &N ) noexcept
+      {
+        return N;
+      } /* End of 'Reduce' function */
+    template<typename L, typename R>
+      inline auto Reduce( const product<L, R> &N ) noexcept
+      {
+        return Mul(Reduce(N.Left), Reduce(N.Right));
+      } /* End of 'Reduce' function */
+
+    /* Evaluate expression function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (matr<value_type>) result matrix.
+     */
+    template<typename L, typename R>
+      inline matr<typename L::value_type> product<L, R>::Eval( VOID ) const
+      {
+        return ToMatr(Reduce(*this));
+      } /* End of 'product::Eval' function */
+
+    /***
+     * Vector expression nodes
+     ***/
+
+    /* Vector leaf node */
+    template<typename Type>
+      struct vec
+      {
+        using value_type = Type;
+        vec3<Type> V; // Vector
+
+        /* Get component function.
+         * ARGUMENTS:
+         *   - component index:
+         *       INT i;
+         * RETURNS:
+         *   (Type) component value.
+         */
+        constexpr Type operator[]( const INT i ) const noexcept
+        {
+          return i == 0 ? V.X : i == 1 ? V.Y : V.Z;
+        } /* End of 'operator[]' function */
+      }; /* End of 'vec' structure */
+
+    /* Vector operation node */
+    template<typename Op, typename L, typename R>
+      struct vec_op
+      {
+        using value_type = typename L::value_type;
+        L Left;  // Left operand
+        R Right; // Right operand (vector node or scalar)
+
+        /* Get component function.
+         * ARGUMENTS:
+         *   - component index:
+         *       INT i;
+         * RETURNS:
+         *   (value_type) component value.
+         */
+        constexpr value_type operator[]( const INT i ) const noexcept
+        {
+          if constexpr (std::is_arithmetic_v<R>)
+            return Op()(Left[i], Right);
+          else
+            return Op()(Left[i], Right[i]);
+        } /* End of 'operator[]' function */
+
+        /* Evaluate expression (conversion) function.
+         * ARGUMENTS: None.
+         * RETURNS:
+         *   (vec3<value_type>) result vector.
+         */
+        constexpr operator vec3<value_type>( VOID ) const noexcept
+        {
+          return vec3<value_type>((*this)[0], (*this)[1], (*this)[2]);
+        } /* End of 'operator vec3' function */
+      }; /* End of 'vec_op' structure */
+
+    /* Vector expression node check */
+    template<typename Node>
+      struct is_vec_node : std::false_type
+      {
+      }; /* End of 'is_vec_node' structure */
+    template<typename Type>
+      struct is_vec_node<vec<Type>> : std::true_type
+      {
+      }; /* End of 'is_vec_node' structure */
+    template<typename Op, typename L, typename R>
+      struct is_vec_node<vec_op<Op, L, R>> : std::true_type
+      {
+      }; /* End of 'is_vec_node' structure */
+
+    /* Vector expression node concept */
+    template<typename Node>
+      concept vec_node = is_vec_node<Node>::value;
+
+    /* Component operations */
+    struct op_add { template<typename Type> constexpr Type operator()( Type A, Type B ) const noexcept { return A + B; } };
+    struct op_sub { template<typename Type> constexpr Type operator()( Type A, Type B ) const noexcept { return A - B; } };
+    struct op_mul { template<typename Type> constexpr Type operator()( Type A, Type B ) const noexcept { return A * B; } };
+    struct op_div { template<typename Type> constexpr Type operator()( Type A, Type B ) const noexcept { return A / B; } };
+
+    /* Wrap vector to node function.
+     * ARGUMENTS:
+     *   - vector:
+     *       const vec3<Type> &V;
+     * RETURNS:
+     *   (vec<Type>) node.
+     */
+    template<typename Type>
+      constexpr vec<Type> Lazy( const vec3<Type> &V ) noexcept
+      {
+        return {V};
+      } /* End of 'Lazy' function */
+
+    /* Vector nodes operation functions.
+     * ARGUMENTS:
+     *   - operands:
+     *       const L &Left;
+     *       const R &Right;
+     * RETURNS:
+     *   (vec_op<...>) node.
+     */
+    template<vec_node L, vec_node R>
+      constexpr vec_op<op_add, L, R> operator+( const L &Left, const R &Right ) noexcept
+      {
+        return {Left, Right};
+      } /* End of 'operator+' function */
+    template<vec_node L, vec_node R>
+      constexpr vec_op<op_sub, L, R> operator-( const L &Left, const R &Right ) noexcept
+      {
+        return {Left, Right};
+      } /* End of 'operator-' function */
+    template<vec_node L, vec_node R>
+      constexpr vec_op<op_mul, L, R> operator*( const L &Left, const R &Right ) noexcept
+      {
+        return {Left, Right};
+      } /* End of 'operator*' function */
+    template<vec_node L>
+      constexpr vec_op<op_mul, L, typename L::value_type> operator*( const L &Left, const typename L::value_type N ) noexcept
+      {
+        return {Left, N};
+      } /* End of 'operator*' function */
+    template<vec_node L>
+      constexpr vec_op<op_div, L, typename L::value_type> operator/( const L &Left, const typename L::value_type N ) noexcept
+      {
+        return {Left, N};
+      } /* End of 'operator/' function */
+
+    /* Evaluate vector expression function.
+     * ARGUMENTS:
+     *   - expression:
+     *       const Node &N;
+     * RETURNS:
+     *   (vec3<...>) result vector.
+     */
+    template<vec_node Node>
+      constexpr vec3<typename Node::value_type> Eval( const Node &N ) noexcept
+      {
+        return vec3<typename Node::value_type>(N[0], N[1], N[2]);
+      } /* End of 'Eval' function */
+
+    /* Evaluate matrix expression function.
+     * ARGUMENTS:
+     *   - expression:
+     *       const Node &N;
+     * RETURNS:
+     *   (matr<...>) result matrix.
+     */
+    template<matr_node Node>
+      inline matr<typename Node::value_type> Eval( const Node &N ) noexcept
+      {
+        return ToMatr(Reduce(N));
+      } /* End of 'Eval' function */
+  } /* end of 'xpr' namespace */
+} /* end of 'mth' namespace */
+
+#endif // !__mth_xpr_h_
+
+/* END OF 'mth_xpr.h' FILE */
@@ -170,8 +170,8 @@ namespace pivk
         if (Dist < 0.001)
           Dist = 0.001;
 
-        NewLoc = (matr::RotateX(Elevator) * matr::RotateY(Azimuth)).TransformPoint(vec3(0, Dist, 0));
-        NewLoc = A.Camera.At + NewLoc;
+        // Orbit offset from 'At' point (one quaternion instead of two matrix products)
+        NewLoc = (quat::RotateX(Elevator) * quat::RotateY(Azimuth)).Rotate(vec3(0, Dist, 0));
 
         // Get projection
         Wp = A.Camera.Size;
@@ -191,9 +191,7 @@ namespace pivk
         A.Camera.Loc = A.Camera.Loc + dv;
       }
 
-      A.Camera.SetLocAtUp((matr::RotateX(Elevator) *
-                           matr::RotateY(Azimuth) *
-                           matr::Translate(A.Camera.At)).TransformPoint(vec3(0, Dist, 0)),
+      A.Camera.SetLocAtUp(A.Camera.At + NewLoc,
                            A.Camera.At,
                            vec3(0, 1, 0));
       A.UpdateCameraBuf();
@@ -55,16 +55,16 @@ namespace pivk
       Pr->Mtl->Shd = A.ShdFind("default");
       Pr->UpdateVA();
 
-      Oak = new model();
-      Oak->LoadG3DM("bin/models/oak.g3dm", &A);
-      House = new model();
-      House->LoadG3DM("bin/models/house.g3dm", &A);
+      Oak = A.ModelLoadG3DM("bin/models/oak.g3dm");
+      House = A.ModelLoadG3DM("bin/models/house.g3dm");
     } /* End of 'unit_skt' function */
 
     /* Default destructor */
     ~unit_map() override
     {
       Pr->Free();
+      anim::GetRef().ModelFree(Oak);
+      anim::GetRef().ModelFree(House);
     } /* End of '~unit_map' function */
 
     /* Unit response function.
@@ -87,20 +87,20 @@ namespace pivk
     {
       A.Draw(Pr);
       Oak->Draw(matr::Translate(vec3(20, 0, 0)));
-      House->Draw(matr::RotateY(100) * matr::Translate(vec3(29.3, 0, 15)));
-      House->Draw(matr::RotateY(100) * matr::Translate(vec3(10.3, 0, 0.3)));
-      House->Draw(matr::RotateY(100) * matr::Translate(vec3(34.7, 0, -7.5)));
-      House->Draw(matr::RotateY(150) * matr::Translate(vec3(58, 0, -14)));
-      House->Draw(matr::RotateY(170) * matr::Translate(vec3(-23.5, 0, -91)));
-      House->Draw(matr::RotateY(-10) * matr::Translate(vec3(-36, 0, -16)));
+      House->Draw(mth::xpr::RotateY(100) * mth::xpr::Translate(vec3(29.3, 0, 15)));
+      House->Draw(mth::xpr::RotateY(100) * mth::xpr::Translate(vec3(10.3, 0, 0.3)));
+      House->Draw(mth::xpr::RotateY(100) * mth::xpr::Translate(vec3(34.7, 0, -7.5)));
+      House->Draw(mth::xpr::RotateY(150) * mth::xpr::Translate(vec3(58, 0, -14)));
+      House->Draw(mth::xpr::RotateY(170) * mth::xpr::Translate(vec3(-23.5, 0, -91)));
+      House->Draw(mth::xpr::RotateY(-10) * mth::xpr::Translate(vec3(-36, 0, -16)));
       //House->Draw(matr::RotateY(-10) * matr::Translate(vec3(-44.7, 0, -58.4)));
-      House->Draw(matr::RotateY(170) * matr::Translate(vec3(-58.5, 0, -115.5)));
-      House->Draw(matr::RotateY(170) * matr::Translate(vec3(52, 0, -134.5)));
-      House->Draw(matr::RotateY(65) * matr::Translate(vec3(-82, 0, -66)));
-      House->Draw(matr::RotateY(175) * matr::Translate(vec3(2, 0, -66)));
-      House->Draw(matr::RotateY(175) * matr::Translate(vec3(45, 0, -60)));
-      House->Draw(matr::RotateY(-100) * matr::Translate(vec3(-85.7, 0, 109.6)));
-      House->Draw(matr::RotateY(74) * matr::Translate(vec3(-42, 0, 92)));
+      House->Draw(mth::xpr::RotateY(170) * mth::xpr::Translate(vec3(-58.5, 0, -115.5)));
+      House->Draw(mth::xpr::RotateY(170) * mth::xpr::Translate(vec3(52, 0, -134.5)));
+      House->Draw(mth::xpr::RotateY(65) * mth::xpr::Translate(vec3(-82, 0, -66)));
+      House->Draw(mth::xpr::RotateY(175) * mth::xpr::Translate(vec3(2, 0, -66)));
+      House->Draw(mth::xpr::RotateY(175) * mth::xpr::Translate(vec3(45, 0, -60)));
+      House->Draw(mth::xpr::RotateY(-100) * mth::xpr::Translate(vec3(-85.7, 0, 109.6)));
+      House->Draw(mth::xpr::RotateY(74) * mth::xpr::Translate(vec3(-42, 0, 92)));
     } /* End of 'Render' function */
   }; /* End of 'unit_map' class */
 
@@ -42,7 +42,7 @@ namespace pivk
     /* Default destructor */
     ~unit_model() override
     {
-      Model->Free();
+      anim::GetRef().ModelFree(Model);
     } /* End of '~unit' function */
 
     /* Unit response function.
@@ -28,6 +28,9 @@ namespace pivk
     texture *Tex;                      // Pointer to texture
     material *Mtl;                     // Pointer to material
     dae DaeParser;                     // DAE parser
+    bvh Bvh;                           // Loaded meshes triangles hierarchy (for picking)
+    vec3 PickPoint;                    // Last picked point
+    BOOL IsPicked = FALSE;             // Last pick hit flag
 
     /* Unit triangle constructor.
      * ARGUMENTS:
@@ -39,6 +42,10 @@ namespace pivk
       std::vector<std::pair<std::vector<vertex::std>, std::vector<INT>>> PrimsData;
 
       DaeParser.LoadGeometry(PrimsData);
+      for (INT i = 0; i < (INT)PrimsData.size(); i++)
+        Bvh.AddMesh(std::span<const vertex::std>(PrimsData[i].first), &vertex::std::P,
+                    std::span<const INT>(PrimsData[i].second), i);
+      Bvh.Build();
 
       PipelinePattern = A.PipelinePatternFind("Zebra pattern");
 
@@ -94,6 +101,16 @@ namespace pivk
     VOID Response( anim &A ) override
     {
       Pr->Mtl->Update();
+
+      // Pick point under mouse cursor
+      if (A.KeysClick[VK_MBUTTON])
+      {
+        hit H;
+
+        IsPicked = Bvh.Intersect(A.Camera, (FLT)A.Mx, (FLT)A.My, H);
+        if (IsPicked)
+          PickPoint = A.Camera.FrameRay((FLT)A.Mx, (FLT)A.My)(H.T);
+      }
     } /* End of 'Response' function */
 
     /* Unit render function.
@@ -108,6 +125,8 @@ namespace pivk
       //A.Draw(Pr);
       //A.Draw(Pr, matr::Translate(vec3(0, 0, 5)));
       A.DrawCylinder(vec3(0, 0, 0), 2, vec3(1, 0, 1), 2, vec4(0.8, 0.47, 0.3, 1));
+      if (IsPicked)
+        A.DrawSphere(PickPoint, 0.1, vec4(0, 1, 0, 1));
       A.DrawAllMarkers();
     } /* End of 'Render' function */
 
@@ -0,0 +1,150 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test.h
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Math library tests common header file.
+ * NOTE:        Tests are built as separate console application
+ *              (see 'mth_test.vcxproj'), with g++/clang:
+ *                g++ -std=c++20 -O2 -I../src test_*.cpp -o mth_test
+ *              Program exit code is number of failed checks.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#ifndef __test_h_
+#define __test_h_
+
+#include <cstdio>
+#include <string>
+
+#include "mth/mth.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Tests context */
+  class context
+  {
+  public:
+    std::string Impl;   // Current implementation name (printed with failures)
+    INT
+      NumOfChecks = 0,  // Number of performed checks
+      NumOfFails = 0;   // Number of failed checks
+
+    /* Check condition function.
+     * ARGUMENTS:
+     *   - check name:
+     *       const std::string &Name;
+     *   - condition:
+     *       BOOL IsOk;
+     *   - failure details:
+     *       const std::string &Details;
+     * RETURNS:
+     *   (BOOL) condition.
+     */
+    BOOL Check( const std::string &Name, BOOL IsOk, const std::string &Details = "" )
+    {
+      NumOfChecks++;
+      if (!IsOk)
+      {
+        NumOfFails++;
+        std::printf("FAIL [%s] %s %s\n", Impl.c_str(), Name.c_str(), Details.c_str());
+      }
+      return IsOk;
+    } /* End of 'Check' function */
+
+    /* Check values are close function.
+     * ARGUMENTS:
+     *   - check name:
+     *       const std::string &Name;
+     *   - tested and reference values:
+     *       DBL Value, Ref;
+     *   - absolute tolerance:
+     *       DBL Tolerance;
+     * RETURNS:
+     *   (BOOL) TRUE if values are close.
+     */
+    BOOL CheckNear( const std::string &Name, DBL Value, DBL Ref, DBL Tolerance )
+    {
+      DBL Diff = Value > Ref ? Value - Ref : Ref - Value;
+      char Buf[128];
+
+      std::snprintf(Buf, sizeof(Buf), "(%.9g, expected %.9g, tolerance %.3g)", Value, Ref, Tolerance);
+      // NaN is never close
+      return Check(Name, Diff <= Tolerance, Buf);
+    } /* End of 'CheckNear' function */
+  }; /* End of 'context' class */
+
+  /* Matrix kernels tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID MatrSuite( context &Ctx );
+
+  /* Batched vectors kernels tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID BatchSuite( context &Ctx );
+
+  /* Quaternions tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID QuatSuite( context &Ctx );
+
+  /* Frustum culling tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID CullSuite( context &Ctx );
+
+  /* Ray packet intersection tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID IsectSuite( context &Ctx );
+
+  /* Bounding volume hierarchy tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID BvhSuite( context &Ctx );
+
+  /* Pseudo random numbers generator tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID RngSuite( context &Ctx );
+
+  /* Lazy evaluation tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID XprSuite( context &Ctx );
+} /* end of 'test' namespace */
+
+#endif // !__test_h_
+
+/* END OF 'test.h' FILE */
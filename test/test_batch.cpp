@@ -0,0 +1,380 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_batch.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Batched vectors kernels tests suite.
+ * NOTE:        Packed, SoA and vertex field 'mth_batch.h' functions are run
+ *              with every supported kernels level (for counts around AVX2
+ *              block size) and compared with scalar loop over generic
+ *              template ('matr<DBL>').
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Float precision relative tolerance */
+  constexpr DBL BatchEps = 1e-5;
+
+  /* Source vectors components range */
+  constexpr FLT BatchRange = 100;
+
+  /* Value written past destination end (must stay untouched) */
+  constexpr FLT BatchGuard = 30.47f;
+
+  /* Test vertex structure (vectors are not 16 bytes aligned in stride) */
+  struct batch_vertex
+  {
+    mth::vec3<FLT> P;   // Position
+    FLT T[2];           // Texture coordinates
+    mth::vec3<FLT> N;   // Normal
+    FLT Pad;            // Some other data
+  }; /* End of 'batch_vertex' structure */
+
+  /* Batch transformation kind */
+  enum class batch_kind
+  {
+    POINTS, VECTORS, NORMALS,
+  }; /* End of 'batch_kind' enum */
+
+  /* Batch kinds names */
+  static const char *BatchKindNames[] = {"points", "vectors", "normals"};
+
+  /* Check vectors are equal function.
+   * ARGUMENTS:
+   *   - vectors:
+   *       const mth::vec3<FLT> &A, &B;
+   * RETURNS:
+   *   (BOOL) TRUE if all components are equal.
+   */
+  static BOOL IsSame( const mth::vec3<FLT> &A, const mth::vec3<FLT> &B )
+  {
+    return A.X == B.X && A.Y == B.Y && A.Z == B.Z;
+  } /* End of 'IsSame' function */
+
+  /* Evaluate reference transformation function.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const mth::matr<DBL> &M;
+   *   - transformation kind:
+   *       batch_kind Kind;
+   *   - source vector:
+   *       const mth::vec3<FLT> &V;
+   * RETURNS:
+   *   (mth::vec3<DBL>) transformed vector.
+   */
+  static mth::vec3<DBL> RefTransform( const mth::matr<DBL> &M, batch_kind Kind, const mth::vec3<FLT> &V )
+  {
+    mth::vec3<DBL> Vd(V.X, V.Y, V.Z);
+
+    if (Kind == batch_kind::POINTS)
+      return M.TransformPoint(Vd);
+    if (Kind == batch_kind::VECTORS)
+      return M.TransformVector(Vd);
+
+    mth::vec3<DBL> R = M.TransformNormal(Vd);
+    DBL Len = std::sqrt(R.X * R.X + R.Y * R.Y + R.Z * R.Z);
+
+    return Len == 0 ? R : mth::vec3<DBL>(R.X / Len, R.Y / Len, R.Z / Len);
+  } /* End of 'RefTransform' function */
+
+  /* Check transformed array function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - transformation matrix:
+   *       const mth::matr<FLT> &M;
+   *   - transformation kind:
+   *       batch_kind Kind;
+   *   - source vectors:
+   *       const std::vector<mth::vec3<FLT>> &Src;
+   *   - result vectors getter:
+   *       get_type Get;
+   * RETURNS: None.
+   */
+  template<typename get_type>
+    static VOID CheckTransformed( context &Ctx, const std::string &Name, const mth::matr<FLT> &M, batch_kind Kind,
+                                  const std::vector<mth::vec3<FLT>> &Src, get_type Get )
+    {
+      mth::matr<DBL> Md;
+      DBL MaxA = 0;
+
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+        {
+          Md.M[i][j] = M.M[i][j];
+          MaxA = std::abs(Md.M[i][j]) > MaxA ? std::abs(Md.M[i][j]) : MaxA;
+        }
+      // Normals are unit (matrices are well conditioned)
+      DBL Tolerance = Kind == batch_kind::NORMALS ? BatchEps * 10 : BatchEps * (1 + 4 * MaxA * BatchRange);
+
+      for (size_t i = 0; i < Src.size(); i++)
+      {
+        mth::vec3<DBL> Ref = RefTransform(Md, Kind, Src[i]);
+        mth::vec3<FLT> R = Get(i);
+        std::string At = Name + " [" + std::to_string(i) + "]";
+
+        if (!Ctx.CheckNear(At + " x", R.X, Ref.X, Tolerance) ||
+            !Ctx.CheckNear(At + " y", R.Y, Ref.Y, Tolerance) ||
+            !Ctx.CheckNear(At + " z", R.Z, Ref.Z, Tolerance))
+          return;
+      }
+    } /* End of 'CheckTransformed' function */
+
+  /* Run packed arrays function by kind.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const mth::matr<FLT> &M;
+   *   - transformation kind:
+   *       batch_kind Kind;
+   *   - source and destination arrays:
+   *       std::span<const mth::vec3<FLT>> Src;
+   *       std::span<mth::vec3<FLT>> Dst;
+   * RETURNS: None.
+   */
+  static VOID RunPacked( const mth::matr<FLT> &M, batch_kind Kind,
+                         std::span<const mth::vec3<FLT>> Src, std::span<mth::vec3<FLT>> Dst )
+  {
+    if (Kind == batch_kind::POINTS)
+      mth::TransformPoints(M, Src, Dst);
+    else if (Kind == batch_kind::VECTORS)
+      mth::TransformVectors(M, Src, Dst);
+    else
+      mth::TransformNormals(M, Src, Dst);
+  } /* End of 'RunPacked' function */
+
+  /* Run SoA function by kind.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const mth::matr<FLT> &M;
+   *   - transformation kind:
+   *       batch_kind Kind;
+   *   - source and destination views:
+   *       const mth::vec3_soa<const FLT> &Src;
+   *       const mth::vec3_soa<FLT> &Dst;
+   * RETURNS: None.
+   */
+  static VOID RunSoA( const mth::matr<FLT> &M, batch_kind Kind,
+                      const mth::vec3_soa<const FLT> &Src, const mth::vec3_soa<FLT> &Dst )
+  {
+    if (Kind == batch_kind::POINTS)
+      mth::TransformPoints(M, Src, Dst);
+    else if (Kind == batch_kind::VECTORS)
+      mth::TransformVectors(M, Src, Dst);
+    else
+      mth::TransformNormals(M, Src, Dst);
+  } /* End of 'RunSoA' function */
+
+  /* Run vertex field function by kind.
+   * ARGUMENTS:
+   *   - transformation matrix:
+   *       const mth::matr<FLT> &M;
+   *   - transformation kind:
+   *       batch_kind Kind;
+   *   - vertices:
+   *       std::span<batch_vertex> V;
+   *   - vertex field:
+   *       mth::vec3<FLT> batch_vertex::*Field;
+   * RETURNS: None.
+   */
+  static VOID RunField( const mth::matr<FLT> &M, batch_kind Kind,
+                        std::span<batch_vertex> V, mth::vec3<FLT> batch_vertex::*Field )
+  {
+    if (Kind == batch_kind::POINTS)
+      mth::TransformPoints(M, V, Field);
+    else if (Kind == batch_kind::VECTORS)
+      mth::TransformVectors(M, V, Field);
+    else
+      mth::TransformNormals(M, V, Field);
+  } /* End of 'RunField' function */
+
+  /* Check bound box function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - tested bound box:
+   *       const mth::vec3<FLT> &Min, &Max;
+   *   - reference bound box:
+   *       const mth::vec3<FLT> &RefMin, &RefMax;
+   * RETURNS: None.
+   */
+  static VOID CheckBounds( context &Ctx, const std::string &Name,
+                           const mth::vec3<FLT> &Min, const mth::vec3<FLT> &Max,
+                           const mth::vec3<FLT> &RefMin, const mth::vec3<FLT> &RefMax )
+  {
+    // Minimum and maximum are exact in any evaluation order
+    Ctx.CheckNear(Name + " min x", Min.X, RefMin.X, 0);
+    Ctx.CheckNear(Name + " min y", Min.Y, RefMin.Y, 0);
+    Ctx.CheckNear(Name + " min z", Min.Z, RefMin.Z, 0);
+    Ctx.CheckNear(Name + " max x", Max.X, RefMax.X, 0);
+    Ctx.CheckNear(Name + " max y", Max.Y, RefMax.Y, 0);
+    Ctx.CheckNear(Name + " max z", Max.Z, RefMax.Z, 0);
+  } /* End of 'CheckBounds' function */
+
+  /* Run batch kernels checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID BatchChecks( context &Ctx )
+  {
+    using matr = mth::matr<FLT>;
+    using vec3 = mth::vec3<FLT>;
+    const struct
+    {
+      const char *Name; // Matrix name
+      matr M;           // Matrix
+    } Matrs[] =
+    {
+      {"identity", matr::Identity()},
+      {"rigid", matr::Rotate(37, vec3(1, 2, 3)) * matr::Translate(vec3(5, -7, 2))},
+      {"affine", matr::Scale(vec3(0.5f, 3, -2)) * matr::RotateY(120) * matr::Translate(vec3(-1, 4, 10))},
+      {"projective", matr::Frustum(-1, 1, -1, 1, 1, 100)},
+    };
+    // Block size neighbours (AVX2 kernels process 8 vectors per step)
+    const size_t Counts[] = {0, 1, 7, 8, 9, 16, 37};
+    mth::rng Rng(102);
+
+    for (size_t Count : Counts)
+    {
+      std::string Size = " n=" + std::to_string(Count);
+      std::vector<vec3> Src(Count);
+
+      for (size_t i = 0; i < Count; i++)
+        Src[i] = vec3(Rng.Rnd1<FLT>() * BatchRange, Rng.Rnd1<FLT>() * BatchRange, Rng.Rnd1<FLT>() * BatchRange);
+      // Zero vector (normal is kept zero)
+      if (Count > 3)
+        Src[3] = vec3(0);
+
+      std::vector<FLT> X(Count), Y(Count), Z(Count);
+      std::vector<batch_vertex> V(Count);
+
+      for (size_t i = 0; i < Count; i++)
+      {
+        X[i] = Src[i].X, Y[i] = Src[i].Y, Z[i] = Src[i].Z;
+        V[i] = {Src[i], {(FLT)i, -(FLT)i}, Src[Count - 1 - i], (FLT)i};
+      }
+      mth::vec3_soa<const FLT> SrcSoA {X, Y, Z};
+
+      for (auto &Mt : Matrs)
+        for (INT k = 0; k < 3; k++)
+        {
+          batch_kind Kind = (batch_kind)k;
+          std::string Name = std::string(BatchKindNames[k]) + " " + Mt.Name + Size;
+
+          /* Packed arrays (destination is longer than source) */
+          std::vector<vec3> Dst(Count + 1, vec3(BatchGuard));
+
+          RunPacked(Mt.M, Kind, Src, Dst);
+          CheckTransformed(Ctx, "packed " + Name, Mt.M, Kind, Src, [&]( size_t i ){ return Dst[i]; });
+          Ctx.Check("packed " + Name + " guard", IsSame(Dst[Count], vec3(BatchGuard)));
+
+          std::vector<vec3> Same = Src;
+
+          RunPacked(Mt.M, Kind, Same, Same);
+          CheckTransformed(Ctx, "packed in place " + Name, Mt.M, Kind, Src, [&]( size_t i ){ return Same[i]; });
+
+          /* Structure of arrays */
+          std::vector<FLT> DX(Count + 1, BatchGuard), DY(Count + 1, BatchGuard), DZ(Count + 1, BatchGuard);
+
+          RunSoA(Mt.M, Kind, SrcSoA, mth::vec3_soa<FLT> {std::span(DX).first(Count), std::span(DY).first(Count), std::span(DZ).first(Count)});
+          CheckTransformed(Ctx, "soa " + Name, Mt.M, Kind, Src, [&]( size_t i ){ return vec3(DX[i], DY[i], DZ[i]); });
+          Ctx.Check("soa " + Name + " guard", DX[Count] == BatchGuard && DY[Count] == BatchGuard && DZ[Count] == BatchGuard);
+
+          std::vector<FLT> SX = X, SY = Y, SZ = Z;
+
+          RunSoA(Mt.M, Kind, mth::vec3_soa<const FLT> {SX, SY, SZ}, mth::vec3_soa<FLT> {SX, SY, SZ});
+          CheckTransformed(Ctx, "soa in place " + Name, Mt.M, Kind, Src, [&]( size_t i ){ return vec3(SX[i], SY[i], SZ[i]); });
+
+          /* Vertex field (other fields are untouched) */
+          std::vector<batch_vertex> W = V;
+          BOOL IsKept = TRUE;
+
+          RunField(Mt.M, Kind, W, &batch_vertex::P);
+          CheckTransformed(Ctx, "field " + Name, Mt.M, Kind, Src, [&]( size_t i ){ return W[i].P; });
+          for (size_t i = 0; i < Count; i++)
+            IsKept = IsKept && W[i].T[0] == V[i].T[0] && W[i].T[1] == V[i].T[1] && IsSame(W[i].N, V[i].N) && W[i].Pad == V[i].Pad;
+          Ctx.Check("field " + Name + " other fields", IsKept);
+        }
+
+      /* Bound boxes (with scalar loop reference) */
+      vec3 RefMin(0), RefMax(0), Min, Max;
+
+      for (size_t i = 0; i < Count; i++)
+        if (i == 0)
+          RefMin = RefMax = Src[i];
+        else
+          RefMin = RefMin.Min(Src[i]), RefMax = RefMax.Max(Src[i]);
+
+      mth::ComputeBounds(Src, Min, Max);
+      CheckBounds(Ctx, "bounds packed" + Size, Min, Max, RefMin, RefMax);
+      mth::ComputeBounds(SrcSoA, Min, Max);
+      CheckBounds(Ctx, "bounds soa" + Size, Min, Max, RefMin, RefMax);
+      mth::ComputeBounds(std::span<const batch_vertex>(V), &batch_vertex::P, Min, Max);
+      CheckBounds(Ctx, "bounds field" + Size, Min, Max, RefMin, RefMax);
+    }
+
+    /* Default constructed (null) spans are not dereferenced */
+    vec3 Min(1), Max(1);
+
+    mth::TransformPoints(Matrs[1].M, std::span<const vec3>(), std::span<vec3>());
+    mth::ComputeBounds(std::span<const vec3>(), Min, Max);
+    CheckBounds(Ctx, "bounds null span", Min, Max, vec3(0), vec3(0));
+  } /* End of 'BatchChecks' function */
+
+  /* Batched vectors kernels tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID BatchSuite( context &Ctx )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("batch: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("batch ") + L.Name;
+      BatchChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "batch generic";
+    BatchChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'BatchSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_batch.cpp' FILE */
@@ -0,0 +1,250 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_bvh.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Bounding volume hierarchy tests suite.
+ * NOTE:        Closest hit and any hit queries are compared with brute
+ *              force scalar intersection of every mesh triangle. Both
+ *              use the same triangle test, so results must be equal
+ *              exactly. Queries are repeated after vertices are moved
+ *              and hierarchy is refitted (not rebuilt).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Number of random test rays */
+  constexpr INT BvhRays = 500;
+
+  /* Half size of scene with test triangles */
+  constexpr FLT BvhRange = 50;
+
+  /* Mesh vertex for hierarchy */
+  struct bvh_vertex
+  {
+    mth::vec3<FLT> P; // Position
+    FLT Id;           // Other vertex data
+  }; /* End of 'bvh_vertex' structure */
+
+  /* Test mesh */
+  struct bvh_mesh
+  {
+    std::vector<bvh_vertex> V; // Vertices
+    std::vector<INT> Ind;      // Triangle list indices
+    INT PrimId;                // Primitive id
+    INT First;                 // First triangle number in hierarchy
+  }; /* End of 'bvh_mesh' structure */
+
+  /* Make random vector function.
+   * ARGUMENTS:
+   *   - random numbers generator:
+   *       mth::rng &Rng;
+   *   - components range:
+   *       FLT Range;
+   * RETURNS:
+   *   (mth::vec3<FLT>) vector.
+   */
+  static mth::vec3<FLT> BvhRndVec( mth::rng &Rng, FLT Range )
+  {
+    return mth::vec3<FLT>(Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range);
+  } /* End of 'BvhRndVec' function */
+
+  /* Add triangle to mesh function.
+   * ARGUMENTS:
+   *   - mesh:
+   *       bvh_mesh &M;
+   *   - triangle vertices:
+   *       const mth::vec3<FLT> &P0, &P1, &P2;
+   * RETURNS: None.
+   */
+  static VOID BvhAddTri( bvh_mesh &M, const mth::vec3<FLT> &P0, const mth::vec3<FLT> &P1, const mth::vec3<FLT> &P2 )
+  {
+    INT n = static_cast<INT>(M.V.size());
+
+    M.V.push_back({P0, 0});
+    M.V.push_back({P1, 1});
+    M.V.push_back({P2, 2});
+    M.Ind.push_back(n);
+    M.Ind.push_back(n + 1);
+    M.Ind.push_back(n + 2);
+  } /* End of 'BvhAddTri' function */
+
+  /* Brute force closest hit function.
+   * ARGUMENTS:
+   *   - meshes:
+   *       const std::vector<bvh_mesh> &Meshes;
+   *   - ray:
+   *       const mth::ray<FLT> &R;
+   *   - nearest hit (only closer than H.T hits are searched):
+   *       mth::hit<FLT> &H;
+   * RETURNS:
+   *   (BOOL) TRUE if hit was updated.
+   */
+  static BOOL BvhBruteForce( const std::vector<bvh_mesh> &Meshes, const mth::ray<FLT> &R, mth::hit<FLT> &H )
+  {
+    BOOL IsHit = FALSE;
+
+    for (auto &M : Meshes)
+      IsHit |= mth::Intersect(R, std::span<const bvh_vertex>(M.V), &bvh_vertex::P, std::span<const INT>(M.Ind), M.PrimId, H);
+    return IsHit;
+  } /* End of 'BvhBruteForce' function */
+
+  /* Compare hierarchy queries with brute force function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - hierarchy:
+   *       const mth::bvh<FLT> &Bvh;
+   *   - meshes:
+   *       const std::vector<bvh_mesh> &Meshes;
+   *   - random numbers generator:
+   *       mth::rng &Rng;
+   * RETURNS: None.
+   */
+  static VOID BvhCheckRays( context &Ctx, const std::string &Name, const mth::bvh<FLT> &Bvh,
+                            const std::vector<bvh_mesh> &Meshes, mth::rng &Rng )
+  {
+    INT NoofHits = 0;
+    BOOL
+      IsSameHit = TRUE, IsSameT = TRUE, IsSameIds = TRUE,
+      IsSameLimited = TRUE, IsSameOccluded = TRUE;
+
+    for (INT i = 0; i < BvhRays; i++)
+    {
+      // Most rays are aimed into scene, some start inside it
+      mth::vec3<FLT>
+        Org = BvhRndVec(Rng, BvhRange * (i % 4 == 0 ? 0.5f : 1.6f)),
+        At = BvhRndVec(Rng, BvhRange * 0.8f);
+      mth::ray<FLT> R(Org, At - Org);
+      mth::hit<FLT> H, Ref;
+      BOOL
+        IsHit = Bvh.Intersect(R, H),
+        IsRef = BvhBruteForce(Meshes, R, Ref);
+
+      NoofHits += IsRef;
+      IsSameHit = IsSameHit && IsHit == IsRef;
+      IsSameT = IsSameT && H.T == Ref.T && H.U == Ref.U && H.V == Ref.V;
+      IsSameIds = IsSameIds && H.PrimId == Ref.PrimId && H.TriId == Ref.TriId;
+
+      // Search limited by previous hit
+      FLT Limit = IsRef ? Ref.T * 0.7f : BvhRange;
+      mth::hit<FLT> HL, RefL;
+
+      HL.T = RefL.T = Limit;
+      IsHit = Bvh.Intersect(R, HL);
+      IsRef = BvhBruteForce(Meshes, R, RefL);
+      IsSameLimited = IsSameLimited && IsHit == IsRef && HL.T == RefL.T && HL.TriId == RefL.TriId;
+
+      // Any hit before and after nearest one
+      if (Ref.IsHit())
+        IsSameOccluded = IsSameOccluded && !Bvh.IsOccluded(R, Ref.T * 0.99f) && Bvh.IsOccluded(R, Ref.T * 1.01f);
+      IsSameOccluded = IsSameOccluded && Bvh.IsOccluded(R) == Ref.IsHit();
+    }
+    Ctx.Check(Name + " hit flags", IsSameHit);
+    Ctx.Check(Name + " hit parameters", IsSameT);
+    Ctx.Check(Name + " hit ids", IsSameIds);
+    Ctx.Check(Name + " limited hit", IsSameLimited);
+    Ctx.Check(Name + " occlusion", IsSameOccluded);
+    // Scene is dense enough for both hits and misses
+    Ctx.Check(Name + " hits and misses", NoofHits > BvhRays / 4 && NoofHits < BvhRays, std::to_string(NoofHits) + " hits");
+  } /* End of 'BvhCheckRays' function */
+
+  /* Bounding volume hierarchy tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID BvhSuite( context &Ctx )
+  {
+    using vec3 = mth::vec3<FLT>;
+    using matr = mth::matr<FLT>;
+    mth::rng Rng(2024);
+    std::vector<bvh_mesh> Meshes(3);
+
+    Ctx.Impl = "bvh";
+
+    /* Empty hierarchy */
+    mth::bvh<FLT> Bvh;
+    mth::hit<FLT> H;
+
+    Bvh.Build();
+    Ctx.Check("empty intersect", !Bvh.Intersect(mth::ray<FLT>(vec3(0), vec3(0, 0, 1)), H) && !H.IsHit());
+    Ctx.Check("empty occlusion", !Bvh.IsOccluded(mth::ray<FLT>(vec3(0), vec3(0, 0, 1))));
+
+    /* Random triangles soup */
+    Meshes[0].PrimId = 3;
+    for (INT i = 0; i < 600; i++)
+    {
+      vec3 C = BvhRndVec(Rng, BvhRange);
+      FLT Size = 1 + Rng.Rnd0<FLT>() * 6;
+
+      BvhAddTri(Meshes[0], C + BvhRndVec(Rng, Size), C + BvhRndVec(Rng, Size), C + BvhRndVec(Rng, Size));
+    }
+
+    /* Triangles with the same center (split by centers is impossible) */
+    Meshes[1].PrimId = 7;
+    for (INT i = 0; i < 40; i++)
+    {
+      vec3 D1 = BvhRndVec(Rng, 8), D2 = BvhRndVec(Rng, 8);
+
+      BvhAddTri(Meshes[1], vec3(10, -5, 20) + D1, vec3(10, -5, 20) - D1 + D2, vec3(10, -5, 20) - D2);
+    }
+
+    /* Large ground triangles */
+    Meshes[2].PrimId = 11;
+    BvhAddTri(Meshes[2], vec3(-60, -45, -60), vec3(-60, -45, 60), vec3(60, -45, 60));
+    BvhAddTri(Meshes[2], vec3(-60, -45, -60), vec3(60, -45, 60), vec3(60, -45, -60));
+
+    for (auto &M : Meshes)
+      M.First = Bvh.AddMesh(std::span<const bvh_vertex>(M.V), &bvh_vertex::P, std::span<const INT>(M.Ind), M.PrimId);
+    Bvh.Build();
+
+    Ctx.Check("triangles count", Bvh.Tris.size() == 642);
+    // Bound box contains all vertices
+    mth::aabb<FLT> B = Bvh.Bound();
+    BOOL IsInside = TRUE;
+
+    for (auto &M : Meshes)
+      for (auto &V : M.V)
+        IsInside = IsInside &&
+          V.P.X >= B.Min.X && V.P.Y >= B.Min.Y && V.P.Z >= B.Min.Z &&
+          V.P.X <= B.Max.X && V.P.Y <= B.Max.Y && V.P.Z <= B.Max.Z;
+    Ctx.Check("bound", IsInside);
+
+    BvhCheckRays(Ctx, "build", Bvh, Meshes, Rng);
+
+    /* Move vertices (soup is transformed, cluster is jittered) and refit */
+    matr M = matr::Rotate(25, vec3(1, 2, 3).Normalizing()) * matr::Translate(vec3(4, -3, 6));
+
+    for (auto &V : Meshes[0].V)
+      V.P = M.TransformPoint(V.P);
+    for (auto &V : Meshes[1].V)
+      V.P = V.P + BvhRndVec(Rng, 3);
+    for (INT i = 0; i < 2; i++)
+      Bvh.UpdateMesh(Meshes[i].First, std::span<const bvh_vertex>(Meshes[i].V), &bvh_vertex::P, std::span<const INT>(Meshes[i].Ind));
+    Bvh.Refit();
+
+    BvhCheckRays(Ctx, "refit", Bvh, Meshes, Rng);
+
+    /* Clear */
+    Bvh.Clear();
+    H = mth::hit<FLT>();
+    Ctx.Check("cleared", !Bvh.Intersect(mth::ray<FLT>(vec3(0, 100, 0), vec3(0, -1, 0)), H) && Bvh.Tris.empty());
+  } /* End of 'BvhSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_bvh.cpp' FILE */
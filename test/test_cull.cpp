@@ -0,0 +1,218 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_cull.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Frustum culling tests suite.
+ * NOTE:        Boxes and spheres arrays are culled with every
+ *              supported kernels level and compared with scalar
+ *              'frustum::IsVisible' and with double precision
+ *              reference. Flags of volumes closer to a plane than
+ *              float rounding are compared only between kernels and
+ *              scalar path, which may differ by fused multiply-add.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Plane distance below which float rounding may change visibility */
+  constexpr DBL CullEps = 1e-3;
+
+  /* Half size of scene with test volumes */
+  constexpr FLT CullRange = 120;
+
+  /* Get reference volume margin (minimal signed distance to frustum planes) function.
+   * ARGUMENTS:
+   *   - frustum:
+   *       const mth::frustum<FLT> &F;
+   *   - volume center:
+   *       const mth::vec3<FLT> &C;
+   *   - volume half size (for spheres all components are radius):
+   *       const mth::vec3<FLT> &Ext;
+   *   - sphere flag (radius is not projected):
+   *       BOOL IsSphere;
+   * RETURNS:
+   *   (DBL) margin (negative - volume is culled).
+   */
+  static DBL CullMargin( const mth::frustum<FLT> &F, const mth::vec3<FLT> &C, const mth::vec3<FLT> &Ext, BOOL IsSphere )
+  {
+    DBL Margin = 0;
+
+    for (INT i = 0; i < mth::frustum<FLT>::PLANES_COUNT; i++)
+    {
+      const mth::vec4<FLT> &Pl = F.Planes[i];
+      DBL
+        D = (DBL)Pl.X * C.X + (DBL)Pl.Y * C.Y + (DBL)Pl.Z * C.Z + Pl.W,
+        R = IsSphere ? (DBL)Ext.X :
+            std::abs((DBL)Pl.X) * Ext.X + std::abs((DBL)Pl.Y) * Ext.Y + std::abs((DBL)Pl.Z) * Ext.Z;
+
+      if (i == 0 || D + R < Margin)
+        Margin = D + R;
+    }
+    return Margin;
+  } /* End of 'CullMargin' function */
+
+  /* Check culling flags function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - culled flags and number of visible volumes:
+   *       const std::vector<BYTE> &Visible;
+   *       size_t NoofVisible;
+   *   - scalar flags:
+   *       const std::vector<BYTE> &Ref;
+   *   - reference margins:
+   *       const std::vector<DBL> &Margins;
+   *   - number of volumes:
+   *       size_t Count;
+   * RETURNS: None.
+   */
+  static VOID CheckCulled( context &Ctx, const std::string &Name,
+                           const std::vector<BYTE> &Visible, size_t NoofVisible,
+                           const std::vector<BYTE> &Ref, const std::vector<DBL> &Margins, size_t Count )
+  {
+    size_t n = 0;
+    BOOL IsSame = TRUE, IsExact = TRUE;
+
+    for (size_t i = 0; i < Count; i++)
+    {
+      n += Visible[i];
+      IsSame = IsSame && (Visible[i] == Ref[i] || std::abs(Margins[i]) < CullEps);
+      IsExact = IsExact && (Visible[i] == (Margins[i] >= 0) || std::abs(Margins[i]) < CullEps);
+    }
+    Ctx.Check(Name + " same as scalar", IsSame);
+    Ctx.Check(Name + " same as reference", IsExact);
+    Ctx.Check(Name + " visible count", n == NoofVisible);
+    // Guard flag past the end is untouched
+    Ctx.Check(Name + " guard", Visible[Count] == 0xCD);
+  } /* End of 'CheckCulled' function */
+
+  /* Run culling checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID CullChecks( context &Ctx )
+  {
+    using vec3 = mth::vec3<FLT>;
+    using matr = mth::matr<FLT>;
+    using aabb = mth::aabb<FLT>;
+    using sphere = mth::sphere<FLT>;
+    mth::frustum<FLT> F(matr::View(vec3(30, 20, 50), vec3(0, 5, 0), vec3(0, 1, 0)) * matr::Frustum(-1, 1, -0.75f, 0.75f, 1, 150));
+    // Block size neighbours (AVX2 kernels process 8 volumes per step)
+    const size_t Counts[] = {0, 1, 7, 8, 9, 16, 37, 200};
+    mth::rng Rng(77);
+
+    for (size_t Count : Counts)
+    {
+      std::string Size = " n=" + std::to_string(Count);
+      std::vector<aabb> Boxes(Count);
+      std::vector<sphere> Spheres(Count);
+
+      for (size_t i = 0; i < Count; i++)
+      {
+        vec3
+          C(Rng.Rnd1<FLT>() * CullRange, Rng.Rnd1<FLT>() * CullRange, Rng.Rnd1<FLT>() * CullRange),
+          Ext(Rng.Rnd0<FLT>() * 10, Rng.Rnd0<FLT>() * 10, Rng.Rnd0<FLT>() * 10);
+
+        // Every 3rd volume is moved to a plane: straddling, touching from outside or just culled
+        if (i % 3 == 0)
+        {
+          const mth::vec4<FLT> &Pl = F.Planes[i / 3 % mth::frustum<FLT>::PLANES_COUNT];
+          vec3 N(Pl.X, Pl.Y, Pl.Z);
+          FLT
+            R = std::abs(Pl.X) * Ext.X + std::abs(Pl.Y) * Ext.Y + std::abs(Pl.Z) * Ext.Z,
+            Shift[] = {0, -R * 0.5f, -R - 0.5f, -R + 0.5f};
+
+          C = C - N * ((N & C) + Pl.W) + N * Shift[i / 3 % 4];
+        }
+        Boxes[i] = aabb(C - Ext, C + Ext);
+        Spheres[i] = sphere(C, Ext.X);
+      }
+
+      /* Boxes */
+      std::vector<BYTE> Visible(Count + 1, 0xCD), Ref(Count);
+      std::vector<DBL> Margins(Count);
+
+      for (size_t i = 0; i < Count; i++)
+      {
+        Ref[i] = static_cast<BYTE>(F.IsVisible(Boxes[i]));
+        Margins[i] = CullMargin(F, Boxes[i].Center(), Boxes[i].Extent(), FALSE);
+      }
+      size_t n = mth::Cull(F, std::span<const aabb>(Boxes), std::span<BYTE>(Visible));
+      CheckCulled(Ctx, "boxes" + Size, Visible, n, Ref, Margins, Count);
+
+      /* Spheres */
+      std::fill(Visible.begin(), Visible.end(), 0xCD);
+      for (size_t i = 0; i < Count; i++)
+      {
+        Ref[i] = static_cast<BYTE>(F.IsVisible(Spheres[i]));
+        Margins[i] = CullMargin(F, Spheres[i].C, vec3(Spheres[i].R), TRUE);
+      }
+      n = mth::Cull(F, std::span<const sphere>(Spheres), std::span<BYTE>(Visible));
+      CheckCulled(Ctx, "spheres" + Size, Visible, n, Ref, Margins, Count);
+    }
+
+    /* Volumes around frustum center are visible, far behind camera are culled */
+    aabb In[] = {aabb(vec3(-1, 4, -1), vec3(1, 6, 1)), aabb(vec3(-500), vec3(500))};
+    aabb Out[] = {aabb(vec3(200, 200, 200), vec3(210, 210, 210)), aabb(vec3(60, 40, 100), vec3(61, 41, 101))};
+    BYTE Flags[2];
+
+    Ctx.Check("boxes inside", mth::Cull(F, std::span<const aabb>(In), std::span<BYTE>(Flags)) == 2);
+    Ctx.Check("boxes outside", mth::Cull(F, std::span<const aabb>(Out), std::span<BYTE>(Flags)) == 0);
+  } /* End of 'CullChecks' function */
+
+  /* Frustum culling tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID CullSuite( context &Ctx )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("cull: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("cull ") + L.Name;
+      CullChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "cull generic";
+    CullChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'CullSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_cull.cpp' FILE */
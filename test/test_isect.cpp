@@ -0,0 +1,290 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_isect.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Ray packet intersection tests suite.
+ * NOTE:        Packet kernels are run with every supported kernels
+ *              level and compared lane by lane with scalar ray
+ *              intersection. Triangle rays are aimed at points with
+ *              barycentrics away from edges, so hit flags do not depend
+ *              on fused multiply-add rounding. Lanes masked out by
+ *              maximal ray parameter (or by closer previous hit) must
+ *              stay untouched.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Relative tolerance of hit parameters */
+  constexpr DBL IsectEps = 1e-4;
+
+  /* Number of random test packets */
+  constexpr INT IsectPackets = 64;
+
+  /* Mesh vertex for packet mesh queries */
+  struct isect_vertex
+  {
+    mth::vec3<FLT> P; // Position
+    FLT Id;           // Other vertex data
+  }; /* End of 'isect_vertex' structure */
+
+  /* Make random vector function.
+   * ARGUMENTS:
+   *   - random numbers generator:
+   *       mth::rng &Rng;
+   *   - components range:
+   *       FLT Range;
+   * RETURNS:
+   *   (mth::vec3<FLT>) vector.
+   */
+  static mth::vec3<FLT> IsectRndVec( mth::rng &Rng, FLT Range )
+  {
+    return mth::vec3<FLT>(Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range);
+  } /* End of 'IsectRndVec' function */
+
+  /* Check hit parameters are close function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - packet lane hit and scalar hit:
+   *       const mth::hit<FLT> &H, &Ref;
+   * RETURNS: None.
+   */
+  static VOID CheckHit( context &Ctx, const std::string &Name, const mth::hit<FLT> &H, const mth::hit<FLT> &Ref )
+  {
+    Ctx.Check(Name + " ids", H.PrimId == Ref.PrimId && H.TriId == Ref.TriId,
+              "(" + std::to_string(H.PrimId) + ":" + std::to_string(H.TriId) + ", expected " +
+              std::to_string(Ref.PrimId) + ":" + std::to_string(Ref.TriId) + ")");
+    if (!Ref.IsHit())
+      return;
+    Ctx.CheckNear(Name + " t", H.T, Ref.T, IsectEps * (1 + Ref.T));
+    Ctx.CheckNear(Name + " u", H.U, Ref.U, IsectEps);
+    Ctx.CheckNear(Name + " v", H.V, Ref.V, IsectEps);
+  } /* End of 'CheckHit' function */
+
+  /* Run ray packet-box checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID IsectBoxChecks( context &Ctx )
+  {
+    using vec3 = mth::vec3<FLT>;
+    mth::rng Rng(91);
+
+    for (INT n = 0; n < IsectPackets; n++)
+    {
+      std::string Name = "box #" + std::to_string(n);
+      vec3 C = IsectRndVec(Rng, 10), Ext(1 + Rng.Rnd0<FLT>() * 3, 1 + Rng.Rnd0<FLT>() * 3, 1 + Rng.Rnd0<FLT>() * 3);
+      mth::aabb<FLT> B(C - Ext, C + Ext);
+      mth::ray_packet R;
+      FLT TMax[8], T[8];
+
+      for (INT i = 0; i < 8; i++)
+      {
+        vec3
+          Org = IsectRndVec(Rng, 20),
+          // Half of rays are aimed inside box, other are random
+          At = i % 2 == 0 ? C + vec3(Rng.Rnd1<FLT>() * Ext.X, Rng.Rnd1<FLT>() * Ext.Y, Rng.Rnd1<FLT>() * Ext.Z) * 0.9f : IsectRndVec(Rng, 20);
+
+        // Axis aligned directions (infinite reciprocals)
+        if (i == 5)
+          At = vec3(Org.X, Org.Y, C.Z);
+        if (i == 7)
+          At = vec3(C.X, Org.Y, Org.Z);
+        R.Set(i, mth::ray<FLT>(Org, At - Org));
+        T[i] = -1;
+        // Masked out lanes (negative maximal parameter), short and unlimited rays
+        TMax[i] = i == 1 || i == 6 ? -1 : i == 3 ? 2.0f : std::numeric_limits<FLT>::max();
+      }
+      // Ray from inside box enters at 0
+      R.Set(4, mth::ray<FLT>(C, IsectRndVec(Rng, 1) + vec3(0.1f)));
+
+      INT Bits = mth::Intersect(R, B, TMax, T);
+
+      for (INT i = 0; i < 8; i++)
+      {
+        mth::ray_inv<FLT> RI(R.Get(i));
+        FLT RefT;
+
+        RI.InvDir = vec3(R.InvX[i], R.InvY[i], R.InvZ[i]);
+        BOOL IsHit = mth::Intersect(RI, B, TMax[i], RefT);
+        std::string Lane = Name + " lane " + std::to_string(i);
+
+        Ctx.Check(Lane + " hit flag", ((Bits >> i) & 1) == IsHit);
+        if (IsHit)
+          Ctx.CheckNear(Lane + " t", T[i], RefT, 0);
+        if (TMax[i] < 0)
+          Ctx.Check(Lane + " masked out", ((Bits >> i) & 1) == 0);
+      }
+      Ctx.Check(Name + " inside hit at 0", ((Bits >> 4) & 1) == 1 && T[4] == 0);
+    }
+  } /* End of 'IsectBoxChecks' function */
+
+  /* Run ray packet-triangle checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID IsectTriangleChecks( context &Ctx )
+  {
+    using vec3 = mth::vec3<FLT>;
+    // Barycentrics of ray targets: inside triangle or clearly outside of it
+    const FLT Targets[][2] =
+    {
+      {0.2f, 0.3f}, {0.6f, 0.1f}, {0.1f, 0.7f}, {0.33f, 0.33f},
+      {-0.3f, 0.4f}, {0.5f, -0.2f}, {0.8f, 0.6f}, {1.5f, 0.2f},
+    };
+    mth::rng Rng(92);
+
+    for (INT n = 0; n < IsectPackets; n++)
+    {
+      std::string Name = "triangle #" + std::to_string(n);
+      vec3
+        P0 = IsectRndVec(Rng, 10),
+        E1 = IsectRndVec(Rng, 5),
+        E2 = IsectRndVec(Rng, 5),
+        N = E1 % E2;
+
+      // Thin triangles and grazing rays are ill-conditioned, so packet and scalar rounding may differ
+      if ((N & N) < 0.25f * (E1 & E1) * (E2 & E2))
+        E2 = E1 % IsectRndVec(Rng, 1) % E1 + E1 * 0.3f, N = E1 % E2;
+      N.Normalize();
+      vec3
+        P1 = P0 + E1,
+        P2 = P0 + E2;
+      mth::ray_packet R;
+      mth::hit_packet H;
+
+      for (INT i = 0; i < 8; i++)
+      {
+        const FLT *Bc = Targets[(i + n) % 8];
+        vec3
+          At = P0 + E1 * Bc[0] + E2 * Bc[1],
+          Org = At + N * ((5 + Rng.Rnd0<FLT>() * 10) * (i % 2 == 0 ? 1 : -1)) + IsectRndVec(Rng, 5);
+
+        // Ray directed away from triangle (hit behind origin)
+        R.Set(i, mth::ray<FLT>(Org, n % 4 == 3 && i == 2 ? Org - At : At - Org));
+      }
+      // Lane 1 has closer previous hit (masked out), lane 6 has farther one (replaced if hit)
+      H.T[1] = 1e-3f, H.U[1] = 0.25f, H.V[1] = 0.5f, H.PrimId[1] = 77, H.TriId[1] = 78;
+      H.T[6] = 1e6f, H.U[6] = 0.5f, H.V[6] = 0.25f, H.PrimId[6] = 77, H.TriId[6] = 79;
+
+      mth::hit_packet Old = H;
+      INT Bits = mth::Intersect(R, P0, P1, P2, 3, n, H);
+
+      for (INT i = 0; i < 8; i++)
+      {
+        mth::hit<FLT> Ref = Old.Get(i);
+        BOOL IsHit = mth::Intersect(R.Get(i), P0, P1, P2, 3, n, Ref);
+        std::string Lane = Name + " lane " + std::to_string(i);
+
+        Ctx.Check(Lane + " hit flag", ((Bits >> i) & 1) == IsHit);
+        CheckHit(Ctx, Lane, H.Get(i), Ref);
+        if (!IsHit)
+          Ctx.Check(Lane + " untouched", H.T[i] == Old.T[i] && H.U[i] == Old.U[i] && H.V[i] == Old.V[i] &&
+                                         H.PrimId[i] == Old.PrimId[i] && H.TriId[i] == Old.TriId[i]);
+      }
+      Ctx.Check(Name + " masked out lane", ((Bits >> 1) & 1) == 0);
+    }
+
+    /* Packet mesh query is same as scalar closest hit */
+    std::vector<isect_vertex> V;
+    std::vector<INT> Ind;
+
+    for (INT i = 0; i < 24; i++)
+    {
+      vec3 P0 = IsectRndVec(Rng, 10);
+
+      V.push_back({P0, 0});
+      V.push_back({P0 + IsectRndVec(Rng, 6), 1});
+      V.push_back({P0 + IsectRndVec(Rng, 6), 2});
+      Ind.push_back(i * 3), Ind.push_back(i * 3 + 1), Ind.push_back(i * 3 + 2);
+    }
+    for (INT n = 0; n < IsectPackets; n++)
+    {
+      std::string Name = "mesh #" + std::to_string(n);
+      mth::ray_packet R;
+      mth::hit_packet H;
+
+      for (INT i = 0; i < 8; i++)
+      {
+        INT Tri = (n * 8 + i) % 24;
+        vec3
+          At = V[Tri * 3].P * 0.4f + V[Tri * 3 + 1].P * 0.3f + V[Tri * 3 + 2].P * 0.3f,
+          Org = IsectRndVec(Rng, 25);
+
+        R.Set(i, mth::ray<FLT>(Org, At - Org));
+      }
+      INT Bits = mth::Intersect(R, std::span<const isect_vertex>(V), &isect_vertex::P, std::span<const INT>(Ind), 5, H);
+
+      for (INT i = 0; i < 8; i++)
+      {
+        mth::hit<FLT> Ref;
+        BOOL IsHit = mth::Intersect(R.Get(i), std::span<const isect_vertex>(V), &isect_vertex::P, std::span<const INT>(Ind), 5, Ref);
+        std::string Lane = Name + " lane " + std::to_string(i);
+
+        Ctx.Check(Lane + " hit flag", ((Bits >> i) & 1) == IsHit);
+        CheckHit(Ctx, Lane, H.Get(i), Ref);
+      }
+    }
+  } /* End of 'IsectTriangleChecks' function */
+
+  /* Ray packet intersection tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID IsectSuite( context &Ctx )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("isect: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("isect ") + L.Name;
+      IsectBoxChecks(Ctx);
+      IsectTriangleChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "isect generic";
+    IsectBoxChecks(Ctx);
+    IsectTriangleChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'IsectSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_isect.cpp' FILE */
@@ -0,0 +1,40 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_main.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Math library tests startup file.
+ * NOTE:        Usage: mth_test (exit code is number of failed checks).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "test.h"
+
+/* Tests main program function.
+ * ARGUMENTS: None.
+ * RETURNS:
+ *   (INT) number of failed checks.
+ */
+INT main( VOID )
+{
+  test::context Ctx;
+
+  test::MatrSuite(Ctx);
+  test::BatchSuite(Ctx);
+  test::QuatSuite(Ctx);
+  test::CullSuite(Ctx);
+  test::IsectSuite(Ctx);
+  test::BvhSuite(Ctx);
+  test::RngSuite(Ctx);
+  test::XprSuite(Ctx);
+
+  std::printf("%d checks, %d failed\n", Ctx.NumOfChecks, Ctx.NumOfFails);
+  return Ctx.NumOfFails;
+} /* End of 'main' function */
+
+/* END OF 'test_main.cpp' FILE */
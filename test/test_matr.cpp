@@ -0,0 +1,241 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_matr.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Matrix kernels tests suite.
+ * NOTE:        'matr<FLT>' operations are run with every supported kernels
+ *              level and compared with generic template ('matr<DBL>').
+ *              Tolerances are scaled by operands magnitude (and by
+ *              condition estimate for inversion).
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Float precision relative tolerance */
+  constexpr DBL Eps = 1e-5;
+
+  /* Test matrix case structure */
+  struct matr_case
+  {
+    std::string Name;   // Case name
+    mth::matr<FLT> M;   // Matrix
+    BOOL IsSingular;    // Matrix is exactly singular flag
+  }; /* End of 'matr_case' structure */
+
+  /* Convert matrix to generic double matrix function.
+   * ARGUMENTS:
+   *   - matrix:
+   *       const mth::matr<FLT> &M;
+   * RETURNS:
+   *   (mth::matr<DBL>) same matrix.
+   */
+  static mth::matr<DBL> ToDbl( const mth::matr<FLT> &M )
+  {
+    mth::matr<DBL> R;
+
+    for (INT i = 0; i < 4; i++)
+      for (INT j = 0; j < 4; j++)
+        R.M[i][j] = M.M[i][j];
+    return R;
+  } /* End of 'ToDbl' function */
+
+  /* Get maximal absolute matrix element function.
+   * ARGUMENTS:
+   *   - matrix:
+   *       const mth::matr<Type> &M;
+   * RETURNS:
+   *   (DBL) maximal absolute element.
+   */
+  template<typename Type>
+    static DBL MaxAbs( const mth::matr<Type> &M )
+    {
+      DBL R = 0;
+
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+          R = std::abs((DBL)M.M[i][j]) > R ? std::abs((DBL)M.M[i][j]) : R;
+      return R;
+    } /* End of 'MaxAbs' function */
+
+  /* Check matrix is close to reference function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - tested and reference matrices:
+   *       const mth::matr<FLT> &M;
+   *       const mth::matr<DBL> &Ref;
+   *   - absolute tolerance:
+   *       DBL Tolerance;
+   * RETURNS: None.
+   */
+  static VOID CheckMatr( context &Ctx, const std::string &Name,
+                         const mth::matr<FLT> &M, const mth::matr<DBL> &Ref, DBL Tolerance )
+  {
+    for (INT i = 0; i < 4; i++)
+      for (INT j = 0; j < 4; j++)
+        if (!Ctx.CheckNear(Name + "[" + std::to_string(i) + "][" + std::to_string(j) + "]", M.M[i][j], Ref.M[i][j], Tolerance))
+          return;
+  } /* End of 'CheckMatr' function */
+
+  /* Make test matrices function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::vector<matr_case>) test cases.
+   */
+  static std::vector<matr_case> MakeCases( VOID )
+  {
+    using matr = mth::matr<FLT>;
+    using vec3 = mth::vec3<FLT>;
+    std::vector<matr_case> Cases;
+    mth::rng Rng(30);
+
+    Cases.push_back({"identity", matr::Identity(), FALSE});
+    Cases.push_back({"rigid", matr::Rotate(37, vec3(1, 2, 3)) * matr::Translate(vec3(5, -7, 2)), FALSE});
+    Cases.push_back({"affine", matr::Scale(vec3(0.5f, 3, -2)) * matr::RotateY(120) * matr::Translate(vec3(-1, 4, 10)), FALSE});
+    Cases.push_back({"projective", matr::Frustum(-1, 1, -1, 1, 1, 100), FALSE});
+    for (INT n = 0; n < 8; n++)
+    {
+      matr M;
+
+      for (INT i = 0; i < 4; i++)
+        for (INT j = 0; j < 4; j++)
+          M.M[i][j] = Rng.Rnd1<FLT>() * 10;
+      Cases.push_back({"random" + std::to_string(n), M, FALSE});
+    }
+
+    // Integer elements - determinant of singular matrices is exactly 0 in any evaluation order
+    Cases.push_back({"zero", matr(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0), TRUE});
+    Cases.push_back({"same rows", matr(1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 9, 1, 2, 3), TRUE});
+    Cases.push_back({"rank 2", matr(1, 2, 3, 4, 2, 0, 1, 5, 3, 2, 4, 9, 4, 4, 7, 13), TRUE});
+    Cases.push_back({"rank 3", matr(1, 2, 3, 4, 2, 0, 1, 5, 0, 1, 1, 2, 3, 3, 5, 11), TRUE});
+    Cases.push_back({"zero column", matr(1, 2, 0, 4, 5, 6, 0, 8, 9, 1, 0, 3, 4, 5, 0, 7), TRUE});
+    Cases.push_back({"flat scale", matr::Scale(vec3(2, 0, 3)) * matr::Translate(vec3(1, 2, 3)), TRUE});
+
+    // Near singular (small but not zero determinant)
+    Cases.push_back({"near same rows", matr(1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4.001f, 9, 1, 2, 3), FALSE});
+    Cases.push_back({"near rank 3", matr(1, 2, 3, 4, 2, 0, 1, 5, 0, 1, 1, 2, 3, 3, 5, 11.01f), FALSE});
+    Cases.push_back({"near flat scale", matr::Scale(vec3(2, 1e-3f, 3)) * matr::Translate(vec3(1, 2, 3)), FALSE});
+    return Cases;
+  } /* End of 'MakeCases' function */
+
+  /* Run matrix operations checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID MatrChecks( context &Ctx )
+  {
+    std::vector<matr_case> Cases = MakeCases();
+    mth::rng Rng(47);
+
+    for (auto &A : Cases)
+    {
+      mth::matr<DBL> Ad = ToDbl(A.M);
+      DBL MaxA = MaxAbs(A.M);
+
+      /* Multiplication (with every case and itself) */
+      for (auto &B : Cases)
+        CheckMatr(Ctx, "mul " + A.Name + " * " + B.Name, A.M * B.M, Ad * ToDbl(B.M), Eps * (1 + 4 * MaxA * MaxAbs(B.M)));
+
+      /* Transposition is exact */
+      CheckMatr(Ctx, "transpose " + A.Name, A.M.Transpose(), Ad.Transpose(), 0);
+
+      /* Determinant (tolerance by Hadamard bound) */
+      DBL Bound = 1;
+
+      for (INT i = 0; i < 4; i++)
+        Bound *= std::sqrt(Ad.M[i][0] * Ad.M[i][0] + Ad.M[i][1] * Ad.M[i][1] + Ad.M[i][2] * Ad.M[i][2] + Ad.M[i][3] * Ad.M[i][3]);
+      DBL Det = !A.M;
+
+      Ctx.CheckNear("determ " + A.Name, Det, !Ad, Eps * Bound);
+      if (A.IsSingular)
+        Ctx.Check("determ " + A.Name + " is zero", Det == 0);
+
+      /* Inversion (singular matrix gives identity) */
+      mth::matr<DBL> RefInv = Ad.Inverse();
+      DBL MaxInv = MaxAbs(RefInv);
+
+      if (A.IsSingular)
+        CheckMatr(Ctx, "inverse " + A.Name, A.M.Inverse(), mth::matr<DBL>::Identity(), 0);
+      else
+        CheckMatr(Ctx, "inverse " + A.Name, A.M.Inverse(), RefInv, Eps * MaxInv * (1 + 4 * MaxA * MaxInv));
+
+      /* Points and vectors transformation */
+      for (INT n = 0; n < 16; n++)
+      {
+        mth::vec3<FLT> V(Rng.Rnd1<FLT>() * 100, Rng.Rnd1<FLT>() * 100, Rng.Rnd1<FLT>() * 100);
+        mth::vec3<DBL> Vd(V.X, V.Y, V.Z);
+        mth::vec3<FLT>
+          P = A.M.TransformPoint(V),
+          D = A.M.TransformVector(V);
+        mth::vec3<DBL>
+          RefP = Ad.TransformPoint(Vd),
+          RefD = Ad.TransformVector(Vd);
+        DBL Tolerance = Eps * (1 + 4 * MaxA * 100);
+
+        Ctx.CheckNear("point " + A.Name + " x", P.X, RefP.X, Tolerance);
+        Ctx.CheckNear("point " + A.Name + " y", P.Y, RefP.Y, Tolerance);
+        Ctx.CheckNear("point " + A.Name + " z", P.Z, RefP.Z, Tolerance);
+        Ctx.CheckNear("vector " + A.Name + " x", D.X, RefD.X, Tolerance);
+        Ctx.CheckNear("vector " + A.Name + " y", D.Y, RefD.Y, Tolerance);
+        Ctx.CheckNear("vector " + A.Name + " z", D.Z, RefD.Z, Tolerance);
+      }
+    }
+  } /* End of 'MatrChecks' function */
+
+  /* Matrix kernels tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID MatrSuite( context &Ctx )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("matr: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("matr ") + L.Name;
+      MatrChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "matr generic";
+    MatrChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'MatrSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_matr.cpp' FILE */
@@ -0,0 +1,333 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_quat.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Quaternion and dual quaternion tests suite.
+ * NOTE:        Rotations are compared with 'matr' (quaternion and
+ *              its negation are same rotation, so matrices are
+ *              compared instead of components). Array kernels are
+ *              run with every supported kernels level and compared
+ *              with scalar operations.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Float precision tolerance (unit quaternions and rotations) */
+  constexpr DBL QuatEps = 1e-5;
+
+  /* Range of test translations and points */
+  constexpr FLT QuatRange = 10;
+
+  /* Check matrices are close function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - tested and reference matrices:
+   *       const mth::matr<FLT> &M, &Ref;
+   *   - absolute tolerance:
+   *       DBL Tolerance;
+   * RETURNS: None.
+   */
+  static VOID CheckQuatMatr( context &Ctx, const std::string &Name,
+                             const mth::matr<FLT> &M, const mth::matr<FLT> &Ref, DBL Tolerance )
+  {
+    for (INT i = 0; i < 4; i++)
+      for (INT j = 0; j < 4; j++)
+        if (!Ctx.CheckNear(Name + "[" + std::to_string(i) + "][" + std::to_string(j) + "]", M.M[i][j], Ref.M[i][j], Tolerance))
+          return;
+  } /* End of 'CheckQuatMatr' function */
+
+  /* Check vectors are close function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - tested and reference vectors:
+   *       const mth::vec3<FLT> &V, &Ref;
+   *   - absolute tolerance:
+   *       DBL Tolerance;
+   * RETURNS: None.
+   */
+  static VOID CheckQuatVec( context &Ctx, const std::string &Name,
+                            const mth::vec3<FLT> &V, const mth::vec3<FLT> &Ref, DBL Tolerance )
+  {
+    Ctx.CheckNear(Name + " x", V.X, Ref.X, Tolerance);
+    Ctx.CheckNear(Name + " y", V.Y, Ref.Y, Tolerance);
+    Ctx.CheckNear(Name + " z", V.Z, Ref.Z, Tolerance);
+  } /* End of 'CheckQuatVec' function */
+
+  /* Check quaternions are close function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   *   - check name:
+   *       const std::string &Name;
+   *   - tested and reference quaternions:
+   *       const mth::quat<FLT> &Q, &Ref;
+   *   - absolute tolerance:
+   *       DBL Tolerance;
+   * RETURNS: None.
+   */
+  static VOID CheckQuat( context &Ctx, const std::string &Name,
+                         const mth::quat<FLT> &Q, const mth::quat<FLT> &Ref, DBL Tolerance )
+  {
+    Ctx.CheckNear(Name + " x", Q.X, Ref.X, Tolerance);
+    Ctx.CheckNear(Name + " y", Q.Y, Ref.Y, Tolerance);
+    Ctx.CheckNear(Name + " z", Q.Z, Ref.Z, Tolerance);
+    Ctx.CheckNear(Name + " w", Q.W, Ref.W, Tolerance);
+  } /* End of 'CheckQuat' function */
+
+  /* Make random vector function.
+   * ARGUMENTS:
+   *   - random numbers generator:
+   *       mth::rng &Rng;
+   *   - components range:
+   *       FLT Range;
+   * RETURNS:
+   *   (mth::vec3<FLT>) vector.
+   */
+  static mth::vec3<FLT> QuatRndVec( mth::rng &Rng, FLT Range )
+  {
+    return mth::vec3<FLT>(Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range);
+  } /* End of 'QuatRndVec' function */
+
+  /* Make test rotations function.
+   * ARGUMENTS: None.
+   * RETURNS:
+   *   (std::vector<mth::quat<FLT>>) unit quaternions.
+   */
+  static std::vector<mth::quat<FLT>> MakeRotations( VOID )
+  {
+    using quat = mth::quat<FLT>;
+    using vec3 = mth::vec3<FLT>;
+    std::vector<quat> Rots;
+    mth::rng Rng(57);
+
+    Rots.push_back(quat::Identity());
+    // Half turns (every 'FromMatr' branch with non positive trace)
+    Rots.push_back(quat::RotateX(180));
+    Rots.push_back(quat::RotateY(180));
+    Rots.push_back(quat::RotateZ(180));
+    Rots.push_back(quat::Rotate(179.5f, vec3(1, 1, 0)));
+    Rots.push_back(quat::RotateX(30));
+    Rots.push_back(quat::RotateY(-75));
+    Rots.push_back(quat::RotateZ(120));
+    for (INT n = 0; n < 16; n++)
+    {
+      vec3 Axis = QuatRndVec(Rng, 1);
+
+      if ((Axis & Axis) < 1e-4f)
+        Axis = vec3(0, 0, 1);
+      Rots.push_back(quat::Rotate(Rng.Rnd1<FLT>() * 360, Axis));
+    }
+    return Rots;
+  } /* End of 'MakeRotations' function */
+
+  /* Run scalar quaternions checks function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID QuatScalarChecks( context &Ctx )
+  {
+    using quat = mth::quat<FLT>;
+    using dual_quat = mth::dual_quat<FLT>;
+    using matr = mth::matr<FLT>;
+    using vec3 = mth::vec3<FLT>;
+    std::vector<quat> Rots = MakeRotations();
+    mth::rng Rng(58);
+
+    for (size_t i = 0; i < Rots.size(); i++)
+    {
+      std::string Name = " #" + std::to_string(i);
+      const quat &Q = Rots[i];
+      matr M = Q.ToMatr();
+
+      /* Quaternion <-> matrix round trip (sign of quaternion is arbitrary) */
+      quat R = quat::FromMatr(M);
+
+      Ctx.CheckNear("from matr is unit" + Name, !R, 1, QuatEps);
+      Ctx.CheckNear("from matr same rotation" + Name, std::abs(R & Q), 1, QuatEps);
+      CheckQuatMatr(Ctx, "round trip" + Name, R.ToMatr(), M, QuatEps);
+
+      /* Vector rotation is same as matrix transformation */
+      for (INT n = 0; n < 4; n++)
+      {
+        vec3 V = QuatRndVec(Rng, QuatRange);
+
+        CheckQuatVec(Ctx, "rotate" + Name, Q.Rotate(V), M.TransformVector(V), QuatEps * QuatRange);
+      }
+
+      /* Composition follows matrix order */
+      const quat &B = Rots[(i * 7 + 3) % Rots.size()];
+
+      CheckQuatMatr(Ctx, "compose" + Name, (Q * B).ToMatr(), M * B.ToMatr(), QuatEps);
+
+      /* Slerp endpoints and midpoint (by shortest arc) */
+      CheckQuatMatr(Ctx, "slerp 0" + Name, quat::Slerp(Q, B, 0).ToMatr(), M, QuatEps);
+      CheckQuatMatr(Ctx, "slerp 1" + Name, quat::Slerp(Q, B, 1).ToMatr(), B.ToMatr(), QuatEps);
+      quat S = quat::Slerp(Q, B, 0.5f);
+
+      Ctx.CheckNear("slerp half is unit" + Name, !S, 1, QuatEps);
+      Ctx.CheckNear("slerp half is middle" + Name, std::abs(S & Q), std::abs(S & B), QuatEps);
+
+      /* Dual quaternion (rotate, then translate) vs matrix */
+      vec3 T = QuatRndVec(Rng, QuatRange);
+      dual_quat D(Q, T);
+      matr DM = M * matr::Translate(T);
+      DBL Tolerance = QuatEps * QuatRange * 4;
+
+      CheckQuatMatr(Ctx, "dual to matr" + Name, D.ToMatr(), DM, Tolerance);
+      CheckQuatVec(Ctx, "dual translation" + Name, D.Translation(), T, Tolerance);
+      for (INT n = 0; n < 4; n++)
+      {
+        vec3 P = QuatRndVec(Rng, QuatRange);
+
+        CheckQuatVec(Ctx, "dual point" + Name, D.TransformPoint(P), DM.TransformPoint(P), Tolerance);
+        CheckQuatVec(Ctx, "dual vector" + Name, D.TransformVector(P), DM.TransformVector(P), Tolerance);
+        CheckQuatVec(Ctx, "dual inverse" + Name, D.Inverse().TransformPoint(D.TransformPoint(P)), P, Tolerance);
+      }
+      CheckQuatMatr(Ctx, "dual from matr" + Name, dual_quat::FromMatr(DM).ToMatr(), DM, Tolerance);
+
+      dual_quat G(B, QuatRndVec(Rng, QuatRange));
+
+      CheckQuatMatr(Ctx, "dual compose" + Name, (D * G).ToMatr(), DM * G.ToMatr(), Tolerance * 2);
+      CheckQuatMatr(Ctx, "dual blend 0" + Name, dual_quat::Blend(D, G, 0).ToMatr(), DM, Tolerance);
+      CheckQuatMatr(Ctx, "dual blend 1" + Name, dual_quat::Blend(D, G, 1).ToMatr(), G.ToMatr(), Tolerance);
+    }
+  } /* End of 'QuatScalarChecks' function */
+
+  /* Run quaternion arrays checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID QuatBatchChecks( context &Ctx )
+  {
+    using quat = mth::quat<FLT>;
+    using dual_quat = mth::dual_quat<FLT>;
+    // Block size neighbours (AVX2 kernels process 8 quaternions per step)
+    const size_t Counts[] = {0, 1, 7, 8, 9, 16, 37};
+    mth::rng Rng(59);
+
+    for (size_t Count : Counts)
+    {
+      std::string Size = " n=" + std::to_string(Count);
+      std::vector<quat> A(Count), B(Count);
+
+      for (size_t i = 0; i < Count; i++)
+      {
+        A[i] = quat(Rng.Rnd1<FLT>() * 3, Rng.Rnd1<FLT>() * 3, Rng.Rnd1<FLT>() * 3, Rng.Rnd1<FLT>() * 3);
+        B[i] = quat(Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>()).Normalize();
+      }
+      // Zero quaternion is kept
+      if (Count > 2)
+        A[2] = quat(0, 0, 0, 0);
+
+      /* Normalization */
+      std::vector<quat> N = A;
+
+      mth::Normalize(std::span<quat>(N));
+      for (size_t i = 0; i < Count; i++)
+        CheckQuat(Ctx, "normalize" + Size + " #" + std::to_string(i), N[i], A[i].Normalizing(), QuatEps);
+
+      /* Composition (separate and in place result) */
+      std::vector<quat> C(Count), P = A;
+
+      mth::Compose(std::span<const quat>(A), std::span<const quat>(B), std::span<quat>(C));
+      mth::Compose(std::span<const quat>(P), std::span<const quat>(B), std::span<quat>(P));
+      for (size_t i = 0; i < Count; i++)
+      {
+        quat Ref = A[i] * B[i];
+
+        CheckQuat(Ctx, "compose" + Size + " #" + std::to_string(i), C[i], Ref, QuatEps * 10);
+        CheckQuat(Ctx, "compose in place" + Size + " #" + std::to_string(i), P[i], Ref, QuatEps * 10);
+      }
+
+      /* Slerp (unit quaternions) */
+      std::vector<quat> S(Count);
+
+      mth::Normalize(std::span<quat>(N));
+      mth::Slerp(std::span<const quat>(N), std::span<const quat>(B), 0.25f, std::span<quat>(S));
+      for (size_t i = 0; i < Count; i++)
+        CheckQuat(Ctx, "slerp" + Size + " #" + std::to_string(i), S[i], quat::Slerp(N[i], B[i], 0.25f), 0);
+
+      /* Dual quaternions composition */
+      std::vector<dual_quat> DA(Count), DB(Count), DC(Count);
+
+      for (size_t i = 0; i < Count; i++)
+      {
+        DA[i] = dual_quat(B[i], QuatRndVec(Rng, QuatRange));
+        DB[i] = dual_quat(N[i], QuatRndVec(Rng, QuatRange));
+      }
+      mth::Compose(std::span<const dual_quat>(DA), std::span<const dual_quat>(DB), std::span<dual_quat>(DC));
+      for (size_t i = 0; i < Count; i++)
+      {
+        dual_quat Ref = DA[i] * DB[i];
+
+        CheckQuat(Ctx, "dual compose real" + Size + " #" + std::to_string(i), DC[i].Real, Ref.Real, 0);
+        CheckQuat(Ctx, "dual compose dual" + Size + " #" + std::to_string(i), DC[i].Dual, Ref.Dual, 0);
+      }
+    }
+  } /* End of 'QuatBatchChecks' function */
+
+  /* Quaternions tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID QuatSuite( context &Ctx )
+  {
+    Ctx.Impl = "quat";
+    QuatScalarChecks(Ctx);
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("quat: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("quat batch ") + L.Name;
+      QuatBatchChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "quat batch generic";
+    QuatBatchChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'QuatSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_quat.cpp' FILE */
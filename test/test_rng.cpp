@@ -0,0 +1,292 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_rng.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Pseudo random numbers generator tests suite.
+ * NOTE:        Scalar stream is compared with known first values and
+ *              with plain reference xoshiro256++ implementation. Span
+ *              filling is run with every supported kernels level: scalar
+ *              and SSE4.1 levels must give the same values as sequential
+ *              'Rnd0' calls, AVX2 level fills blocks of 8 numbers from 4
+ *              jumped streams (two numbers per 64-bit value) and the rest
+ *              from scalar stream, so it is compared with reference
+ *              streams instead.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Reference xoshiro256++ generator */
+  struct rng_ref
+  {
+    UINT64 S[4]; // Stream state
+
+    /* Constructor by seed (splitmix64 expansion).
+     * ARGUMENTS:
+     *   - generator seed:
+     *       UINT64 Seed;
+     */
+    rng_ref( UINT64 Seed )
+    {
+      for (INT i = 0; i < 4; i++)
+      {
+        UINT64 Z = (Seed += 0x9E3779B97F4A7C15ULL);
+
+        Z = (Z ^ (Z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        Z = (Z ^ (Z >> 27)) * 0x94D049BB133111EBULL;
+        S[i] = Z ^ (Z >> 31);
+      }
+    } /* End of 'rng_ref' function */
+
+    /* Get next 64-bit value function.
+     * ARGUMENTS: None.
+     * RETURNS:
+     *   (UINT64) random value.
+     */
+    UINT64 Next( VOID )
+    {
+      UINT64
+        Sum = S[0] + S[3],
+        R = ((Sum << 23) | (Sum >> 41)) + S[0],
+        T = S[1] << 17;
+
+      S[2] ^= S[0];
+      S[3] ^= S[1];
+      S[1] ^= S[2];
+      S[0] ^= S[3];
+      S[2] ^= T;
+      S[3] = (S[3] << 45) | (S[3] >> 19);
+      return R;
+    } /* End of 'Next' function */
+
+    /* Advance stream by 2^128 values function.
+     * ARGUMENTS: None.
+     * RETURNS: None.
+     */
+    VOID Jump( VOID )
+    {
+      const UINT64 J[] = {0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL};
+      UINT64 T[4] = {0, 0, 0, 0};
+
+      for (UINT64 W : J)
+        for (INT b = 0; b < 64; b++)
+        {
+          if ((W >> b) & 1)
+            for (INT k = 0; k < 4; k++)
+              T[k] ^= S[k];
+          Next();
+        }
+      for (INT k = 0; k < 4; k++)
+        S[k] = T[k];
+    } /* End of 'Jump' function */
+  }; /* End of 'rng_ref' structure */
+
+  /* Run span filling checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID RngFillChecks( context &Ctx )
+  {
+    BOOL IsStreams = FALSE;
+
+#if defined(USE_MTH_MATR_SIMD)
+    IsStreams = mth::simd::GetKernels().Level == mth::simd::level::AVX2;
+#endif // USE_MTH_MATR_SIMD
+
+    // Block size neighbours (AVX2 kernel fills 8 numbers per step)
+    const size_t Counts[] = {0, 1, 7, 8, 9, 16, 37};
+    const FLT Ranges[][2] = {{0, 1}, {-1, 1}, {-5, 20}};
+
+    for (size_t Count : Counts)
+      for (auto &Rg : Ranges)
+      {
+        std::string Name = "fill n=" + std::to_string(Count) + " [" + std::to_string((INT)Rg[0]) + ", " + std::to_string((INT)Rg[1]) + ")";
+        const UINT64 Seed = 31 + Count;
+        mth::rng Rng(Seed), Twin(Seed);
+        std::vector<FLT> Dst(Count + 1, -7), Ref(Count);
+        size_t Blocks = IsStreams ? Count / 8 * 8 : 0;
+
+        Rng.Fill(std::span<FLT>(Dst.data(), Count), Rg[0], Rg[1]);
+
+        // Blocks are filled from lanes started after 1, 2, 3 and 4 jumps
+        rng_ref Lanes[4] {Seed, Seed, Seed, Seed};
+
+        for (INT k = 0; k < 4; k++)
+          for (INT j = 0; j <= k; j++)
+            Lanes[k].Jump();
+        for (size_t i = 0; i < Blocks; i += 8)
+          for (INT k = 0; k < 4; k++)
+          {
+            UINT64 R = Lanes[k].Next();
+            FLT Scale = (Rg[1] - Rg[0]) / 16777216.0f;
+
+            Ref[i + 2 * k] = std::fma(static_cast<FLT>(static_cast<UINT>(R) >> 8), Scale, Rg[0]);
+            Ref[i + 2 * k + 1] = std::fma(static_cast<FLT>(static_cast<UINT>(R >> 32) >> 8), Scale, Rg[0]);
+          }
+        // Rest is filled from scalar stream
+        for (size_t i = Blocks; i < Count; i++)
+          Ref[i] = Rg[0] + (Rg[1] - Rg[0]) * Twin.Rnd0();
+
+        BOOL IsSame = TRUE, IsInRange = TRUE;
+
+        for (size_t i = 0; i < Count; i++)
+        {
+          IsSame = IsSame && Dst[i] == Ref[i];
+          IsInRange = IsInRange && Dst[i] >= Rg[0] && Dst[i] < Rg[1];
+        }
+        Ctx.Check(Name + " values", IsSame);
+        Ctx.Check(Name + " range", IsInRange);
+        Ctx.Check(Name + " guard", Dst[Count] == -7);
+
+        // Next fill continues the same streams
+        std::vector<FLT> Part(Count + 16), Whole(Count + 16);
+        mth::rng Rng1(Seed), Rng2(Seed);
+
+        Rng1.Fill(std::span<FLT>(Part.data(), 16), Rg[0], Rg[1]);
+        Rng1.Fill(std::span<FLT>(Part.data() + 16, Count), Rg[0], Rg[1]);
+        Rng2.Fill(std::span<FLT>(Whole.data(), Count + 16), Rg[0], Rg[1]);
+        Ctx.Check(Name + " continuation", std::equal(Part.begin(), Part.end(), Whole.begin()));
+      }
+
+    /* Uniformity of long span */
+    std::vector<FLT> Big(100000);
+    mth::rng Rng(5);
+    DBL Mean = 0, Var = 0;
+
+    Rng.Fill(std::span<FLT>(Big), 0, 1);
+    for (FLT X : Big)
+      Mean += X;
+    Mean /= Big.size();
+    for (FLT X : Big)
+      Var += (X - Mean) * (X - Mean);
+    Var /= Big.size();
+    Ctx.CheckNear("fill mean", Mean, 0.5, 0.01);
+    Ctx.CheckNear("fill variance", Var, 1.0 / 12, 0.005);
+  } /* End of 'RngFillChecks' function */
+
+  /* Pseudo random numbers generator tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID RngSuite( context &Ctx )
+  {
+    Ctx.Impl = "rng";
+
+    /* Known first values (scalar stream starts after 5 jumps) */
+    const struct
+    {
+      UINT64 Seed;      // Generator seed
+      UINT64 Values[4]; // First values
+    } Known[] =
+    {
+      {0, {0x1C03DD26568CA9EDULL, 0xE962C153F6A7B585ULL, 0xFF3EC853B2128720ULL, 0x40F3DFE12C9728F5ULL}},
+      {2024, {0x58BDE29B88D89E39ULL, 0xB040CFAD79BDA0FBULL, 0x42A339D97D84E506ULL, 0xA4F11626881422DAULL}},
+    };
+
+    for (auto &K : Known)
+    {
+      mth::rng Rng(K.Seed);
+      rng_ref Ref(K.Seed);
+      BOOL IsKnown = TRUE, IsRef = TRUE;
+
+      for (INT i = 0; i < 5; i++)
+        Ref.Jump();
+      for (UINT64 V : K.Values)
+        IsKnown = IsKnown && Rng.Next() == V;
+      Rng.SetSeed(K.Seed);
+      for (INT i = 0; i < 1000; i++)
+        IsRef = IsRef && Rng.Next() == Ref.Next();
+      Ctx.Check("known values seed=" + std::to_string(K.Seed), IsKnown);
+      Ctx.Check("reference stream seed=" + std::to_string(K.Seed), IsRef);
+    }
+    Ctx.Check("default seed", mth::rng().Next() == 0xCFD8414B3659040FULL);
+
+    /* Same seed gives same sequence, other seed gives other one */
+    mth::rng A(99), B(99), C(100);
+    BOOL IsSame = TRUE, IsOther = FALSE;
+
+    for (INT i = 0; i < 100; i++)
+    {
+      UINT64 V = A.Next();
+
+      IsSame = IsSame && V == B.Next();
+      IsOther = IsOther || V != C.Next();
+    }
+    Ctx.Check("same seed", IsSame);
+    Ctx.Check("other seed", IsOther);
+
+    /* Numbers ranges */
+    mth::rng Rng(7);
+    BOOL IsIn0 = TRUE, IsIn1 = TRUE, IsIn0D = TRUE;
+    FLT Min0 = 1, Max0 = 0;
+
+    for (INT i = 0; i < 100000; i++)
+    {
+      FLT X0 = Rng.Rnd0<FLT>(), X1 = Rng.Rnd1<FLT>();
+      DBL D0 = Rng.Rnd0<DBL>();
+
+      IsIn0 = IsIn0 && X0 >= 0 && X0 < 1;
+      IsIn1 = IsIn1 && X1 >= -1 && X1 < 1;
+      IsIn0D = IsIn0D && D0 >= 0 && D0 < 1;
+      Min0 = std::min(Min0, X0);
+      Max0 = std::max(Max0, X0);
+    }
+    Ctx.Check("rnd0 range", IsIn0);
+    Ctx.Check("rnd1 range", IsIn1);
+    Ctx.Check("rnd0 double range", IsIn0D);
+    Ctx.Check("rnd0 spread", Min0 < 0.001f && Max0 > 0.999f);
+
+    // Largest possible values are still below 1
+    Ctx.Check("rnd0 upper bound", static_cast<FLT>(16777215) * static_cast<FLT>(1.0 / 16777216.0) < 1);
+    Ctx.Check("rnd0 double upper bound", static_cast<DBL>(9007199254740991ULL) * (1.0 / 9007199254740992.0) < 1);
+
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("rng: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("rng ") + L.Name;
+      RngFillChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "rng generic";
+    RngFillChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'RngSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_rng.cpp' FILE */
@@ -0,0 +1,221 @@
+/***************************************************************
+ * Copyright (C) 1992-2024
+ *    Computer Graphics Support Group of 30 Phys-Math Lyceum
+ ***************************************************************/
+
+/* FILE:        test_xpr.cpp
+ * PROGRAMMER:  IP5
+ * LAST UPDATE: 17.10.2026
+ * PURPOSE:     Lazy (expression template) evaluation tests suite.
+ * NOTE:        Expressions are evaluated with every supported kernels
+ *              level and must be equal bit by bit (up to sign of exact
+ *              zero) to eager operators chain. There are no 'vec4'
+ *              expression nodes, so 'vec4' values are checked through
+ *              transformation by evaluated matrices.
+ *
+ * No part of this file may be changed without agreement of
+ * Computer Graphics Support Group of 30 Phys-Math Lyceum.
+ */
+
+#include "test.h"
+
+/* Tests namespace */
+namespace test
+{
+  /* Number of random expressions of every kind */
+  constexpr INT XprCount = 200;
+
+  /* Check matrices are equal function.
+   * ARGUMENTS:
+   *   - matrices:
+   *       const mth::matr<FLT> &A, &B;
+   * RETURNS:
+   *   (BOOL) TRUE if all elements are equal.
+   */
+  static BOOL XprSame( const mth::matr<FLT> &A, const mth::matr<FLT> &B )
+  {
+    for (INT i = 0; i < 4; i++)
+      for (INT j = 0; j < 4; j++)
+        if (A.M[i][j] != B.M[i][j])
+          return FALSE;
+    return TRUE;
+  } /* End of 'XprSame' function */
+
+  /* Check vectors are equal function.
+   * ARGUMENTS:
+   *   - vectors:
+   *       const mth::vec3<FLT> &A, &B;
+   * RETURNS:
+   *   (BOOL) TRUE if all components are equal.
+   */
+  static BOOL XprSame( const mth::vec3<FLT> &A, const mth::vec3<FLT> &B )
+  {
+    return A.X == B.X && A.Y == B.Y && A.Z == B.Z;
+  } /* End of 'XprSame' function */
+
+  /* Check vectors are equal function.
+   * ARGUMENTS:
+   *   - vectors:
+   *       const mth::vec4<FLT> &A, &B;
+   * RETURNS:
+   *   (BOOL) TRUE if all components are equal.
+   */
+  static BOOL XprSame( const mth::vec4<FLT> &A, const mth::vec4<FLT> &B )
+  {
+    return A.X == B.X && A.Y == B.Y && A.Z == B.Z && A.W == B.W;
+  } /* End of 'XprSame' function */
+
+  /* Make random vector function.
+   * ARGUMENTS:
+   *   - random numbers generator:
+   *       mth::rng &Rng;
+   *   - components range:
+   *       FLT Range;
+   * RETURNS:
+   *   (mth::vec3<FLT>) vector.
+   */
+  static mth::vec3<FLT> XprRndVec( mth::rng &Rng, FLT Range )
+  {
+    return mth::vec3<FLT>(Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range, Rng.Rnd1<FLT>() * Range);
+  } /* End of 'XprRndVec' function */
+
+  /* Run expressions checks with current kernels function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  static VOID XprChecks( context &Ctx )
+  {
+    namespace xpr = mth::xpr;
+    using vec3 = mth::vec3<FLT>;
+    using vec4 = mth::vec4<FLT>;
+    using matr = mth::matr<FLT>;
+    mth::rng Rng(404);
+    BOOL
+      IsTS = TRUE, IsST = TRUE, IsTT = TRUE, IsSS = TRUE,
+      IsRT = TRUE, IsSRT = TRUE, IsTRS = TRUE, IsGeneral = TRUE,
+      IsConv = TRUE, IsVec4 = TRUE, IsVec3 = TRUE;
+
+    for (INT i = 0; i < XprCount; i++)
+    {
+      vec3
+        T1 = XprRndVec(Rng, 100),
+        T2 = XprRndVec(Rng, 100),
+        S1 = XprRndVec(Rng, 5),
+        S2 = XprRndVec(Rng, 5),
+        Axis = XprRndVec(Rng, 1) + vec3(0, 0, 2);
+      FLT
+        A1 = Rng.Rnd1<FLT>() * 180,
+        A2 = Rng.Rnd1<FLT>() * 180;
+      matr G(Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(),
+             Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(),
+             Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(),
+             Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>(), Rng.Rnd1<FLT>());
+
+      /* Sparse products */
+      IsTS = IsTS && XprSame(xpr::Eval(xpr::Translate(T1) * xpr::Scale(S1)), matr::Translate(T1) * matr::Scale(S1));
+      IsST = IsST && XprSame(xpr::Eval(xpr::Scale(S1) * xpr::Translate(T1)), matr::Scale(S1) * matr::Translate(T1));
+      IsTT = IsTT && XprSame(xpr::Eval(xpr::Translate(T1) * xpr::Translate(T2)), matr::Translate(T1) * matr::Translate(T2));
+      IsSS = IsSS && XprSame(xpr::Eval(xpr::Scale(S1) * xpr::Scale(S2)), matr::Scale(S1) * matr::Scale(S2));
+      IsRT = IsRT && XprSame(xpr::Eval(xpr::RotateY(A1) * xpr::Translate(T1)), matr::RotateY(A1) * matr::Translate(T1));
+
+      /* Chains */
+      matr
+        SRT = xpr::Scale(S1) * xpr::RotateX(A1) * xpr::Rotate(A2, Axis) * xpr::Translate(T1),
+        SRTRef = matr::Scale(S1) * matr::RotateX(A1) * matr::Rotate(A2, Axis) * matr::Translate(T1),
+        TRS = xpr::Translate(T1) * xpr::RotateZ(A2) * xpr::Scale(S2) * xpr::Translate(T2) * xpr::Scale(S1),
+        TRSRef = matr::Translate(T1) * matr::RotateZ(A2) * matr::Scale(S2) * matr::Translate(T2) * matr::Scale(S1);
+
+      IsSRT = IsSRT && XprSame(SRT, SRTRef);
+      IsTRS = IsTRS && XprSame(TRS, TRSRef);
+
+      /* Products with plain matrices */
+      matr
+        LG = G * xpr::Scale(S1) * xpr::Translate(T1),
+        LGRef = G * matr::Scale(S1) * matr::Translate(T1),
+        RG = xpr::RotateY(A1) * xpr::Scale(S2) * G,
+        RGRef = matr::RotateY(A1) * matr::Scale(S2) * G,
+        MG = xpr::Translate(T2) * xpr::Lazy(G) * xpr::Translate(T1),
+        MGRef = matr::Translate(T2) * G * matr::Translate(T1);
+
+      IsGeneral = IsGeneral && XprSame(LG, LGRef) && XprSame(RG, RGRef) && XprSame(MG, MGRef);
+
+      /* Conversion and member evaluation are the same */
+      auto X = xpr::RotateZ(A1) * xpr::Translate(T1) * xpr::Scale(S1);
+      matr XConv = X;
+
+      IsConv = IsConv && XprSame(XConv, X.Eval()) && XprSame(XConv, xpr::Eval(X));
+
+      /* 4D vectors transformed by evaluated matrices */
+      vec4 P(T2.X, T2.Y, T2.Z, 1), D(S2.X, S2.Y, S2.Z, 0);
+
+      IsVec4 = IsVec4 &&
+        XprSame(SRT.Transform4x4(P), SRTRef.Transform4x4(P)) && XprSame(SRT.Transform4x4(D), SRTRef.Transform4x4(D)) &&
+        XprSame(TRS.Transform4x4(P), TRSRef.Transform4x4(P)) && XprSame(LG.Transform4x4(D), LGRef.Transform4x4(D));
+
+      /* 3D vector expressions */
+      vec3
+        V1 = xpr::Lazy(T1) + xpr::Lazy(T2) * A1 - xpr::Lazy(S1) / A2,
+        V1Ref = T1 + T2 * A1 - S1 / A2,
+        V2 = xpr::Eval((xpr::Lazy(S1) - xpr::Lazy(T1)) * xpr::Lazy(S2) + xpr::Lazy(T2) * 0.5f),
+        V2Ref = (S1 - T1) * S2 + T2 * 0.5f,
+        V3 = (xpr::Lazy(Axis) * xpr::Lazy(Axis) + xpr::Lazy(S1)) / 3.0f,
+        V3Ref = (Axis * Axis + S1) / 3.0f;
+
+      IsVec3 = IsVec3 && XprSame(V1, V1Ref) && XprSame(V2, V2Ref) && XprSame(V3, V3Ref);
+    }
+    Ctx.Check("translate * scale", IsTS);
+    Ctx.Check("scale * translate", IsST);
+    Ctx.Check("translate * translate", IsTT);
+    Ctx.Check("scale * scale", IsSS);
+    Ctx.Check("rotate * translate", IsRT);
+    Ctx.Check("scale * rotate * translate chain", IsSRT);
+    Ctx.Check("translate * rotate * scale chain", IsTRS);
+    Ctx.Check("plain matrix operands", IsGeneral);
+    Ctx.Check("evaluation forms", IsConv);
+    Ctx.Check("vec4 transform", IsVec4);
+    Ctx.Check("vec3 expressions", IsVec3);
+  } /* End of 'XprChecks' function */
+
+  /* Lazy evaluation tests suite function.
+   * ARGUMENTS:
+   *   - tests context:
+   *       context &Ctx;
+   * RETURNS: None.
+   */
+  VOID XprSuite( context &Ctx )
+  {
+#if defined(USE_MTH_MATR_SIMD)
+    using mth::simd::level;
+    const struct
+    {
+      level Level;      // Kernels level
+      const char *Name; // Level name
+    } Levels[] =
+    {
+      {level::SCALAR, "scalar"},
+      {level::SSE41, "sse4.1"},
+      {level::AVX2, "avx2"},
+    };
+    level Best = mth::simd::DetectLevel();
+
+    for (auto &L : Levels)
+    {
+      if (mth::simd::SetLevel(L.Level) != L.Level)
+      {
+        std::printf("xpr: %s kernels are not supported by CPU, skipped\n", L.Name);
+        continue;
+      }
+      Ctx.Impl = std::string("xpr ") + L.Name;
+      XprChecks(Ctx);
+    }
+    mth::simd::SetLevel(Best);
+#else  // USE_MTH_MATR_SIMD
+    Ctx.Impl = "xpr generic";
+    XprChecks(Ctx);
+#endif // USE_MTH_MATR_SIMD
+  } /* End of 'XprSuite' function */
+} /* end of 'test' namespace */
+
+/* END OF 'test_xpr.cpp' FILE */